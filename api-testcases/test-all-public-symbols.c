@@ -53,6 +53,7 @@ static duk_ret_t test_func(duk_context *ctx) {
 	(void) duk_del_prop_string(ctx, 0, "dummy");
 	(void) duk_del_prop(ctx, 0);
 	(void) duk_del_var(ctx);
+	(void) duk_deserialize(ctx, 0);
 	(void) duk_destroy_heap(ctx);
 	(void) duk_dump_context_stderr(ctx);
 	(void) duk_dump_context_stdout(ctx);
@@ -157,6 +158,7 @@ static duk_ret_t test_func(duk_context *ctx) {
 	(void) duk_pop_3(ctx);
 	(void) duk_pop_n(ctx, 0);
 	(void) duk_pop(ctx);
+	(void) duk_process_pending(ctx, 0);
 	(void) duk_push_array(ctx);
 	(void) duk_push_boolean(ctx, 0);
 	(void) duk_push_buffer(ctx, 0, 0);
@@ -219,9 +221,11 @@ static duk_ret_t test_func(duk_context *ctx) {
 	(void) duk_require_undefined(ctx, 0);
 	(void) duk_require_valid_index(ctx, 0);
 	(void) duk_resize_buffer(ctx, 0, 0);
+	(void) duk_resume(ctx, 0, 0);
 	(void) duk_safe_call(ctx, NULL, 0, 0);
 	(void) duk_safe_to_lstring(ctx, 0, NULL);
 	(void) duk_safe_to_string(ctx, 0);
+	(void) duk_serialize(ctx, 0);
 	(void) duk_set_finalizer(ctx, 0);
 	(void) duk_set_global_object(ctx);
 	(void) duk_set_magic(ctx, 0, 0);
@@ -253,6 +257,7 @@ static duk_ret_t test_func(duk_context *ctx) {
 	(void) duk_trim(ctx, 0);
 	(void) duk_xcopy_top(ctx, NULL, 0);
 	(void) duk_xmove_top(ctx, NULL, 0);
+	(void) duk_yield(ctx);
 
 	printf("never here\n"); fflush(stdout);
 	return 0;
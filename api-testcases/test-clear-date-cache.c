@@ -0,0 +1,62 @@
+/*
+ *  duk_clear_date_cache() makes a time zone change made by the application
+ *  visible to local time conversions.  POSIX TZ strings are used so that
+ *  no time zone database is needed.
+ */
+
+/*===
+*** test_tz_change (duk_safe_call)
+offset before: 0
+offset after clear: -180
+hours after clear: 3
+==> rc=0, result='undefined'
+*** test_repeat (duk_safe_call)
+offset: 0
+==> rc=0, result='undefined'
+===*/
+
+#include <time.h>
+
+static void set_tz(const char *tz) {
+	setenv("TZ", tz, 1);
+	tzset();
+}
+
+static duk_ret_t test_tz_change(duk_context *ctx) {
+	set_tz("AAA0");
+	duk_eval_string(ctx, "new Date(0).getTimezoneOffset()");
+	printf("offset before: %ld\n", (long) duk_get_int(ctx, -1));
+	duk_pop(ctx);
+
+	/* Without clearing the cache the old offset may still be used for
+	 * nearby time values, so it isn't checked here.
+	 */
+	set_tz("BBB-3");
+	duk_clear_date_cache(ctx);
+
+	duk_eval_string(ctx, "new Date(0).getTimezoneOffset()");
+	printf("offset after clear: %ld\n", (long) duk_get_int(ctx, -1));
+	duk_pop(ctx);
+	duk_eval_string(ctx, "new Date(0).getHours()");
+	printf("hours after clear: %ld\n", (long) duk_get_int(ctx, -1));
+	duk_pop(ctx);
+
+	return 0;
+}
+
+static duk_ret_t test_repeat(duk_context *ctx) {
+	/* Clearing an already empty cache is harmless. */
+	set_tz("AAA0");
+	duk_clear_date_cache(ctx);
+	duk_clear_date_cache(ctx);
+	duk_eval_string(ctx, "new Date(0).getTimezoneOffset()");
+	printf("offset: %ld\n", (long) duk_get_int(ctx, -1));
+	duk_pop(ctx);
+
+	return 0;
+}
+
+void test(duk_context *ctx) {
+	TEST_SAFE_CALL(test_tz_change);
+	TEST_SAFE_CALL(test_repeat);
+}
@@ -0,0 +1,94 @@
+/*
+ *  duk_process_pending(): the end result must be the same regardless of
+ *  whether refzero processing is budgeted (DUK_OPT_REFZERO_BUDGET) or not.
+ */
+
+/*===
+*** test_drop_graph (duk_safe_call)
+finalized after drop: ok
+pending after processing: 0
+finalized after processing: 1001
+==> rc=0, result='undefined'
+*** test_finalizer_calls (duk_safe_call)
+finalizer called
+pending after processing: 0
+==> rc=0, result='undefined'
+*** test_null_ctx (duk_safe_call)
+pending: 0
+==> rc=0, result='undefined'
+===*/
+
+static int finalize_count = 0;
+
+static duk_ret_t counting_finalizer(duk_context *ctx) {
+	finalize_count++;
+	return 0;
+}
+
+static duk_ret_t test_drop_graph(duk_context *ctx) {
+	duk_idx_t i;
+	int loops = 0;
+
+	finalize_count = 0;
+
+	/* Array of objects sharing a finalizer through their prototype.
+	 * The prototype itself gets finalized too, 1001 calls in total.
+	 */
+	duk_push_object(ctx);
+	duk_push_c_function(ctx, counting_finalizer, 1);
+	duk_set_finalizer(ctx, -2);
+	duk_push_array(ctx);
+	for (i = 0; i < 1000; i++) {
+		duk_push_object(ctx);
+		duk_dup(ctx, -3);
+		duk_set_prototype(ctx, -2);
+		duk_put_prop_index(ctx, -2, (duk_uarridx_t) i);
+	}
+
+	/* Dropping the array frees the elements, either all at once or
+	 * partially if a refzero budget is in effect.
+	 */
+	duk_set_top(ctx, 0);
+	printf("finalized after drop: %s\n",
+	       (finalize_count > 0 && finalize_count <= 1001) ? "ok" : "unexpected");
+
+	while (duk_process_pending(ctx, 10)) {
+		loops++;
+		if (loops > 1000) {
+			printf("too many loops\n");
+			break;
+		}
+	}
+	printf("pending after processing: %d\n", (int) duk_process_pending(ctx, 0));
+	printf("finalized after processing: %d\n", finalize_count);
+
+	return 0;
+}
+
+static duk_ret_t pending_finalizer(duk_context *ctx) {
+	/* Refzero processing is already running, so this is a no-op. */
+	(void) duk_process_pending(ctx, 0);
+	printf("finalizer called\n");
+	return 0;
+}
+
+static duk_ret_t test_finalizer_calls(duk_context *ctx) {
+	duk_push_object(ctx);
+	duk_push_c_function(ctx, pending_finalizer, 1);
+	duk_set_finalizer(ctx, -2);
+	duk_pop(ctx);
+
+	printf("pending after processing: %d\n", (int) duk_process_pending(ctx, -1));
+	return 0;
+}
+
+static duk_ret_t test_null_ctx(duk_context *ctx) {
+	printf("pending: %d\n", (int) duk_process_pending(NULL, 0));
+	return 0;
+}
+
+void test(duk_context *ctx) {
+	TEST_SAFE_CALL(test_drop_graph);
+	TEST_SAFE_CALL(test_finalizer_calls);
+	TEST_SAFE_CALL(test_null_ctx);
+}
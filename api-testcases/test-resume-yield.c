@@ -0,0 +1,212 @@
+/*
+ *  duk_resume() and duk_yield(): drive Ecmascript threads from C and
+ *  suspend them inside Duktape/C calls.
+ */
+
+/*===
+*** test_basic (duk_safe_call)
+request: read 1
+request: read 2
+request: read 3
+yielded: 0, result: sum 60
+final top: 1
+==> rc=0, result='undefined'
+*** test_interleaved (duk_safe_call)
+thread 0 waits
+thread 1 waits
+thread 2 waits
+thread 2 done: 2-200
+thread 1 done: 1-100
+thread 0 done: 0-0
+final top: 0
+==> rc=0, result='undefined'
+*** test_resume_error (duk_safe_call)
+request: fail
+yielded: 0, result: caught: Error: io failed
+final top: 1
+==> rc=0, result='undefined'
+*** test_uncaught (duk_safe_call)
+request: x
+==> rc=1, result='RangeError: aiee'
+*** test_thread_constructor (duk_safe_call)
+yielded: 1, result: 1
+yielded: 1, result: 2
+yielded: 0, result: 3
+==> rc=0, result='undefined'
+*** test_invalid_yield (duk_safe_call)
+==> rc=1, result='TypeError: invalid state for yield'
+*** test_invalid_resume (duk_safe_call)
+yielded: 0, result: 123
+==> rc=1, result='TypeError: invalid state for resume'
+===*/
+
+/* Native function which suspends the calling thread; the value given to
+ * duk_resume() becomes its return value.
+ */
+static duk_ret_t wait_io(duk_context *ctx) {
+	duk_yield(ctx);
+	return 0;  /* never here */
+}
+
+static void push_io_thread(duk_context *ctx, const char *src) {
+	duk_context *new_ctx;
+
+	(void) duk_push_thread(ctx);
+	new_ctx = duk_get_context(ctx, -1);
+	duk_push_c_function(new_ctx, wait_io, 1);
+	duk_put_global_string(new_ctx, "waitIo");
+	duk_eval_string(new_ctx, src);
+}
+
+static duk_ret_t test_basic(duk_context *ctx) {
+	duk_bool_t yielded;
+	int i;
+
+	push_io_thread(ctx, "(function (x) {\n"
+	                    "    var sum = 0;\n"
+	                    "    for (var i = 1; i <= 3; i++) {\n"
+	                    "        sum += waitIo('read ' + i);\n"
+	                    "    }\n"
+	                    "    return 'sum ' + sum;\n"
+	                    "})");
+
+	/* Initial resume, value is the thread function argument. */
+	duk_push_undefined(ctx);
+	yielded = duk_resume(ctx, 0, 0);
+	i = 0;
+	while (yielded) {
+		printf("request: %s\n", duk_get_string(ctx, -1));
+		duk_pop(ctx);
+		duk_push_int(ctx, ++i * 10);
+		yielded = duk_resume(ctx, 0, 0);
+	}
+	printf("yielded: %d, result: %s\n", (int) yielded, duk_get_string(ctx, -1));
+	duk_pop(ctx);
+
+	printf("final top: %ld\n", (long) duk_get_top(ctx));
+	return 0;
+}
+
+static duk_ret_t test_interleaved(duk_context *ctx) {
+	int i;
+
+	for (i = 0; i < 3; i++) {
+		push_io_thread(ctx, "(function (id) {\n"
+		                    "    print('thread ' + id + ' waits');\n"
+		                    "    return 'thread ' + id + ' done: ' + id + '-' + waitIo(id);\n"
+		                    "})");
+		duk_push_int(ctx, i);
+		(void) duk_resume(ctx, i, 0);
+		duk_pop(ctx);
+	}
+
+	/* Complete the pending requests in reverse order. */
+	for (i = 2; i >= 0; i--) {
+		duk_push_int(ctx, i * 100);
+		(void) duk_resume(ctx, i, 0);
+		printf("%s\n", duk_get_string(ctx, -1));
+		duk_pop(ctx);
+	}
+	duk_pop_3(ctx);
+
+	printf("final top: %ld\n", (long) duk_get_top(ctx));
+	return 0;
+}
+
+static duk_ret_t test_resume_error(duk_context *ctx) {
+	duk_bool_t yielded;
+
+	push_io_thread(ctx, "(function () {\n"
+	                    "    try {\n"
+	                    "        return waitIo('fail');\n"
+	                    "    } catch (e) {\n"
+	                    "        return 'caught: ' + e;\n"
+	                    "    }\n"
+	                    "})");
+
+	duk_push_undefined(ctx);
+	(void) duk_resume(ctx, 0, 0);
+	printf("request: %s\n", duk_get_string(ctx, -1));
+	duk_pop(ctx);
+
+	duk_push_error_object(ctx, DUK_ERR_ERROR, "io failed");
+	yielded = duk_resume(ctx, 0, 1 /*is_error*/);
+	printf("yielded: %d, result: %s\n", (int) yielded, duk_get_string(ctx, -1));
+	duk_pop(ctx);
+
+	printf("final top: %ld\n", (long) duk_get_top(ctx));
+	return 0;
+}
+
+static duk_ret_t test_uncaught(duk_context *ctx) {
+	push_io_thread(ctx, "(function () {\n"
+	                    "    waitIo('x');\n"
+	                    "    throw new RangeError('aiee');\n"
+	                    "})");
+
+	duk_push_undefined(ctx);
+	(void) duk_resume(ctx, 0, 0);
+	printf("request: %s\n", duk_get_string(ctx, -1));
+	duk_pop(ctx);
+
+	duk_push_undefined(ctx);
+	(void) duk_resume(ctx, 0, 0);  /* throws */
+	printf("never here\n");
+	return 0;
+}
+
+static duk_ret_t test_thread_constructor(duk_context *ctx) {
+	duk_bool_t yielded;
+
+	/* Ecmascript side yields work the same way. */
+	duk_eval_string(ctx, "new Duktape.Thread(function (x) {\n"
+	                     "    x = Duktape.Thread.yield(x);\n"
+	                     "    x = Duktape.Thread.yield(x + 1);\n"
+	                     "    return x + 1;\n"
+	                     "})");
+
+	duk_push_int(ctx, 1);
+	do {
+		yielded = duk_resume(ctx, 0, 0);
+		printf("yielded: %d, result: %s\n", (int) yielded, duk_to_string(ctx, -1));
+		duk_to_int(ctx, -1);
+	} while (yielded);
+	duk_pop_2(ctx);
+	return 0;
+}
+
+static duk_ret_t test_invalid_yield(duk_context *ctx) {
+	/* Not running in a resumed thread. */
+	duk_push_c_function(ctx, wait_io, 1);
+	duk_push_int(ctx, 123);
+	duk_call(ctx, 1);
+	printf("never here\n");
+	return 0;
+}
+
+static duk_ret_t test_invalid_resume(duk_context *ctx) {
+	duk_bool_t yielded;
+
+	push_io_thread(ctx, "(function (x) { return x; })");
+
+	duk_push_int(ctx, 123);
+	yielded = duk_resume(ctx, 0, 0);
+	printf("yielded: %d, result: %s\n", (int) yielded, duk_to_string(ctx, -1));
+	duk_pop(ctx);
+
+	/* Thread has finished. */
+	duk_push_int(ctx, 234);
+	(void) duk_resume(ctx, 0, 0);
+	printf("never here\n");
+	return 0;
+}
+
+void test(duk_context *ctx) {
+	TEST_SAFE_CALL(test_basic);
+	TEST_SAFE_CALL(test_interleaved);
+	TEST_SAFE_CALL(test_resume_error);
+	TEST_SAFE_CALL(test_uncaught);
+	TEST_SAFE_CALL(test_thread_constructor);
+	TEST_SAFE_CALL(test_invalid_yield);
+	TEST_SAFE_CALL(test_invalid_resume);
+}
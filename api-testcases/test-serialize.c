@@ -0,0 +1,330 @@
+/*
+ *  duk_serialize() and duk_deserialize(): copy values between heaps.
+ */
+
+/*===
+*** test_roundtrip (duk_safe_call)
+{"undef":"undefined","nul":null,"t":true,"f":false,"i":123,"neg":-2147483648,"big":4294967296,"frac":0.5,"nz":"-0","nan":"NaN","inf":"Infinity","str":"fooሴbar","arr":[1,"undefined",3],"nested":{"a":{"b":{"c":"deep"}}}}
+arr length: 5, 1 in arr: false
+buf: fixed 3 010203, dynbuf: dynamic 2 0405
+date: 2015-02-03T04:05:06.789Z
+re: /fo+\/bar/gi true true false
+wrappers: object true object 123 object foo
+typed: Uint16Array 3 1,2,65535 6 ArrayBuffer
+dataview: 4 513
+arraybuffer: 2 [object ArrayBuffer]
+duktape buffer: object 3 true
+nodejs buffer: 3 abc true
+final top: 0
+==> rc=0, result='undefined'
+*** test_refs (duk_safe_call)
+shared: true
+cycle: true true
+array cycle: true
+final top: 0
+==> rc=0, result='undefined'
+*** test_cross_heap (duk_safe_call)
+size: 87
+other heap: {"msg":"hello","data":[1,2,3],"self":true}
+final top: 0
+==> rc=0, result='undefined'
+*** test_no_side_effects (duk_safe_call)
+getter called
+setters triggered: 0
+proto: true true
+keys: a,1
+==> rc=0, result='undefined'
+*** test_unsupported (duk_safe_call)
+function: TypeError: serialize failed
+error: TypeError: serialize failed
+proxy: TypeError: serialize failed
+pointer: TypeError: serialize failed
+thread: TypeError: serialize failed
+nested: TypeError: serialize failed
+recursion: RangeError: serialize recursion limit
+==> rc=0, result='undefined'
+*** test_corrupt (duk_safe_call)
+empty: TypeError: deserialize failed
+bad marker: TypeError: deserialize failed
+bad version: TypeError: deserialize failed
+truncated: TypeError: deserialize failed
+trailing: TypeError: deserialize failed
+bad tag: TypeError: deserialize failed
+bad ref: TypeError: deserialize failed
+bad length: TypeError: deserialize failed
+internal key: TypeError: deserialize failed
+internal string: TypeError: deserialize failed
+regexp: success
+bad regexp: TypeError: deserialize failed
+bad bufferobject: TypeError: deserialize failed
+not a buffer: TypeError: not buffer
+prefixes rejected: 85/85
+==> rc=0, result='undefined'
+===*/
+
+static void roundtrip(duk_context *ctx) {
+	duk_serialize(ctx, -1);
+	duk_deserialize(ctx, -1);
+}
+
+static duk_ret_t test_roundtrip(duk_context *ctx) {
+	unsigned char *p;
+
+	duk_eval_string(ctx,
+		"({ undef: undefined, nul: null, t: true, f: false, i: 123, neg: -2147483648,\n"
+		"   big: 4294967296, frac: 0.5, nz: -0, nan: NaN, inf: 1/0,\n"
+		"   str: 'foo\\u1234bar', arr: [ 1, undefined, 3 ],\n"
+		"   nested: { a: { b: { c: 'deep' } } } })");
+	roundtrip(ctx);
+	duk_eval_string(ctx,
+		"(function (v) {\n"
+		"    return JSON.stringify(v, function (k, x) {\n"
+		"        if (x === undefined) { return 'undefined'; }\n"
+		"        if (typeof x === 'number' && (x !== x || !isFinite(x))) { return String(x); }\n"
+		"        if (x === 0 && 1 / x < 0) { return '-0'; }\n"
+		"        return x;\n"
+		"    });\n"
+		"})");
+	duk_dup(ctx, -2);
+	duk_call(ctx, 1);
+	printf("%s\n", duk_get_string(ctx, -1));
+	duk_pop_2(ctx);
+
+	/* Trailing holes are kept in 'length'. */
+	duk_eval_string(ctx, "var a = [ 'x' ]; a[2] = 'y'; a.length = 5; a");
+	roundtrip(ctx);
+	duk_put_global_string(ctx, "arr");
+	duk_eval_string_noresult(ctx, "print('arr length: ' + arr.length + ', 1 in arr: ' + (1 in arr));");
+
+	p = (unsigned char *) duk_push_fixed_buffer(ctx, 3);
+	p[0] = 1; p[1] = 2; p[2] = 3;
+	roundtrip(ctx);
+	p = (unsigned char *) duk_push_dynamic_buffer(ctx, 2);
+	p[0] = 4; p[1] = 5;
+	roundtrip(ctx);
+	printf("buf: %s %ld ", duk_is_dynamic_buffer(ctx, -2) ? "dynamic" : "fixed", (long) duk_get_length(ctx, -2));
+	printf("%s, ", duk_hex_encode(ctx, -2));
+	printf("dynbuf: %s %ld ", duk_is_dynamic_buffer(ctx, -1) ? "dynamic" : "fixed", (long) duk_get_length(ctx, -1));
+	printf("%s\n", duk_hex_encode(ctx, -1));
+	duk_pop_2(ctx);
+
+	duk_eval_string(ctx, "new Date('2015-02-03T04:05:06.789Z')");
+	roundtrip(ctx);
+	duk_put_global_string(ctx, "val");
+	duk_eval_string_noresult(ctx, "print('date: ' + val.toISOString());");
+
+	duk_eval_string(ctx, "/fo+\\/bar/gi");
+	roundtrip(ctx);
+	duk_put_global_string(ctx, "val");
+	duk_eval_string_noresult(ctx, "print('re: ' + val + ' ' + val.test('xFOO/BAR') + ' ' + "
+	                              "(val instanceof RegExp) + ' ' + val.multiline);");
+
+	duk_eval_string(ctx, "[ new Boolean(true), new Number(123), new String('foo') ]");
+	roundtrip(ctx);
+	duk_put_global_string(ctx, "val");
+	duk_eval_string_noresult(ctx, "print('wrappers: ' + val.map(function (v) { return typeof v + ' ' + v.valueOf(); }).join(' '));");
+
+	duk_eval_string(ctx, "new Uint16Array([ 0, 1, 2, 65535, 4 ]).subarray(1, 4)");
+	roundtrip(ctx);
+	duk_put_global_string(ctx, "val");
+	duk_eval_string_noresult(ctx, "print('typed: ' + Object.prototype.toString.call(val).slice(8, -1) + ' ' + "
+	                              "val.length + ' ' + Array.prototype.join.call(val) + ' ' + val.buffer.byteLength + ' ' + "
+	                              "Object.prototype.toString.call(val.buffer).slice(8, -1));");
+
+	duk_eval_string(ctx, "new DataView(new Uint8Array([ 9, 9, 1, 2, 3, 4 ]).buffer, 2)");
+	roundtrip(ctx);
+	duk_put_global_string(ctx, "val");
+	duk_eval_string_noresult(ctx, "print('dataview: ' + val.byteLength + ' ' + val.getUint16(0, true));");
+
+	duk_eval_string(ctx, "new ArrayBuffer(2)");
+	roundtrip(ctx);
+	duk_put_global_string(ctx, "val");
+	duk_eval_string_noresult(ctx, "print('arraybuffer: ' + val.byteLength + ' ' + Object.prototype.toString.call(val));");
+
+	duk_eval_string(ctx, "new Duktape.Buffer('abc')");
+	roundtrip(ctx);
+	duk_put_global_string(ctx, "val");
+	duk_eval_string_noresult(ctx, "print('duktape buffer: ' + typeof val + ' ' + val.length + ' ' + "
+	                              "(Object.getPrototypeOf(val) === Duktape.Buffer.prototype));");
+
+	duk_eval_string(ctx, "new Buffer('abc')");
+	roundtrip(ctx);
+	duk_put_global_string(ctx, "val");
+	duk_eval_string_noresult(ctx, "print('nodejs buffer: ' + val.length + ' ' + val.toString() + ' ' + "
+	                              "(Object.getPrototypeOf(val) === Buffer.prototype));");
+
+	printf("final top: %ld\n", (long) duk_get_top(ctx));
+	return 0;
+}
+
+static duk_ret_t test_refs(duk_context *ctx) {
+	duk_eval_string(ctx,
+		"var shared = { x: 1 };\n"
+		"var o = { a: shared, b: shared };\n"
+		"o.self = o;\n"
+		"o.list = [ o, shared ];\n"
+		"o.list.push(o.list);\n"
+		"o");
+	roundtrip(ctx);
+	duk_put_global_string(ctx, "val");
+	duk_eval_string_noresult(ctx,
+		"print('shared: ' + (val.a === val.b && val.a !== shared));\n"
+		"print('cycle: ' + (val.self === val) + ' ' + (val.list[0] === val && val.list[1] === val.a));\n"
+		"print('array cycle: ' + (val.list[2] === val.list));");
+
+	printf("final top: %ld\n", (long) duk_get_top(ctx));
+	return 0;
+}
+
+static duk_ret_t test_cross_heap(duk_context *ctx) {
+	duk_context *ctx2;
+	void *buf;
+	void *copy;
+	duk_size_t len;
+
+	duk_eval_string(ctx, "var m = { msg: 'hello', data: [ 1, 2, 3 ] }; m.self = m; m");
+	duk_serialize(ctx, -1);
+	buf = duk_get_buffer(ctx, -1, &len);
+	printf("size: %ld\n", (long) len);
+
+	/* The serialized form is self contained: the host may copy it
+	 * anywhere, e.g. into a queue read by another native thread.
+	 */
+	ctx2 = duk_create_heap_default();
+	if (!ctx2) {
+		printf("failed to create heap\n");
+		return 0;
+	}
+	copy = duk_push_fixed_buffer(ctx2, len);
+	memcpy(copy, buf, len);
+	duk_pop(ctx);
+
+	duk_deserialize(ctx2, -1);
+	duk_put_global_string(ctx2, "m");
+	duk_eval_string_noresult(ctx2,
+		"print('other heap: ' + JSON.stringify({ msg: m.msg, data: m.data, self: m.self === m }));");
+	duk_destroy_heap(ctx2);
+
+	printf("final top: %ld\n", (long) duk_get_top(ctx));
+	return 0;
+}
+
+static duk_ret_t test_no_side_effects(duk_context *ctx) {
+	/* Getters are invoked when serializing (like JSON.stringify()), but
+	 * deserializing defines properties directly so that setters in the
+	 * receiving heap are never triggered.
+	 */
+	duk_eval_string(ctx,
+		"var src = { get a() { print('getter called'); return 1; }, 1: 2 };\n"
+		"var count = 0;\n"
+		"Object.defineProperty(Object.prototype, 'a', { set: function () { count++; }, configurable: true });\n"
+		"Object.defineProperty(Object.prototype, '1', { set: function () { count++; }, configurable: true });\n"
+		"src");
+	roundtrip(ctx);
+	duk_put_global_string(ctx, "val");
+	duk_eval_string_noresult(ctx,
+		"delete Object.prototype.a; delete Object.prototype[1];\n"
+		"print('setters triggered: ' + count);\n"
+		"print('proto: ' + (Object.getPrototypeOf(val) === Object.prototype) + ' ' + Object.isExtensible(val));\n"
+		"print('keys: ' + Object.keys(val).sort().reverse());");
+	return 0;
+}
+
+static duk_ret_t unsupported_helper(duk_context *ctx) {
+	duk_serialize(ctx, -1);
+	return 0;
+}
+
+static void try_serialize(duk_context *ctx, const char *name) {
+	duk_int_t rc;
+
+	rc = duk_safe_call(ctx, unsupported_helper, 1, 1);
+	printf("%s: %s\n", name, rc == DUK_EXEC_SUCCESS ? "success" : duk_safe_to_string(ctx, -1));
+	duk_pop(ctx);
+}
+
+static duk_ret_t test_unsupported(duk_context *ctx) {
+	duk_eval_string(ctx, "(function () {})");
+	try_serialize(ctx, "function");
+	duk_eval_string(ctx, "new Error('aiee')");
+	try_serialize(ctx, "error");
+	duk_eval_string(ctx, "new Proxy({}, {})");
+	try_serialize(ctx, "proxy");
+	duk_push_pointer(ctx, (void *) 0x1234);
+	try_serialize(ctx, "pointer");
+	duk_push_thread(ctx);
+	try_serialize(ctx, "thread");
+	duk_eval_string(ctx, "({ a: [ 1, 2, { f: Math.sin } ] })");
+	try_serialize(ctx, "nested");
+	duk_eval_string(ctx, "var o = {}; for (var i = 0; i < 10000; i++) { o = { next: o }; }; o");
+	try_serialize(ctx, "recursion");
+	return 0;
+}
+
+static duk_ret_t deserialize_helper(duk_context *ctx) {
+	duk_deserialize(ctx, -1);
+	return 0;
+}
+
+static void try_deserialize(duk_context *ctx, const char *name, const char *hex) {
+	duk_int_t rc;
+
+	duk_push_string(ctx, hex);
+	duk_hex_decode(ctx, -1);
+	rc = duk_safe_call(ctx, deserialize_helper, 1, 1);
+	printf("%s: %s\n", name, rc == DUK_EXEC_SUCCESS ? "success" : duk_safe_to_string(ctx, -1));
+	duk_pop(ctx);
+}
+
+static duk_ret_t test_corrupt(duk_context *ctx) {
+	void *buf;
+	void *copy;
+	duk_size_t len;
+	duk_size_t i;
+	duk_size_t rejected;
+
+	try_deserialize(ctx, "empty", "");
+	try_deserialize(ctx, "bad marker", "be0100");
+	try_deserialize(ctx, "bad version", "bf0200");
+	try_deserialize(ctx, "truncated", "bf010600000005666f6f");
+	try_deserialize(ctx, "trailing", "bf010000");
+	try_deserialize(ctx, "bad tag", "bf01ff");
+	try_deserialize(ctx, "bad ref", "bf010a000000010100000001610900000001");
+	try_deserialize(ctx, "bad length", "bf010a000000010100001000610000");
+	try_deserialize(ctx, "internal key", "bf010a000000010100000002ff4100");
+	try_deserialize(ctx, "internal string", "bf010600000002ff41");
+	try_deserialize(ctx, "regexp", "bf010d0000000361626301");
+	try_deserialize(ctx, "bad regexp", "bf010d000000012800");
+	try_deserialize(ctx, "bad bufferobject", "bf010f180000000003010203");
+
+	duk_push_int(ctx, 123);
+	(void) duk_safe_call(ctx, deserialize_helper, 1, 1);
+	printf("not a buffer: %s\n", duk_safe_to_string(ctx, -1));
+	duk_pop(ctx);
+
+	/* Every proper prefix of a valid serialization must be rejected. */
+	duk_eval_string(ctx, "var o = { a: [ 1, 'two', 3.5 ], d: new Date(0) }; o.o = o; o");
+	duk_serialize(ctx, -1);
+	buf = duk_get_buffer(ctx, -1, &len);
+	rejected = 0;
+	for (i = 0; i < len; i++) {
+		copy = duk_push_fixed_buffer(ctx, i);
+		memcpy(copy, buf, i);
+		if (duk_safe_call(ctx, deserialize_helper, 1, 1) != DUK_EXEC_SUCCESS) {
+			rejected++;
+		}
+		duk_pop(ctx);
+	}
+	printf("prefixes rejected: %ld/%ld\n", (long) rejected, (long) len);
+	duk_pop(ctx);
+	return 0;
+}
+
+void test(duk_context *ctx) {
+	TEST_SAFE_CALL(test_roundtrip);
+	TEST_SAFE_CALL(test_refs);
+	TEST_SAFE_CALL(test_cross_heap);
+	TEST_SAFE_CALL(test_no_side_effects);
+	TEST_SAFE_CALL(test_unsupported);
+	TEST_SAFE_CALL(test_corrupt);
+}
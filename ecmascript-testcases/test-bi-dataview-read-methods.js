@@ -454,7 +454,7 @@ read TypedArray test, arrayLength 16
 6 0 3 8721 4386 13090 8755
 6 0 4 1144201745 287454020 1430532898 573785173
 6 0 5 1144201745 287454020 1430532898 573785173
-6 0 6 716.5322875976563 1.2795344104949228e-28 13482743300096 2.4295198285501637e-18
+6 0 6 716.5322875976562 1.2795344104949228e-28 13482743300096 2.4295198285501637e-18
 6 0 7 -7.086876636573014e-268 3.841412024471731e-226 RangeError
 6 1 0  RangeError
 6 1 1  RangeError
@@ -494,7 +494,7 @@ read TypedArray test, arrayLength 16
 6 5 3 8721 4386 13090 8755
 6 5 4 1144201745 287454020 RangeError
 6 5 5 1144201745 287454020 RangeError
-6 5 6 716.5322875976563 1.2795344104949228e-28 RangeError
+6 5 6 716.5322875976562 1.2795344104949228e-28 RangeError
 6 5 7  RangeError
 6 6 0 17 17 34 34
 6 6 1 17 17 34 34
@@ -502,7 +502,7 @@ read TypedArray test, arrayLength 16
 6 6 3 8721 4386 13090 8755
 6 6 4 1144201745 287454020 1430532898 573785173
 6 6 5 1144201745 287454020 1430532898 573785173
-6 6 6 716.5322875976563 1.2795344104949228e-28 13482743300096 2.4295198285501637e-18
+6 6 6 716.5322875976562 1.2795344104949228e-28 13482743300096 2.4295198285501637e-18
 6 6 7  RangeError
 6 7 0 17 17 34 34
 6 7 1 17 17 34 34
@@ -510,7 +510,7 @@ read TypedArray test, arrayLength 16
 6 7 3 8721 4386 13090 8755
 6 7 4 1144201745 287454020 1430532898 573785173
 6 7 5 1144201745 287454020 1430532898 573785173
-6 7 6 716.5322875976563 1.2795344104949228e-28 13482743300096 2.4295198285501637e-18
+6 7 6 716.5322875976562 1.2795344104949228e-28 13482743300096 2.4295198285501637e-18
 6 7 7 -7.086876636573014e-268 3.841412024471731e-226 RangeError
 6 8 0  RangeError
 6 8 1  RangeError
@@ -1320,7 +1320,7 @@ read TypedArray test, arrayLength 17
 6 0 3 8721 4386 13090 8755
 6 0 4 1144201745 287454020 1430532898 573785173
 6 0 5 1144201745 287454020 1430532898 573785173
-6 0 6 716.5322875976563 1.2795344104949228e-28 13482743300096 2.4295198285501637e-18
+6 0 6 716.5322875976562 1.2795344104949228e-28 13482743300096 2.4295198285501637e-18
 6 0 7 -7.086876636573014e-268 3.841412024471731e-226 -1.1246123502434041e-185 6.171838568684498e-144
 6 1 0  RangeError
 6 1 1  RangeError
@@ -1360,7 +1360,7 @@ read TypedArray test, arrayLength 17
 6 5 3 8721 4386 13090 8755
 6 5 4 1144201745 287454020 RangeError
 6 5 5 1144201745 287454020 RangeError
-6 5 6 716.5322875976563 1.2795344104949228e-28 RangeError
+6 5 6 716.5322875976562 1.2795344104949228e-28 RangeError
 6 5 7  RangeError
 6 6 0 17 17 34 34
 6 6 1 17 17 34 34
@@ -1368,7 +1368,7 @@ read TypedArray test, arrayLength 17
 6 6 3 8721 4386 13090 8755
 6 6 4 1144201745 287454020 1430532898 573785173
 6 6 5 1144201745 287454020 1430532898 573785173
-6 6 6 716.5322875976563 1.2795344104949228e-28 13482743300096 2.4295198285501637e-18
+6 6 6 716.5322875976562 1.2795344104949228e-28 13482743300096 2.4295198285501637e-18
 6 6 7  RangeError
 6 7 0 17 17 34 34
 6 7 1 17 17 34 34
@@ -1376,7 +1376,7 @@ read TypedArray test, arrayLength 17
 6 7 3 8721 4386 13090 8755
 6 7 4 1144201745 287454020 1430532898 573785173
 6 7 5 1144201745 287454020 1430532898 573785173
-6 7 6 716.5322875976563 1.2795344104949228e-28 13482743300096 2.4295198285501637e-18
+6 7 6 716.5322875976562 1.2795344104949228e-28 13482743300096 2.4295198285501637e-18
 6 7 7 -7.086876636573014e-268 3.841412024471731e-226 RangeError
 6 8 0  RangeError
 6 8 1  RangeError
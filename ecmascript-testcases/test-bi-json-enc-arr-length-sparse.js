@@ -7,8 +7,8 @@
 /*===
 0
 1
-100
 3
+100
 [1,2,null,4,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,null,"foo"]
 ===*/
 
@@ -17,8 +17,8 @@ function sparseArrayLengthTest() {
 
     // sparse array test
     arr = [1, 2];
-    arr[100] = 'foo';  // becomes sparse
-    arr[3] = 4;        // will enumerate "incorrectly"
+    arr[100] = 'foo';  // stored outside the array part
+    arr[3] = 4;        // enumerates before '100' because it is in the array part
 
     // custom behavior here
     for (k in arr) {
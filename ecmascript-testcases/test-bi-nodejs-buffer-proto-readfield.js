@@ -236,7 +236,7 @@ false 8 readInt16LE 8721
 false 8 readInt16BE 4386
 false 8 readInt32LE 1144201745
 false 8 readInt32BE 287454020
-false 8 readFloatLE 716.5322875976563
+false 8 readFloatLE 716.5322875976562
 false 8 readFloatBE 1.2795344104949228e-28
 false 8 readDoubleLE -7.086876636573014e-268
 false 8 readDoubleBE 3.841412024471731e-226
@@ -586,7 +586,7 @@ true 8 readInt16LE 8721
 true 8 readInt16BE 4386
 true 8 readInt32LE 1144201745
 true 8 readInt32BE 287454020
-true 8 readFloatLE 716.5322875976563
+true 8 readFloatLE 716.5322875976562
 true 8 readFloatBE 1.2795344104949228e-28
 true 8 readDoubleLE -7.086876636573014e-268
 true 8 readDoubleBE 3.841412024471731e-226
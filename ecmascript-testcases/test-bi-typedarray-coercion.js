@@ -1963,19 +1963,19 @@ coercion test
 70 -256 -> -256
 71 -255.9 -> -255.89999389648438
 72 -255.5 -> -255.5
-73 -255.1 -> -255.10000610351563
+73 -255.1 -> -255.10000610351562
 74 -255 -> -255
 75 -254.9 -> -254.89999389648438
 76 -254.5 -> -254.5
-77 -254.1 -> -254.10000610351563
+77 -254.1 -> -254.10000610351562
 78 -254 -> -254
 79 -129.9 -> -129.89999389648438
 80 -129.5 -> -129.5
-81 -129.1 -> -129.10000610351563
+81 -129.1 -> -129.10000610351562
 82 -129 -> -129
 83 -128.9 -> -128.89999389648438
 84 -128.5 -> -128.5
-85 -128.1 -> -128.10000610351563
+85 -128.1 -> -128.10000610351562
 86 -128 -> -128
 87 -127.9 -> -127.9000015258789
 88 -127.5 -> -127.5
@@ -2010,19 +2010,19 @@ coercion test
 117 127.5 -> 127.5
 118 127.9 -> 127.9000015258789
 119 128 -> 128
-120 128.1 -> 128.10000610351563
+120 128.1 -> 128.10000610351562
 121 128.5 -> 128.5
 122 128.9 -> 128.89999389648438
 123 129 -> 129
-124 129.1 -> 129.10000610351563
+124 129.1 -> 129.10000610351562
 125 129.5 -> 129.5
 126 129.9 -> 129.89999389648438
 127 254 -> 254
-128 254.1 -> 254.10000610351563
+128 254.1 -> 254.10000610351562
 129 254.5 -> 254.5
 130 254.9 -> 254.89999389648438
 131 255 -> 255
-132 255.1 -> 255.10000610351563
+132 255.1 -> 255.10000610351562
 133 255.5 -> 255.5
 134 255.9 -> 255.89999389648438
 135 256 -> 256
@@ -717,7 +717,7 @@ read TypedArray test, arrayLength 16
 7 0 4 8721 17459
 7 0 5 1144201745 -2005440939
 7 0 6 1144201745 2289526357
-7 0 7 716.5322875976563 -7.444914951583743e-34
+7 0 7 716.5322875976562 -7.444914951583743e-34
 7 0 8 -7.086876636573014e-268 undefined
 7 1 0 undefined undefined
 7 1 1 undefined undefined
@@ -735,7 +735,7 @@ read TypedArray test, arrayLength 16
 7 2 4 8721 undefined
 7 2 5 1144201745 undefined
 7 2 6 1144201745 undefined
-7 2 7 716.5322875976563 undefined
+7 2 7 716.5322875976562 undefined
 7 2 8 -7.086876636573014e-268 undefined
 7 3 0 17 34
 7 3 1 17 34
@@ -744,7 +744,7 @@ read TypedArray test, arrayLength 16
 7 3 4 8721 17459
 7 3 5 1144201745 -2005440939
 7 3 6 1144201745 2289526357
-7 3 7 716.5322875976563 -7.444914951583743e-34
+7 3 7 716.5322875976562 -7.444914951583743e-34
 7 3 8 RangeError
 7 4 0 17 34
 7 4 1 17 34
@@ -2420,7 +2420,7 @@ read TypedArray test, arrayLength 17
 7 2 4 8721 undefined
 7 2 5 1144201745 undefined
 7 2 6 1144201745 undefined
-7 2 7 716.5322875976563 undefined
+7 2 7 716.5322875976562 undefined
 7 2 8 -7.086876636573014e-268 undefined
 7 3 0 17 34
 7 3 1 17 34
@@ -2429,7 +2429,7 @@ read TypedArray test, arrayLength 17
 7 3 4 8721 17459
 7 3 5 1144201745 -2005440939
 7 3 6 1144201745 2289526357
-7 3 7 716.5322875976563 -7.444914951583743e-34
+7 3 7 716.5322875976562 -7.444914951583743e-34
 7 3 8 RangeError
 7 4 0 17 34
 7 4 1 17 34
@@ -0,0 +1,207 @@
+/*
+ *  Arrays with a dense array part and a few high indices keep the array
+ *  part; the high indices are stored as ordinary properties until the
+ *  array part grows to cover them.  The internal representation must not
+ *  be visible to user code.
+ */
+
+/*===
+basic
+3 1000001
+1 2 3 undefined foo
+true false true
+0,1,2,1000000
+0,1,2,1000000
+[1,2,3]
+0 1 2 1000000
+delete
+true false 1000001
+0,1,2
+shrink
+1001 x undefined false
+5 5 0,1,2,3,4
+grow
+0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25 26 27 28 29
+30 0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17,18,19,20,21,22,23,24,25,26,27,28,29
+push/pop
+1000002 last
+1000001
+foo undefined false
+attributes
+getter
+1000001 true
+101 false getter
+write 101 prevented false
+101 true nc
+TypeError 101 true
+freeze
+true true 1000001 1
+===*/
+
+function basicTest() {
+    var a = [ 1, 2, 3 ];
+    var k;
+    var res;
+
+    a[1000000] = 'foo';
+    print(a.length - 1000000 + 2, a.length);
+    print(a[0], a[1], a[2], a[3], a[1000000]);
+    print(1000000 in a, 999999 in a, a.hasOwnProperty('1000000'));
+    print(Object.keys(a).join(','));
+
+    res = [];
+    for (k in a) {
+        res.push(k);
+    }
+    print(res.join(','));
+
+    print(JSON.stringify(a.slice(0, 3)));
+
+    res = [];
+    a.forEach(function (v, i) {
+        res.push(i);
+    });
+    print(res.join(' '));
+}
+
+function deleteTest() {
+    var a = [ 1, 2, 3 ];
+    a[1000000] = 'foo';
+    print(delete a[1000000], 1000000 in a, a.length);
+    print(Object.keys(a).join(','));
+}
+
+function shrinkTest() {
+    var a = [ 1, 2, 3 ];
+    var i;
+
+    a[1000] = 'x';
+    a[1000000] = 'y';
+    a.length = 1001;
+    print(a.length, a[1000], a[1000000], 1000000 in a);
+
+    a = [];
+    for (i = 0; i < 10; i++) {
+        a[i] = i;
+    }
+    a[500000] = 'z';
+    a.length = 5;
+    print(a.length, Object.keys(a).length, Object.keys(a).join(','));
+}
+
+function growTest() {
+    var a = [];
+    var i;
+    var res = [];
+
+    // Sparse entries are written first and are migrated into the array
+    // part when the dense prefix grows over them.
+    for (i = 29; i >= 20; i--) {
+        a[i] = i;
+    }
+    for (i = 0; i < 20; i++) {
+        a[i] = i;
+    }
+    for (i = 0; i < a.length; i++) {
+        res.push(a[i]);
+    }
+    print(res.join(' '));
+    // Key order of non-dense arrays is implementation specific.
+    print(a.length, Object.keys(a).sort(function (x, y) { return x - y; }).join(','));
+}
+
+function pushPopTest() {
+    var a = [ 1, 2, 3 ];
+    a[1000000] = 'foo';
+    a.push('last');
+    print(a.length, a[1000001]);
+    a.pop();
+    print(a.length);
+    print(a.pop(), a[1000000], 1000000 in a);
+}
+
+function attributesTest() {
+    var a;
+    var i;
+
+    // Accessor above the array part.
+    a = [ 1, 2, 3 ];
+    Object.defineProperty(a, '1000000', {
+        get: function () { return 'getter'; },
+        configurable: true
+    });
+    print(a[1000000]);
+    print(a.length, 1000000 in a);
+
+    // Growing the dense part over a non-default property must keep the
+    // property attributes intact.
+    a = [];
+    for (i = 0; i < 10; i++) {
+        a[i] = i;
+    }
+    Object.defineProperty(a, '100', {
+        get: function () { return 'getter'; },
+        configurable: false
+    });
+    for (i = 10; i < 100; i++) {
+        a[i] = i;
+    }
+    print(a.length, Object.getOwnPropertyDescriptor(a, '100').configurable, a[100]);
+
+    a = [ 1, 2, 3 ];
+    Object.defineProperty(a, '100', {
+        value: 'ro',
+        writable: false,
+        configurable: true
+    });
+    a[100] = 'changed';
+    print('write', a.length, 'prevented', a[100] === 'changed');
+
+    // Non-configurable sparse entry blocks length shrink.
+    a = [];
+    for (i = 0; i < 10; i++) {
+        a[i] = i;
+    }
+    Object.defineProperty(a, '100', {
+        value: 'nc',
+        writable: true,
+        configurable: false
+    });
+    a.length = 5;  // non-strict: silent failure
+    print(a.length, 5 in a, a[100]);
+    try {
+        (function () {
+            'use strict';
+            a.length = 0;
+        })();
+    } catch (e) {
+        print(e.name, a.length, 0 in a);
+    }
+}
+
+function freezeTest() {
+    var a = [ 1, 2, 3 ];
+    a[1000000] = 1;
+    Object.freeze(a);
+    a[1000000] = 2;
+    print(Object.isFrozen(a), Object.isSealed(a), a.length, a[1000000]);
+}
+
+try {
+    print('basic');
+    basicTest();
+    print('delete');
+    deleteTest();
+    print('shrink');
+    shrinkTest();
+    print('grow');
+    growTest();
+    print('push/pop');
+    pushPopTest();
+    print('attributes');
+    attributesTest();
+    print('freeze');
+    freezeTest();
+} catch (e) {
+    print(e);
+}
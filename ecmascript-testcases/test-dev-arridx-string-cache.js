@@ -0,0 +1,64 @@
+/*
+ *  Number-to-string coercions of array index values are served from a
+ *  small heap level cache of interned strings.  The cache holds weak
+ *  references so the strings must still be garbage collected correctly.
+ */
+
+/*===
+0 63 64 4294967294 4294967295
+string 0 0
+sparse 10000 10001
+gc 10000 1000
+map 123 456 undefined
+===*/
+
+function arridxStringCacheTest() {
+    var o, a, i, k, cnt;
+
+    // Boundary values: 0xffffffff is not an array index.
+    print(String(0), String(63), String(64), String(4294967294), String(4294967295));
+    print(typeof String(7), String(-0), (-0).toString());
+
+    // Sparse array, keys live in the entry part.
+    a = [];
+    a[1e6] = 1;
+    for (i = 0; i < 10000; i++) {
+        a[i * 3] = i;
+    }
+    cnt = 0;
+    for (i = 0; i < 10000; i++) {
+        if (a[i * 3] === i && a[String(i * 3)] === i) { cnt++; }
+    }
+    print('sparse', cnt, Object.keys(a).length);
+
+    // Let cached key strings become garbage and then recreate them.
+    a = null;
+    Duktape.gc();
+    o = {};
+    for (i = 0; i < 10000; i++) {
+        o[i] = i;
+    }
+    cnt = 0;
+    for (k in o) {
+        if (o[k] === +k) { cnt++; }
+    }
+    o = null;
+    Duktape.gc();
+    o = {};
+    for (i = 0; i < 1000; i++) {
+        o[String(i * 64)] = i;
+    }
+    print('gc', cnt, Object.keys(o).length);
+
+    // Integer keyed map.
+    o = {};
+    o[123] = 'x';
+    o['456'] = 'y';
+    print('map', Object.keys(o)[0], Object.keys(o)[1], o[789]);
+}
+
+try {
+    arridxStringCacheTest();
+} catch (e) {
+    print(e.stack || e);
+}
@@ -0,0 +1,100 @@
+/*
+ *  Built-ins producing strings through the internal buffer writer:
+ *  outputs much larger than the initial buffer size estimate, and
+ *  outputs with many small writes crossing resize boundaries.
+ */
+
+/*===
+fromCharCode
+3000 3000 15000
+replace
+200000 abcabc-abc-
+9000 xxxxxxxxxx
+uri
+20000 76666
+20000 true
+escape
+120000 true
+json
+"\u00e4\u1234\ud800" 34
+20001 true
+done
+===*/
+
+function rep(s, n) {
+    // Avoid a += loop which is quadratic for long results.
+    return new Array(n + 1).join(s);
+}
+
+function fromCharCodeTest() {
+    var args1 = [], args2 = [];
+    var i, s1, s2;
+
+    for (i = 0; i < 3000; i++) {
+        args1.push(0x41 + (i % 26));
+        args2.push(i % 2 ? 0x1234 : 0xe4);
+    }
+    s1 = String.fromCharCode.apply(null, args1);
+    s2 = String.fromCharCode.apply(null, args2);
+    print(s1.length, s2.length, Duktape.enc('hex', s2).length);
+}
+
+function replaceTest() {
+    var s = rep('abc', 10) + '-abc-';
+    var t;
+
+    // Replacement much longer than input.
+    t = 'x'.replace('x', function () { return rep('y', 200000); });
+    print(t.length, s.replace(rep('abc', 8), '').replace(/abc$/, ''));
+
+    // Many small writes: global regexp with $-substitutions.
+    t = rep('ab', 3000).replace(/b/g, '$&$&');
+    print(t.length, rep('x', 1000).replace(/x/g, 'x').substring(0, 10));
+}
+
+function uriTest() {
+    var s = rep('\u00e4', 10000) + rep('a/b', 10000 / 3 | 0) + 'a';
+    var e = encodeURIComponent(s);
+
+    print(s.length, e.length);
+    print(decodeURIComponent(e).length, decodeURIComponent(e) === s);
+}
+
+function escapeTest() {
+    var s = rep('\u1234\u00e4 ', 10000);
+    var e = escape(s);
+
+    print(e.length, unescape(e) === s);
+}
+
+function jsonTest() {
+    var obj = [];
+    var i, t;
+
+    print(JSON.stringify('\u00e4\u1234\ud800').replace(/[^\x20-\x7e]/g, function (c) {
+        return '\\u' + ('0000' + c.charCodeAt(0).toString(16)).slice(-4);
+    }), Duktape.enc('jx', '\u00e4\u1234\ud800' + rep('\x01', 4)).length);
+
+    for (i = 0; i < 10000; i++) {
+        obj.push(i % 10);
+    }
+    t = JSON.stringify(obj);
+    print(t.length, JSON.stringify(JSON.parse(t)) === t);
+}
+
+try {
+    print('fromCharCode');
+    fromCharCodeTest();
+    print('replace');
+    replaceTest();
+    print('uri');
+    uriTest();
+    print('escape');
+    escapeTest();
+    print('json');
+    jsonTest();
+} catch (e) {
+    print(e.stack || e);
+}
+
+print('done');
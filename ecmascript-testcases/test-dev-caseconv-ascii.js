@@ -0,0 +1,60 @@
+/*
+ *  toUpperCase()/toLowerCase() and case insensitive RegExp matching have
+ *  an ASCII fast path; check that it agrees with the generic Unicode path
+ *  and that mixed input still uses the full rules.
+ */
+
+/*===
+ascii
+content-type content-type ABC abc@[`{ ABC@[`{
+true true
+true 128
+non-ascii
+STRASSE%20%u03A3%u0391%u03A3%20%C4BC %u03C3%u03B1%u03C2%20%E4bc
+%u0130 i%u0307
+regexp
+true ABCdef true false true false
+true true false
+===*/
+
+function asciiTest() {
+    var s, t, i;
+
+    print('Content-Type'.toLowerCase(), 'content-type'.toLowerCase(), 'abc'.toUpperCase(),
+          'ABC@[`{'.toLowerCase(), 'abc@[`{'.toUpperCase());
+
+    // Unchanged strings are returned as is, still equal.
+    t = 'already-lower';
+    print(t.toLowerCase() === t, ''.toUpperCase() === '');
+
+    s = '';
+    for (i = 0; i < 128; i++) {
+        s += String.fromCharCode(i);
+    }
+    print(s.toUpperCase() === s.replace(/[a-z]/g, function (c) {
+        return String.fromCharCode(c.charCodeAt(0) - 32);
+    }), s.toLowerCase().length);
+}
+
+function nonAsciiTest() {
+    print(escape('stra\u00dfe \u03a3\u0391\u03a3 \u00e4bc'.toUpperCase()),
+          escape('\u03a3\u0391\u03a3 \u00c4BC'.toLowerCase()));
+    print(escape('\u0130'.toUpperCase()), escape('\u0130'.toLowerCase()));
+}
+
+function regexpTest() {
+    print(/hello/i.test('HeLLo'), /[a-z]+/i.exec('ABCdef')[0], /\u00e4/i.test('\u00c4'),
+          /\u017f/i.test('s'), /[@-\[]/i.test('a'), /\u212a/i.test('k'));
+    print(/^[^a-z]$/i.test('@'), /^\x60$/i.test('`'), /^[^A-Z]+$/i.test('xyz'));
+}
+
+try {
+    print('ascii');
+    asciiTest();
+    print('non-ascii');
+    nonAsciiTest();
+    print('regexp');
+    regexpTest();
+} catch (e) {
+    print(e.stack || e);
+}
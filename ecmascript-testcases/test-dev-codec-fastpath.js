@@ -0,0 +1,133 @@
+/*
+ *  Hex and base64 encoding/decoding process full groups at a time and
+ *  handle the rest (partial groups, whitespace, padding, errors) separately.
+ *  Exercise the boundaries between the two.
+ */
+
+/*===
+base64 encode
+empty ""
+1 AA==
+2 AAE=
+3 AAEC
+4 AAECAw==
+11 AAECAwQFBgcICQo=
+12 AAECAwQFBgcICQoL
+13 AAECAwQFBgcICQoLDA==
+14 AAECAwQFBgcICQoLDA0=
+15 AAECAwQFBgcICQoLDA0O
+string /w== w7/Dv8O/
+base64 decode
+AAECAwQFBgcICQoL 000102030405060708090a0b
+AAECAwQFBgcICQoLDA== 000102030405060708090a0b0c
+AAECAwQFBgcICQoLDA0= 000102030405060708090a0b0c0d
+AAEC AwQF 000102030405
+"AAEC\nAwQF\r\n" 000102030405
+AA==AAE=AAEC 000001000102
+buffer input 666f6f626172
+TypeError
+TypeError
+TypeError
+TypeError
+TypeError
+TypeError
+hex encode
+empty ""
+1 00
+4 00010203
+5 0001020304
+9 000102030405060708
+string 666f6fc3bf
+hex decode
+000102030405060708
+0a0b0c0d0e0f
+TypeError
+TypeError
+TypeError
+TypeError
+roundtrip ok
+===*/
+
+function mkbuf(n) {
+    var b = Duktape.Buffer(n);
+    var i;
+    for (i = 0; i < n; i++) {
+        b[i] = i;
+    }
+    return b;
+}
+
+function tryDecode(fmt, val) {
+    try {
+        print(Duktape.enc('hex', Duktape.dec(fmt, val)));
+    } catch (e) {
+        print(e.name);
+    }
+}
+
+function base64Test() {
+    print('base64 encode');
+    print('empty', JSON.stringify(Duktape.enc('base64', mkbuf(0))));
+    [ 1, 2, 3, 4, 11, 12, 13, 14, 15 ].forEach(function (n) {
+        print(n, Duktape.enc('base64', mkbuf(n)));
+    });
+    print('string', Duktape.enc('base64', Duktape.dec('hex', 'ff')), Duktape.enc('base64', 'ÿÿÿ'));
+
+    print('base64 decode');
+    [ 'AAECAwQFBgcICQoL', 'AAECAwQFBgcICQoLDA==', 'AAECAwQFBgcICQoLDA0=',
+      'AAEC AwQF' ].forEach(function (s) {
+        print(s, Duktape.enc('hex', Duktape.dec('base64', s)));
+    });
+    print(JSON.stringify('AAEC\nAwQF\r\n'), Duktape.enc('hex', Duktape.dec('base64', 'AAEC\nAwQF\r\n')));
+    print('AA==AAE=AAEC', Duktape.enc('hex', Duktape.dec('base64', 'AA==AAE=AAEC')));
+    print('buffer input', Duktape.enc('hex', Duktape.dec('base64', Duktape.Buffer('Zm9vYmFy'))));
+
+    // Invalid character within a full group, unpadded tail, bad padding.
+    tryDecode('base64', 'AAECAwQFBg@ICQoL');
+    tryDecode('base64', 'AAECAwQFBgcICQo');
+    tryDecode('base64', 'AAECAwQFBgcICQ=L');
+    tryDecode('base64', 'AAECAwQFBgcICQoLD===');
+    tryDecode('base64', 'AAECA=QF');
+    tryDecode('base64', 'AAECAwQFBgcIäCQoL');
+}
+
+function hexTest() {
+    print('hex encode');
+    print('empty', JSON.stringify(Duktape.enc('hex', mkbuf(0))));
+    [ 1, 4, 5, 9 ].forEach(function (n) {
+        print(n, Duktape.enc('hex', mkbuf(n)));
+    });
+    print('string', Duktape.enc('hex', 'fooÿ'));
+
+    print('hex decode');
+    tryDecode('hex', '000102030405060708');
+    tryDecode('hex', '0A0b0C0d0E0f');
+    tryDecode('hex', '000102030405060x08');  // invalid within a full round
+    tryDecode('hex', '0001020304050607g8');  // invalid in the tail
+    tryDecode('hex', '00010');               // odd length
+    tryDecode('hex', '00 102');
+}
+
+function roundtripTest() {
+    var i, n, b, ok = true;
+    for (n = 0; n < 64; n++) {
+        b = Duktape.Buffer(n);
+        for (i = 0; i < n; i++) {
+            b[i] = (n * 31 + i * 17) & 0xff;
+        }
+        if (String(Duktape.dec('base64', Duktape.enc('base64', b))) !== String(b) ||
+            String(Duktape.dec('hex', Duktape.enc('hex', b))) !== String(b)) {
+            print('mismatch', n);
+            ok = false;
+        }
+    }
+    print('roundtrip', ok ? 'ok' : 'failed');
+}
+
+try {
+    base64Test();
+    hexTest();
+    roundtripTest();
+} catch (e) {
+    print(e.stack || e);
+}
@@ -0,0 +1,123 @@
+/*
+ *  Instances created with 'new' get an initial property table size based on
+ *  earlier instances of the same constructor.  The size is only a hint so
+ *  results must be the same regardless of how instances vary.
+ */
+
+/*===
+point 0 0,1 x,y
+point 99 99,100 x,y
+grow 0 a
+grow 1 a,b0
+grow 5 a,b0,b1,b2,b3,b4
+grow 1 a,b0
+delete c,d
+replace true false 1
+hint true
+replaced hint true
+bound 3,4 x,y true
+many 200 p0 p199
+proto 7 true
+===*/
+
+function Point(x, y) {
+    this.x = x;
+    this.y = y;
+}
+Point.prototype.sum = function () { return this.x + this.y; };
+
+function Grow(n) {
+    var i;
+    this.a = 1;
+    for (i = 0; i < n; i++) {
+        this['b' + i] = i;
+    }
+}
+
+function Deleter() {
+    this.a = 1;
+    this.b = 2;
+    this.c = 3;
+    delete this.a;
+    delete this.b;
+    this.d = 4;
+}
+
+function Replacer(flag) {
+    this.ignored = true;
+    if (flag) {
+        return { replaced: 1 };
+    }
+}
+
+// Records the entry part size of 'this' at entry; Duktape.info() field
+// 5 is the entry part size of an object.
+function Sized(n, replace) {
+    var i;
+    this.esize = Duktape.info(this)[5];
+    for (i = 0; i < n; i++) {
+        this['p' + i] = i;
+    }
+    if (replace) {
+        return { replaced: true };
+    }
+}
+
+function Many() {
+    var i;
+    for (i = 0; i < 200; i++) {
+        this['p' + i] = i;
+    }
+}
+
+function test() {
+    var i, p, g, o, B, k;
+
+    for (i = 0; i < 100; i++) {
+        p = new Point(i, i + 1);
+        if (i === 0 || i === 99) {
+            print('point', i, [ p.x, p.y ], Object.keys(p));
+        }
+    }
+
+    [ 0, 1, 5, 1 ].forEach(function (n) {
+        g = new Grow(n);
+        print('grow', n, Object.keys(g));
+    });
+
+    new Deleter();
+    o = new Deleter();
+    print('delete', Object.keys(o));
+
+    new Replacer(false);
+    o = new Replacer(true);
+    print('replace', o.replaced === 1, o instanceof Replacer, Object.keys(o).length);
+
+    // A used instance gives a size hint for the next instance, but
+    // a fallback discarded for a replacement object resets the hint.
+    new Sized(10, false);
+    o = new Sized(0, false);
+    print('hint', o.esize >= 11);
+    new Sized(10, true);
+    o = new Sized(0, false);
+    print('replaced hint', o.esize === 0);
+
+    B = Point.bind(null, 3);
+    new B(4);
+    o = new B(4);
+    print('bound', [ o.x, o.y ], Object.keys(o), o instanceof Point);
+
+    new Many();
+    o = new Many();
+    k = Object.keys(o);
+    print('many', k.length, k[0], k[199]);
+
+    o = new Point(3, 4);
+    print('proto', o.sum(), Object.getPrototypeOf(o) === Point.prototype);
+}
+
+try {
+    test();
+} catch (e) {
+    print(e);
+}
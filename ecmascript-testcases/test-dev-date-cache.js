@@ -0,0 +1,112 @@
+/*
+ *  Local time offsets and day breakdowns are cached per heap.  Results must
+ *  not depend on the order in which time values are converted, so convert the
+ *  same set of time values in sequential, reverse, and shuffled order and
+ *  compare.  Works in any time zone; DST transitions are only crossed when
+ *  the local time zone has them.
+ */
+
+/*===
+forward vs. reverse: true
+forward vs. shuffled: true
+forward vs. local parts: true
+day breakdown: true
+===*/
+
+function describe(t) {
+    var d = new Date(t);
+    return [ t, d.getTimezoneOffset(), d.getFullYear(), d.getMonth(), d.getDate(),
+             d.getHours(), d.getMinutes(), d.getSeconds(), d.getMilliseconds(),
+             d.getDay() ].join(' ');
+}
+
+function convertAll(times) {
+    var res = {};
+    times.forEach(function (t) {
+        res[t] = describe(t);
+    });
+    return res;
+}
+
+function compare(a, b) {
+    var k;
+    for (k in a) {
+        if (a[k] !== b[k]) {
+            print('mismatch:', a[k], b[k]);
+            return false;
+        }
+    }
+    return true;
+}
+
+function orderTest() {
+    var times = [];
+    var t, i, j, tmp;
+    var seed = 1;
+    var fwd, rev, shuf, local;
+
+    // Hourly steps over two years, minute steps around each local midnight
+    // of the first month, and a few far away values.
+    for (t = Date.UTC(2014, 0, 1); t < Date.UTC(2016, 0, 1); t += 3600e3 + 7) {
+        times.push(t);
+    }
+    for (i = 0; i < 31; i++) {
+        for (j = -30; j < 30; j++) {
+            times.push(Date.UTC(2014, 0, 1 + i) + j * 60e3 + 999);
+        }
+    }
+    times.push(-8.64e15, 8.64e15, 0, -1, Date.UTC(1600, 1, 29), Date.UTC(2100, 5, 30));
+
+    fwd = convertAll(times);
+    rev = convertAll(times.slice(0).reverse());
+
+    for (i = times.length - 1; i > 0; i--) {
+        seed = (seed * 1103515245 + 12345) % 2147483648;
+        j = seed % (i + 1);
+        tmp = times[i]; times[i] = times[j]; times[j] = tmp;
+    }
+    shuf = convertAll(times);
+
+    print('forward vs. reverse:', compare(fwd, rev));
+    print('forward vs. shuffled:', compare(fwd, shuf));
+
+    // Local parts -> time value goes through the offset cache too.  Skip
+    // values whose local time is ambiguous or skipped due to DST.
+    local = true;
+    times.forEach(function (t) {
+        var d = new Date(t);
+        var d2 = new Date(d.getFullYear(), d.getMonth(), d.getDate(), d.getHours(),
+                          d.getMinutes(), d.getSeconds(), d.getMilliseconds());
+        if (d2.getTime() !== t &&
+            new Date(t - 3 * 3600e3).getTimezoneOffset() === new Date(t + 3 * 3600e3).getTimezoneOffset()) {
+            print('local mismatch:', t, d2.getTime());
+            local = false;
+        }
+    });
+    print('forward vs. local parts:', local);
+}
+
+function dayTest() {
+    // Alternate between two days so that the day breakdown cache is hit
+    // and replaced repeatedly.
+    var a = Date.UTC(2000, 1, 29, 12);
+    var b = Date.UTC(1999, 11, 31, 12);
+    var i, ok = true;
+
+    for (i = 0; i < 100; i++) {
+        if (new Date(a + i).toISOString().substring(0, 10) !== '2000-02-29' ||
+            new Date(b + i).toISOString().substring(0, 10) !== '1999-12-31' ||
+            new Date(a + i).getUTCDate() !== 29 ||
+            new Date(b + i).getUTCMonth() !== 11) {
+            ok = false;
+        }
+    }
+    print('day breakdown:', ok);
+}
+
+try {
+    orderTest();
+    dayTest();
+} catch (e) {
+    print(e.stack || e);
+}
@@ -0,0 +1,139 @@
+/*
+ *  Own key lists (Object.keys(), Object.getOwnPropertyNames(), JSON
+ *  encoding) are built directly from the object without an intermediate
+ *  enumerator object.  Key order must match for-in enumeration.
+ */
+
+/*===
+object
+a,b,1,c
+a,b,1,c
+a,b,1,c,hidden
+{"a":1,"b":2,"1":3,"c":4}
+array
+0,1,3,foo
+0,1,3,foo
+0,1,3,length,foo
+sparse
+0,1000000,foo
+string
+0,1,2,extra
+0,1,2,length,extra
+buffer
+0,1,2
+0,1,2,length,byteLength,byteOffset,BYTES_PER_ELEMENT,buffer
+function
+0 true true
+large
+100 k0 k99 true
+proxy
+x,y
+fresh
+true true
+===*/
+
+function forInKeys(obj) {
+    var res = [];
+    var k;
+    for (k in obj) {
+        res.push(k);
+    }
+    return res;
+}
+
+function objectTest() {
+    var obj = { a: 1, b: 2 };
+    obj[1] = 3;
+    obj.c = 4;
+    Object.defineProperty(obj, 'hidden', { value: 5, enumerable: false });
+
+    print(Object.keys(obj));
+    print(forInKeys(obj));
+    print(Object.getOwnPropertyNames(obj));
+    print(JSON.stringify(obj));
+}
+
+function arrayTest() {
+    var arr = [ 1, 2 ];
+    arr[3] = 4;
+    arr.foo = 'bar';
+
+    print(Object.keys(arr));
+    print(forInKeys(arr));
+    print(Object.getOwnPropertyNames(arr));
+
+    print('sparse');
+    arr = [ 1 ];
+    arr[1000000] = 2;
+    arr.foo = 'bar';
+    print(Object.keys(arr));
+}
+
+function stringTest() {
+    var obj = new String('foo');
+    obj.extra = 1;
+
+    print(Object.keys(obj));
+    print(Object.getOwnPropertyNames(obj));
+}
+
+function bufferTest() {
+    var obj = new Uint8Array(3);
+
+    print(Object.keys(obj));
+    print(Object.getOwnPropertyNames(obj));
+}
+
+function functionTest() {
+    function f(a, b) {}
+
+    print(Object.keys(f).length,
+          Object.getOwnPropertyNames(f).indexOf('length') >= 0,
+          Object.getOwnPropertyNames(f).indexOf('prototype') >= 0);
+}
+
+function largeTest() {
+    var obj = {};
+    var i, k;
+
+    for (i = 0; i < 100; i++) {
+        obj['k' + i] = i;
+    }
+    k = Object.keys(obj);
+    print(k.length, k[0], k[99], k.join() === forInKeys(obj).join());
+}
+
+function proxyTest() {
+    var p = new Proxy({ x: 1, y: 2 }, {});
+    print(Object.keys(p));
+}
+
+function freshTest() {
+    // Each call returns a new, writable array.
+    var obj = { a: 1 };
+    var k1 = Object.keys(obj);
+    var k2 = Object.keys(obj);
+    k1.push('b');
+    print(k1 !== k2, k2.length === 1);
+}
+
+try {
+    print('object');
+    objectTest();
+    print('array');
+    arrayTest();
+    print('string');
+    stringTest();
+    print('buffer');
+    bufferTest();
+    print('function');
+    functionTest();
+    print('large');
+    largeTest();
+    print('proxy');
+    proxyTest();
+    print('fresh');
+    freshTest();
+} catch (e) {
+    print(e.stack || e);
+}
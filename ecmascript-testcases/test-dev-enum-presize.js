@@ -0,0 +1,147 @@
+/*
+ *  The enumerator object is allocated at its final size based on a key
+ *  count computed beforehand.  Exercise cases where the count is only an
+ *  upper bound (shadowed keys), virtual keys, large key sets (which use a
+ *  hash part), and mutation of the target during enumeration.
+ */
+
+/*===
+shadowing
+a,b,c,d
+0,1,2,x,y
+0,1,2,length,foo
+0,1,length,byteLength,byteOffset,BYTES_PER_ELEMENT,buffer
+large
+100 k0 k99
+200 k99 99
+mutation
+a,c,d
+a,b,c
+getOwnPropertyNames
+0,1,2,length,foo
+0,1,length
+nested
+a1,a2,a3,b1,b2,b3,c1,c2,c3
+===*/
+
+function keysOf(obj) {
+    var res = [];
+    var k;
+    for (k in obj) {
+        res.push(k);
+    }
+    return res;
+}
+
+function shadowingTest() {
+    var proto = { a: 1, b: 2, c: 3 };
+    var obj = Object.create(proto);
+    var arr;
+
+    obj.c = 'own';
+    obj.a = 'own';
+    obj.d = 4;
+    print(keysOf(obj).sort());
+
+    arr = [ 1, 2, 3 ];
+    Object.getPrototypeOf(arr).x = 1;
+    Object.prototype.y = 2;
+    Object.prototype[1] = 'shadowed';
+    print(keysOf(arr));
+    delete Array.prototype.x;
+    delete Object.prototype.y;
+    delete Object.prototype[1];
+
+    obj = new String('foo');
+    obj.foo = 'bar';
+    print(Object.getOwnPropertyNames(obj));
+
+    obj = new Uint8Array(2);
+    print(Object.getOwnPropertyNames(obj));
+}
+
+function largeTest() {
+    var obj = {};
+    var sub;
+    var i, k;
+
+    for (i = 0; i < 100; i++) {
+        obj['k' + i] = i;
+    }
+    k = keysOf(obj);
+    print(k.length, k[0], k[k.length - 1]);
+
+    // Child shadows every key of a large prototype.
+    sub = Object.create(obj);
+    for (i = 99; i >= 0; i--) {
+        sub['k' + i] = i;
+    }
+    for (i = 0; i < 100; i++) {
+        sub[i] = i;
+    }
+    k = keysOf(sub);
+    print(k.length, k[0], k[k.length - 1]);
+}
+
+function mutationTest() {
+    var obj = { a: 1, b: 2, c: 3, d: 4 };
+    var res = [];
+    var k;
+
+    // Deleted keys are skipped, added keys are not enumerated.
+    for (k in obj) {
+        res.push(k);
+        if (k === 'a') {
+            delete obj.b;
+            obj.e = 5;
+        }
+    }
+    print(res);
+
+    // Enough additions to force the target to be resized.
+    obj = { a: 1, b: 2, c: 3 };
+    res = [];
+    for (k in obj) {
+        var i;
+        res.push(k);
+        for (i = 0; i < 100; i++) {
+            obj['x' + i + k] = i;
+        }
+    }
+    print(res);
+}
+
+function getOwnPropertyNamesTest() {
+    var obj = [ 1, 2, 3 ];
+    obj.foo = 'bar';
+    print(Object.getOwnPropertyNames(obj));
+    print(Object.getOwnPropertyNames(new String('xy')));
+}
+
+function nestedTest() {
+    var obj = { a: 1, b: 2, c: 3 };
+    var res = [];
+    var k1, k2;
+
+    for (k1 in obj) {
+        for (k2 in obj) {
+            res.push(k1 + obj[k2]);
+        }
+    }
+    print(res);
+}
+
+try {
+    print('shadowing');
+    shadowingTest();
+    print('large');
+    largeTest();
+    print('mutation');
+    mutationTest();
+    print('getOwnPropertyNames');
+    getOwnPropertyNamesTest();
+    print('nested');
+    nestedTest();
+} catch (e) {
+    print(e.stack || e);
+}
@@ -2088,14 +2088,14 @@ downgrade sanity
 1.0000000149011612 1.0000004
 -1.0000000298023224 -1.0000008
 -1.0000000298023224 -1.0000008
--2.9802322387695313e-8 -0.0000008
--2.9802322387695313e-8 -0.0000008
+-2.9802322387695312e-8 -0.0000008
+-2.9802322387695312e-8 -0.0000008
 0.9999999701976776 0.ffffff8
 0.9999999701976776 0.ffffff8
 -0.9999999701976776 -0.ffffff8
 -0.9999999701976776 -0.ffffff8
-2.9802322387695313e-8 0.0000008
-2.9802322387695313e-8 0.0000008
+2.9802322387695312e-8 0.0000008
+2.9802322387695312e-8 0.0000008
 1.0000000298023224 1.0000008
 1.0000000298023224 1.0000008
 -1.0000000596046448 -1.000001
@@ -2182,8 +2182,8 @@ downgrade sanity
 0.000003814697265625 0.00004
 1.0000038146972656 1.00004
 1.0000038146972656 1.00004
--1.0000076293945313 -1.00008
--1.0000076293945313 -1.00008
+-1.0000076293945312 -1.00008
+-1.0000076293945312 -1.00008
 -0.00000762939453125 -0.00008
 -0.00000762939453125 -0.00008
 0.9999923706054688 0.ffff8
@@ -2192,8 +2192,8 @@ downgrade sanity
 -0.9999923706054688 -0.ffff8
 0.00000762939453125 0.00008
 0.00000762939453125 0.00008
-1.0000076293945313 1.00008
-1.0000076293945313 1.00008
+1.0000076293945312 1.00008
+1.0000076293945312 1.00008
 -1.0000152587890625 -1.0001
 -1.0000152587890625 -1.0001
 -0.0000152587890625 -0.0001
@@ -0,0 +1,209 @@
+/*
+ *  Fastint preserving paths outside plain register arithmetic: comparisons,
+ *  mixed fastint/double bitwise operations, increment/decrement of variables
+ *  and properties, Math built-ins and integer coercions.
+ */
+
+/*---
+{
+    "custom": true,
+    "specialoptions": "requires DUK_OPT_FASTINT"
+}
+---*/
+
+function isFastint(v) {
+    if (typeof Duktape !== 'object') {
+        return 'NOT-DUKTAPE';
+    } else if (Duktape.info(true)[1] === 0xfff4) {
+        return Duktape.info(v)[1] === 0xfff1;  // packed duk_tval
+    } else if (Duktape.info(true)[1] === 4) {
+        return Duktape.info(v)[1] === 1;  // non-packed duk_tval
+    }
+    return 'CANNOT-DETERMINE';
+}
+
+function show(name, v) {
+    var s = (v === 0 && 1 / v < 0) ? '-0' : String(v);
+    print(name, s, isFastint(v));
+}
+
+/*===
+comparisons
+true false true false true true
+false true false true false false
+true true false
+false false false false
+===*/
+
+function comparisonTest() {
+    var a = 3, b = 5, c = 3, d = 3.5, n = NaN;
+
+    print(a < b, a > b, a <= c, a < c, a >= c, b >= a);
+    print(b < a, b > a, d < a, d > a, a == b, a === b);
+    print(a == c, a === c, a != c);
+    print(n < a, n >= a, a > n, a <= n);
+}
+
+try {
+    print('comparisons');
+    comparisonTest();
+} catch (e) {
+    print(e);
+}
+
+/*===
+bitwise
+and 1 true
+or 7 true
+xor 6 true
+shl -2147483648 true
+sar -1 true
+shr 4294967295 true
+not -6 true
+mixed-and 1 true
+mixed-shr 1 true
+mixed-not -4 true
+===*/
+
+function bitwiseTest() {
+    var x = 5, y = 3, dbl = 3.5, big = 4294967295.5;
+
+    show('and', x & y);
+    show('or', x | y);
+    show('xor', x ^ y);
+    show('shl', 1 << 31);
+    show('sar', -1 >> 4);
+    show('shr', -1 >>> 0);
+    show('not', ~x);
+    show('mixed-and', x & dbl);
+    show('mixed-shr', dbl >>> 1);
+    show('mixed-not', ~dbl);
+}
+
+try {
+    print('bitwise');
+    bitwiseTest();
+} catch (e) {
+    print(e);
+}
+
+/*===
+incdec
+closure 11 true
+closure-post 11 true
+global 3 true
+prop 10 true
+prop-post 9 true
+prop-dec -1 true
+double-prop 1.5 false
+===*/
+
+var globalCounter = 0;
+
+function incDecTest() {
+    var counter = 10;
+    var o = { c: 0 };
+    var p = { c: 0.5 };
+    var i, t;
+
+    function bump() { return ++counter; }
+    function bumpPost() { return counter++; }
+
+    show('closure', bump());
+    show('closure-post', bumpPost());
+
+    for (i = 0; i < 3; i++) {
+        globalCounter++;
+    }
+    show('global', globalCounter);
+
+    for (i = 0; i < 10; i++) {
+        t = o.c++;
+    }
+    show('prop', o.c);
+    show('prop-post', t);
+    o.c = 0;
+    --o.c;
+    show('prop-dec', o.c);
+    p.c++;
+    show('double-prop', p.c);
+}
+
+try {
+    print('incdec');
+    incDecTest();
+} catch (e) {
+    print(e);
+}
+
+/*===
+math
+floor 7 true
+ceil -7 true
+round 7 true
+abs 3 true
+abs-neg 3 true
+max 5 true
+min -2 true
+max-mixed 5.5 false
+max-empty -Infinity false
+min-empty Infinity false
+max-nan NaN false
+floor-dbl 7 true
+===*/
+
+function mathTest() {
+    var seven = 7;
+
+    show('floor', Math.floor(seven));
+    show('ceil', Math.ceil(-seven));
+    show('round', Math.round(seven));
+    show('abs', Math.abs(3));
+    show('abs-neg', Math.abs(-3));
+    show('max', Math.max(1, 5, 3));
+    show('min', Math.min(4, -2, 0));
+    show('max-mixed', Math.max(1, 5.5, 3));
+    show('max-empty', Math.max());
+    show('min-empty', Math.min());
+    show('max-nan', Math.max(1, NaN, 3));
+    show('floor-dbl', Math.floor(7.5));
+}
+
+try {
+    print('math');
+    mathTest();
+} catch (e) {
+    print(e);
+}
+
+/*===
+builtins
+charCodeAt 98 true
+length 4 true
+array-length 100 true
+array-index 99 true
+parseInt 123 true
+Number 456 true
+===*/
+
+function builtinTest() {
+    var arr = [];
+    var i;
+
+    show('charCodeAt', 'abc'.charCodeAt(1));
+    show('length', 'abcd'.length);
+    for (i = 0; i < 100; i++) {
+        arr[arr.length] = i;
+    }
+    show('array-length', arr.length);
+    show('array-index', arr[arr.length - 1]);
+    show('parseInt', parseInt('123'));
+    show('Number', Number('456'));
+}
+
+try {
+    print('builtins');
+    builtinTest();
+} catch (e) {
+    print(e);
+}
@@ -0,0 +1,47 @@
+/*
+ *  Duktape.fastintStats() only exists with DUK_OPT_FASTINT_STATS.  When it
+ *  does, operations with fastint inputs and a double result are counted.
+ */
+
+/*===
+consistent true
+===*/
+
+function sum(arr) {
+    return arr.reduce(function (a, b) { return a + b; }, 0);
+}
+
+function test() {
+    var st;
+    var i, t;
+    var ok;
+
+    if (typeof Duktape.fastintStats !== 'function') {
+        // Not enabled in this build.
+        print('consistent', !('fastintStats' in Duktape));
+        return;
+    }
+
+    Duktape.fastintStats(true);  // reset
+    st = Duktape.fastintStats();
+    ok = (sum(st.op) === 0 && sum(st.extraop) === 0);
+
+    // Non-integer division results of fastint inputs: 1/3, 2/3, 4/3, ...
+    for (i = 0; i < 10; i++) {
+        t = i / 3;
+    }
+    st = Duktape.fastintStats(true);
+    ok = ok && (sum(st.op) + sum(st.extraop) >= 6);
+
+    st = Duktape.fastintStats();
+    ok = ok && (sum(st.op) === 0);
+    ok = ok && (st.op.length > 0 && st.extraop.length > 0);
+
+    print('consistent', ok);
+}
+
+try {
+    test();
+} catch (e) {
+    print(e);
+}
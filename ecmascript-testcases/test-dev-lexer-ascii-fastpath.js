@@ -0,0 +1,96 @@
+/*
+ *  The lexer scans runs of ASCII identifier characters, whitespace, comments,
+ *  and simple decimal integers directly from the source.  Exercise the
+ *  boundaries between the fast path and the generic path.
+ */
+
+/*===
+identifiers
+true 100
+3 3
+7 7
+8 8
+escape 9
+keywords true null
+numbers
+0 7 123456789012345 1234567890123456 12345678901234568
+255 1.5 100 3
+SyntaxError
+SyntaxError
+SyntaxError
+8 10
+lines
+4
+5
+6
+6
+8
+3
+3
+===*/
+
+function identifierTest() {
+    var longName = 'a' + new Array(100).join('b');
+    var src = 'var ' + longName + ' = 1; ' + longName + ' === 1';
+
+    print(eval(src), longName.length);
+
+    // Identifier followed by a non-ASCII IdentifierPart or an escape
+    // must continue in the generic path.
+    print(eval('var abcä = 3; abcä'), eval('abc\\u00e4'));
+    print(eval('var ab\\u0063d = 7; abcd'), eval('abcd'));
+    print(eval('var äbc = 8; äbc'), eval('\\u00e4bc'));
+    print('escape', eval('var x\\u0079 = 9; xy'));
+
+    // Keywords and literals are still recognized.
+    print('keywords', eval('true'), eval('null'));
+}
+
+function numberTest() {
+    print(eval('0'), eval('07'), eval('123456789012345'), eval('1234567890123456'),
+          eval('12345678901234567'));
+    print(eval('0xff'), eval('1.5'), eval('1e2'), eval('1 + 2'));
+
+    [ '1a', '12\\u0061', '3in[]' ].forEach(function (src) {
+        try {
+            eval(src);
+            print('never here');
+        } catch (e) {
+            print(e.name);
+        }
+    });
+
+    print(eval('1..toString().length + 7'), eval('(5).valueOf() + 5'));
+}
+
+function lineTest() {
+    var pad = new Array(200).join(' ');
+    var longComment = new Array(50).join('comment text ');
+
+    function lineOf(src) {
+        return eval(src + 'new Error().lineNumber');
+    }
+
+    // Whitespace runs, long and short, don't affect line numbers.
+    print(lineOf('\n\n' + pad + '\n' + pad));
+    print(lineOf('/* a\n b\n c\n d */ ' + pad + '\n'));
+    print(lineOf('/* ' + longComment + '\r\n' + longComment + '\r\n' + longComment + '\r' + longComment + '\n*/\n'));
+    print(lineOf('// ' + longComment + '\n/*' + longComment + ' */\n' + pad + '//x\r\n//y\n\n'));
+    print(lineOf('/***/\n/**\n**/\n/* * / */\n/*' + longComment + '**/\n' + pad + '\n\n'));
+
+    // Line terminator inside a multi-line comment acts as a line
+    // terminator for automatic semicolon insertion.
+    print(eval('var a = 1, b = 2; a /*' + longComment + '\n' + longComment + '*/ b = 3; b'));
+    print(eval('var c = 3 /*' + longComment + '*/; c'));
+}
+
+try {
+    print('identifiers');
+    identifierTest();
+    print('numbers');
+    numberTest();
+    print('lines');
+    lineTest();
+} catch (e) {
+    print(e.stack || e);
+}
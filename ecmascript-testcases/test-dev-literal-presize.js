@@ -0,0 +1,117 @@
+/*
+ *  Object and array literals get an initial property table size hint from
+ *  the compiler.  The hint only affects allocation so results must be the
+ *  same as without it: duplicate keys, getters/setters, elisions, nesting
+ *  and literals larger than the maximum hint.
+ */
+
+/*===
+object
+{"a":1,"b":2,"c":3}
+{"x":3,"y":2}
+a,b
+10 20
+{"1":"one","2":"two","foo":"bar"}
+{"inner":{"p":1,"q":[1,2]},"z":true}
+large 1000 999 999
+===*/
+
+function objectTest() {
+    var o, i, src, k;
+
+    print(JSON.stringify({ a: 1, b: 2, c: 3 }));
+    print(JSON.stringify({ x: 1, y: 2, x: 3 }));
+
+    o = { get a() { return 10; }, set a(v) { this._a = v; }, get b() { return 20; } };
+    print(Object.keys(o).join(','));
+    print(o.a, o.b);
+
+    print(JSON.stringify({ 1: 'one', 2: 'two', foo: 'bar' }));
+    print(JSON.stringify({ inner: { p: 1, q: [ 1, 2 ] }, z: true }));
+
+    src = [];
+    for (i = 0; i < 1000; i++) {
+        src.push('k' + i + ': ' + i);
+    }
+    o = eval('({' + src.join(',') + '})');
+    k = Object.keys(o);
+    print('large', k.length, k[999].substring(1), o.k999);
+}
+
+try {
+    print('object');
+    objectTest();
+} catch (e) {
+    print(e);
+}
+
+/*===
+array
+[] 0
+[1,2,3] 3
+[1,null,3] 3 false
+[1,2,null,null] 4 false
+3 undefined
+[[1,2],[3,[4]]] 2
+large 1000 999 0,1,2
+mixed 5 x,1.5,true,,[object Object]
+===*/
+
+function arrayTest() {
+    var a, i, src;
+
+    a = [];
+    print(JSON.stringify(a), a.length);
+    a = [ 1, 2, 3 ];
+    print(JSON.stringify(a), a.length);
+    a = [ 1, , 3 ];
+    print(JSON.stringify(a), a.length, 1 in a);
+    a = [ 1, 2, , , ];
+    print(JSON.stringify(a), a.length, 3 in a);
+    a = [ , , , ];
+    print(a.length, a[0]);
+    a = [ [ 1, 2 ], [ 3, [ 4 ] ] ];
+    print(JSON.stringify(a), a.length);
+
+    src = [];
+    for (i = 0; i < 1000; i++) {
+        src.push(String(i));
+    }
+    a = eval('[' + src.join(',') + ']');
+    print('large', a.length, a[999], a.slice(0, 3));
+
+    a = [ 'x', 1.5, true, null, {} ];
+    print('mixed', a.length, a);
+}
+
+try {
+    print('array');
+    arrayTest();
+} catch (e) {
+    print(e);
+}
+
+/*===
+loop
+100 abc 0,1,2 abc
+===*/
+
+/* Literals evaluated repeatedly must not share state. */
+function loopTest() {
+    var res = [];
+    var i;
+
+    for (i = 0; i < 100; i++) {
+        res.push({ idx: i, name: 'abc', arr: [ 0, 1, 2 ] });
+    }
+    res[0].arr.push(3);
+    res[0].name = 'changed';
+    print(res.length, res[99].name, res[99].arr, res[1].name);
+}
+
+try {
+    print('loop');
+    loopTest();
+} catch (e) {
+    print(e);
+}
@@ -0,0 +1,90 @@
+/*
+ *  Decimal number-to-string and string-to-number conversions have 64-bit
+ *  fast paths (Grisu3, cached power multiplication) which fall back to
+ *  Dragon4 when they can't guarantee a correct result.  The result must
+ *  be the same either way.
+ */
+
+/*===
+tostring
+0.1 0.2 0.3 0.30000000000000004
+0.3333333333333333 3.141592653589793 2.718281828459045
+123.456 -1.5 4.35 1.7976931348623157e+308 2.2250738585072014e-308 5e-324
+72880277568.95312
+1e+21 1e-7 0.000001 9007199254740994 123456789012345680000
+1.7800590868057611e-307 7.120236347223045e-307 9.113902524445497e-305
+1.2e+1 1.23456e+2 1.00000e+0 0.1
+parse
+0.1 0.30000000000000004 9007199254740992 9007199254740998
+2.225073858507201e-308 5e-324 0 1.7976931348623157e+308 Infinity
+123456789012345680000 12345678901234567000 -1e-300 1e+300
+roundtrip
+powers of two 0
+random 0
+===*/
+
+function tostringTest() {
+    print(0.1, 0.2, 0.3, 0.1 + 0.2);
+    print(1 / 3, Math.PI, Math.E);
+    print(123.456, -1.5, 4.35, Number.MAX_VALUE, 2.2250738585072014e-308, Number.MIN_VALUE);
+    // Exactly half way between two shortest candidates, even digit wins.
+    print(72880277568.953125);
+    print(1e21, 1e-7, 1e-6, 9007199254740993, 123456789012345678901);
+
+    // Powers of two have unequal gaps to their neighbours.
+    print(Math.pow(2, -1019), Math.pow(2, -1017), Math.pow(2, -1010));
+
+    // Forced exponential format uses the same digits; fixed formats
+    // always use Dragon4.
+    print((12).toExponential(), (123.456).toExponential(), (1).toExponential(5), (0.1).toPrecision(1));
+}
+
+function parseTest() {
+    print(Number('0.1'), Number('0.30000000000000004'), Number('9007199254740992'),
+          Number('9007199254740998'));
+    print(Number('2.2250738585072011e-308'), Number('4.9e-324'), Number('2e-324'),
+          Number('1.7976931348623157e308'), Number('1.7976931348623159e308'));
+    print(Number('123456789012345678901'), Number('12345678901234567890'),
+          Number('-1e-300'), Number('1e300'));
+}
+
+function roundtripTest() {
+    var i, x, failed;
+    var seed = 12345;
+
+    function rnd() {
+        seed = (seed * 1103515245 + 12345) % 2147483648;
+        return seed / 2147483648;
+    }
+
+    failed = 0;
+    for (i = -1074; i <= 1023; i++) {
+        x = Math.pow(2, i);
+        if (Number(String(x)) !== x) {
+            print('failed:', i, x);
+            failed++;
+        }
+    }
+    print('powers of two', failed);
+
+    failed = 0;
+    for (i = 0; i < 10000; i++) {
+        x = rnd() * Math.pow(10, Math.floor(rnd() * 600) - 300);
+        if (Number(String(x)) !== x) {
+            print('failed:', x);
+            failed++;
+        }
+    }
+    print('random', failed);
+}
+
+try {
+    print('tostring');
+    tostringTest();
+    print('parse');
+    parseTest();
+    print('roundtrip');
+    roundtripTest();
+} catch (e) {
+    print(e.stack || e);
+}
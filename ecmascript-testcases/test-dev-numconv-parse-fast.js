@@ -0,0 +1,172 @@
+/*
+ *  Decimal string-to-number fast path for Number(), parseInt() and
+ *  parseFloat(): results must match the generic parser exactly, and all
+ *  inputs outside the fast path must still be handled.
+ */
+
+/*===
+"0" 0 0 0 0
+"-0" -0 -0 -0 -0
+"+0" 0 0 0 0
+"1" 1 1 1 1
+"-1" -1 -1 -1 -1
+"+1" 1 1 1 1
+"123" 123 123 123 123
+"  123  " 123 123 123 123
+"<0009><000a>123<000d><000a>" 123 123 123 123
+"123abc" NaN 123 123 123
+"12.5" 12.5 12 12 12.5
+"-12.5" -12.5 -12 -12 -12.5
+".5" 0.5 NaN NaN 0.5
+"-.5" -0.5 NaN NaN -0.5
+"5." 5 5 5 5
+"." NaN NaN NaN NaN
+"" 0 NaN NaN NaN
+"   " 0 NaN NaN NaN
+"1e3" 1000 1 1 1000
+"1E3" 1000 1 1 1000
+"1e+3" 1000 1 1 1000
+"1e-3" 0.001 1 1 0.001
+"1e" NaN 1 1 1
+"1e+" NaN 1 1 1
+"1.5e2" 150 1 1 150
+"1.50" 1.5 1 1 1.5
+"2.000" 2 2 2 2
+"0.000" 0 0 0 0
+"-0.0" -0 -0 -0 -0
+"00" 0 0 0 0
+"007" 7 7 7 7
+"0x10" 16 16 0 0
+"0X1f" 31 31 0 0
+"0.1" 0.1 0 0 0.1
+"0.2" 0.2 0 0 0.2
+"0.3" 0.3 0 0 0.3
+"1.7976931348623157e308" 1.7976931348623157e+308 1 1 1.7976931348623157e+308
+"1.7976931348623159e308" Infinity 1 1 Infinity
+"5e-324" 5e-324 5 5 5e-324
+"2e-324" 0 2 2 0
+"4.9406564584124654e-324" 5e-324 4 4 5e-324
+"2.2250738585072014e-308" 2.2250738585072014e-308 2 2 2.2250738585072014e-308
+"9007199254740991" 9007199254740991 9007199254740991 9007199254740991 9007199254740991
+"9007199254740992" 9007199254740992 9007199254740992 9007199254740992 9007199254740992
+"18446744073709551615" 18446744073709552000 18446744073709552000 18446744073709552000 18446744073709552000
+"1234567890123456789" 1234567890123456800 1234567890123456800 1234567890123456800 1234567890123456800
+"12345678901234567890" 12345678901234567000 12345678901234567000 12345678901234567000 12345678901234567000
+"123456789012345678901234567890" 1.2345678901234568e+29 1.2345678901234568e+29 1.2345678901234568e+29 1.2345678901234568e+29
+"0.1234567890123456789" 0.12345678901234568 0 0 0.12345678901234568
+"0.12345678901234567890123" 0.12345678901234568 0 0 0.12345678901234568
+"Infinity" Infinity NaN NaN Infinity
+"-Infinity" -Infinity NaN NaN -Infinity
+"+Infinity" Infinity NaN NaN Infinity
+"infinity" NaN NaN NaN NaN
+"NaN" NaN NaN NaN NaN
+"1e400" Infinity 1 1 Infinity
+"-1e400" -Infinity -1 -1 -Infinity
+"1e-400" 0 1 1 0
+"1e9999" Infinity 1 1 Infinity
+"1e10000" Infinity 1 1 Infinity
+"3.14159265358979323846" 3.141592653589793 3 3 3.141592653589793
+"2.718281828459045" 2.718281828459045 2 2 2.718281828459045
+"1,5" NaN 1 1 1
+"1 2" NaN 1 1 1
+"<00a0>123<00a0>" 123 123 123 123
+"<feff>123" 123 123 123 123
+"<2028>123" 123 123 123 123
+"1.2.3" NaN 1 1 1.2
+"1e5e5" NaN 1 1 100000
+"--1" NaN NaN NaN NaN
+"+-1" NaN NaN NaN NaN
+"<0661><0662><0663>" NaN NaN NaN NaN
+random done, mismatches: 0
+[0,0,1,-1,12.5,1000,0.001,0.1,1.2345678901234568e+29]
+01 SyntaxError
++1 SyntaxError
+.5 SyntaxError
+1. SyntaxError
+1e SyntaxError
+- SyntaxError
+===*/
+
+var inputs = [
+    '0', '-0', '+0', '1', '-1', '+1', '123', '  123  ', '\t\n123\r\n', '123abc',
+    '12.5', '-12.5', '.5', '-.5', '5.', '.', '', '   ',
+    '1e3', '1E3', '1e+3', '1e-3', '1e', '1e+', '1.5e2', '1.50', '2.000', '0.000',
+    '-0.0', '00', '007', '0x10', '0X1f', '0.1', '0.2', '0.3', '1.7976931348623157e308',
+    '1.7976931348623159e308', '5e-324', '2e-324', '4.9406564584124654e-324', '2.2250738585072014e-308',
+    '9007199254740991', '9007199254740992', '18446744073709551615', '1234567890123456789',
+    '12345678901234567890', '123456789012345678901234567890', '0.1234567890123456789', '0.12345678901234567890123',
+    'Infinity', '-Infinity', '+Infinity', 'infinity', 'NaN', '1e400', '-1e400', '1e-400', '1e9999', '1e10000',
+    '3.14159265358979323846', '2.718281828459045', '1,5', '1 2', '\u00a0123\u00a0', '\ufeff123', '\u2028123',
+    '1.2.3', '1e5e5', '--1', '+-1', '\u0661\u0662\u0663'
+];
+
+function esc(x) {
+    return '"' + x.replace(/[^\u0020-\u007e]/g, function (c) {
+        return '<' + ('0000' + c.charCodeAt(0).toString(16)).substr(-4) + '>';
+    }) + '"';
+}
+
+function fmt(x) {
+    if (x === 0 && 1 / x < 0) {
+        return '-0';
+    }
+    return String(x);
+}
+
+function basicTest() {
+    inputs.forEach(function (v) {
+        print(esc(v), fmt(Number(v)), fmt(parseInt(v)), fmt(parseInt(v, 10)), fmt(parseFloat(v)));
+    });
+}
+
+function randomTest() {
+    var seed = 12345;
+    var i, j, s, n, mismatch = 0;
+
+    function rnd(n) {
+        seed = (seed * 1103515245 + 12345) % 2147483648;
+        return Math.floor(seed / 2147483648 * n);
+    }
+
+    for (i = 0; i < 20000; i++) {
+        s = '';
+        n = 1 + rnd(20);
+        for (j = 0; j < n; j++) {
+            s += String(rnd(10));
+        }
+        if (rnd(2)) {
+            j = rnd(s.length + 1);
+            s = s.substring(0, j) + '.' + s.substring(j);
+        }
+        if (rnd(2)) {
+            s += 'e' + (rnd(2) ? '-' : '') + String(rnd(330));
+        }
+        // Round trip check: the shortest representation must parse back
+        // to the same value, and parseFloat() must agree with Number().
+        n = Number(s);
+        if (Number(String(n)) !== n || parseFloat(s) !== n) {
+            mismatch++;
+            print('mismatch:', s, n, Number(String(n)), parseFloat(s));
+        }
+    }
+    print('random done, mismatches:', mismatch);
+}
+
+function jsonTest() {
+    print(JSON.stringify(JSON.parse('[0, -0, 1, -1, 12.5, 1e3, 1E-3, 0.1, 123456789012345678901234567890]')));
+    [ '01', '+1', '.5', '1.', '1e', '-' ].forEach(function (v) {
+        try {
+            print(JSON.parse(v));
+        } catch (e) {
+            print(v, e.name);
+        }
+    });
+}
+
+try {
+    basicTest();
+    randomTest();
+    jsonTest();
+} catch (e) {
+    print(e);
+}
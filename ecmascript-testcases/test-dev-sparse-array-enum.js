@@ -4,6 +4,9 @@
  *
  *    - If dense, enumerate array keys first, then other keys
  *
+ *    - Far away array keys are stored outside the array part and
+ *      enumerate in insertion order after the array part keys
+ *
  *    - When converting to sparse, re-add keys so that array keys
  *      are first (i.e. preserve order when abandoning array part)
  *
@@ -50,9 +53,19 @@ array keys
 2
 3
 4
+10
 foo
 10000
+array keys
+0
+1
+2
+3
+4
 10
+foo
+10000
+5
 ===*/
 
 var a;
@@ -67,10 +80,16 @@ a[4] = 5;
 a[3] = 4;
 enumArray(a);
 
-// force to sparse
+// far away key, array part is kept
 a[10000] = 9999;
 enumArray(a);
 
-// array order no longer maintained; now insertion order
+// array part grows to cover the new key, array order maintained
 a[10] = 9;
 enumArray(a);
+
+// force to sparse (non-default attributes); array order no longer
+// maintained, now insertion order
+Object.defineProperty(a, '1', { writable: false });
+a[5] = 6;
+enumArray(a);
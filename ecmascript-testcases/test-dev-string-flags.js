@@ -0,0 +1,115 @@
+/*
+ *  String flags (ASCII, JSON escape, identifier, array index) computed at
+ *  intern time or lazily on first use must match what the builtins would
+ *  compute by scanning.
+ */
+
+/*===
+json
+"foo" "foo bar" "a\"b" "a\\b" "tab\there" "nl\n" "\u0001" "<007f>" "caf<00e9>" "x\u2028y" ""
+{"foo":1,"$bar":2,"_1":3,"1a":4,"":5,"a-b":6,"<00e4>":7,"if":8,"a\u0000":9}
+jx
+{foo:1,$bar:2,_1:3,"1a":4,"":5,"a-b":6,"\xe4":7,if:8,"a\x00":9}
+"foo" "foo bar" "a\"b" "a\\b" "tab\there" "nl\n" "\x01" "\x7f" "caf\xe9" "x\u2028y" ""
+jc
+{"foo":1,"$bar":2,"_1":3,"1a":4,"":5,"a-b":6,"\u00e4":7,"if":8,"a\u0000":9}
+"foo" "foo bar" "a\"b" "a\\b" "tab\there" "nl\n" "\u0001" "\u007f" "caf\u00e9" "x\u2028y" ""
+case
+FOO BAR! foo bar! CAF<00c9> abc a<007f>
+array index
+0 1
+1 2
+01 0
+4294967294 4294967295
+4294967295 0
+42949672950 0
+1e3 0
+-1 0
+ 0
+<0661> 0
+reserved words
+implements ok
+strict implements SyntaxError
+if SyntaxError
+escaped if 123
+iff 234
+===*/
+
+/* Print with control characters, DEL and non-ASCII characters escaped. */
+function safePrint() {
+    var args = Array.prototype.map.call(arguments, function (x) {
+        return String(x).replace(/[\u0000-\u001f\u007f-\uffff]/g, function (c) {
+            return '<' + ('0000' + c.charCodeAt(0).toString(16)).substr(-4) + '>';
+        });
+    });
+    print(args.join(' '));
+}
+
+var obj = { foo: 1, $bar: 2, _1: 3, '1a': 4, '': 5, 'a-b': 6, '\u00e4': 7, 'if': 8, 'a\u0000': 9 };
+var strs = [ 'foo', 'foo bar', 'a"b', 'a\\b', 'tab\there', 'nl\n', '\u0001', '\u007f',
+             'caf\u00e9', 'x\u2028y', '' ];
+
+function jsonTest() {
+    safePrint(strs.map(function (v) { return JSON.stringify(v); }).join(' '));
+    safePrint(JSON.stringify(obj));
+}
+
+function jxTest() {
+    safePrint(Duktape.enc('jx', obj));
+    safePrint(strs.map(function (v) { return Duktape.enc('jx', v); }).join(' '));
+}
+
+function jcTest() {
+    safePrint(Duktape.enc('jc', obj));
+    safePrint(strs.map(function (v) { return Duktape.enc('jc', v); }).join(' '));
+}
+
+function caseTest() {
+    safePrint('foo bar!'.toUpperCase(), 'FOO BAR!'.toLowerCase(),
+              'caf\u00e9'.toUpperCase(), 'abc'.toLowerCase(), 'A\u007f'.toLowerCase());
+}
+
+function arrayIndexTest() {
+    [ '0', '1', '01', '4294967294', '4294967295', '42949672950', '1e3', '-1', '', '\u0661' ].forEach(function (k) {
+        var arr = [];
+        arr[k] = 'x';
+        safePrint(k, arr.length);
+    });
+}
+
+function reservedWordTest() {
+    var implements = 'ok';
+    print('implements', implements);
+    try {
+        eval('"use strict"; var implements = 1;');
+        print('strict implements', 'no error');
+    } catch (e) {
+        print('strict implements', e.name);
+    }
+    try {
+        eval('var if = 1;');
+        print('if', 'no error');
+    } catch (e) {
+        print('if', e.name);
+    }
+    eval('var \\u0069f = 123;');
+    print('escaped if', eval('\\u0069f'));
+    print('iff', eval('var iff = 234; iff'));
+}
+
+try {
+    print('json');
+    jsonTest();
+    print('jx');
+    jxTest();
+    print('jc');
+    jcTest();
+    print('case');
+    caseTest();
+    print('array index');
+    arrayIndexTest();
+    print('reserved words');
+    reservedWordTest();
+} catch (e) {
+    print(e);
+}
@@ -0,0 +1,129 @@
+/*
+ *  Substring search used by String.prototype.indexOf(), lastIndexOf(),
+ *  replace() and split() with string patterns.  Exercise both the short
+ *  and the long needle/haystack paths, non-ASCII input and boundaries.
+ */
+
+/*===
+short
+0 4 -1 8 8 -1
+8 4 0 -1 8 0
+3 -1 0 3
+non-ascii
+2 6 -1 5 0
+6 2 -1 9
+long
+1000 2001 -1 0 2990
+2001 1000 -1 980 2990
+1001 -1 3001 1001
+overlap
+0 1 2 3 4 5 6 7
+7 6 5 4 3 2 1 0
+replace
+xBy
+xxxAAAA\u1234-7-
+-foo-ab
+split
+5 a,b,c,d,
+4 \u1234x\u1234|\u1234\u1234|\u1234|
+3 1000 1000 4
+done
+===*/
+
+function esc(x) {
+    return String(x).replace(/[\u0080-\uffff]/g, function (c) {
+        var h = '0000' + c.charCodeAt(0).toString(16);
+        return '\\u' + h.substring(h.length - 4);
+    });
+}
+
+function rep(s, n) {
+    var res = '';
+    while (n-- > 0) { res += s; }
+    return res;
+}
+
+function shortTest() {
+    var s = 'abc abc abc';
+
+    print(s.indexOf('abc'), s.indexOf('abc', 1), s.indexOf('abd'),
+          s.indexOf('abc', 8), s.indexOf('', 8), s.indexOf('abc', 9));
+    print(s.lastIndexOf('abc'), s.lastIndexOf('abc', 7), s.lastIndexOf('abc', 3),
+          s.lastIndexOf('x'), s.lastIndexOf('abc', 100), s.lastIndexOf('abc', -5));
+    print('xyzabc'.indexOf('abc'), 'ab'.indexOf('abc'), 'a'.indexOf('a'), 'xyza'.lastIndexOf('a'));
+}
+
+function nonAsciiTest() {
+    var s = '\u00e4\u1234abc\u1234\u00e4abc';
+
+    print(s.indexOf('abc'), s.indexOf('\u00e4abc'), s.indexOf('\u00e4\u00e4'),
+          s.indexOf('\u1234\u00e4', 3), s.indexOf('\u00e4\u1234'));
+    print(s.lastIndexOf('\u00e4'), s.lastIndexOf('abc', 5), s.lastIndexOf('\u1234\u1234'),
+          s.lastIndexOf('c'));
+}
+
+function longTest() {
+    // Long needle within a long haystack: uses the BMH path.
+    var needle = 'needle\u1234-xyz';
+    var s = rep('x', 1000) + needle + rep('\u00e4', 990) + needle + rep('y', 978) + needle;
+
+    print(s.indexOf(needle), s.indexOf(needle, 1001), s.indexOf(needle + 'q'),
+          s.indexOf(s.substring(0, 20)), s.indexOf(needle, 2002));
+    print(s.lastIndexOf(needle, 2989), s.lastIndexOf(needle, 1999), s.lastIndexOf('q' + needle),
+          s.lastIndexOf(s.substring(0, 20)), s.lastIndexOf(needle));
+    print(s.indexOf('eedle\u1234-xyz'), s.indexOf('zzzzzzzzzz'), s.length, s.lastIndexOf('eedle\u1234-xyz', 1001));
+}
+
+function overlapTest() {
+    var s = rep('a', 16);
+    var res = [];
+    var i;
+
+    for (i = 0; i < 8; i++) {
+        res.push(s.indexOf('aaaaaaaaa', i));
+    }
+    print(res.join(' '));
+    res = [];
+    for (i = 7; i >= 0; i--) {
+        res.push(s.lastIndexOf('aaaaaaaaa', i));
+    }
+    print(res.join(' '));
+}
+
+function replaceTest() {
+    print('xAy'.replace('A', 'B'));
+    print(esc('xxxAAAA\u1234'.replace('\u1234', function (m, pos) { return '\u1234-' + pos + '-'; })));
+    print('ab'.replace('', '-foo-'));
+}
+
+function splitTest() {
+    var s, t;
+
+    t = 'a--b--c--d--'.split('--');
+    print(t.length, t.join(','));
+    t = '\u1234x\u1234ab\u1234\u1234ab\u1234ab'.split('ab');
+    print(t.length, esc(t.join('|')));
+
+    s = rep('\u00e4', 1000) + 'separator!' + rep('\u00e4', 1000) + 'separator!' + 'tail';
+    t = s.split('separator!');
+    print(t.length, t[0].length, t[1].length, t[2].length);
+}
+
+try {
+    print('short');
+    shortTest();
+    print('non-ascii');
+    nonAsciiTest();
+    print('long');
+    longTest();
+    print('overlap');
+    overlapTest();
+    print('replace');
+    replaceTest();
+    print('split');
+    splitTest();
+} catch (e) {
+    print(e.stack || e);
+}
+
+print('done');
@@ -0,0 +1,96 @@
+/*
+ *  Interleaved string interning, lookups, and string freeing across
+ *  several string table resizes.  With DUK_OPT_STRTAB_INCREMENTAL_RESIZE
+ *  this exercises all string table operations while a migration from the
+ *  previous table is in progress; the output is the same for any string
+ *  table implementation.
+ */
+
+/*===
+round 0 keys 3334 mismatches 0
+round 1 keys 6668 mismatches 0
+round 2 keys 10002 mismatches 0
+round 3 keys 13336 mismatches 0
+round 4 keys 16670 mismatches 0
+final keys 16670 mismatches 0
+===*/
+
+var ROUNDS = 5;
+var COUNT = 10000;
+
+function key(round, i) {
+    return 'str-' + round + '-' + i;
+}
+
+function verify(obj, rounds) {
+    var r, i, k;
+    var mismatches = 0;
+
+    for (r = 0; r < rounds; r++) {
+        for (i = 0; i < COUNT; i++) {
+            // A freshly created string must intern to the same string as
+            // the property key (if still alive) regardless of which table
+            // it currently lives in.
+            k = key(r, i);
+            if (i % 3 === 0) {
+                if (!(k in obj) || obj[k] !== i) {
+                    mismatches++;
+                }
+            } else {
+                if (k in obj) {
+                    mismatches++;
+                }
+            }
+        }
+    }
+    return mismatches;
+}
+
+function test() {
+    var obj = {};
+    var round, i, k, tmp;
+
+    for (round = 0; round < ROUNDS; round++) {
+        for (i = 0; i < COUNT; i++) {
+            obj[key(round, i)] = i;
+
+            // Temporary strings which are freed right away.
+            tmp = 'tmp-' + round + '-' + i;
+            tmp = null;
+
+            // Lookups of earlier surviving keys, possibly still in the
+            // previous table.
+            if (i % 3 === 0 && round > 0) {
+                k = key(round - 1, i);
+                if (obj[k] !== i) {
+                    print('lookup failed:', k);
+                }
+            }
+
+            if (i % 2500 === 0) {
+                Duktape.gc();
+            }
+        }
+
+        // Free two thirds of this round's keys; the strings are freed
+        // while a migration may be in progress.
+        for (i = 0; i < COUNT; i++) {
+            if (i % 3 !== 0) {
+                delete obj[key(round, i)];
+            }
+        }
+        Duktape.gc();
+
+        print('round', round, 'keys', Object.keys(obj).length,
+              'mismatches', verify(obj, round + 1));
+    }
+
+    Duktape.gc();
+    print('final keys', Object.keys(obj).length, 'mismatches', verify(obj, ROUNDS));
+}
+
+try {
+    test();
+} catch (e) {
+    print(e);
+}
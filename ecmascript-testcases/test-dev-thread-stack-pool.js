@@ -0,0 +1,133 @@
+/*
+ *  Stacks of freed threads are pooled and reused by new threads.  Exercise
+ *  thread creation while other threads are alive, threads whose stacks grew
+ *  (and may or may not be pooled), threads terminated by an error, and
+ *  threads which are only reachable from the resume() call.
+ */
+
+/*===
+sequential 1000 499500
+interleaved 0,1,2,3,4,5,6,7,8,9,10,11 600
+deep 2000 0 2000 1
+error Error: thread 0 Error: thread 1 Error: thread 2
+try 10 10
+yield 45
+===*/
+
+function counter(n) {
+    var i;
+    for (i = 0; i < n; i++) {
+        Duktape.Thread.yield(i);
+    }
+    return n;
+}
+
+function sequentialTest() {
+    var i, sum = 0;
+    for (i = 0; i < 1000; i++) {
+        var t = new Duktape.Thread(function (v) {
+            return v;
+        });
+        sum += Duktape.Thread.resume(t, i);
+    }
+    print('sequential', i, sum);
+}
+
+function interleavedTest() {
+    // Keep a set of threads alive while others are created and dropped.
+    var live = [];
+    var firsts = [];
+    var i, sum = 0;
+
+    for (i = 0; i < 12; i++) {
+        live.push(new Duktape.Thread(counter));
+        firsts.push(i);
+    }
+    for (i = 0; i < 12; i++) {
+        Duktape.Thread.resume(live[i], 100);
+    }
+    for (i = 0; i < 100; i++) {
+        // Short-lived thread, freed right away.
+        sum += Duktape.Thread.resume(new Duktape.Thread(function (v) { return v; }), 1);
+        live.forEach(function (t) {
+            Duktape.Thread.resume(t);
+        });
+        sum += 5;
+    }
+    print('interleaved', firsts.join(','), sum);
+}
+
+function deepTest() {
+    function rec(n) {
+        if (n <= 0) {
+            Duktape.Thread.yield(0);
+            return 0;
+        }
+        return 1 + rec(n - 1);
+    }
+    var t1 = new Duktape.Thread(rec);
+    var first = Duktape.Thread.resume(t1, 2000);  // yields at depth 2000
+    var t2 = new Duktape.Thread(function (v) { return v + 1; });
+    var res2 = Duktape.Thread.resume(t2, 0);
+    var res1 = Duktape.Thread.resume(t1);
+    t1 = null;
+    t2 = null;
+    print('deep', 2000, first, res1, res2);
+}
+
+function errorTest() {
+    var res = [];
+    var i;
+    for (i = 0; i < 3; i++) {
+        try {
+            Duktape.Thread.resume(new Duktape.Thread(function (v) {
+                throw new Error('thread ' + v);
+            }), i);
+        } catch (e) {
+            res.push(String(e));
+        }
+    }
+    print('error', res.join(' '));
+}
+
+function tryTest() {
+    // Catch stack use inside pooled threads.
+    var i, ok = 0, count = 0;
+    for (i = 0; i < 10; i++) {
+        ok += Duktape.Thread.resume(new Duktape.Thread(function (v) {
+            try {
+                try {
+                    throw v;
+                } finally {
+                    count++;
+                }
+            } catch (e) {
+                return e === v ? 1 : 0;
+            }
+        }), i);
+    }
+    print('try', ok, count);
+}
+
+function yieldTest() {
+    // Only reference to a yielded thread is dropped by the yield itself.
+    var i, sum = 0;
+    for (i = 0; i < 10; i++) {
+        sum += Duktape.Thread.resume(new Duktape.Thread(function (v) {
+            Duktape.Thread.yield(v);
+            return -1;
+        }), i);
+    }
+    print('yield', sum);
+}
+
+try {
+    sequentialTest();
+    interleavedTest();
+    deepTest();
+    errorTest();
+    tryTest();
+    yieldTest();
+} catch (e) {
+    print(e.stack || e);
+}
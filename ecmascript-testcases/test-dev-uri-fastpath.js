@@ -0,0 +1,167 @@
+/*
+ *  URI encode/decode and escape/unescape copy runs of characters needing
+ *  no transformation in one step.  Exercise run boundaries, inputs which
+ *  are copied entirely as is, and errors following a copied run.
+ */
+
+/*===
+encodeURI "" ""
+encodeURI "abc" "abc"
+encodeURI "q=hello world&lang=en-US#top" "q=hello%20world&lang=en-US#top"
+encodeURI "/path/to/file.html?x=1;y=2" "/path/to/file.html?x=1;y=2"
+encodeURI "a<00e4>b<20ac>c<d83d><de00>d" "a%C3%A4b%E2%82%ACc%F0%9F%98%80d"
+encodeURI "%41%42%43" "%2541%2542%2543"
+encodeURI "%" "%25"
+encodeURI "100%" "100%25"
+encodeURI "%u0041%E4%zz%4" "%25u0041%25E4%25zz%254"
+encodeURI "~!*()'-_." "~!*()'-_."
+encodeURI "\u0000\u001f<007f>" "%00%1F%7F"
+encodeURIComponent "" ""
+encodeURIComponent "abc" "abc"
+encodeURIComponent "q=hello world&lang=en-US#top" "q%3Dhello%20world%26lang%3Den-US%23top"
+encodeURIComponent "/path/to/file.html?x=1;y=2" "%2Fpath%2Fto%2Ffile.html%3Fx%3D1%3By%3D2"
+encodeURIComponent "a<00e4>b<20ac>c<d83d><de00>d" "a%C3%A4b%E2%82%ACc%F0%9F%98%80d"
+encodeURIComponent "%41%42%43" "%2541%2542%2543"
+encodeURIComponent "%" "%25"
+encodeURIComponent "100%" "100%25"
+encodeURIComponent "%u0041%E4%zz%4" "%25u0041%25E4%25zz%254"
+encodeURIComponent "~!*()'-_." "~!*()'-_."
+encodeURIComponent "\u0000\u001f<007f>" "%00%1F%7F"
+decodeURI "" ""
+decodeURI "abc" "abc"
+decodeURI "q=hello world&lang=en-US#top" "q=hello world&lang=en-US#top"
+decodeURI "/path/to/file.html?x=1;y=2" "/path/to/file.html?x=1;y=2"
+decodeURI "a<00e4>b<20ac>c<d83d><de00>d" "a<00e4>b<20ac>c<d83d><de00>d"
+decodeURI "%41%42%43" "ABC"
+decodeURI "%" URIError
+decodeURI "100%" URIError
+decodeURI "%u0041%E4%zz%4" URIError
+decodeURI "~!*()'-_." "~!*()'-_."
+decodeURI "\u0000\u001f<007f>" "\u0000\u001f<007f>"
+decodeURIComponent "" ""
+decodeURIComponent "abc" "abc"
+decodeURIComponent "q=hello world&lang=en-US#top" "q=hello world&lang=en-US#top"
+decodeURIComponent "/path/to/file.html?x=1;y=2" "/path/to/file.html?x=1;y=2"
+decodeURIComponent "a<00e4>b<20ac>c<d83d><de00>d" "a<00e4>b<20ac>c<d83d><de00>d"
+decodeURIComponent "%41%42%43" "ABC"
+decodeURIComponent "%" URIError
+decodeURIComponent "100%" URIError
+decodeURIComponent "%u0041%E4%zz%4" URIError
+decodeURIComponent "~!*()'-_." "~!*()'-_."
+decodeURIComponent "\u0000\u001f<007f>" "\u0000\u001f<007f>"
+escape "" ""
+escape "abc" "abc"
+escape "q=hello world&lang=en-US#top" "q%3Dhello%20world%26lang%3Den-US%23top"
+escape "/path/to/file.html?x=1;y=2" "/path/to/file.html%3Fx%3D1%3By%3D2"
+escape "a<00e4>b<20ac>c<d83d><de00>d" "a%E4b%u20ACc%uD83D%uDE00d"
+escape "%41%42%43" "%2541%2542%2543"
+escape "%" "%25"
+escape "100%" "100%25"
+escape "%u0041%E4%zz%4" "%25u0041%25E4%25zz%254"
+escape "~!*()'-_." "%7E%21*%28%29%27-_."
+escape "\u0000\u001f<007f>" "%00%1F%7F"
+unescape "" ""
+unescape "abc" "abc"
+unescape "q=hello world&lang=en-US#top" "q=hello world&lang=en-US#top"
+unescape "/path/to/file.html?x=1;y=2" "/path/to/file.html?x=1;y=2"
+unescape "a<00e4>b<20ac>c<d83d><de00>d" "a<00e4>b<20ac>c<d83d><de00>d"
+unescape "%41%42%43" "ABC"
+unescape "%" "%"
+unescape "100%" "100%"
+unescape "%u0041%E4%zz%4" "A<00e4>%zz%4"
+unescape "~!*()'-_." "~!*()'-_."
+unescape "\u0000\u001f<007f>" "\u0000\u001f<007f>"
+true true true
+true true true
+URIError
+URIError
+URIError
+URIError
+URIError
+URIError
+URIError
+URIError
+URIError
+true
+===*/
+
+function safePrint() {
+    var args = Array.prototype.map.call(arguments, function (x) {
+        return String(x).replace(/[\u0000-\u001f\u007f-\uffff]/g, function (c) {
+            return '<' + ('0000' + c.charCodeAt(0).toString(16)).substr(-4) + '>';
+        });
+    });
+    print(args.join(' '));
+}
+
+var inputs = [
+    '',
+    'abc',
+    'q=hello world&lang=en-US#top',
+    '/path/to/file.html?x=1;y=2',
+    'a\u00e4b\u20acc\ud83d\ude00d',
+    '%41%42%43',
+    '%',
+    '100%',
+    '%u0041%E4%zz%4',
+    '~!*()\'-_.',
+    '\u0000\u001f\u007f'
+];
+
+function test(name, fn) {
+    inputs.forEach(function (v) {
+        try {
+            safePrint(name, JSON.stringify(v), JSON.stringify(fn(v)));
+        } catch (e) {
+            safePrint(name, JSON.stringify(v), e.name);
+        }
+    });
+}
+
+function identityTest() {
+    var s = 'abcdefghijklmnopqrstuvwxyz0123456789';
+    print(encodeURIComponent(s) === s, encodeURI(s) === s, escape(s) === s);
+    print(decodeURIComponent(s) === s, decodeURI(s) === s, unescape(s) === s);
+}
+
+function errorTest() {
+    [ 'abcdef\ud800', 'abcdef\udc00xyz', 'abcdef\ud800x' ].forEach(function (v) {
+        try {
+            print(encodeURIComponent(v));
+        } catch (e) {
+            print(e.name);
+        }
+    });
+    [ 'abcdef%', 'abcdef%4', 'abcdef%zz', 'abcdef%C3', 'abcdef%C3%28', 'abcdef%ED%A0%80' ].forEach(function (v) {
+        try {
+            print(decodeURIComponent(v));
+        } catch (e) {
+            print(e.name);
+        }
+    });
+}
+
+function roundTripTest() {
+    var i, s = '', ok = true;
+    for (i = 0; i < 0xd800; i += 37) {
+        s += 'xy' + String.fromCharCode(i) + 'z';
+    }
+    ok = ok && (decodeURIComponent(encodeURIComponent(s)) === s);
+    ok = ok && (decodeURI(encodeURI(s)) === s);
+    ok = ok && (unescape(escape(s)) === s);
+    print(ok);
+}
+
+try {
+    test('encodeURI', encodeURI);
+    test('encodeURIComponent', encodeURIComponent);
+    test('decodeURI', decodeURI);
+    test('decodeURIComponent', decodeURIComponent);
+    test('escape', escape);
+    test('unescape', unescape);
+    identityTest();
+    errorTest();
+    roundTripTest();
+} catch (e) {
+    print(e);
+}
@@ -0,0 +1,261 @@
+/*
+ *  Example process wide, refcounted, read-only store for external string
+ *  data shared by multiple Duktape heaps.
+ *
+ *  Duktape calls DUK_OPT_EXTSTR_INTERN_CHECK() when interning a new string
+ *  and DUK_OPT_EXTSTR_FREE() when an external string is freed; each non-NULL
+ *  intern check result is paired with exactly one free call.  This store
+ *  keeps one copy of each string it accepts and a reference count which is
+ *  incremented by the intern check hook and decremented by the free hook,
+ *  so that identical large strings (script sources, JSON templates, etc)
+ *  interned in many heaps are stored only once.
+ *
+ *  The hooks may be called from any thread running a heap, so the store is
+ *  protected by a mutex.  Heaps themselves are not affected: each heap is
+ *  still used from one native thread at a time.
+ */
+
+#include "duktape.h"
+#include "duk_extstr_shared.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <pthread.h>
+
+/* Define to enable some debug printfs. */
+/* #define DUK_EXTSTR_SHARED_DEBUG */
+
+typedef struct extstr_entry extstr_entry;
+struct extstr_entry {
+	extstr_entry *next;
+	duk_size_t len;
+	unsigned long refcount;
+	duk_uint32_t hash;
+	unsigned char data[1];  /* 'len' bytes followed by a NUL */
+};
+
+typedef struct {
+	pthread_mutex_t mutex;
+	extstr_entry **buckets;
+	duk_size_t num_buckets;
+	duk_size_t num_entries;
+	duk_size_t min_len;        /* strings this long or longer are shared automatically */
+	duk_size_t preload_min_len;  /* shortest preloaded string, read-only once heaps exist */
+	unsigned long hits;
+	unsigned long misses;
+	unsigned long hit_bytes;     /* bytes not duplicated thanks to sharing */
+} extstr_store;
+
+#define INITIAL_BUCKETS  256
+
+static extstr_store store;
+static int store_initialized = 0;
+
+#define ENTRY_FROM_DATA(ptr) \
+	((extstr_entry *) (void *) ((unsigned char *) (ptr) - offsetof(extstr_entry, data)))
+
+static duk_uint32_t hash_data(const unsigned char *p, duk_size_t len) {
+	/* FNV-1a */
+	duk_uint32_t h = 2166136261UL;
+	duk_size_t i;
+
+	for (i = 0; i < len; i++) {
+		h ^= (duk_uint32_t) p[i];
+		h *= 16777619UL;
+	}
+	return h;
+}
+
+static void grow_buckets(void) {
+	extstr_entry **new_buckets;
+	extstr_entry *e, *next;
+	duk_size_t new_size;
+	duk_size_t i;
+
+	new_size = store.num_buckets * 2;
+	new_buckets = (extstr_entry **) calloc(new_size, sizeof(extstr_entry *));
+	if (!new_buckets) {
+		return;  /* keep using the current buckets, just slower */
+	}
+	for (i = 0; i < store.num_buckets; i++) {
+		for (e = store.buckets[i]; e != NULL; e = next) {
+			next = e->next;
+			e->next = new_buckets[e->hash % new_size];
+			new_buckets[e->hash % new_size] = e;
+		}
+	}
+	free(store.buckets);
+	store.buckets = new_buckets;
+	store.num_buckets = new_size;
+}
+
+/* Find an entry, optionally creating one.  Caller holds the mutex. */
+static extstr_entry *lookup_entry(const unsigned char *p, duk_size_t len, int create) {
+	extstr_entry *e;
+	duk_uint32_t h;
+
+	h = hash_data(p, len);
+	for (e = store.buckets[h % store.num_buckets]; e != NULL; e = e->next) {
+		if (e->hash == h && e->len == len && memcmp((const void *) e->data, (const void *) p, len) == 0) {
+			return e;
+		}
+	}
+	if (!create) {
+		return NULL;
+	}
+
+	e = (extstr_entry *) malloc(sizeof(extstr_entry) + len);
+	if (!e) {
+		return NULL;
+	}
+	memcpy((void *) e->data, (const void *) p, len);
+	e->data[len] = (unsigned char) 0;
+	e->len = len;
+	e->hash = h;
+	e->refcount = 0;
+	e->next = store.buckets[h % store.num_buckets];
+	store.buckets[h % store.num_buckets] = e;
+	store.num_entries++;
+
+	if (store.num_entries > store.num_buckets * 2) {
+		grow_buckets();
+	}
+	return e;
+}
+
+static void unlink_entry(extstr_entry *e) {
+	extstr_entry **prev;
+
+	for (prev = &store.buckets[e->hash % store.num_buckets]; *prev != NULL; prev = &(*prev)->next) {
+		if (*prev == e) {
+			*prev = e->next;
+			store.num_entries--;
+			return;
+		}
+	}
+}
+
+int duk_extstr_shared_init(duk_size_t min_len) {
+	if (store_initialized) {
+		return 0;
+	}
+	memset((void *) &store, 0, sizeof(store));
+	store.buckets = (extstr_entry **) calloc(INITIAL_BUCKETS, sizeof(extstr_entry *));
+	if (!store.buckets) {
+		return -1;
+	}
+	if (pthread_mutex_init(&store.mutex, NULL) != 0) {
+		free(store.buckets);
+		return -1;
+	}
+	store.num_buckets = INITIAL_BUCKETS;
+	store.min_len = min_len;
+	store.preload_min_len = min_len;
+	store_initialized = 1;
+	return 0;
+}
+
+void duk_extstr_shared_deinit(void) {
+	extstr_entry *e, *next;
+	duk_size_t i;
+
+	if (!store_initialized) {
+		return;
+	}
+
+	/* All heaps must have been destroyed by now; only preloaded
+	 * strings may remain.
+	 */
+	for (i = 0; i < store.num_buckets; i++) {
+		for (e = store.buckets[i]; e != NULL; e = next) {
+			next = e->next;
+			free((void *) e);
+		}
+	}
+	free(store.buckets);
+	pthread_mutex_destroy(&store.mutex);
+	store_initialized = 0;
+}
+
+/* Must be called before creating any heaps which use the hooks: the intern
+ * check hook reads 'preload_min_len' without taking the lock, which is only
+ * safe if the value no longer changes once the hooks may run.
+ */
+const void *duk_extstr_shared_preload(const void *data, duk_size_t len) {
+	extstr_entry *e;
+
+	pthread_mutex_lock(&store.mutex);
+	e = lookup_entry((const unsigned char *) data, len, 1 /*create*/);
+	if (e) {
+		e->refcount++;  /* pinned until deinit */
+		if (len < store.preload_min_len) {
+			store.preload_min_len = len;
+		}
+	}
+	pthread_mutex_unlock(&store.mutex);
+
+	return e ? (const void *) e->data : NULL;
+}
+
+void *duk_extstr_shared_intern_check(void *udata, void *ptr, duk_size_t len) {
+	extstr_entry *e;
+
+	(void) udata;
+
+	/* Cheap rejection without taking the lock: short strings are common
+	 * and external data wouldn't save memory for them anyway.  Reading
+	 * 'preload_min_len' unlocked is safe because it is only written by
+	 * duk_extstr_shared_init() and duk_extstr_shared_preload() before any
+	 * heap exists (and thus before any thread calls this hook).
+	 */
+	if (len < store.preload_min_len || len < 4) {
+		return NULL;
+	}
+
+	pthread_mutex_lock(&store.mutex);
+	e = lookup_entry((const unsigned char *) ptr, len, len >= store.min_len /*create*/);
+	if (e) {
+		if (e->refcount > 0) {
+			store.hits++;
+			store.hit_bytes += (unsigned long) len;
+		} else {
+			store.misses++;
+		}
+		e->refcount++;
+#if defined(DUK_EXTSTR_SHARED_DEBUG)
+		printf("extstr_shared: intern %p, len %ld, refcount %ld\n",
+		       (void *) e->data, (long) len, (long) e->refcount);
+#endif
+	}
+	pthread_mutex_unlock(&store.mutex);
+
+	return e ? (void *) e->data : NULL;
+}
+
+void duk_extstr_shared_free(void *udata, const void *ptr) {
+	extstr_entry *e;
+
+	(void) udata;
+
+	e = ENTRY_FROM_DATA(ptr);
+
+	pthread_mutex_lock(&store.mutex);
+#if defined(DUK_EXTSTR_SHARED_DEBUG)
+	printf("extstr_shared: free %p, len %ld, refcount %ld\n",
+	       (void *) e->data, (long) e->len, (long) e->refcount);
+#endif
+	if (--e->refcount == 0) {
+		unlink_entry(e);
+		free((void *) e);
+	}
+	pthread_mutex_unlock(&store.mutex);
+}
+
+void duk_extstr_shared_dump(void) {
+	pthread_mutex_lock(&store.mutex);
+	printf("extstr_shared: %ld strings, %ld hits (%ld bytes not duplicated), %ld misses\n",
+	       (long) store.num_entries, (long) store.hits, (long) store.hit_bytes,
+	       (long) store.misses);
+	pthread_mutex_unlock(&store.mutex);
+}
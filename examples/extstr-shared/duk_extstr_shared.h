@@ -0,0 +1,13 @@
+#ifndef DUK_EXTSTR_SHARED_H_INCLUDED
+#define DUK_EXTSTR_SHARED_H_INCLUDED
+
+#include "duktape.h"
+
+int duk_extstr_shared_init(duk_size_t min_len);
+void duk_extstr_shared_deinit(void);
+const void *duk_extstr_shared_preload(const void *data, duk_size_t len);
+void *duk_extstr_shared_intern_check(void *udata, void *ptr, duk_size_t len);
+void duk_extstr_shared_free(void *udata, const void *ptr);
+void duk_extstr_shared_dump(void);
+
+#endif  /* DUK_EXTSTR_SHARED_H_INCLUDED */
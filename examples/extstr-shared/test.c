@@ -0,0 +1,62 @@
+/*
+ *  Run the same script in several heaps, each in its own native thread,
+ *  with large strings shared through the external string store.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include "duktape.h"
+#include "duk_extstr_shared.h"
+
+#define NUM_HEAPS  8
+
+static const char *script =
+	"var template = JSON.stringify({ description: 'A long constant string which is "
+	"interned by every heap running this script, and which is therefore a good "
+	"candidate for sharing between heaps.', items: [ 1, 2, 3 ] });\n"
+	"var res = 0;\n"
+	"for (var i = 0; i < 1000; i++) { res += JSON.parse(template).items[i % 3]; }\n"
+	"res;";
+
+static void *run_heap(void *arg) {
+	duk_context *ctx;
+
+	ctx = duk_create_heap_default();
+	if (!ctx) {
+		return NULL;
+	}
+	duk_eval_string(ctx, script);
+	printf("heap %d: result %s\n", (int) (long) arg, duk_to_string(ctx, -1));
+	duk_destroy_heap(ctx);
+	return NULL;
+}
+
+int main(int argc, char *argv[]) {
+	pthread_t threads[NUM_HEAPS];
+	long i;
+
+	(void) argc; (void) argv;
+
+	if (duk_extstr_shared_init(64 /*min_len*/) != 0) {
+		return 1;
+	}
+
+	/* The script source itself is a constant; preload it so that all
+	 * heaps share it regardless of the length threshold.
+	 */
+	(void) duk_extstr_shared_preload((const void *) script, strlen(script));
+
+	for (i = 0; i < NUM_HEAPS; i++) {
+		if (pthread_create(&threads[i], NULL, run_heap, (void *) i) != 0) {
+			return 1;
+		}
+	}
+	for (i = 0; i < NUM_HEAPS; i++) {
+		pthread_join(threads[i], NULL);
+	}
+
+	duk_extstr_shared_dump();
+	duk_extstr_shared_deinit();
+	return 0;
+}
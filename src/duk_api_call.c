@@ -318,6 +318,17 @@ DUK_EXTERNAL void duk_new(duk_context *ctx, duk_idx_t nargs) {
 
 	duk_push_object(ctx);  /* class Object, extensible */
 
+	/* If earlier instances of this constructor ended up with properties,
+	 * allocate the entry part at that size right away to avoid growing
+	 * it step by step while the constructor runs.
+	 */
+	if (DUK_HOBJECT_IS_COMPILEDFUNCTION(cons) &&
+	    ((duk_hcompiledfunction *) cons)->ctor_esize > 0) {
+		duk_hobject_resize_entrypart(thr,
+		                             duk_get_hobject(ctx, -1),
+		                             (duk_uint32_t) ((duk_hcompiledfunction *) cons)->ctor_esize);
+	}
+
 	/* [... constructor arg1 ... argN final_cons fallback] */
 
 	duk_get_prop_stridx(ctx, -2, DUK_STRIDX_PROTOTYPE);
@@ -345,17 +356,18 @@ DUK_EXTERNAL void duk_new(duk_context *ctx, duk_idx_t nargs) {
 	duk_insert(ctx, idx_cons);      /* also stash it before constructor,
 	                                 * in case we need it (as the fallback value)
 	                                 */
-	duk_pop(ctx);                   /* pop final_cons */
-
+	duk_insert(ctx, idx_cons);      /* keep final_cons reachable for recording
+	                                 * allocation site feedback
+	                                 */
 
-	/* [... fallback constructor fallback(this) arg1 ... argN];
-	 * Note: idx_cons points to first 'fallback', not 'constructor'.
+	/* [... final_cons fallback constructor fallback(this) arg1 ... argN];
+	 * Note: idx_cons points to 'final_cons', not 'constructor'.
 	 */
 
-	DUK_DDD(DUK_DDDPRINT("before call, idx_cons+1 (constructor) -> %!T, idx_cons+2 (fallback/this) -> %!T, "
+	DUK_DDD(DUK_DDDPRINT("before call, idx_cons+2 (constructor) -> %!T, idx_cons+3 (fallback/this) -> %!T, "
 	                     "nargs=%ld, top=%ld",
-	                     (duk_tval *) duk_get_tval(ctx, idx_cons + 1),
 	                     (duk_tval *) duk_get_tval(ctx, idx_cons + 2),
+	                     (duk_tval *) duk_get_tval(ctx, idx_cons + 3),
 	                     (long) nargs,
 	                     (long) duk_get_top(ctx)));
 
@@ -370,7 +382,7 @@ DUK_EXTERNAL void duk_new(duk_context *ctx, duk_idx_t nargs) {
 	                     call_flags);   /* call_flags */
 	DUK_UNREF(rc);
 
-	/* [... fallback retval] */
+	/* [... final_cons fallback retval] */
 
 	DUK_DDD(DUK_DDDPRINT("constructor call finished, rc=%ld, fallback=%!iT, retval=%!iT",
 	                     (long) rc,
@@ -379,14 +391,35 @@ DUK_EXTERNAL void duk_new(duk_context *ctx, duk_idx_t nargs) {
 
 	/*
 	 *  Determine whether to use the constructor return value as the created
-	 *  object instance or not.
+	 *  object instance or not.  Record the property count of the instance
+	 *  for sizing later instances; deleted entries are included which is
+	 *  fine for a hint.  When the constructor returns a replacement object,
+	 *  the discarded fallback says nothing about instances actually used,
+	 *  so the hint is reset.
 	 */
 
+	cons = duk_get_hobject(ctx, -3);
+	DUK_ASSERT(cons != NULL);
 	if (duk_is_object(ctx, -1)) {
+		if (DUK_HOBJECT_IS_COMPILEDFUNCTION(cons)) {
+			((duk_hcompiledfunction *) cons)->ctor_esize = 0;
+		}
 		duk_remove(ctx, -2);
 	} else {
+		if (DUK_HOBJECT_IS_COMPILEDFUNCTION(cons)) {
+			duk_uint32_t esize;
+
+			fallback = duk_get_hobject(ctx, -2);
+			DUK_ASSERT(fallback != NULL);
+			esize = DUK_HOBJECT_GET_ENEXT(fallback);
+			if (esize > DUK_HCOMPILEDFUNCTION_MAX_CTOR_ESIZE) {
+				esize = DUK_HCOMPILEDFUNCTION_MAX_CTOR_ESIZE;
+			}
+			((duk_hcompiledfunction *) cons)->ctor_esize = (duk_uint16_t) esize;
+		}
 		duk_pop(ctx);
 	}
+	duk_remove(ctx, -2);
 
 	/*
 	 *  Augment created errors upon creation (not when they are thrown or
@@ -406,6 +439,78 @@ DUK_EXTERNAL void duk_new(duk_context *ctx, duk_idx_t nargs) {
 	DUK_ERROR(thr, DUK_ERR_TYPE_ERROR, DUK_STR_NOT_CONSTRUCTABLE);
 }
 
+/*
+ *  Native coroutine control.
+ *
+ *  Resuming is handled by the bytecode executor, which requires the resumer
+ *  to be an Ecmascript function calling Duktape.Thread.resume(): the resumer
+ *  continues executing bytecode when the resumee yields or finishes.  To
+ *  resume from C, duk_resume() calls a small Ecmascript trampoline which
+ *  performs the actual resume.  The trampoline is compiled on first use and
+ *  cached in the heap.  It gets the resume function through a closure so
+ *  that it doesn't depend on the (writable) Duktape global.
+ */
+
+DUK_LOCAL void duk__push_resume_func(duk_context *ctx) {
+	duk_hthread *thr = (duk_hthread *) ctx;
+	duk_hobject *h;
+
+	if (thr->heap->resume_func != NULL) {
+		duk_push_hobject(ctx, thr->heap->resume_func);
+		return;
+	}
+
+	/* The resume() call must not be a tail call: the trampoline activation
+	 * must remain on the call stack as the resumer.
+	 */
+	duk_compile_string(ctx,
+	                   DUK_COMPILE_FUNCTION | DUK_COMPILE_STRICT,
+	                   "function (resume) {"
+	                   "return function (t, v, e) { var res = resume(t, v, e); return res; };"
+	                   "}");
+	duk_push_c_function(ctx, duk_bi_thread_resume, 3);
+	duk_call(ctx, 1);
+
+	h = duk_require_hobject(ctx, -1);
+	DUK_ASSERT(DUK_HOBJECT_IS_COMPILEDFUNCTION(h));
+	thr->heap->resume_func = h;
+	DUK_HOBJECT_INCREF(thr, h);
+}
+
+DUK_EXTERNAL duk_bool_t duk_resume(duk_context *ctx, duk_idx_t thread_index, duk_bool_t is_error) {
+	duk_hthread *thr_resume;
+
+	DUK_ASSERT_CTX_VALID(ctx);
+
+	thread_index = duk_require_normalize_index(ctx, thread_index);
+	thr_resume = duk_require_hthread(ctx, thread_index);
+	(void) duk_require_valid_index(ctx, -1);
+
+	/* [ ... thread ... value ] */
+
+	duk__push_resume_func(ctx);
+	duk_dup(ctx, thread_index);
+	duk_dup(ctx, -3);
+	duk_push_boolean(ctx, is_error);
+	duk_call(ctx, 3);
+
+	/* [ ... thread ... value result ] */
+
+	duk_remove(ctx, -2);
+
+	/* The thread is still reachable through 'thread_index'. */
+	DUK_ASSERT(thr_resume->state == DUK_HTHREAD_STATE_YIELDED ||
+	           thr_resume->state == DUK_HTHREAD_STATE_TERMINATED);
+	return (thr_resume->state == DUK_HTHREAD_STATE_YIELDED);
+}
+
+DUK_EXTERNAL void duk_yield(duk_context *ctx) {
+	DUK_ASSERT_CTX_VALID(ctx);
+
+	duk_bi_thread_yield_helper(ctx, 0 /*is_error*/);
+	DUK_UNREACHABLE();
+}
+
 DUK_EXTERNAL duk_bool_t duk_is_constructor_call(duk_context *ctx) {
 	duk_hthread *thr = (duk_hthread *) ctx;
 	duk_activation *act;
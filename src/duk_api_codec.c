@@ -6,6 +6,114 @@
 
 #include "duk_internal.h"
 
+#if defined(DUK_USE_BASE64_FASTPATH)
+DUK_LOCAL const duk_uint8_t duk__base64_enctab[64] = {
+	'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H',
+	'I', 'J', 'K', 'L', 'M', 'N', 'O', 'P',
+	'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X',
+	'Y', 'Z', 'a', 'b', 'c', 'd', 'e', 'f',
+	'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n',
+	'o', 'p', 'q', 'r', 's', 't', 'u', 'v',
+	'w', 'x', 'y', 'z', '0', '1', '2', '3',
+	'4', '5', '6', '7', '8', '9', '+', '/'
+};
+
+/* Decode table: 0-63 for base64 characters, -1 for invalid characters,
+ * -2 for allowed whitespace, -3 for padding ('=').
+ */
+DUK_LOCAL const duk_int8_t duk__base64_dectab[256] = {
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -2, -2, -1, -1, -2, -1, -1,  /* 0x00-0x0f */
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  /* 0x10-0x1f */
+	-2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 62, -1, -1, -1, 63,  /* 0x20-0x2f */
+	52, 53, 54, 55, 56, 57, 58, 59, 60, 61, -1, -1, -1, -3, -1, -1,  /* 0x30-0x3f */
+	-1,  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14,  /* 0x40-0x4f */
+	15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, -1, -1, -1, -1, -1,  /* 0x50-0x5f */
+	-1, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40,  /* 0x60-0x6f */
+	41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, -1, -1, -1, -1, -1,  /* 0x70-0x7f */
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  /* 0x80-0x8f */
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  /* 0x90-0x9f */
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  /* 0xa0-0xaf */
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  /* 0xb0-0xbf */
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  /* 0xc0-0xcf */
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  /* 0xd0-0xdf */
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  /* 0xe0-0xef */
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1   /* 0xf0-0xff */
+};
+#define DUK__BASE64_DEC_WHITESPACE  (-2)
+#define DUK__BASE64_DEC_PADDING     (-3)
+#endif  /* DUK_USE_BASE64_FASTPATH */
+
+#if defined(DUK_USE_BASE64_FASTPATH)
+DUK_LOCAL void duk__base64_encode_fast_3(const duk_uint8_t *src, duk_uint8_t *dst) {
+	duk_uint_t t;
+
+	t = (duk_uint_t) src[0];
+	t = (t << 8) + (duk_uint_t) src[1];
+	t = (t << 8) + (duk_uint_t) src[2];
+
+	dst[0] = duk__base64_enctab[t >> 18];
+	dst[1] = duk__base64_enctab[(t >> 12) & 0x3fU];
+	dst[2] = duk__base64_enctab[(t >> 6) & 0x3fU];
+	dst[3] = duk__base64_enctab[t & 0x3fU];
+}
+
+/* dst length must be exactly ceil(len/3)*4 */
+DUK_LOCAL void duk__base64_encode_helper(const duk_uint8_t *src, const duk_uint8_t *src_end,
+                                         duk_uint8_t *dst, duk_uint8_t *dst_end) {
+	duk_size_t n;
+	duk_uint_t t;
+
+	DUK_UNREF(dst_end);
+
+	/* Full 3-byte groups, four groups per round. */
+	n = (duk_size_t) (src_end - src) / 3;
+	while (n >= 4) {
+		duk__base64_encode_fast_3(src, dst);
+		duk__base64_encode_fast_3(src + 3, dst + 4);
+		duk__base64_encode_fast_3(src + 6, dst + 8);
+		duk__base64_encode_fast_3(src + 9, dst + 12);
+		src += 12;
+		dst += 16;
+		n -= 4;
+	}
+	while (n > 0) {
+		duk__base64_encode_fast_3(src, dst);
+		src += 3;
+		dst += 4;
+		n--;
+	}
+
+	/* Final partial group, if any:
+	 *
+	 *  Missing bytes    base64 example
+	 *    1                XXX=
+	 *    2                XX==
+	 */
+	switch (src_end - src) {
+	case 1:
+		t = (duk_uint_t) src[0];
+		dst[0] = duk__base64_enctab[t >> 2];
+		dst[1] = duk__base64_enctab[(t << 4) & 0x3fU];
+		dst[2] = (duk_uint8_t) '=';
+		dst[3] = (duk_uint8_t) '=';
+		dst += 4;
+		break;
+	case 2:
+		t = ((duk_uint_t) src[0] << 8) + (duk_uint_t) src[1];
+		dst[0] = duk__base64_enctab[t >> 10];
+		dst[1] = duk__base64_enctab[(t >> 4) & 0x3fU];
+		dst[2] = duk__base64_enctab[(t << 2) & 0x3fU];
+		dst[3] = (duk_uint8_t) '=';
+		dst += 4;
+		break;
+	default:
+		DUK_ASSERT(src == src_end);
+		break;
+	}
+
+	DUK_ASSERT(dst == dst_end);
+}
+#else  /* DUK_USE_BASE64_FASTPATH */
 /* dst length must be exactly ceil(len/3)*4 */
 DUK_LOCAL void duk__base64_encode_helper(const duk_uint8_t *src, const duk_uint8_t *src_end,
                                          duk_uint8_t *dst, duk_uint8_t *dst_end) {
@@ -64,6 +172,106 @@ DUK_LOCAL void duk__base64_encode_helper(const duk_uint8_t *src, const duk_uint8
 	}
 }
 
+#endif  /* DUK_USE_BASE64_FASTPATH */
+
+#if defined(DUK_USE_BASE64_FASTPATH)
+DUK_LOCAL duk_bool_t duk__base64_decode_helper(const duk_uint8_t *src, const duk_uint8_t *src_end,
+                                               duk_uint8_t *dst, duk_uint8_t *dst_end, duk_uint8_t **out_dst_final) {
+	duk_uint_fast32_t t;
+	duk_int_t a, b, c, d;
+	duk_small_int_t x;
+	duk_small_uint_t group_idx;
+
+	DUK_UNREF(dst_end);
+
+	t = 0;
+	group_idx = 0;
+
+	for (;;) {
+		/* Fast path for full groups of four base64 characters without
+		 * whitespace or padding.  Anything else, including the end of
+		 * input, is handled one character at a time below.
+		 */
+		if (group_idx == 0) {
+			while (src_end - src >= 4) {
+				a = (duk_int_t) duk__base64_dectab[src[0]];
+				b = (duk_int_t) duk__base64_dectab[src[1]];
+				c = (duk_int_t) duk__base64_dectab[src[2]];
+				d = (duk_int_t) duk__base64_dectab[src[3]];
+				if ((a | b | c | d) < 0) {
+					break;
+				}
+				t = ((duk_uint_fast32_t) a << 18) |
+				    ((duk_uint_fast32_t) b << 12) |
+				    ((duk_uint_fast32_t) c << 6) |
+				    (duk_uint_fast32_t) d;
+				DUK_ASSERT(dst + 3 <= dst_end);
+				dst[0] = (duk_uint8_t) ((t >> 16) & 0xff);
+				dst[1] = (duk_uint8_t) ((t >> 8) & 0xff);
+				dst[2] = (duk_uint8_t) (t & 0xff);
+				src += 4;
+				dst += 3;
+			}
+			t = 0;
+		}
+
+		if (src >= src_end) {
+			break;
+		}
+
+		x = (duk_small_int_t) duk__base64_dectab[*src++];
+		if (x >= 0) {
+			t = (t << 6) + (duk_uint_fast32_t) x;
+			if (group_idx == 3) {
+				/* output 3 bytes from 't' */
+				DUK_ASSERT(dst + 3 <= dst_end);
+				dst[0] = (duk_uint8_t) ((t >> 16) & 0xff);
+				dst[1] = (duk_uint8_t) ((t >> 8) & 0xff);
+				dst[2] = (duk_uint8_t) (t & 0xff);
+				dst += 3;
+				group_idx = 0;
+			} else {
+				group_idx++;
+			}
+		} else if (x == DUK__BASE64_DEC_PADDING) {
+			/* Same padding rules as in the slow path below. */
+			if (group_idx == 2) {
+				/* xx== -> 1 byte, t contains 12 bits, 4 on right are zero */
+				DUK_ASSERT(dst < dst_end);
+				*dst++ = (duk_uint8_t) ((t >> 4) & 0xff);
+				if (src >= src_end || *src++ != (duk_uint8_t) '=') {
+					goto error;
+				}
+			} else if (group_idx == 3) {
+				/* xxx= -> 2 bytes, t contains 18 bits, 2 on right are zero */
+				DUK_ASSERT(dst + 2 <= dst_end);
+				dst[0] = (duk_uint8_t) ((t >> 10) & 0xff);
+				dst[1] = (duk_uint8_t) ((t >> 2) & 0xff);
+				dst += 2;
+			} else {
+				goto error;
+			}
+			group_idx = 0;
+		} else if (x == DUK__BASE64_DEC_WHITESPACE) {
+			/* allow basic ASCII whitespace */
+			;
+		} else {
+			goto error;
+		}
+	}
+
+	if (group_idx != 0) {
+		/* unpadded base64 not accepted, see below */
+		goto error;
+	}
+
+	*out_dst_final = dst;
+	return 1;
+
+ error:
+	return 0;
+}
+#else  /* DUK_USE_BASE64_FASTPATH */
 DUK_LOCAL duk_bool_t duk__base64_decode_helper(const duk_uint8_t *src, const duk_uint8_t *src_end,
                                                duk_uint8_t *dst, duk_uint8_t *dst_end, duk_uint8_t **out_dst_final) {
 	duk_uint_fast32_t t;
@@ -163,6 +371,7 @@ DUK_LOCAL duk_bool_t duk__base64_decode_helper(const duk_uint8_t *src, const duk
  error:
 	return 0;
 }
+#endif  /* DUK_USE_BASE64_FASTPATH */
 
 /* Shared handling for encode/decode argument.  Fast path handling for
  * buffer and string values because they're the most common.  In particular,
@@ -179,7 +388,7 @@ DUK_LOCAL const duk_uint8_t *duk__prep_codec_arg(duk_context *ctx, duk_idx_t ind
 
 DUK_EXTERNAL const char *duk_base64_encode(duk_context *ctx, duk_idx_t index) {
 	duk_hthread *thr = (duk_hthread *) ctx;
-	duk_uint8_t *src;
+	const duk_uint8_t *src;
 	duk_size_t srclen;
 	duk_size_t dstlen;
 	duk_uint8_t *dst;
@@ -187,12 +396,9 @@ DUK_EXTERNAL const char *duk_base64_encode(duk_context *ctx, duk_idx_t index) {
 
 	DUK_ASSERT_CTX_VALID(ctx);
 
-	/* XXX: optimize for string inputs: no need to coerce to a buffer
-	 * which makes a copy of the input.
-	 */
-
+	/* String and buffer inputs are read directly without making a copy. */
 	index = duk_require_normalize_index(ctx, index);
-	src = (duk_uint8_t *) duk_to_buffer(ctx, index, &srclen);
+	src = duk__prep_codec_arg(ctx, index, &srclen);
 	/* Note: for srclen=0, src may be NULL */
 
 	/* Computation must not wrap; this limit works for 32-bit size_t:
@@ -204,10 +410,11 @@ DUK_EXTERNAL const char *duk_base64_encode(duk_context *ctx, duk_idx_t index) {
 		goto type_error;
 	}
 	dstlen = (srclen + 2) / 3 * 4;
-	dst = (duk_uint8_t *) duk_push_fixed_buffer(ctx, dstlen);
 
-	duk__base64_encode_helper((const duk_uint8_t *) src, (const duk_uint8_t *) (src + srclen),
-	                          dst, (dst + dstlen));
+	/* Fixed buffer, no zeroing because we'll fill all the data. */
+	dst = (duk_uint8_t *) duk_push_buffer_raw(ctx, dstlen, DUK_BUF_FLAG_NOZERO /*flags*/);
+
+	duk__base64_encode_helper(src, src + srclen, dst, dst + dstlen);
 
 	ret = duk_to_string(ctx, -1);
 	duk_replace(ctx, index);
@@ -229,12 +436,11 @@ DUK_EXTERNAL void duk_base64_decode(duk_context *ctx, duk_idx_t index) {
 
 	DUK_ASSERT_CTX_VALID(ctx);
 
-	/* XXX: optimize for buffer inputs: no need to coerce to a string
-	 * which causes an unnecessary interning.
+	/* String and buffer inputs are read directly, so that e.g. buffer
+	 * inputs don't cause an unnecessary string interning.
 	 */
-
 	index = duk_require_normalize_index(ctx, index);
-	src = (const duk_uint8_t *) duk_to_lstring(ctx, index, &srclen);
+	src = duk__prep_codec_arg(ctx, index, &srclen);
 
 	/* Computation must not wrap, only srclen + 3 is at risk of
 	 * wrapping because after that the number gets smaller.
@@ -245,17 +451,35 @@ DUK_EXTERNAL void duk_base64_decode(duk_context *ctx, duk_idx_t index) {
 		goto type_error;
 	}
 	dstlen = (srclen + 3) / 4 * 3;  /* upper limit */
-	dst = (duk_uint8_t *) duk_push_dynamic_buffer(ctx, dstlen);
+
+	/* The limit is exact for padded input without whitespace once the
+	 * padding characters are accounted for; the final resize is then
+	 * skipped.  Whitespace can only make the output shorter.
+	 */
+	if (srclen >= 4 && (srclen & 0x03U) == 0) {
+		if (src[srclen - 1] == (duk_uint8_t) '=') {
+			dstlen--;
+			if (src[srclen - 2] == (duk_uint8_t) '=') {
+				dstlen--;
+			}
+		}
+	}
+
+	/* No zeroing: the buffer is either filled exactly or resized snugly
+	 * (which leaves no spare area), or an error is thrown.
+	 */
+	dst = (duk_uint8_t *) duk_push_buffer_raw(ctx, dstlen, DUK_BUF_FLAG_DYNAMIC | DUK_BUF_FLAG_NOZERO /*flags*/);
 	/* Note: for dstlen=0, dst may be NULL */
 
-	retval = duk__base64_decode_helper((const duk_uint8_t *) src, (const duk_uint8_t *) (src + srclen),
-	                                   dst, dst + dstlen, &dst_final);
+	retval = duk__base64_decode_helper(src, src + srclen, dst, dst + dstlen, &dst_final);
 	if (!retval) {
 		goto type_error;
 	}
 
 	/* XXX: convert to fixed buffer? */
-	(void) duk_resize_buffer(ctx, -1, (duk_size_t) (dst_final - dst));
+	if ((duk_size_t) (dst_final - dst) != dstlen) {
+		(void) duk_resize_buffer(ctx, -1, (duk_size_t) (dst_final - dst));
+	}
 	duk_replace(ctx, index);
 	return;
 
@@ -270,6 +494,10 @@ DUK_EXTERNAL const char *duk_hex_encode(duk_context *ctx, duk_idx_t index) {
 	duk_small_uint_t t;
 	duk_uint8_t *buf;
 	const char *ret;
+#if defined(DUK_USE_HEX_FASTPATH)
+	duk_size_t len_safe;
+	duk_uint16_t *p16;
+#endif
 
 	DUK_ASSERT_CTX_VALID(ctx);
 
@@ -281,11 +509,29 @@ DUK_EXTERNAL const char *duk_hex_encode(duk_context *ctx, duk_idx_t index) {
 	buf = (duk_uint8_t *) duk_push_buffer_raw(ctx, len * 2, DUK_BUF_FLAG_NOZERO /*flags*/);
 	DUK_ASSERT(buf != NULL);
 
-	for (i = 0; i < len; i++) {
-		/* XXX: by using two 256-entry tables could avoid shifting and masking. */
-		t = (duk_small_uint_t) inp[i];
-		buf[i*2 + 0] = duk_lc_digits[t >> 4];
-		buf[i*2 + 1] = duk_lc_digits[t & 0x0f];
+#if defined(DUK_USE_HEX_FASTPATH)
+	/* One 16-bit store per input byte; requires an aligned buffer. */
+	if (DUK_LIKELY((((duk_size_t) (void *) buf) & 0x01U) == 0)) {
+		p16 = (duk_uint16_t *) (void *) buf;
+		len_safe = len & ~((duk_size_t) 0x03U);
+		for (i = 0; i < len_safe; i += 4) {
+			p16[0] = duk_hex_enctab[inp[i]];
+			p16[1] = duk_hex_enctab[inp[i + 1]];
+			p16[2] = duk_hex_enctab[inp[i + 2]];
+			p16[3] = duk_hex_enctab[inp[i + 3]];
+			p16 += 4;
+		}
+		for (; i < len; i++) {
+			*p16++ = duk_hex_enctab[inp[i]];
+		}
+	} else
+#endif  /* DUK_USE_HEX_FASTPATH */
+	{
+		for (i = 0; i < len; i++) {
+			t = (duk_small_uint_t) inp[i];
+			buf[i*2 + 0] = duk_lc_digits[t >> 4];
+			buf[i*2 + 1] = duk_lc_digits[t & 0x0f];
+		}
 	}
 
 	/* XXX: Using a string return value forces a string intern which is
@@ -307,6 +553,11 @@ DUK_EXTERNAL void duk_hex_decode(duk_context *ctx, duk_idx_t index) {
 	duk_size_t i;
 	duk_small_int_t t;
 	duk_uint8_t *buf;
+#if defined(DUK_USE_HEX_FASTPATH)
+	duk_int_t chk;
+	duk_uint8_t *p;
+	duk_size_t len_safe;
+#endif
 
 	DUK_ASSERT_CTX_VALID(ctx);
 
@@ -322,6 +573,45 @@ DUK_EXTERNAL void duk_hex_decode(duk_context *ctx, duk_idx_t index) {
 	buf = (duk_uint8_t *) duk_push_buffer_raw(ctx, len / 2, DUK_BUF_FLAG_NOZERO /*flags*/);
 	DUK_ASSERT(buf != NULL);
 
+#if defined(DUK_USE_HEX_FASTPATH)
+	/* Four output bytes per round with a single validity check: an
+	 * invalid character makes the corresponding 't' negative and thus
+	 * 'chk' negative.  Bytes written before the check are harmless.
+	 */
+	p = buf;
+	len_safe = len & ~((duk_size_t) 0x07U);
+	for (i = 0; i < len_safe; i += 8) {
+		t = ((duk_small_int_t) duk_hex_dectab_shift4[inp[i]]) |
+		    ((duk_small_int_t) duk_hex_dectab[inp[i + 1]]);
+		chk = t;
+		p[0] = (duk_uint8_t) t;
+		t = ((duk_small_int_t) duk_hex_dectab_shift4[inp[i + 2]]) |
+		    ((duk_small_int_t) duk_hex_dectab[inp[i + 3]]);
+		chk |= t;
+		p[1] = (duk_uint8_t) t;
+		t = ((duk_small_int_t) duk_hex_dectab_shift4[inp[i + 4]]) |
+		    ((duk_small_int_t) duk_hex_dectab[inp[i + 5]]);
+		chk |= t;
+		p[2] = (duk_uint8_t) t;
+		t = ((duk_small_int_t) duk_hex_dectab_shift4[inp[i + 6]]) |
+		    ((duk_small_int_t) duk_hex_dectab[inp[i + 7]]);
+		chk |= t;
+		p[3] = (duk_uint8_t) t;
+		p += 4;
+
+		if (DUK_UNLIKELY(chk < 0)) {
+			goto type_error;
+		}
+	}
+	for (; i < len; i += 2) {
+		t = ((duk_small_int_t) duk_hex_dectab_shift4[inp[i]]) |
+		    ((duk_small_int_t) duk_hex_dectab[inp[i + 1]]);
+		if (DUK_UNLIKELY(t < 0)) {
+			goto type_error;
+		}
+		*p++ = (duk_uint8_t) t;
+	}
+#else  /* DUK_USE_HEX_FASTPATH */
 	for (i = 0; i < len; i += 2) {
 		/* For invalid characters the value -1 gets extended to
 		 * at least 16 bits.  If either nybble is invalid, the
@@ -334,6 +624,7 @@ DUK_EXTERNAL void duk_hex_decode(duk_context *ctx, duk_idx_t index) {
 		}
 		buf[i >> 1] = (duk_uint8_t) t;
 	}
+#endif  /* DUK_USE_HEX_FASTPATH */
 
 	duk_replace(ctx, index);
 	return;
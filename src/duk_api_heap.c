@@ -126,3 +126,22 @@ DUK_EXTERNAL void duk_set_global_object(duk_context *ctx) {
 
 	/* [ ... ] */
 }
+
+DUK_EXTERNAL void duk_clear_date_cache(duk_context *ctx) {
+	duk_hthread *thr = (duk_hthread *) ctx;
+
+	DUK_ASSERT_CTX_VALID(ctx);
+	DUK_ASSERT(thr != NULL);
+	DUK_ASSERT(thr->heap != NULL);
+
+#if defined(DUK_USE_DATE_CACHE)
+	/* Local time offsets are cached for ranges of time values assuming
+	 * the platform time zone doesn't change; forget everything cached
+	 * after the application has changed it.
+	 */
+	thr->heap->datecache.tzo_valid = 0;
+	thr->heap->datecache.day_valid = 0;
+#else
+	DUK_UNREF(thr);
+#endif
+}
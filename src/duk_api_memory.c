@@ -94,6 +94,10 @@ DUK_EXTERNAL void duk_gc(duk_context *ctx, duk_uint_t flags) {
 	DUK_ASSERT(heap != NULL);
 
 	DUK_D(DUK_DPRINT("mark-and-sweep requested by application"));
+#if defined(DUK_USE_REFZERO_BUDGET)
+	/* pending refzero objects are roots for mark-and-sweep, free them first */
+	(void) duk_heap_process_pending(thr, 0);
+#endif
 	duk_heap_mark_and_sweep(heap, 0);
 #else
 	DUK_D(DUK_DPRINT("mark-and-sweep requested by application but mark-and-sweep not enabled, ignoring"));
@@ -101,3 +105,22 @@ DUK_EXTERNAL void duk_gc(duk_context *ctx, duk_uint_t flags) {
 	DUK_UNREF(flags);
 #endif
 }
+
+DUK_EXTERNAL duk_bool_t duk_process_pending(duk_context *ctx, duk_int_t budget) {
+#ifdef DUK_USE_REFERENCE_COUNTING
+	duk_hthread *thr = (duk_hthread *) ctx;
+
+	/* NULL accepted */
+	if (!ctx) {
+		return 0;
+	}
+	DUK_ASSERT_CTX_VALID(ctx);
+
+	DUK_DD(DUK_DDPRINT("pending refzero processing requested by application, budget %ld", (long) budget));
+	return duk_heap_process_pending(thr, budget);
+#else
+	DUK_UNREF(ctx);
+	DUK_UNREF(budget);
+	return 0;
+#endif
+}
@@ -0,0 +1,840 @@
+/*
+ *  Serializing values into a flat, heap independent byte buffer and back.
+ *
+ *  The serialized form can be deserialized into a different Duktape heap,
+ *  which allows values to be moved between heaps (e.g. heaps owned by
+ *  different native threads) without going through JSON text.  Object
+ *  graphs are copied as is: shared references and reference loops are
+ *  preserved.
+ *
+ *  Format (all integers in network order):
+ *
+ *    buffer   = 0xbf version value
+ *    value    = tag [payload]
+ *    props    = u32 count, then 'count' times: key value
+ *    key      = 0x00 u32 (array index) | 0x01 u32 len, bytes (string)
+ *
+ *  Objects are numbered in the order they are first encountered; later
+ *  occurrences are encoded as references to that number.  Only enumerable
+ *  own properties are serialized and the prototype is not preserved: the
+ *  deserialized object gets the standard built-in prototype of its type.
+ *  Values which cannot be meaningfully copied between heaps (functions,
+ *  threads, pointers, Proxy objects, etc) cause a TypeError.
+ */
+
+#include "duk_internal.h"
+
+#define DUK__SER_MARKER                 0xbfU
+#define DUK__SER_VERSION                0x01U
+
+#define DUK__SER_TAG_UNDEFINED          0x00U
+#define DUK__SER_TAG_NULL               0x01U
+#define DUK__SER_TAG_FALSE              0x02U
+#define DUK__SER_TAG_TRUE               0x03U
+#define DUK__SER_TAG_INT32              0x04U  /* i32 */
+#define DUK__SER_TAG_NUMBER             0x05U  /* IEEE double */
+#define DUK__SER_TAG_STRING             0x06U  /* u32 len, bytes */
+#define DUK__SER_TAG_BUFFER             0x07U  /* u32 len, bytes */
+#define DUK__SER_TAG_DYNBUFFER          0x08U  /* u32 len, bytes */
+#define DUK__SER_TAG_REF                0x09U  /* u32 object number */
+#define DUK__SER_TAG_OBJECT             0x0aU  /* props */
+#define DUK__SER_TAG_ARRAY              0x0bU  /* u32 length, props */
+#define DUK__SER_TAG_DATE               0x0cU  /* IEEE double */
+#define DUK__SER_TAG_REGEXP             0x0dU  /* u32 len, bytes (source), u8 flags */
+#define DUK__SER_TAG_WRAPPER            0x0eU  /* value (boolean, number, or string) */
+#define DUK__SER_TAG_BUFFEROBJ          0x0fU  /* u8 class, u8 flags, u32 len, bytes */
+
+#define DUK__SER_KEY_INDEX              0x00U
+#define DUK__SER_KEY_STRING             0x01U
+
+#define DUK__SER_REGEXP_FLAG_GLOBAL     (1 << 0)
+#define DUK__SER_REGEXP_FLAG_IGNORECASE (1 << 1)
+#define DUK__SER_REGEXP_FLAG_MULTILINE  (1 << 2)
+
+#define DUK__SER_BUFOBJ_FLAG_NODEJS     (1 << 0)  /* Node.js Buffer (vs. Duktape.Buffer) */
+
+/* Value stack slots needed for one level of object recursion. */
+#define DUK__SER_VALSTACK_SPACE         8
+
+/* Object/array recursion limit (to protect C stack) */
+#define DUK__SER_RECURSION_LIMIT        DUK_JSON_ENC_RECURSION_LIMIT
+
+typedef struct {
+	duk_hthread *thr;
+	duk_hbuffer_dynamic *h_buf;
+	duk_idx_t idx_seen;         /* object: pointer -> object number */
+	duk_uint32_t num_objects;
+	duk_int_t recursion_depth;
+} duk__ser_enc_ctx;
+
+typedef struct {
+	duk_hthread *thr;
+	const duk_uint8_t *p;
+	const duk_uint8_t *p_end;
+	duk_idx_t idx_objects;      /* array: object number -> object */
+	duk_uint32_t num_objects;
+	duk_int_t recursion_depth;
+} duk__ser_dec_ctx;
+
+/* Element type specific information for typed arrays, indexed with
+ * DUK_HBUFFEROBJECT_ELEM_xxx.  Must match duk_bi_buffer.c.
+ */
+DUK_LOCAL const duk_uint8_t duk__ser_class_from_elemtype[9] = {
+	DUK_HOBJECT_CLASS_UINT8ARRAY,
+	DUK_HOBJECT_CLASS_UINT8CLAMPEDARRAY,
+	DUK_HOBJECT_CLASS_INT8ARRAY,
+	DUK_HOBJECT_CLASS_UINT16ARRAY,
+	DUK_HOBJECT_CLASS_INT16ARRAY,
+	DUK_HOBJECT_CLASS_UINT32ARRAY,
+	DUK_HOBJECT_CLASS_INT32ARRAY,
+	DUK_HOBJECT_CLASS_FLOAT32ARRAY,
+	DUK_HOBJECT_CLASS_FLOAT64ARRAY
+};
+DUK_LOCAL const duk_uint8_t duk__ser_proto_from_elemtype[9] = {
+	DUK_BIDX_UINT8ARRAY_PROTOTYPE,
+	DUK_BIDX_UINT8CLAMPEDARRAY_PROTOTYPE,
+	DUK_BIDX_INT8ARRAY_PROTOTYPE,
+	DUK_BIDX_UINT16ARRAY_PROTOTYPE,
+	DUK_BIDX_INT16ARRAY_PROTOTYPE,
+	DUK_BIDX_UINT32ARRAY_PROTOTYPE,
+	DUK_BIDX_INT32ARRAY_PROTOTYPE,
+	DUK_BIDX_FLOAT32ARRAY_PROTOTYPE,
+	DUK_BIDX_FLOAT64ARRAY_PROTOTYPE
+};
+DUK_LOCAL const duk_uint8_t duk__ser_shift_from_elemtype[9] = {
+	0, 0, 0, 1, 1, 2, 2, 2, 3
+};
+
+/*
+ *  Encoding
+ */
+
+DUK_LOCAL_DECL void duk__ser_enc_value(duk__ser_enc_ctx *enc_ctx);
+
+DUK_LOCAL void duk__ser_emit_byte(duk__ser_enc_ctx *enc_ctx, duk_uint8_t x) {
+	duk_hbuffer_append_byte(enc_ctx->thr, enc_ctx->h_buf, x);
+}
+
+DUK_LOCAL void duk__ser_emit_u32(duk__ser_enc_ctx *enc_ctx, duk_uint32_t x) {
+	duk_uint8_t tmp[4];
+
+	tmp[0] = (duk_uint8_t) (x >> 24);
+	tmp[1] = (duk_uint8_t) (x >> 16);
+	tmp[2] = (duk_uint8_t) (x >> 8);
+	tmp[3] = (duk_uint8_t) x;
+	duk_hbuffer_append_bytes(enc_ctx->thr, enc_ctx->h_buf, tmp, 4);
+}
+
+DUK_LOCAL void duk__ser_emit_double(duk__ser_enc_ctx *enc_ctx, duk_double_t d) {
+	duk_double_union du;
+
+	du.d = d;
+	DUK_DBLUNION_DOUBLE_HTON(&du);
+	duk_hbuffer_append_bytes(enc_ctx->thr, enc_ctx->h_buf, du.uc, 8);
+}
+
+DUK_LOCAL void duk__ser_emit_data(duk__ser_enc_ctx *enc_ctx, const duk_uint8_t *data, duk_size_t len) {
+	if (len > (duk_size_t) DUK_UINT32_MAX) {
+		DUK_ERROR(enc_ctx->thr, DUK_ERR_RANGE_ERROR, DUK_STR_BUFFER_TOO_LONG);
+	}
+	duk__ser_emit_u32(enc_ctx, (duk_uint32_t) len);
+	duk_hbuffer_append_bytes(enc_ctx->thr, enc_ctx->h_buf, data, len);
+}
+
+DUK_LOCAL void duk__ser_emit_hstring(duk__ser_enc_ctx *enc_ctx, duk_hstring *h) {
+	DUK_ASSERT(h != NULL);
+	duk__ser_emit_data(enc_ctx, DUK_HSTRING_GET_DATA(h), DUK_HSTRING_GET_BYTELEN(h));
+}
+
+DUK_LOCAL void duk__ser_enc_number(duk__ser_enc_ctx *enc_ctx, duk_double_t d) {
+	duk_int32_t i;
+
+	/* Whole numbers in the 32-bit range (except negative zero) are very
+	 * common and get a shorter encoding.  The range check comes first
+	 * so that the cast is always defined (NaN fails the comparisons).
+	 */
+	if (d >= -2147483648.0 && d <= 2147483647.0) {
+		i = (duk_int32_t) d;
+		if ((duk_double_t) i == d && !(i == 0 && DUK_SIGNBIT(d))) {
+			duk__ser_emit_byte(enc_ctx, DUK__SER_TAG_INT32);
+			duk__ser_emit_u32(enc_ctx, (duk_uint32_t) i);
+			return;
+		}
+	}
+	duk__ser_emit_byte(enc_ctx, DUK__SER_TAG_NUMBER);
+	duk__ser_emit_double(enc_ctx, d);
+}
+
+/* Encode enumerable own properties of the object at stack top. */
+DUK_LOCAL void duk__ser_enc_props(duk__ser_enc_ctx *enc_ctx) {
+	duk_context *ctx = (duk_context *) enc_ctx->thr;
+	duk_hstring *h_key;
+	duk_size_t off_count;
+	duk_uint32_t count;
+	duk_uint8_t *p;
+
+	/* The property count is not known beforehand (enumeration has side
+	 * effects, e.g. getters), so emit a placeholder and patch it.
+	 */
+	off_count = DUK_HBUFFER_GET_SIZE(enc_ctx->h_buf);
+	duk__ser_emit_u32(enc_ctx, 0);
+	count = 0;
+
+	duk_enum(ctx, -1, DUK_ENUM_OWN_PROPERTIES_ONLY);
+	while (duk_next(ctx, -1, 1 /*get_value*/)) {
+		/* [ ... obj enum key val ] */
+		h_key = duk_get_hstring(ctx, -2);
+		DUK_ASSERT(h_key != NULL);
+		if (DUK_HSTRING_HAS_ARRIDX(h_key)) {
+			duk__ser_emit_byte(enc_ctx, DUK__SER_KEY_INDEX);
+			duk__ser_emit_u32(enc_ctx, (duk_uint32_t) duk_js_to_arrayindex_string_helper(h_key));
+		} else {
+			duk__ser_emit_byte(enc_ctx, DUK__SER_KEY_STRING);
+			duk__ser_emit_hstring(enc_ctx, h_key);
+		}
+		duk__ser_enc_value(enc_ctx);
+		duk_pop_2(ctx);
+		count++;
+	}
+	duk_pop(ctx);
+
+	p = (duk_uint8_t *) DUK_HBUFFER_DYNAMIC_GET_DATA_PTR(enc_ctx->thr->heap, enc_ctx->h_buf) + off_count;
+	p[0] = (duk_uint8_t) (count >> 24);
+	p[1] = (duk_uint8_t) (count >> 16);
+	p[2] = (duk_uint8_t) (count >> 8);
+	p[3] = (duk_uint8_t) count;
+}
+
+DUK_LOCAL void duk__ser_enc_bufferobject(duk__ser_enc_ctx *enc_ctx, duk_hbufferobject *h_bufobj) {
+	duk_hthread *thr = enc_ctx->thr;
+	duk_small_uint_t flags;
+	duk_uint_t len;
+	duk_uint8_t *data;
+
+	DUK_ASSERT_HBUFFEROBJECT_VALID(h_bufobj);
+
+	flags = 0;
+	if (DUK_HOBJECT_GET_PROTOTYPE(thr->heap, (duk_hobject *) h_bufobj) == thr->builtins[DUK_BIDX_NODEJS_BUFFER_PROTOTYPE]) {
+		flags |= DUK__SER_BUFOBJ_FLAG_NODEJS;
+	}
+
+	/* Only the bytes visible through the object are copied; the
+	 * underlying buffer may have been resized after the object was
+	 * created so clamp to what is actually available.
+	 */
+	if (h_bufobj->buf != NULL) {
+		len = DUK_HBUFFEROBJECT_CLAMP_BYTELENGTH(h_bufobj, h_bufobj->length);
+		len &= ~((((duk_uint_t) 1U) << h_bufobj->shift) - 1U);
+		data = DUK_HBUFFEROBJECT_GET_SLICE_BASE(thr->heap, h_bufobj);
+	} else {
+		len = 0;
+		data = NULL;
+	}
+
+	duk__ser_emit_byte(enc_ctx, DUK__SER_TAG_BUFFEROBJ);
+	duk__ser_emit_byte(enc_ctx, (duk_uint8_t) DUK_HOBJECT_GET_CLASS_NUMBER((duk_hobject *) h_bufobj));
+	duk__ser_emit_byte(enc_ctx, (duk_uint8_t) flags);
+	duk__ser_emit_data(enc_ctx, data, (duk_size_t) len);
+}
+
+DUK_LOCAL void duk__ser_enc_object(duk__ser_enc_ctx *enc_ctx, duk_hobject *h) {
+	duk_context *ctx = (duk_context *) enc_ctx->thr;
+	duk_small_uint_t flags;
+
+	DUK_ASSERT(h != NULL);
+
+	/* [ ... obj ] */
+
+	duk_push_sprintf(ctx, DUK_STR_FMT_PTR, (void *) h);
+	duk_dup_top(ctx);
+	if (duk_get_prop(ctx, enc_ctx->idx_seen)) {
+		duk__ser_emit_byte(enc_ctx, DUK__SER_TAG_REF);
+		duk__ser_emit_u32(enc_ctx, (duk_uint32_t) duk_get_uint(ctx, -1));
+		duk_pop_2(ctx);
+		return;
+	}
+	duk_pop(ctx);
+	duk_push_uint(ctx, (duk_uint_t) enc_ctx->num_objects);
+	duk_put_prop(ctx, enc_ctx->idx_seen);  /* -> [ ... obj ] */
+	enc_ctx->num_objects++;
+
+	if (DUK_HOBJECT_HAS_EXOTIC_PROXYOBJ(h)) {
+		goto fail_type;
+	}
+	if (DUK_HOBJECT_IS_BUFFEROBJECT(h)) {
+		duk__ser_enc_bufferobject(enc_ctx, (duk_hbufferobject *) h);
+		return;
+	}
+
+	switch (DUK_HOBJECT_GET_CLASS_NUMBER(h)) {
+	case DUK_HOBJECT_CLASS_OBJECT:
+	case DUK_HOBJECT_CLASS_ARGUMENTS: {
+		duk__ser_emit_byte(enc_ctx, DUK__SER_TAG_OBJECT);
+		duk__ser_enc_props(enc_ctx);
+		break;
+	}
+	case DUK_HOBJECT_CLASS_ARRAY: {
+		duk__ser_emit_byte(enc_ctx, DUK__SER_TAG_ARRAY);
+		duk__ser_emit_u32(enc_ctx, duk_hobject_get_length(enc_ctx->thr, h));
+		duk__ser_enc_props(enc_ctx);
+		break;
+	}
+	case DUK_HOBJECT_CLASS_DATE: {
+		duk_get_prop_stridx(ctx, -1, DUK_STRIDX_INT_VALUE);
+		duk__ser_emit_byte(enc_ctx, DUK__SER_TAG_DATE);
+		duk__ser_emit_double(enc_ctx, duk_to_number(ctx, -1));
+		duk_pop(ctx);
+		break;
+	}
+	case DUK_HOBJECT_CLASS_REGEXP: {
+		flags = 0;
+		if (duk_get_prop_stridx_boolean(ctx, -1, DUK_STRIDX_GLOBAL, NULL)) {
+			flags |= DUK__SER_REGEXP_FLAG_GLOBAL;
+		}
+		if (duk_get_prop_stridx_boolean(ctx, -1, DUK_STRIDX_IGNORE_CASE, NULL)) {
+			flags |= DUK__SER_REGEXP_FLAG_IGNORECASE;
+		}
+		if (duk_get_prop_stridx_boolean(ctx, -1, DUK_STRIDX_MULTILINE, NULL)) {
+			flags |= DUK__SER_REGEXP_FLAG_MULTILINE;
+		}
+		duk_get_prop_stridx(ctx, -1, DUK_STRIDX_SOURCE);
+		duk__ser_emit_byte(enc_ctx, DUK__SER_TAG_REGEXP);
+		duk__ser_emit_hstring(enc_ctx, duk_to_hstring(ctx, -1));
+		duk__ser_emit_byte(enc_ctx, (duk_uint8_t) flags);
+		duk_pop(ctx);
+		break;
+	}
+	case DUK_HOBJECT_CLASS_BOOLEAN:
+	case DUK_HOBJECT_CLASS_NUMBER:
+	case DUK_HOBJECT_CLASS_STRING: {
+		duk_get_prop_stridx(ctx, -1, DUK_STRIDX_INT_VALUE);
+		duk__ser_emit_byte(enc_ctx, DUK__SER_TAG_WRAPPER);
+		duk__ser_enc_value(enc_ctx);
+		duk_pop(ctx);
+		break;
+	}
+	default: {
+		/* Functions, errors, threads, pointer objects, etc. */
+		goto fail_type;
+	}
+	}
+	return;
+
+ fail_type:
+	DUK_ERROR(enc_ctx->thr, DUK_ERR_TYPE_ERROR, DUK_STR_SERIALIZE_FAILED);
+}
+
+/* Encode the value at stack top, leaving the value stack unchanged. */
+DUK_LOCAL void duk__ser_enc_value(duk__ser_enc_ctx *enc_ctx) {
+	duk_context *ctx = (duk_context *) enc_ctx->thr;
+	duk_hbuffer *h_buf;
+
+	switch (duk_get_type(ctx, -1)) {
+	case DUK_TYPE_UNDEFINED: {
+		duk__ser_emit_byte(enc_ctx, DUK__SER_TAG_UNDEFINED);
+		break;
+	}
+	case DUK_TYPE_NULL: {
+		duk__ser_emit_byte(enc_ctx, DUK__SER_TAG_NULL);
+		break;
+	}
+	case DUK_TYPE_BOOLEAN: {
+		duk__ser_emit_byte(enc_ctx, duk_get_boolean(ctx, -1) ? DUK__SER_TAG_TRUE : DUK__SER_TAG_FALSE);
+		break;
+	}
+	case DUK_TYPE_NUMBER: {
+		duk__ser_enc_number(enc_ctx, duk_get_number(ctx, -1));
+		break;
+	}
+	case DUK_TYPE_STRING: {
+		duk__ser_emit_byte(enc_ctx, DUK__SER_TAG_STRING);
+		duk__ser_emit_hstring(enc_ctx, duk_get_hstring(ctx, -1));
+		break;
+	}
+	case DUK_TYPE_BUFFER: {
+		h_buf = duk_get_hbuffer(ctx, -1);
+		DUK_ASSERT(h_buf != NULL);
+		duk__ser_emit_byte(enc_ctx, DUK_HBUFFER_HAS_DYNAMIC(h_buf) ? DUK__SER_TAG_DYNBUFFER : DUK__SER_TAG_BUFFER);
+		duk__ser_emit_data(enc_ctx,
+		                   (const duk_uint8_t *) DUK_HBUFFER_GET_DATA_PTR(enc_ctx->thr->heap, h_buf),
+		                   DUK_HBUFFER_GET_SIZE(h_buf));
+		break;
+	}
+	case DUK_TYPE_OBJECT: {
+		DUK_ASSERT(enc_ctx->recursion_depth >= 0);
+		if (enc_ctx->recursion_depth >= DUK__SER_RECURSION_LIMIT) {
+			DUK_ERROR(enc_ctx->thr, DUK_ERR_RANGE_ERROR, DUK_STR_SERIALIZE_RECLIMIT);
+		}
+		enc_ctx->recursion_depth++;
+		duk_require_stack(ctx, DUK__SER_VALSTACK_SPACE);
+		duk__ser_enc_object(enc_ctx, duk_get_hobject(ctx, -1));
+		enc_ctx->recursion_depth--;
+		break;
+	}
+	default: {
+		/* Pointers and lightfuncs. */
+		DUK_ERROR(enc_ctx->thr, DUK_ERR_TYPE_ERROR, DUK_STR_SERIALIZE_FAILED);
+	}
+	}
+}
+
+DUK_EXTERNAL void duk_serialize(duk_context *ctx, duk_idx_t index) {
+	duk_hthread *thr = (duk_hthread *) ctx;
+	duk__ser_enc_ctx enc_ctx_alloc;
+	duk__ser_enc_ctx *enc_ctx = &enc_ctx_alloc;
+	duk_size_t len;
+	void *buf;
+#ifdef DUK_USE_ASSERTIONS
+	duk_idx_t top_at_entry;
+#endif
+
+	DUK_ASSERT_CTX_VALID(ctx);
+#ifdef DUK_USE_ASSERTIONS
+	top_at_entry = duk_get_top(ctx);
+#endif
+
+	index = duk_require_normalize_index(ctx, index);
+
+	DUK_MEMZERO(enc_ctx, sizeof(*enc_ctx));
+	enc_ctx->thr = thr;
+
+	(void) duk_push_dynamic_buffer(ctx, 0);
+	enc_ctx->h_buf = (duk_hbuffer_dynamic *) duk_get_hbuffer(ctx, -1);
+	DUK_ASSERT(enc_ctx->h_buf != NULL);
+	enc_ctx->idx_seen = duk_push_object_internal(ctx);
+
+	duk__ser_emit_byte(enc_ctx, DUK__SER_MARKER);
+	duk__ser_emit_byte(enc_ctx, DUK__SER_VERSION);
+	duk_dup(ctx, index);
+	duk__ser_enc_value(enc_ctx);
+	duk_pop_2(ctx);  /* -> [ ... buf ] */
+	DUK_ASSERT(enc_ctx->recursion_depth == 0);
+
+	/* Result is a fixed buffer so that the host gets a single compact
+	 * allocation to hand over to the receiving side.
+	 */
+	len = DUK_HBUFFER_GET_SIZE(enc_ctx->h_buf);
+	buf = duk_push_fixed_buffer(ctx, len);
+	DUK_MEMCPY(buf, DUK_HBUFFER_DYNAMIC_GET_DATA_PTR(thr->heap, enc_ctx->h_buf), len);
+	duk_replace(ctx, index);
+	duk_pop(ctx);
+
+	DUK_ASSERT(duk_get_top(ctx) == top_at_entry);
+}
+
+/*
+ *  Decoding
+ *
+ *  The input may be corrupted or come from an untrusted source, so every
+ *  read is bounds checked and the resulting values are created using only
+ *  internal property definition primitives: no setters or other user code
+ *  is invoked.
+ */
+
+DUK_LOCAL_DECL void duk__ser_dec_value(duk__ser_dec_ctx *dec_ctx);
+
+DUK_LOCAL void duk__ser_dec_error(duk__ser_dec_ctx *dec_ctx) {
+	DUK_ERROR(dec_ctx->thr, DUK_ERR_TYPE_ERROR, DUK_STR_DESERIALIZE_FAILED);
+}
+
+DUK_LOCAL void duk__ser_dec_need(duk__ser_dec_ctx *dec_ctx, duk_size_t n) {
+	if ((duk_size_t) (dec_ctx->p_end - dec_ctx->p) < n) {
+		duk__ser_dec_error(dec_ctx);
+	}
+}
+
+DUK_LOCAL duk_uint8_t duk__ser_dec_byte(duk__ser_dec_ctx *dec_ctx) {
+	duk__ser_dec_need(dec_ctx, 1);
+	return *dec_ctx->p++;
+}
+
+DUK_LOCAL duk_uint32_t duk__ser_dec_u32(duk__ser_dec_ctx *dec_ctx) {
+	const duk_uint8_t *p;
+
+	duk__ser_dec_need(dec_ctx, 4);
+	p = dec_ctx->p;
+	dec_ctx->p += 4;
+	return (((duk_uint32_t) p[0]) << 24) |
+	       (((duk_uint32_t) p[1]) << 16) |
+	       (((duk_uint32_t) p[2]) << 8) |
+	       ((duk_uint32_t) p[3]);
+}
+
+DUK_LOCAL duk_double_t duk__ser_dec_double(duk__ser_dec_ctx *dec_ctx) {
+	duk_double_union du;
+
+	duk__ser_dec_need(dec_ctx, 8);
+	DUK_MEMCPY((void *) du.uc, (const void *) dec_ctx->p, 8);
+	dec_ctx->p += 8;
+	DUK_DBLUNION_DOUBLE_NTOH(&du);
+	return du.d;
+}
+
+/* Read a length prefixed byte sequence; returns a pointer into the input. */
+DUK_LOCAL const duk_uint8_t *duk__ser_dec_data(duk__ser_dec_ctx *dec_ctx, duk_size_t *out_len) {
+	const duk_uint8_t *p;
+	duk_uint32_t len;
+
+	len = duk__ser_dec_u32(dec_ctx);
+	duk__ser_dec_need(dec_ctx, (duk_size_t) len);
+	p = dec_ctx->p;
+	dec_ctx->p += len;
+	*out_len = (duk_size_t) len;
+	return p;
+}
+
+/* Internal strings (0xff prefix) are never serialized, so reject them
+ * anywhere in the input: they could be used to create internal keys or
+ * values which user code could otherwise not get hold of.
+ */
+DUK_LOCAL void duk__ser_dec_push_string(duk__ser_dec_ctx *dec_ctx) {
+	const duk_uint8_t *p;
+	duk_size_t len;
+
+	p = duk__ser_dec_data(dec_ctx, &len);
+	if (len > 0 && p[0] == (duk_uint8_t) 0xff) {
+		duk__ser_dec_error(dec_ctx);
+	}
+	duk_push_lstring((duk_context *) dec_ctx->thr, (const char *) p, len);
+}
+
+DUK_LOCAL void duk__ser_dec_push_buffer(duk__ser_dec_ctx *dec_ctx, duk_bool_t dynamic) {
+	const duk_uint8_t *p;
+	duk_size_t len;
+	void *buf;
+
+	p = duk__ser_dec_data(dec_ctx, &len);
+	buf = duk_push_buffer_raw((duk_context *) dec_ctx->thr, len, (dynamic ? DUK_BUF_FLAG_DYNAMIC : 0) | DUK_BUF_FLAG_NOZERO);
+	DUK_ASSERT(buf != NULL || len == 0);
+	if (len > 0) {
+		DUK_MEMCPY(buf, (const void *) p, len);
+	}
+}
+
+/* Register the object at stack top so that later references resolve to it. */
+DUK_LOCAL void duk__ser_dec_register(duk__ser_dec_ctx *dec_ctx) {
+	duk_context *ctx = (duk_context *) dec_ctx->thr;
+
+	duk_dup_top(ctx);
+	duk_xdef_prop_index_wec(ctx, dec_ctx->idx_objects, dec_ctx->num_objects);
+	dec_ctx->num_objects++;
+}
+
+/* Create a RegExp from [ ... source flags ], called using duk_safe_call()
+ * so that a corrupted source can't escape as a SyntaxError.
+ */
+DUK_LOCAL duk_ret_t duk__ser_dec_regexp_raw(duk_context *ctx) {
+	/* [ ... source flags ] */
+	duk_push_hobject_bidx(ctx, DUK_BIDX_REGEXP_CONSTRUCTOR);
+	duk_insert(ctx, -3);
+	duk_new(ctx, 2);
+	return 1;
+}
+
+/* Decode properties into the object at stack top. */
+DUK_LOCAL void duk__ser_dec_props(duk__ser_dec_ctx *dec_ctx) {
+	duk_context *ctx = (duk_context *) dec_ctx->thr;
+	duk_uint32_t count;
+	duk_uint8_t key_type;
+	duk_hstring *h_key;
+
+	count = duk__ser_dec_u32(dec_ctx);
+	while (count-- > 0) {
+		key_type = duk__ser_dec_byte(dec_ctx);
+		if (key_type == DUK__SER_KEY_INDEX) {
+			duk_push_uint(ctx, (duk_uint_t) duk__ser_dec_u32(dec_ctx));
+			h_key = duk_to_hstring(ctx, -1);
+		} else if (key_type == DUK__SER_KEY_STRING) {
+			duk__ser_dec_push_string(dec_ctx);
+			h_key = duk_get_hstring(ctx, -1);
+		} else {
+			h_key = NULL;
+		}
+		if (h_key == NULL || DUK_HSTRING_HAS_INTERNAL(h_key)) {
+			duk__ser_dec_error(dec_ctx);
+		}
+		duk__ser_dec_value(dec_ctx);
+
+		/* [ ... obj key val ] */
+		duk_def_prop(ctx, -3, DUK_DEFPROP_HAVE_VALUE |
+		                      DUK_DEFPROP_HAVE_WRITABLE | DUK_DEFPROP_WRITABLE |
+		                      DUK_DEFPROP_HAVE_ENUMERABLE | DUK_DEFPROP_ENUMERABLE |
+		                      DUK_DEFPROP_HAVE_CONFIGURABLE | DUK_DEFPROP_CONFIGURABLE);
+	}
+}
+
+DUK_LOCAL void duk__ser_dec_bufferobject(duk__ser_dec_ctx *dec_ctx) {
+	duk_context *ctx = (duk_context *) dec_ctx->thr;
+	duk_hthread *thr = dec_ctx->thr;
+	duk_small_uint_t class_num;
+	duk_small_uint_t flags;
+	duk_small_int_t proto_bidx;
+	duk_small_uint_t elem_type;
+	duk_small_uint_t shift;
+	duk_bool_t is_view;
+	duk_hbuffer *h_val;
+	duk_hbufferobject *h_bufobj;
+
+	DUK_UNREF(thr);
+
+	class_num = (duk_small_uint_t) duk__ser_dec_byte(dec_ctx);
+	flags = (duk_small_uint_t) duk__ser_dec_byte(dec_ctx);
+	elem_type = DUK_HBUFFEROBJECT_ELEM_UINT8;
+	shift = 0;
+	is_view = 0;
+
+	if (class_num == DUK_HOBJECT_CLASS_BUFFER) {
+		proto_bidx = (flags & DUK__SER_BUFOBJ_FLAG_NODEJS) ?
+		             DUK_BIDX_NODEJS_BUFFER_PROTOTYPE : DUK_BIDX_BUFFER_PROTOTYPE;
+	} else if (class_num == DUK_HOBJECT_CLASS_ARRAYBUFFER) {
+		proto_bidx = DUK_BIDX_ARRAYBUFFER_PROTOTYPE;
+	} else if (class_num == DUK_HOBJECT_CLASS_DATAVIEW) {
+		proto_bidx = DUK_BIDX_DATAVIEW_PROTOTYPE;
+		is_view = 1;
+	} else {
+		for (elem_type = 0; elem_type <= DUK_HBUFFEROBJECT_ELEM_MAX; elem_type++) {
+			if (duk__ser_class_from_elemtype[elem_type] == class_num) {
+				break;
+			}
+		}
+		if (elem_type > DUK_HBUFFEROBJECT_ELEM_MAX) {
+			duk__ser_dec_error(dec_ctx);
+		}
+		proto_bidx = (duk_small_int_t) duk__ser_proto_from_elemtype[elem_type];
+		shift = duk__ser_shift_from_elemtype[elem_type];
+		is_view = 1;
+	}
+
+	duk__ser_dec_push_buffer(dec_ctx, 0 /*dynamic*/);
+	h_val = duk_get_hbuffer(ctx, -1);
+	DUK_ASSERT(h_val != NULL);
+	if (DUK_HBUFFER_GET_SIZE(h_val) & ((1U << shift) - 1U)) {
+		duk__ser_dec_error(dec_ctx);
+	}
+
+	if (is_view) {
+		/* Views get a fresh ArrayBuffer as their .buffer. */
+		h_bufobj = duk_push_bufferobject(ctx,
+		                                 DUK_HOBJECT_FLAG_EXTENSIBLE |
+		                                 DUK_HOBJECT_FLAG_BUFFEROBJECT |
+		                                 DUK_HOBJECT_CLASS_AS_FLAGS(DUK_HOBJECT_CLASS_ARRAYBUFFER),
+		                                 DUK_BIDX_ARRAYBUFFER_PROTOTYPE);
+		DUK_ASSERT(h_bufobj != NULL);
+		h_bufobj->buf = h_val;
+		DUK_HBUFFER_INCREF(thr, h_val);
+		h_bufobj->length = (duk_uint_t) DUK_HBUFFER_GET_SIZE(h_val);
+		DUK_ASSERT_HBUFFEROBJECT_VALID(h_bufobj);
+		duk_remove(ctx, -2);  /* -> [ ... arraybuffer ] */
+	}
+
+	h_bufobj = duk_push_bufferobject(ctx,
+	                                 DUK_HOBJECT_FLAG_EXTENSIBLE |
+	                                 DUK_HOBJECT_FLAG_BUFFEROBJECT |
+	                                 DUK_HOBJECT_CLASS_AS_FLAGS(class_num),
+	                                 proto_bidx);
+	DUK_ASSERT(h_bufobj != NULL);
+	h_bufobj->buf = h_val;
+	DUK_HBUFFER_INCREF(thr, h_val);
+	DUK_ASSERT(h_bufobj->offset == 0);
+	h_bufobj->length = (duk_uint_t) DUK_HBUFFER_GET_SIZE(h_val);
+	h_bufobj->shift = (duk_uint8_t) shift;
+	h_bufobj->elem_type = (duk_uint8_t) elem_type;
+	h_bufobj->is_view = (duk_uint8_t) is_view;
+	DUK_ASSERT_HBUFFEROBJECT_VALID(h_bufobj);
+
+	if (is_view) {
+		duk_dup(ctx, -2);
+		duk_xdef_prop_stridx(ctx, -2, DUK_STRIDX_LC_BUFFER, DUK_PROPDESC_FLAGS_NONE);
+		duk_compact(ctx, -1);
+	}
+	duk_remove(ctx, -2);  /* -> [ ... bufobj ] */
+}
+
+DUK_LOCAL void duk__ser_dec_object(duk__ser_dec_ctx *dec_ctx, duk_uint8_t tag) {
+	duk_context *ctx = (duk_context *) dec_ctx->thr;
+	duk_hthread *thr = dec_ctx->thr;
+	duk_uint32_t len;
+	duk_small_uint_t flags;
+
+	switch (tag) {
+	case DUK__SER_TAG_OBJECT: {
+		duk_push_object(ctx);
+		duk__ser_dec_register(dec_ctx);
+		duk__ser_dec_props(dec_ctx);
+		break;
+	}
+	case DUK__SER_TAG_ARRAY: {
+		len = duk__ser_dec_u32(dec_ctx);
+		duk_push_array(ctx);
+		duk__ser_dec_register(dec_ctx);
+		duk__ser_dec_props(dec_ctx);
+
+		/* Set 'length' last: trailing holes are not visible in the
+		 * properties.  Shrinking (corrupted input) is harmless.
+		 */
+		duk_hobject_set_length(thr, duk_get_hobject(ctx, -1), len);
+		break;
+	}
+	case DUK__SER_TAG_DATE: {
+		duk_push_hobject_bidx(ctx, DUK_BIDX_DATE_CONSTRUCTOR);
+		duk_push_number(ctx, duk__ser_dec_double(dec_ctx));
+		duk_new(ctx, 1);
+		duk__ser_dec_register(dec_ctx);
+		break;
+	}
+	case DUK__SER_TAG_REGEXP: {
+		duk__ser_dec_push_string(dec_ctx);
+		flags = (duk_small_uint_t) duk__ser_dec_byte(dec_ctx);
+		duk_push_sprintf(ctx, "%s%s%s",
+		                 (flags & DUK__SER_REGEXP_FLAG_GLOBAL) ? "g" : "",
+		                 (flags & DUK__SER_REGEXP_FLAG_IGNORECASE) ? "i" : "",
+		                 (flags & DUK__SER_REGEXP_FLAG_MULTILINE) ? "m" : "");
+		if (duk_safe_call(ctx, duk__ser_dec_regexp_raw, 2 /*nargs*/, 1 /*nrets*/) != DUK_EXEC_SUCCESS) {
+			duk__ser_dec_error(dec_ctx);
+		}
+		duk__ser_dec_register(dec_ctx);
+		break;
+	}
+	case DUK__SER_TAG_WRAPPER: {
+		duk__ser_dec_value(dec_ctx);
+		if (!duk_check_type_mask(ctx, -1, DUK_TYPE_MASK_BOOLEAN |
+		                                  DUK_TYPE_MASK_NUMBER |
+		                                  DUK_TYPE_MASK_STRING)) {
+			duk__ser_dec_error(dec_ctx);
+		}
+		duk_to_object(ctx, -1);
+		duk__ser_dec_register(dec_ctx);
+		break;
+	}
+	case DUK__SER_TAG_BUFFEROBJ: {
+		duk__ser_dec_bufferobject(dec_ctx);
+		duk__ser_dec_register(dec_ctx);
+		break;
+	}
+	default: {
+		duk__ser_dec_error(dec_ctx);
+	}
+	}
+}
+
+/* Decode one value and push it. */
+DUK_LOCAL void duk__ser_dec_value(duk__ser_dec_ctx *dec_ctx) {
+	duk_context *ctx = (duk_context *) dec_ctx->thr;
+	duk_uint8_t tag;
+	duk_uint32_t num;
+
+	tag = duk__ser_dec_byte(dec_ctx);
+	switch (tag) {
+	case DUK__SER_TAG_UNDEFINED: {
+		duk_push_undefined(ctx);
+		break;
+	}
+	case DUK__SER_TAG_NULL: {
+		duk_push_null(ctx);
+		break;
+	}
+	case DUK__SER_TAG_FALSE: {
+		duk_push_false(ctx);
+		break;
+	}
+	case DUK__SER_TAG_TRUE: {
+		duk_push_true(ctx);
+		break;
+	}
+	case DUK__SER_TAG_INT32: {
+		duk_push_int(ctx, (duk_int_t) (duk_int32_t) duk__ser_dec_u32(dec_ctx));
+		break;
+	}
+	case DUK__SER_TAG_NUMBER: {
+		duk_push_number(ctx, duk__ser_dec_double(dec_ctx));
+		break;
+	}
+	case DUK__SER_TAG_STRING: {
+		duk__ser_dec_push_string(dec_ctx);
+		break;
+	}
+	case DUK__SER_TAG_BUFFER:
+	case DUK__SER_TAG_DYNBUFFER: {
+		duk__ser_dec_push_buffer(dec_ctx, (tag == DUK__SER_TAG_DYNBUFFER));
+		break;
+	}
+	case DUK__SER_TAG_REF: {
+		num = duk__ser_dec_u32(dec_ctx);
+		if (num >= dec_ctx->num_objects) {
+			duk__ser_dec_error(dec_ctx);
+		}
+		duk_get_prop_index(ctx, dec_ctx->idx_objects, (duk_uarridx_t) num);
+		break;
+	}
+	default: {
+		DUK_ASSERT(dec_ctx->recursion_depth >= 0);
+		if (dec_ctx->recursion_depth >= DUK__SER_RECURSION_LIMIT) {
+			DUK_ERROR(dec_ctx->thr, DUK_ERR_RANGE_ERROR, DUK_STR_SERIALIZE_RECLIMIT);
+		}
+		dec_ctx->recursion_depth++;
+		duk_require_stack(ctx, DUK__SER_VALSTACK_SPACE);
+		duk__ser_dec_object(dec_ctx, tag);
+		dec_ctx->recursion_depth--;
+		break;
+	}
+	}
+}
+
+DUK_EXTERNAL void duk_deserialize(duk_context *ctx, duk_idx_t index) {
+	duk_hthread *thr = (duk_hthread *) ctx;
+	duk__ser_dec_ctx dec_ctx_alloc;
+	duk__ser_dec_ctx *dec_ctx = &dec_ctx_alloc;
+	duk_hbuffer *h_buf;
+	const duk_uint8_t *p;
+	duk_size_t len;
+	void *buf;
+#ifdef DUK_USE_ASSERTIONS
+	duk_idx_t top_at_entry;
+#endif
+
+	DUK_ASSERT_CTX_VALID(ctx);
+#ifdef DUK_USE_ASSERTIONS
+	top_at_entry = duk_get_top(ctx);
+#endif
+
+	index = duk_require_normalize_index(ctx, index);
+	p = (const duk_uint8_t *) duk_require_buffer_data(ctx, index, &len);
+
+	/* The data pointer of a dynamic buffer is not stable if the buffer
+	 * is resized, e.g. by a finalizer triggered by a GC while decoding,
+	 * so decode from a private copy unless the input is a plain fixed
+	 * buffer.
+	 */
+	h_buf = duk_get_hbuffer(ctx, index);
+	if (h_buf == NULL || DUK_HBUFFER_HAS_DYNAMIC(h_buf)) {
+		buf = duk_push_fixed_buffer(ctx, len);
+		if (len > 0) {
+			DUK_MEMCPY(buf, (const void *) p, len);
+		}
+		p = (const duk_uint8_t *) buf;
+	} else {
+		duk_dup(ctx, index);
+	}
+
+	DUK_MEMZERO(dec_ctx, sizeof(*dec_ctx));
+	dec_ctx->thr = thr;
+	dec_ctx->p = p;
+	dec_ctx->p_end = p + len;
+	dec_ctx->idx_objects = duk_push_array(ctx);
+
+	if (duk__ser_dec_byte(dec_ctx) != DUK__SER_MARKER ||
+	    duk__ser_dec_byte(dec_ctx) != DUK__SER_VERSION) {
+		duk__ser_dec_error(dec_ctx);
+	}
+	duk__ser_dec_value(dec_ctx);
+	if (dec_ctx->p != dec_ctx->p_end) {
+		/* Trailing garbage. */
+		duk__ser_dec_error(dec_ctx);
+	}
+	DUK_ASSERT(dec_ctx->recursion_depth == 0);
+
+	duk_replace(ctx, index);
+	duk_pop_2(ctx);
+
+	DUK_ASSERT(duk_get_top(ctx) == top_at_entry);
+}
@@ -639,6 +639,15 @@ duk_bool_t duk_valstack_resize_raw(duk_context *ctx,
 			DUK_DDD(DUK_DDDPRINT("no need to grow or shrink valstack"));
 			return 1;
 		}
+#if defined(DUK_USE_STACK_GEOMETRIC_GROWTH)
+		/* Applies to compacting shrinks too: callers (e.g. call handling
+		 * restoring the entry size) only need 'min_new_size' entries.
+		 */
+		if (min_new_size > (old_size >> DUK_STACK_SHRINK_SHIFT)) {
+			DUK_DDD(DUK_DDDPRINT("valstack shrink not worth it yet (hysteresis)"));
+			return 1;
+		}
+#endif
 	}
 
 	new_size = min_new_size;
@@ -668,6 +677,18 @@ duk_bool_t duk_valstack_resize_raw(duk_context *ctx,
 		}
 	}
 
+#if defined(DUK_USE_STACK_GEOMETRIC_GROWTH)
+	/* Geometric headroom (for both growing and shrinking) is added after
+	 * the limit check so that it doesn't affect the limit.
+	 */
+	if (!compact_flag) {
+		new_size += min_new_size >> DUK_STACK_GROW_SHIFT;
+		if (new_size > thr->valstack_max) {
+			new_size = thr->valstack_max;
+		}
+	}
+#endif
+
 	/*
 	 *  When resizing the valstack, a mark-and-sweep may be triggered for
 	 *  the allocation of the new valstack.  If the mark-and-sweep needs
@@ -696,6 +717,13 @@ duk_bool_t duk_valstack_resize_raw(duk_context *ctx,
 	}
 
 	DUK_DDD(DUK_DDDPRINT("valstack resize successful"));
+#if defined(DUK_USE_DEBUG)
+	if (is_shrink) {
+		thr->heap->stats_valstack_shrink++;
+	} else {
+		thr->heap->stats_valstack_grow++;
+	}
+#endif
 	return 1;
 }
 
@@ -1881,7 +1909,14 @@ DUK_EXTERNAL duk_double_t duk_to_number(duk_context *ctx, duk_idx_t index) {
 
 	tv = duk_require_tval(ctx, index);
 	DUK_ASSERT(tv != NULL);
-	/* XXX: fastint? */
+#if defined(DUK_USE_FASTINT)
+	/* A fastint is already a number: keep the representation instead
+	 * of upgrading the value in place to a double.
+	 */
+	if (DUK_TVAL_IS_FASTINT(tv)) {
+		return (duk_double_t) DUK_TVAL_GET_FASTINT(tv);
+	}
+#endif
 	d = duk_js_tonumber(thr, tv);
 
 	/* Note: need to re-lookup because ToNumber() may have side effects */
@@ -1910,12 +1945,10 @@ DUK_LOCAL duk_double_t duk__to_int_uint_helper(duk_context *ctx, duk_idx_t index
 	DUK_ASSERT(tv != NULL);
 	d = coerce_func(thr, tv);
 
-	/* XXX: fastint? */
-
 	/* Relookup in case coerce_func() has side effects, e.g. ends up coercing an object */
 	tv = duk_require_tval(ctx, index);
 	DUK_TVAL_SET_TVAL(&tv_tmp, tv);
-	DUK_TVAL_SET_NUMBER(tv, d);  /* no need to incref */
+	DUK_TVAL_SET_NUMBER_CHKFAST(tv, d);  /* no need to incref; integer result, usually a fastint */
 	DUK_TVAL_DECREF(thr, &tv_tmp);  /* side effects */
 	return d;
 }
@@ -2992,7 +3025,7 @@ DUK_EXTERNAL void duk_push_int(duk_context *ctx, duk_int_t val) {
 	if (val >= DUK_FASTINT_MIN && val <= DUK_FASTINT_MAX) {
 		DUK_TVAL_SET_FASTINT(tv_slot, (duk_int64_t) val);
 	} else {
-		duk_double_t = (duk_double_t) val;
+		duk_double_t d = (duk_double_t) val;
 		DUK_TVAL_SET_NUMBER(tv_slot, d);
 	}
 #endif
@@ -3026,7 +3059,7 @@ DUK_EXTERNAL void duk_push_uint(duk_context *ctx, duk_uint_t val) {
 		/* XXX: take advantage of val being unsigned, no need to mask */
 		DUK_TVAL_SET_FASTINT(tv_slot, (duk_int64_t) val);
 	} else {
-		duk_double_t = (duk_double_t) val;
+		duk_double_t d = (duk_double_t) val;
 		DUK_TVAL_SET_NUMBER(tv_slot, d);
 	}
 #endif
@@ -39,8 +39,8 @@
 /* Forward declarations. */
 DUK_LOCAL_DECL duk_double_t duk__push_this_get_timeval_tzoffset(duk_context *ctx, duk_small_uint_t flags, duk_int_t *out_tzoffset);
 DUK_LOCAL_DECL duk_double_t duk__push_this_get_timeval(duk_context *ctx, duk_small_uint_t flags);
-DUK_LOCAL_DECL void duk__timeval_to_parts(duk_double_t d, duk_int_t *parts, duk_double_t *dparts, duk_small_uint_t flags);
-DUK_LOCAL_DECL duk_double_t duk__get_timeval_from_dparts(duk_double_t *dparts, duk_small_uint_t flags);
+DUK_LOCAL_DECL void duk__timeval_to_parts(duk_context *ctx, duk_double_t d, duk_int_t *parts, duk_double_t *dparts, duk_small_uint_t flags);
+DUK_LOCAL_DECL duk_double_t duk__get_timeval_from_dparts(duk_context *ctx, duk_double_t *dparts, duk_small_uint_t flags);
 DUK_LOCAL_DECL void duk__twodigit_year_fixup(duk_context *ctx, duk_idx_t idx_val);
 DUK_LOCAL_DECL duk_bool_t duk__is_leap_year(duk_int_t year);
 DUK_LOCAL_DECL duk_bool_t duk__timeval_in_valid_range(duk_double_t x);
@@ -330,10 +330,10 @@ DUK_LOCAL duk_int_t duk__get_local_tzoffset(duk_double_t d) {
 	 *    https://bugzilla.mozilla.org/show_bug.cgi?id=351066
 	 */
 
-	duk__timeval_to_parts(d, parts, dparts, DUK__FLAG_EQUIVYEAR /*flags*/);
+	duk__timeval_to_parts(NULL, d, parts, dparts, DUK__FLAG_EQUIVYEAR /*flags*/);
 	DUK_ASSERT(parts[DUK__IDX_YEAR] >= 1970 && parts[DUK__IDX_YEAR] <= 2038);
 
-	d = duk__get_timeval_from_dparts(dparts, 0 /*flags*/);
+	d = duk__get_timeval_from_dparts(NULL, dparts, 0 /*flags*/);
 	DUK_ASSERT(d >= 0 && d < 2147483648.0 * 1000.0);  /* unsigned 31-bit range */
 	t = (time_t) (d / 1000.0);
 	DUK_DDD(DUK_DDDPRINT("timeval: %lf -> time_t %ld", (double) d, (long) t));
@@ -440,6 +440,124 @@ DUK_LOCAL duk_int_t duk__get_local_tzoffset(duk_double_t d) {
 }
 #endif  /* DUK_USE_DATE_TZO_WINDOWS */
 
+#if defined(DUK_USE_DATE_CACHE)
+/* Maximum step (in milliseconds) by which the cached local time offset range
+ * is extended.  The platform offset is assumed to change at most once within
+ * this step, which holds for all real world DST rules.
+ */
+#define DUK__TZO_CACHE_STEP  (7.0 * (duk_double_t) DUK__MS_DAY)
+
+/* Find the last time value in [lo,hi[ whose local time offset is 'tzo_lo',
+ * given that 'lo' has offset 'tzo_lo' and 'hi' has some other offset.
+ * Bisection, ~30 platform calls for a full step.
+ */
+DUK_LOCAL duk_double_t duk__find_tzoffset_change(duk_double_t lo, duk_double_t hi, duk_int_t tzo_lo) {
+	duk_double_t mid;
+
+	while (hi - lo > 1.0) {
+		mid = DUK_FLOOR((lo + hi) / 2.0);
+		if (DUK__GET_LOCAL_TZOFFSET(mid) == tzo_lo) {
+			lo = mid;
+		} else {
+			hi = mid;
+		}
+	}
+	return lo;
+}
+
+/* Get local time offset (in seconds) for a certain (UTC) instant 'd' using
+ * the heap level cache.  The cache holds a range [tzo_start,tzo_end] of time
+ * values known to have the same offset.  A miss close to the range probes the
+ * offset one step further away: if it's unchanged the range is extended by a
+ * full step, otherwise the exact offset change is located once and the range
+ * ends there (the new range starts there if 'd' is past the change).  This
+ * makes repeated conversions of nearby time values, e.g. timestamps from
+ * Date.now(), hit the cache almost always.  'ctx' may be NULL, which bypasses
+ * the cache.
+ */
+DUK_LOCAL duk_int_t duk__get_local_tzoffset_cached(duk_context *ctx, duk_double_t d) {
+	duk_datecache *dc;
+	duk_double_t probe;
+	duk_double_t change;
+	duk_int_t tzo;
+	duk_int_t tzo_probe;
+
+	/* Non-finite and out-of-range values are handled by the platform
+	 * function (they don't call into the platform) and are not cached.
+	 */
+	if (ctx == NULL || !DUK_ISFINITE(d) || !duk__timeval_in_leeway_range(d)) {
+		return DUK__GET_LOCAL_TZOFFSET(d);
+	}
+	dc = &((duk_hthread *) ctx)->heap->datecache;
+
+	if (dc->tzo_valid) {
+		if (d >= dc->tzo_start && d <= dc->tzo_end) {
+			return dc->tzo_offset;
+		}
+
+		if (d > dc->tzo_end && d <= dc->tzo_end + DUK__TZO_CACHE_STEP) {
+			probe = dc->tzo_end + DUK__TZO_CACHE_STEP;
+			if (!duk__timeval_in_leeway_range(probe)) {
+				probe = d;
+			}
+			tzo_probe = DUK__GET_LOCAL_TZOFFSET(probe);
+			if (tzo_probe == dc->tzo_offset) {
+				dc->tzo_end = probe;
+				return tzo_probe;
+			}
+
+			/* Offset changes in ]tzo_end,probe]: 'change' is the
+			 * last time value with the old offset.
+			 */
+			change = duk__find_tzoffset_change(dc->tzo_end, probe, dc->tzo_offset);
+			if (d <= change) {
+				dc->tzo_end = change;
+			} else {
+				dc->tzo_start = change + 1.0;
+				dc->tzo_end = probe;
+				dc->tzo_offset = tzo_probe;
+			}
+			return dc->tzo_offset;
+		}
+
+		if (d < dc->tzo_start && d >= dc->tzo_start - DUK__TZO_CACHE_STEP) {
+			probe = dc->tzo_start - DUK__TZO_CACHE_STEP;
+			if (!duk__timeval_in_leeway_range(probe)) {
+				probe = d;
+			}
+			tzo_probe = DUK__GET_LOCAL_TZOFFSET(probe);
+			if (tzo_probe == dc->tzo_offset) {
+				dc->tzo_start = probe;
+				return tzo_probe;
+			}
+
+			/* Offset changes in ]probe,tzo_start]: 'change' is the
+			 * last time value with the new (probed) offset.
+			 */
+			change = duk__find_tzoffset_change(probe, dc->tzo_start, tzo_probe);
+			if (d > change) {
+				dc->tzo_start = change + 1.0;
+			} else {
+				dc->tzo_start = probe;
+				dc->tzo_end = change;
+				dc->tzo_offset = tzo_probe;
+			}
+			return dc->tzo_offset;
+		}
+	}
+
+	/* Cache empty or 'd' far away from the cached range: restart. */
+	tzo = DUK__GET_LOCAL_TZOFFSET(d);
+	dc->tzo_start = d;
+	dc->tzo_end = d;
+	dc->tzo_offset = tzo;
+	dc->tzo_valid = 1;
+	return tzo;
+}
+#else  /* DUK_USE_DATE_CACHE */
+#define duk__get_local_tzoffset_cached(ctx,d)  DUK__GET_LOCAL_TZOFFSET((d))
+#endif  /* DUK_USE_DATE_CACHE */
+
 #ifdef DUK_USE_DATE_PRS_STRPTIME
 DUK_LOCAL duk_bool_t duk__parse_string_strptime(duk_context *ctx, const char *str) {
 	struct tm tm;
@@ -822,7 +940,7 @@ DUK_LOCAL duk_bool_t duk__parse_string_iso8601_subset(duk_context *ctx, const ch
 		dparts[i] = parts[i];
 	}
 
-	d = duk__get_timeval_from_dparts(dparts, 0 /*flags*/);
+	d = duk__get_timeval_from_dparts(ctx, dparts, 0 /*flags*/);
 	duk_push_number(ctx, d);
 	return 1;
 }
@@ -1066,9 +1184,10 @@ DUK_LOCAL duk_double_t duk__make_day(duk_double_t year, duk_double_t month, duk_
 
 /* Split time value into parts.  The time value is assumed to be an internal
  * one, i.e. finite, no fractions.  Possible local time adjustment has already
- * been applied when reading the time value.
+ * been applied when reading the time value.  If 'ctx' is non-NULL, the heap
+ * level day breakdown cache is used.
  */
-DUK_LOCAL void duk__timeval_to_parts(duk_double_t d, duk_int_t *parts, duk_double_t *dparts, duk_small_uint_t flags) {
+DUK_LOCAL void duk__timeval_to_parts(duk_context *ctx, duk_double_t d, duk_int_t *parts, duk_double_t *dparts, duk_small_uint_t flags) {
 	duk_double_t d1, d2;
 	duk_int_t t1, t2;
 	duk_int_t day_since_epoch;
@@ -1083,7 +1202,11 @@ DUK_LOCAL void duk__timeval_to_parts(duk_double_t d, duk_int_t *parts, duk_doubl
 	duk_small_uint_t i;
 	duk_bool_t is_leap;
 	duk_small_int_t arridx;
+#if defined(DUK_USE_DATE_CACHE)
+	duk_datecache *dc;
+#endif
 
+	DUK_UNREF(ctx);
 	DUK_ASSERT(DUK_ISFINITE(d));    /* caller checks */
 	DUK_ASSERT(DUK_FLOOR(d) == d);  /* no fractions in internal time */
 
@@ -1139,22 +1262,49 @@ DUK_LOCAL void duk__timeval_to_parts(duk_double_t d, duk_int_t *parts, duk_doubl
 	parts[DUK__IDX_WEEKDAY] = (t2 + 4 + DUK__WEEKDAY_MOD_ADDER) % 7;  /* E5.1 Section 15.9.1.6 */
 	DUK_ASSERT(parts[DUK__IDX_WEEKDAY] >= 0 && parts[DUK__IDX_WEEKDAY] <= 6);
 
-	year = duk__year_from_day(t2, &day_in_year);
-	day = day_in_year;
-	is_leap = duk__is_leap_year(year);
-	for (month = 0; month < 12; month++) {
-		dim = duk__days_in_month[month];
-		if (month == 1 && is_leap) {
-			dim++;
+	/* Year/month/day breakdown only depends on the day number, so it is
+	 * cached: conversions of time values within the same day (e.g. log
+	 * timestamps) skip it.
+	 */
+#if defined(DUK_USE_DATE_CACHE)
+	dc = (ctx != NULL ? &((duk_hthread *) ctx)->heap->datecache : NULL);
+	if (dc != NULL && dc->day_valid && dc->day_num == t2) {
+		year = dc->day_year;
+		day_in_year = dc->day_in_year;
+		month = dc->day_month;
+		day = dc->day_day;
+		is_leap = duk__is_leap_year(year);
+	} else
+#endif
+	{
+		year = duk__year_from_day(t2, &day_in_year);
+		day = day_in_year;
+		is_leap = duk__is_leap_year(year);
+		for (month = 0; month < 12; month++) {
+			dim = duk__days_in_month[month];
+			if (month == 1 && is_leap) {
+				dim++;
+			}
+			DUK_DDD(DUK_DDDPRINT("month=%ld, dim=%ld, day=%ld",
+			                     (long) month, (long) dim, (long) day));
+			if (day < dim) {
+				break;
+			}
+			day -= dim;
 		}
-		DUK_DDD(DUK_DDDPRINT("month=%ld, dim=%ld, day=%ld",
-		                     (long) month, (long) dim, (long) day));
-		if (day < dim) {
-			break;
+		DUK_DDD(DUK_DDDPRINT("final month=%ld", (long) month));
+
+#if defined(DUK_USE_DATE_CACHE)
+		if (dc != NULL) {
+			dc->day_num = t2;
+			dc->day_year = year;
+			dc->day_in_year = day_in_year;
+			dc->day_month = month;
+			dc->day_day = day;
+			dc->day_valid = 1;
 		}
-		day -= dim;
+#endif
 	}
-	DUK_DDD(DUK_DDDPRINT("final month=%ld", (long) month));
 	DUK_ASSERT(month >= 0 && month <= 11);
 	DUK_ASSERT(day >= 0 && day <= 31);
 
@@ -1211,9 +1361,10 @@ DUK_LOCAL void duk__timeval_to_parts(duk_double_t d, duk_int_t *parts, duk_doubl
  * or local time; if local, they need to be (conceptually) converted into
  * UTC time.  The parts may represent valid or invalid time, and may be
  * wildly out of range (but may cancel each other and still come out in
- * the valid Date range).
+ * the valid Date range).  If 'ctx' is non-NULL, the heap level local time
+ * offset cache is used.
  */
-DUK_LOCAL duk_double_t duk__get_timeval_from_dparts(duk_double_t *dparts, duk_small_uint_t flags) {
+DUK_LOCAL duk_double_t duk__get_timeval_from_dparts(duk_context *ctx, duk_double_t *dparts, duk_small_uint_t flags) {
 #if defined(DUK_USE_PARANOID_DATE_COMPUTATION)
 	/* See comments below on MakeTime why these are volatile. */
 	volatile duk_double_t tmp_time;
@@ -1227,6 +1378,8 @@ DUK_LOCAL duk_double_t duk__get_timeval_from_dparts(duk_double_t *dparts, duk_sm
 	duk_small_uint_t i;
 	duk_int_t tzoff, tzoffprev1, tzoffprev2;
 
+	DUK_UNREF(ctx);
+
 	/* Expects 'this' at top of stack on entry. */
 
 	/* Coerce all finite parts with ToInteger().  ToInteger() must not
@@ -1312,7 +1465,7 @@ DUK_LOCAL duk_double_t duk__get_timeval_from_dparts(duk_double_t *dparts, duk_sm
 		for (i = 0; i < DUK__LOCAL_TZOFFSET_MAXITER; i++) {
 			tzoffprev2 = tzoffprev1;
 			tzoffprev1 = tzoff;
-			tzoff = DUK__GET_LOCAL_TZOFFSET(d - tzoff * 1000L);
+			tzoff = duk__get_local_tzoffset_cached(ctx, d - tzoff * 1000L);
 			DUK_DDD(DUK_DDDPRINT("tzoffset iteration, i=%d, tzoff=%ld, tzoffprev1=%ld tzoffprev2=%ld",
 			                     (int) i, (long) tzoff, (long) tzoffprev1, (long) tzoffprev2));
 			if (tzoff == tzoffprev1) {
@@ -1382,7 +1535,7 @@ DUK_LOCAL duk_double_t duk__push_this_get_timeval_tzoffset(duk_context *ctx, duk
 		/* Note: DST adjustment is determined using UTC time.
 		 * If 'd' is NaN, tzoffset will be 0.
 		 */
-		tzoffset = DUK__GET_LOCAL_TZOFFSET(d);  /* seconds */
+		tzoffset = duk__get_local_tzoffset_cached(ctx, d);  /* seconds */
 		d += tzoffset * 1000L;
 	}
 	if (out_tzoffset) {
@@ -1406,7 +1559,7 @@ DUK_LOCAL duk_ret_t duk__set_this_timeval_from_dparts(duk_context *ctx, duk_doub
 
 	/* [ ... this ] */
 
-	d = duk__get_timeval_from_dparts(dparts, flags);
+	d = duk__get_timeval_from_dparts(ctx, dparts, flags);
 	duk_push_number(ctx, d);  /* -> [ ... this timeval_new ] */
 	duk_dup_top(ctx);         /* -> [ ... this timeval_new timeval_new ] */
 	duk_put_prop_stridx(ctx, -3, DUK_STRIDX_INT_VALUE);
@@ -1493,7 +1646,7 @@ DUK_LOCAL duk_ret_t duk__to_string_helper(duk_context *ctx, duk_small_uint_t fla
 	DUK_ASSERT(DUK_ISFINITE(d));
 
 	/* formatters always get one-based month/day-of-month */
-	duk__timeval_to_parts(d, parts, NULL, DUK__FLAG_ONEBASED);
+	duk__timeval_to_parts(ctx, d, parts, NULL, DUK__FLAG_ONEBASED);
 	DUK_ASSERT(parts[DUK__IDX_MONTH] >= 1 && parts[DUK__IDX_MONTH] <= 12);
 	DUK_ASSERT(parts[DUK__IDX_DAY] >= 1 && parts[DUK__IDX_DAY] <= 31);
 
@@ -1542,7 +1695,7 @@ DUK_LOCAL duk_ret_t duk__get_part_helper(duk_context *ctx, duk_small_uint_t flag
 	}
 	DUK_ASSERT(DUK_ISFINITE(d));
 
-	duk__timeval_to_parts(d, parts, NULL, flags_and_idx);  /* no need to mask idx portion */
+	duk__timeval_to_parts(ctx, d, parts, NULL, flags_and_idx);  /* no need to mask idx portion */
 
 	/* Setter APIs detect special year numbers (0...99) and apply a +1900
 	 * only in certain cases.  The legacy getYear() getter applies -1900
@@ -1573,7 +1726,7 @@ DUK_LOCAL duk_ret_t duk__set_part_helper(duk_context *ctx, duk_small_uint_t flag
 	DUK_ASSERT(DUK_ISFINITE(d) || DUK_ISNAN(d));
 
 	if (DUK_ISFINITE(d)) {
-		duk__timeval_to_parts(d, parts, dparts, flags_and_maxnargs);
+		duk__timeval_to_parts(ctx, d, parts, dparts, flags_and_maxnargs);
 	} else {
 		/* NaN timevalue: we need to coerce the arguments, but
 		 * the resulting internal timestamp needs to remain NaN.
@@ -1731,10 +1884,11 @@ DUK_LOCAL void duk__set_parts_from_args(duk_context *ctx, duk_double_t *dparts,
  *  'out_buf' must be at least DUK_BI_DATE_ISO8601_BUFSIZE long.
  */
 
-DUK_INTERNAL void duk_bi_date_format_timeval(duk_double_t timeval, duk_uint8_t *out_buf) {
+DUK_INTERNAL void duk_bi_date_format_timeval(duk_context *ctx, duk_double_t timeval, duk_uint8_t *out_buf) {
 	duk_int_t parts[DUK__NUM_PARTS];
 
-	duk__timeval_to_parts(timeval,
+	duk__timeval_to_parts(ctx,
+	                      timeval,
 	                      parts,
 	                      NULL,
 	                      DUK__FLAG_ONEBASED);
@@ -1954,7 +2108,7 @@ DUK_INTERNAL duk_ret_t duk_bi_date_constructor_utc(duk_context *ctx) {
 		duk_push_nan(ctx);
 	} else {
 		duk__set_parts_from_args(ctx, dparts, nargs);
-		d = duk__get_timeval_from_dparts(dparts, 0 /*flags*/);
+		d = duk__get_timeval_from_dparts(ctx, dparts, 0 /*flags*/);
 		duk_push_number(ctx, d);
 	}
 	return 1;
@@ -2115,7 +2269,7 @@ DUK_INTERNAL duk_ret_t duk_bi_date_prototype_get_timezone_offset(duk_context *ct
 		duk_push_nan(ctx);
 	} else {
 		DUK_ASSERT(DUK_ISFINITE(d));
-		tzoffset = DUK__GET_LOCAL_TZOFFSET(d);
+		tzoffset = duk__get_local_tzoffset_cached(ctx, d);
 		duk_push_int(ctx, -tzoffset / 60);
 	}
 	return 1;
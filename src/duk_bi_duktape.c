@@ -184,6 +184,10 @@ DUK_INTERNAL duk_ret_t duk_bi_duktape_object_gc(duk_context *ctx) {
 	duk_bool_t rc;
 
 	flags = (duk_small_uint_t) duk_get_uint(ctx, 0);
+#if defined(DUK_USE_REFZERO_BUDGET)
+	/* pending refzero objects are roots for mark-and-sweep, free them first */
+	(void) duk_heap_process_pending(thr, 0);
+#endif
 	rc = duk_heap_mark_and_sweep(thr->heap, flags);
 
 	/* XXX: Not sure what the best return value would be in the API.
@@ -311,3 +315,44 @@ DUK_INTERNAL duk_ret_t duk_bi_duktape_object_compact(duk_context *ctx) {
 	duk_compact(ctx, 0);
 	return 1;  /* return the argument object */
 }
+
+/*
+ *  Fastint downgrade statistics
+ *
+ *  Only present when DUK_USE_FASTINT_STATS is enabled; the property is
+ *  deleted during built-in initialization otherwise.
+ */
+
+DUK_INTERNAL duk_ret_t duk_bi_duktape_object_fastint_stats(duk_context *ctx) {
+#if defined(DUK_USE_FASTINT_STATS)
+	duk_hthread *thr = (duk_hthread *) ctx;
+	duk_heap *heap;
+	duk_small_int_t i;
+
+	heap = thr->heap;
+	DUK_ASSERT(heap != NULL);
+
+	duk_push_object(ctx);
+	duk_push_array(ctx);
+	for (i = 0; i <= DUK_BC_OP_MAX; i++) {
+		duk_push_size_t(ctx, heap->stats_fastint_downgrade[i]);
+		duk_put_prop_index(ctx, -2, (duk_uarridx_t) i);
+	}
+	duk_put_prop_string(ctx, -2, "op");
+	duk_push_array(ctx);
+	for (i = 0; i <= DUK_BC_EXTRAOP_MAX; i++) {
+		duk_push_size_t(ctx, heap->stats_fastint_downgrade_extra[i]);
+		duk_put_prop_index(ctx, -2, (duk_uarridx_t) i);
+	}
+	duk_put_prop_string(ctx, -2, "extraop");
+
+	if (duk_to_boolean(ctx, 0)) {
+		DUK_MEMZERO((void *) heap->stats_fastint_downgrade, sizeof(heap->stats_fastint_downgrade));
+		DUK_MEMZERO((void *) heap->stats_fastint_downgrade_extra, sizeof(heap->stats_fastint_downgrade_extra));
+	}
+	return 1;
+#else
+	DUK_UNREF(ctx);
+	return DUK_RET_UNSUPPORTED_ERROR;
+#endif
+}
@@ -17,28 +17,32 @@
 	))
 #define DUK__CHECK_BITMASK(table,cp)  ((table)[(cp) >> 3] & (1 << ((cp) & 0x07)))
 
-/* E5.1 Section 15.1.3.3: uriReserved + uriUnescaped + '#' */
-DUK_LOCAL const duk_uint8_t duk__encode_uriunescaped_table[16] = {
-	DUK__MKBITS(0, 0, 0, 0, 0, 0, 0, 0), DUK__MKBITS(0, 0, 0, 0, 0, 0, 0, 0),  /* 0x00-0x0f */
-	DUK__MKBITS(0, 0, 0, 0, 0, 0, 0, 0), DUK__MKBITS(0, 0, 0, 0, 0, 0, 0, 0),  /* 0x10-0x1f */
-	DUK__MKBITS(0, 1, 0, 1, 1, 0, 1, 1), DUK__MKBITS(1, 1, 1, 1, 1, 1, 1, 1),  /* 0x20-0x2f */
-	DUK__MKBITS(1, 1, 1, 1, 1, 1, 1, 1), DUK__MKBITS(1, 1, 1, 1, 0, 1, 0, 1),  /* 0x30-0x3f */
-	DUK__MKBITS(1, 1, 1, 1, 1, 1, 1, 1), DUK__MKBITS(1, 1, 1, 1, 1, 1, 1, 1),  /* 0x40-0x4f */
-	DUK__MKBITS(1, 1, 1, 1, 1, 1, 1, 1), DUK__MKBITS(1, 1, 1, 0, 0, 0, 0, 1),  /* 0x50-0x5f */
-	DUK__MKBITS(0, 1, 1, 1, 1, 1, 1, 1), DUK__MKBITS(1, 1, 1, 1, 1, 1, 1, 1),  /* 0x60-0x6f */
-	DUK__MKBITS(1, 1, 1, 1, 1, 1, 1, 1), DUK__MKBITS(1, 1, 1, 0, 0, 0, 1, 0),  /* 0x70-0x7f */
-};
-
-/* E5.1 Section 15.1.3.4: uriUnescaped */
-DUK_LOCAL const duk_uint8_t duk__encode_uricomponent_unescaped_table[16] = {
-	DUK__MKBITS(0, 0, 0, 0, 0, 0, 0, 0), DUK__MKBITS(0, 0, 0, 0, 0, 0, 0, 0),  /* 0x00-0x0f */
-	DUK__MKBITS(0, 0, 0, 0, 0, 0, 0, 0), DUK__MKBITS(0, 0, 0, 0, 0, 0, 0, 0),  /* 0x10-0x1f */
-	DUK__MKBITS(0, 1, 0, 0, 0, 0, 0, 1), DUK__MKBITS(1, 1, 1, 0, 0, 1, 1, 0),  /* 0x20-0x2f */
-	DUK__MKBITS(1, 1, 1, 1, 1, 1, 1, 1), DUK__MKBITS(1, 1, 0, 0, 0, 0, 0, 0),  /* 0x30-0x3f */
-	DUK__MKBITS(0, 1, 1, 1, 1, 1, 1, 1), DUK__MKBITS(1, 1, 1, 1, 1, 1, 1, 1),  /* 0x40-0x4f */
-	DUK__MKBITS(1, 1, 1, 1, 1, 1, 1, 1), DUK__MKBITS(1, 1, 1, 0, 0, 0, 0, 1),  /* 0x50-0x5f */
-	DUK__MKBITS(0, 1, 1, 1, 1, 1, 1, 1), DUK__MKBITS(1, 1, 1, 1, 1, 1, 1, 1),  /* 0x60-0x6f */
-	DUK__MKBITS(1, 1, 1, 1, 1, 1, 1, 1), DUK__MKBITS(1, 1, 1, 0, 0, 0, 1, 0),  /* 0x70-0x7f */
+/* Character classes for bytes which are copied as is by the transforms,
+ * used to copy runs of such characters in one step.  Bytes >= 0x80 are
+ * never copied as is because they need to be decoded.
+ */
+#define DUK__TRANSFORM_COPY_URI          (1 << 0)  /* encodeURI(): E5.1 Section 15.1.3.3: uriReserved + uriUnescaped + '#' */
+#define DUK__TRANSFORM_COPY_URICOMPONENT (1 << 1)  /* encodeURIComponent(): E5.1 Section 15.1.3.4: uriUnescaped */
+#define DUK__TRANSFORM_COPY_ESCAPE       (1 << 2)  /* escape(): E5.1 Section B.2.1, step 7 */
+#define DUK__TRANSFORM_COPY_DECODE       (1 << 3)  /* decodeURI(), decodeURIComponent(), unescape(): ASCII except '%' */
+
+DUK_LOCAL const duk_uint8_t duk__transform_copy_class[256] = {
+	0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,  /* 0x00-0x0f */
+	0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,  /* 0x10-0x1f */
+	0x08, 0x0b, 0x08, 0x09, 0x09, 0x00, 0x09, 0x0b, 0x0b, 0x0b, 0x0f, 0x0d, 0x09, 0x0f, 0x0f, 0x0d,  /* 0x20-0x2f */
+	0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x09, 0x09, 0x08, 0x09, 0x08, 0x09,  /* 0x30-0x3f */
+	0x0d, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f,  /* 0x40-0x4f */
+	0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x08, 0x08, 0x08, 0x08, 0x0f,  /* 0x50-0x5f */
+	0x08, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f,  /* 0x60-0x6f */
+	0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x08, 0x08, 0x08, 0x0b, 0x08,  /* 0x70-0x7f */
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  /* 0x80-0x8f */
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  /* 0x90-0x9f */
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  /* 0xa0-0xaf */
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  /* 0xb0-0xbf */
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  /* 0xc0-0xcf */
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  /* 0xd0-0xdf */
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  /* 0xe0-0xef */
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00   /* 0xf0-0xff */
 };
 
 /* E5.1 Section 15.1.3.1: uriReserved + '#' */
@@ -65,27 +69,14 @@ DUK_LOCAL const duk_uint8_t duk__decode_uri_component_reserved_table[16] = {
 	DUK__MKBITS(0, 0, 0, 0, 0, 0, 0, 0), DUK__MKBITS(0, 0, 0, 0, 0, 0, 0, 0),  /* 0x70-0x7f */
 };
 
-#ifdef DUK_USE_SECTION_B
-/* E5.1 Section B.2.2, step 7. */
-DUK_LOCAL const duk_uint8_t duk__escape_unescaped_table[16] = {
-	DUK__MKBITS(0, 0, 0, 0, 0, 0, 0, 0), DUK__MKBITS(0, 0, 0, 0, 0, 0, 0, 0),  /* 0x00-0x0f */
-	DUK__MKBITS(0, 0, 0, 0, 0, 0, 0, 0), DUK__MKBITS(0, 0, 0, 0, 0, 0, 0, 0),  /* 0x10-0x1f */
-	DUK__MKBITS(0, 0, 0, 0, 0, 0, 0, 0), DUK__MKBITS(0, 0, 1, 1, 0, 1, 1, 1),  /* 0x20-0x2f */
-	DUK__MKBITS(1, 1, 1, 1, 1, 1, 1, 1), DUK__MKBITS(1, 1, 0, 0, 0, 0, 0, 0),  /* 0x30-0x3f */
-	DUK__MKBITS(1, 1, 1, 1, 1, 1, 1, 1), DUK__MKBITS(1, 1, 1, 1, 1, 1, 1, 1),  /* 0x40-0x4f */
-	DUK__MKBITS(1, 1, 1, 1, 1, 1, 1, 1), DUK__MKBITS(1, 1, 1, 0, 0, 0, 0, 1),  /* 0x50-0x5f */
-	DUK__MKBITS(0, 1, 1, 1, 1, 1, 1, 1), DUK__MKBITS(1, 1, 1, 1, 1, 1, 1, 1),  /* 0x60-0x6f */
-	DUK__MKBITS(1, 1, 1, 1, 1, 1, 1, 1), DUK__MKBITS(1, 1, 1, 0, 0, 0, 0, 0)   /* 0x70-0x7f */
-};
-#endif  /* DUK_USE_SECTION_B */
-
 typedef struct {
 	duk_hthread *thr;
 	duk_hstring *h_str;
-	duk_hbuffer_dynamic *h_buf;
+	duk_bufwriter_ctx bw;
 	const duk_uint8_t *p;
 	const duk_uint8_t *p_start;
 	const duk_uint8_t *p_end;
+	duk_small_uint_t copy_mask;  /* DUK__TRANSFORM_COPY_xxx for bytes copied as is */
 } duk__transform_context;
 
 typedef void (*duk__transform_callback)(duk__transform_context *tfm_ctx, void *udata, duk_codepoint_t cp);
@@ -108,47 +99,77 @@ DUK_LOCAL duk_small_int_t duk__decode_hex_escape(const duk_uint8_t *p, duk_small
 	return t;
 }
 
-DUK_LOCAL int duk__transform_helper(duk_context *ctx, duk__transform_callback callback, void *udata) {
+/* Skip a run of bytes which are copied as is. */
+DUK_LOCAL const duk_uint8_t *duk__transform_scan_copy(const duk_uint8_t *p, const duk_uint8_t *p_end, duk_small_uint_t copy_mask) {
+	while (p < p_end && (duk__transform_copy_class[*p] & copy_mask)) {
+		p++;
+	}
+	return p;
+}
+
+DUK_LOCAL int duk__transform_helper(duk_context *ctx, duk__transform_callback callback, void *udata, duk_small_uint_t copy_mask) {
 	duk_hthread *thr = (duk_hthread *) ctx;
 	duk__transform_context tfm_ctx_alloc;
 	duk__transform_context *tfm_ctx = &tfm_ctx_alloc;
+	const duk_uint8_t *p_run;
 	duk_codepoint_t cp;
 
 	tfm_ctx->thr = thr;
+	tfm_ctx->copy_mask = copy_mask;
 
 	tfm_ctx->h_str = duk_to_hstring(ctx, 0);
 	DUK_ASSERT(tfm_ctx->h_str != NULL);
 
-	(void) duk_push_dynamic_buffer(ctx, 0);
-	tfm_ctx->h_buf = (duk_hbuffer_dynamic *) duk_get_hbuffer(ctx, -1);
-	DUK_ASSERT(tfm_ctx->h_buf != NULL);
-	DUK_ASSERT(DUK_HBUFFER_HAS_DYNAMIC(tfm_ctx->h_buf));
-
 	tfm_ctx->p_start = DUK_HSTRING_GET_DATA(tfm_ctx->h_str);
 	tfm_ctx->p_end = tfm_ctx->p_start + DUK_HSTRING_GET_BYTELEN(tfm_ctx->h_str);
 	tfm_ctx->p = tfm_ctx->p_start;
 
-	while (tfm_ctx->p < tfm_ctx->p_end) {
+	/* If the whole input is copied as is, the result is the input
+	 * string itself and no buffer is needed.
+	 */
+	p_run = duk__transform_scan_copy(tfm_ctx->p, tfm_ctx->p_end, copy_mask);
+	if (p_run == tfm_ctx->p_end) {
+		duk_push_hstring(ctx, tfm_ctx->h_str);
+		return 1;
+	}
+
+	DUK_BW_INIT_PUSHBUF(thr, &tfm_ctx->bw, DUK_HSTRING_GET_BYTELEN(tfm_ctx->h_str));  /* initial size guess */
+
+	for (;;) {
+		/* Copy a run of bytes needing no transformation in one step,
+		 * then handle one codepoint with the callback.
+		 */
+		if (p_run > tfm_ctx->p) {
+			DUK_BW_WRITE_ENSURE_BYTES(thr, &tfm_ctx->bw, tfm_ctx->p, (duk_size_t) (p_run - tfm_ctx->p));
+			tfm_ctx->p = p_run;
+		}
+		if (tfm_ctx->p >= tfm_ctx->p_end) {
+			break;
+		}
 		cp = (duk_codepoint_t) duk_unicode_decode_xutf8_checked(thr, &tfm_ctx->p, tfm_ctx->p_start, tfm_ctx->p_end);
 		callback(tfm_ctx, udata, cp);
+		p_run = duk__transform_scan_copy(tfm_ctx->p, tfm_ctx->p_end, copy_mask);
 	}
 
+	DUK_BW_FINISH(thr, &tfm_ctx->bw);
 	duk_to_string(ctx, -1);
 	return 1;
 }
 
 DUK_LOCAL void duk__transform_callback_encode_uri(duk__transform_context *tfm_ctx, void *udata, duk_codepoint_t cp) {
 	duk_uint8_t xutf8_buf[DUK_UNICODE_MAX_XUTF8_LENGTH];
-	duk_uint8_t buf[3];
 	duk_small_int_t len;
 	duk_codepoint_t cp1, cp2;
 	duk_small_int_t i, t;
-	const duk_uint8_t *unescaped_table = (duk_uint8_t *) udata;
+
+	DUK_UNREF(udata);
+
+	DUK_BW_ENSURE(tfm_ctx->thr, &tfm_ctx->bw, 3 * DUK_UNICODE_MAX_XUTF8_LENGTH);
 
 	if (cp < 0) {
 		goto uri_error;
-	} else if ((cp < 0x80L) && DUK__CHECK_BITMASK(unescaped_table, cp)) {
-		duk_hbuffer_append_byte(tfm_ctx->thr, tfm_ctx->h_buf, (duk_uint8_t) cp);
+	} else if ((cp < 0x80L) && (duk__transform_copy_class[cp] & tfm_ctx->copy_mask)) {
+		DUK_BW_WRITE_RAW_U8(tfm_ctx->thr, &tfm_ctx->bw, (duk_uint8_t) cp);
 		return;
 	} else if (cp >= 0xdc00L && cp <= 0xdfffL) {
 		goto uri_error;
@@ -178,12 +199,12 @@ DUK_LOCAL void duk__transform_callback_encode_uri(duk__transform_context *tfm_ct
 	}
 
 	len = duk_unicode_encode_xutf8((duk_ucodepoint_t) cp, xutf8_buf);
-	buf[0] = (duk_uint8_t) '%';
 	for (i = 0; i < len; i++) {
 		t = (int) xutf8_buf[i];
-		buf[1] = (duk_uint8_t) duk_uc_nybbles[t >> 4];
-		buf[2] = (duk_uint8_t) duk_uc_nybbles[t & 0x0f];
-		duk_hbuffer_append_bytes(tfm_ctx->thr, tfm_ctx->h_buf, buf, 3);
+		DUK_BW_WRITE_RAW_U8(tfm_ctx->thr, &tfm_ctx->bw, DUK_ASC_PERCENT);
+		DUK_BW_WRITE_RAW_U8_2(tfm_ctx->thr, &tfm_ctx->bw,
+		                      duk_uc_nybbles[t >> 4],
+		                      duk_uc_nybbles[t & 0x0f]);
 	}
 	return;
 
@@ -198,6 +219,11 @@ DUK_LOCAL void duk__transform_callback_decode_uri(duk__transform_context *tfm_ct
 	duk_small_int_t t;  /* must be signed */
 	duk_small_uint_t i;
 
+	/* Most writes are one XUTF-8 codepoint or a reserved '%xx' escape;
+	 * a surrogate pair reserves more space below.
+	 */
+	DUK_BW_ENSURE(tfm_ctx->thr, &tfm_ctx->bw, DUK_UNICODE_MAX_XUTF8_LENGTH);
+
 	if (cp == (duk_codepoint_t) '%') {
 		const duk_uint8_t *p = tfm_ctx->p;
 		duk_size_t left = (duk_size_t) (tfm_ctx->p_end - p);  /* bytes left */
@@ -218,9 +244,9 @@ DUK_LOCAL void duk__transform_callback_decode_uri(duk__transform_context *tfm_ct
 			if (DUK__CHECK_BITMASK(reserved_table, t)) {
 				/* decode '%xx' to '%xx' if decoded char in reserved set */
 				DUK_ASSERT(tfm_ctx->p - 1 >= tfm_ctx->p_start);
-				duk_hbuffer_append_bytes(tfm_ctx->thr, tfm_ctx->h_buf, (duk_uint8_t *) (p - 1), 3);
+				DUK_BW_WRITE_RAW_BYTES(tfm_ctx->thr, &tfm_ctx->bw, (const duk_uint8_t *) (p - 1), 3);
 			} else {
-				duk_hbuffer_append_byte(tfm_ctx->thr, tfm_ctx->h_buf, (duk_uint8_t) t);
+				DUK_BW_WRITE_RAW_U8(tfm_ctx->thr, &tfm_ctx->bw, (duk_uint8_t) t);
 			}
 			tfm_ctx->p += 2;
 			return;
@@ -302,13 +328,14 @@ DUK_LOCAL void duk__transform_callback_decode_uri(duk__transform_context *tfm_ct
 		if (cp >= 0x10000L) {
 			cp -= 0x10000L;
 			DUK_ASSERT(cp < 0x100000L);
-			duk_hbuffer_append_xutf8(tfm_ctx->thr, tfm_ctx->h_buf, (duk_ucodepoint_t) ((cp >> 10) + 0xd800L));
-			duk_hbuffer_append_xutf8(tfm_ctx->thr, tfm_ctx->h_buf, (duk_ucodepoint_t) ((cp & 0x03ffUL) + 0xdc00L));
+			DUK_BW_ENSURE(tfm_ctx->thr, &tfm_ctx->bw, 2 * DUK_UNICODE_MAX_XUTF8_LENGTH);
+			DUK_BW_WRITE_RAW_XUTF8(tfm_ctx->thr, &tfm_ctx->bw, (duk_ucodepoint_t) ((cp >> 10) + 0xd800L));
+			DUK_BW_WRITE_RAW_XUTF8(tfm_ctx->thr, &tfm_ctx->bw, (duk_ucodepoint_t) ((cp & 0x03ffUL) + 0xdc00L));
 		} else {
-			duk_hbuffer_append_xutf8(tfm_ctx->thr, tfm_ctx->h_buf, (duk_ucodepoint_t) cp);
+			DUK_BW_WRITE_RAW_XUTF8(tfm_ctx->thr, &tfm_ctx->bw, (duk_ucodepoint_t) cp);
 		}
 	} else {
-		duk_hbuffer_append_xutf8(tfm_ctx->thr, tfm_ctx->h_buf, (duk_ucodepoint_t) cp);
+		DUK_BW_WRITE_RAW_XUTF8(tfm_ctx->thr, &tfm_ctx->bw, (duk_ucodepoint_t) cp);
 	}
 	return;
 
@@ -325,7 +352,7 @@ DUK_LOCAL void duk__transform_callback_escape(duk__transform_context *tfm_ctx, v
 
 	if (cp < 0) {
 		goto esc_error;
-	} else if ((cp < 0x80L) && DUK__CHECK_BITMASK(duk__escape_unescaped_table, cp)) {
+	} else if ((cp < 0x80L) && (duk__transform_copy_class[cp] & tfm_ctx->copy_mask)) {
 		buf[0] = (duk_uint8_t) cp;
 		len = 1;
 	} else if (cp < 0x100L) {
@@ -350,7 +377,7 @@ DUK_LOCAL void duk__transform_callback_escape(duk__transform_context *tfm_ctx, v
 		goto esc_error;
 	}
 
-	duk_hbuffer_append_bytes(tfm_ctx->thr, tfm_ctx->h_buf, buf, len);
+	DUK_BW_WRITE_ENSURE_BYTES(tfm_ctx->thr, &tfm_ctx->bw, buf, len);
 	return;
 
  esc_error:
@@ -377,7 +404,7 @@ DUK_LOCAL void duk__transform_callback_unescape(duk__transform_context *tfm_ctx,
 		}
 	}
 
-	duk_hbuffer_append_xutf8(tfm_ctx->thr, tfm_ctx->h_buf, cp);
+	DUK_BW_WRITE_ENSURE_XUTF8(tfm_ctx->thr, &tfm_ctx->bw, cp);
 }
 #endif  /* DUK_USE_SECTION_B */
 
@@ -651,28 +678,28 @@ DUK_INTERNAL duk_ret_t duk_bi_global_object_is_finite(duk_context *ctx) {
  */
 
 DUK_INTERNAL duk_ret_t duk_bi_global_object_decode_uri(duk_context *ctx) {
-	return duk__transform_helper(ctx, duk__transform_callback_decode_uri, (void *) duk__decode_uri_reserved_table);
+	return duk__transform_helper(ctx, duk__transform_callback_decode_uri, (void *) duk__decode_uri_reserved_table, DUK__TRANSFORM_COPY_DECODE);
 }
 
 DUK_INTERNAL duk_ret_t duk_bi_global_object_decode_uri_component(duk_context *ctx) {
-	return duk__transform_helper(ctx, duk__transform_callback_decode_uri, (void *) duk__decode_uri_component_reserved_table);
+	return duk__transform_helper(ctx, duk__transform_callback_decode_uri, (void *) duk__decode_uri_component_reserved_table, DUK__TRANSFORM_COPY_DECODE);
 }
 
 DUK_INTERNAL duk_ret_t duk_bi_global_object_encode_uri(duk_context *ctx) {
-	return duk__transform_helper(ctx, duk__transform_callback_encode_uri, (void *) duk__encode_uriunescaped_table);
+	return duk__transform_helper(ctx, duk__transform_callback_encode_uri, (void *) NULL, DUK__TRANSFORM_COPY_URI);
 }
 
 DUK_INTERNAL duk_ret_t duk_bi_global_object_encode_uri_component(duk_context *ctx) {
-	return duk__transform_helper(ctx, duk__transform_callback_encode_uri, (void *) duk__encode_uricomponent_unescaped_table);
+	return duk__transform_helper(ctx, duk__transform_callback_encode_uri, (void *) NULL, DUK__TRANSFORM_COPY_URICOMPONENT);
 }
 
 #ifdef DUK_USE_SECTION_B
 DUK_INTERNAL duk_ret_t duk_bi_global_object_escape(duk_context *ctx) {
-	return duk__transform_helper(ctx, duk__transform_callback_escape, (void *) NULL);
+	return duk__transform_helper(ctx, duk__transform_callback_escape, (void *) NULL, DUK__TRANSFORM_COPY_ESCAPE);
 }
 
 DUK_INTERNAL duk_ret_t duk_bi_global_object_unescape(duk_context *ctx) {
-	return duk__transform_helper(ctx, duk__transform_callback_unescape, (void *) NULL);
+	return duk__transform_helper(ctx, duk__transform_callback_unescape, (void *) NULL, DUK__TRANSFORM_COPY_DECODE);
 }
 #else  /* DUK_USE_SECTION_B */
 DUK_INTERNAL duk_ret_t duk_bi_global_object_escape(duk_context *ctx) {
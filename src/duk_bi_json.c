@@ -13,6 +13,9 @@
  *  Local defines and forward declarations.
  */
 
+#define DUK__JSON_DECSTR_BUFSIZE       128
+#define DUK__JSON_STRINGIFY_BUFSIZE    128
+
 DUK_LOCAL_DECL void duk__dec_syntax_error(duk_json_dec_ctx *js_ctx);
 DUK_LOCAL_DECL void duk__dec_eat_white(duk_json_dec_ctx *js_ctx);
 DUK_LOCAL_DECL duk_small_int_t duk__dec_peek(duk_json_dec_ctx *js_ctx);
@@ -37,7 +40,6 @@ DUK_LOCAL_DECL void duk__dec_reviver_walk(duk_json_dec_ctx *js_ctx);
 DUK_LOCAL_DECL void duk__emit_1(duk_json_enc_ctx *js_ctx, duk_uint_fast8_t ch);
 DUK_LOCAL_DECL void duk__emit_2(duk_json_enc_ctx *js_ctx, duk_uint_fast16_t packed_chars);
 DUK_LOCAL_DECL void duk__emit_esc_auto(duk_json_enc_ctx *js_ctx, duk_uint_fast32_t cp);
-DUK_LOCAL_DECL void duk__emit_xutf8(duk_json_enc_ctx *js_ctx, duk_uint_fast32_t cp);
 DUK_LOCAL_DECL void duk__emit_hstring(duk_json_enc_ctx *js_ctx, duk_hstring *h);
 #if defined(DUK_USE_JX) || defined(DUK_USE_JC)
 DUK_LOCAL_DECL void duk__emit_cstring(duk_json_enc_ctx *js_ctx, const char *p);
@@ -186,7 +188,8 @@ DUK_LOCAL void duk__dec_req_stridx(duk_json_dec_ctx *js_ctx, duk_small_uint_t st
 DUK_LOCAL void duk__dec_string(duk_json_dec_ctx *js_ctx) {
 	duk_hthread *thr = js_ctx->thr;
 	duk_context *ctx = (duk_context *) thr;
-	duk_hbuffer_dynamic *h_buf;
+	duk_bufwriter_ctx bw_alloc;
+	duk_bufwriter_ctx *bw;
 	duk_small_int_t x;
 	duk_uint_fast32_t cp;
 
@@ -197,12 +200,15 @@ DUK_LOCAL void duk__dec_string(duk_json_dec_ctx *js_ctx) {
 	 * so they'll simply pass through (valid UTF-8 or not).
 	 */
 
-	duk_push_dynamic_buffer(ctx, 0);
-	h_buf = (duk_hbuffer_dynamic *) duk_get_hbuffer(ctx, -1);
-	DUK_ASSERT(h_buf != NULL);
-	DUK_ASSERT(DUK_HBUFFER_HAS_DYNAMIC(h_buf));
+	bw = &bw_alloc;
+	DUK_BW_INIT_PUSHBUF(thr, bw, DUK__JSON_DECSTR_BUFSIZE);
 
 	for (;;) {
+		/* Reserve space for one XUTF-8 codepoint, the maximum
+		 * produced by one iteration.
+		 */
+		DUK_BW_ENSURE(thr, bw, DUK_UNICODE_MAX_XUTF8_LENGTH);
+
 		x = duk__dec_get(js_ctx);
 		if (x == DUK_ASC_DOUBLEQUOTE) {
 			break;
@@ -247,15 +253,16 @@ DUK_LOCAL void duk__dec_string(duk_json_dec_ctx *js_ctx) {
 				/* catches EOF (-1) */
 				goto syntax_error;
 			}
-			duk_hbuffer_append_xutf8(thr, h_buf, (duk_uint32_t) cp);
+			DUK_BW_WRITE_RAW_XUTF8(thr, bw, cp);
 		} else if (x < 0x20) {
 			/* catches EOF (-1) */
 			goto syntax_error;
 		} else {
-			duk_hbuffer_append_byte(thr, h_buf, (duk_uint8_t) x);
+			DUK_BW_WRITE_RAW_U8(thr, bw, (duk_uint8_t) x);
 		}
 	}
 
+	DUK_BW_FINISH(thr, bw);
 	duk_to_string(ctx, -1);
 
 	/* [ ... str ] */
@@ -807,22 +814,26 @@ DUK_LOCAL void duk__dec_reviver_walk(duk_json_dec_ctx *js_ctx) {
 #define DUK__EMIT_1(js_ctx,ch)          duk__emit_1((js_ctx), (duk_uint_fast8_t) (ch))
 #define DUK__EMIT_2(js_ctx,ch1,ch2)     duk__emit_2((js_ctx), (((duk_uint_fast16_t)(ch1)) << 8) + (duk_uint_fast16_t)(ch2))
 #define DUK__EMIT_ESC_AUTO(js_ctx,cp)   duk__emit_esc_auto((js_ctx), (cp))
-#define DUK__EMIT_XUTF8(js_ctx,cp)      duk__emit_xutf8((js_ctx), (cp))
 #define DUK__EMIT_HSTR(js_ctx,h)        duk__emit_hstring((js_ctx), (h))
 #if defined(DUK_USE_JX) || defined(DUK_USE_JC)
 #define DUK__EMIT_CSTR(js_ctx,p)        duk__emit_cstring((js_ctx), (p))
 #endif
 #define DUK__EMIT_STRIDX(js_ctx,i)      duk__emit_stridx((js_ctx), (i))
 
+/* Maximum output length for one escaped codepoint: "\U+XXXXXXXX"-style
+ * escapes are 10 bytes, a non-escaped XUTF-8 codepoint is at most 7 bytes.
+ */
+#define DUK__JSON_MAX_ESC_LEN  10
+
 DUK_LOCAL void duk__emit_1(duk_json_enc_ctx *js_ctx, duk_uint_fast8_t ch) {
-	duk_hbuffer_append_byte(js_ctx->thr, js_ctx->h_buf, (duk_uint8_t) ch);
+	DUK_BW_WRITE_ENSURE_U8(js_ctx->thr, &js_ctx->bw, ch);
 }
 
 DUK_LOCAL void duk__emit_2(duk_json_enc_ctx *js_ctx, duk_uint_fast16_t packed_chars) {
-	duk_uint8_t buf[2];
-	buf[0] = (duk_uint8_t) (packed_chars >> 8);
-	buf[1] = (duk_uint8_t) (packed_chars & 0xff);
-	duk_hbuffer_append_bytes(js_ctx->thr, js_ctx->h_buf, (duk_uint8_t *) buf, 2);
+	DUK_BW_WRITE_ENSURE_U8_2(js_ctx->thr,
+	                         &js_ctx->bw,
+	                         (duk_uint8_t) (packed_chars >> 8),
+	                         (duk_uint8_t) (packed_chars & 0xff));
 }
 
 #define DUK__MKESC(nybbles,esc1,esc2)  \
@@ -831,7 +842,6 @@ DUK_LOCAL void duk__emit_2(duk_json_enc_ctx *js_ctx, duk_uint_fast16_t packed_ch
 	((duk_uint_fast32_t) (esc2))
 
 DUK_LOCAL void duk__emit_esc_auto(duk_json_enc_ctx *js_ctx, duk_uint_fast32_t cp) {
-	duk_uint8_t buf[2];
 	duk_uint_fast32_t tmp;
 	duk_small_uint_t dig;
 
@@ -868,34 +878,29 @@ DUK_LOCAL void duk__emit_esc_auto(duk_json_enc_ctx *js_ctx, duk_uint_fast32_t cp
 		}
 	}
 
-	buf[0] = (duk_uint8_t) ((tmp >> 8) & 0xff);
-	buf[1] = (duk_uint8_t) (tmp & 0xff);
-	duk_hbuffer_append_bytes(js_ctx->thr, js_ctx->h_buf, buf, 2);
+	DUK_BW_ENSURE(js_ctx->thr, &js_ctx->bw, DUK__JSON_MAX_ESC_LEN);
+	DUK_BW_WRITE_RAW_U8_2(js_ctx->thr,
+	                      &js_ctx->bw,
+	                      (duk_uint8_t) ((tmp >> 8) & 0xff),
+	                      (duk_uint8_t) (tmp & 0xff));
 
 	tmp = tmp >> 16;
 	while (tmp > 0) {
 		tmp--;
 		dig = (duk_small_uint_t) ((cp >> (4 * tmp)) & 0x0f);
-		duk_hbuffer_append_byte(js_ctx->thr, js_ctx->h_buf, duk_lc_digits[dig]);
+		DUK_BW_WRITE_RAW_U8(js_ctx->thr, &js_ctx->bw, duk_lc_digits[dig]);
 	}
 }
 
-DUK_LOCAL void duk__emit_xutf8(duk_json_enc_ctx *js_ctx, duk_uint_fast32_t cp) {
-	(void) duk_hbuffer_append_xutf8(js_ctx->thr, js_ctx->h_buf, cp);
-}
-
 DUK_LOCAL void duk__emit_hstring(duk_json_enc_ctx *js_ctx, duk_hstring *h) {
 	DUK_ASSERT(h != NULL);
-	duk_hbuffer_append_bytes(js_ctx->thr,
-	                         js_ctx->h_buf,
-	                         (duk_uint8_t *) DUK_HSTRING_GET_DATA(h),
-	                         (duk_size_t) DUK_HSTRING_GET_BYTELEN(h));
+	DUK_BW_WRITE_ENSURE_HSTRING(js_ctx->thr, &js_ctx->bw, h);
 }
 
 #if defined(DUK_USE_JX) || defined(DUK_USE_JC)
 DUK_LOCAL void duk__emit_cstring(duk_json_enc_ctx *js_ctx, const char *p) {
 	DUK_ASSERT(p != NULL);
-	(void) duk_hbuffer_append_cstring(js_ctx->thr, js_ctx->h_buf, p);
+	DUK_BW_WRITE_ENSURE_CSTRING(js_ctx->thr, &js_ctx->bw, p);
 }
 #endif
 
@@ -907,44 +912,18 @@ DUK_LOCAL void duk__emit_stridx(duk_json_enc_ctx *js_ctx, duk_small_uint_t strid
 
 /* Check whether key quotes would be needed (custom encoding). */
 DUK_LOCAL duk_bool_t duk__enc_key_quotes_needed(duk_hstring *h_key) {
-	const duk_uint8_t *p, *p_start, *p_end;
-	duk_small_uint_t ch;
-
 	DUK_ASSERT(h_key != NULL);
-	p_start = DUK_HSTRING_GET_DATA(h_key);
-	p_end = p_start + DUK_HSTRING_GET_BYTELEN(h_key);
-	p = p_start;
-
-	DUK_DDD(DUK_DDDPRINT("duk__enc_key_quotes_needed: h_key=%!O, p_start=%p, p_end=%p, p=%p",
-	                     (duk_heaphdr *) h_key, (void *) p_start, (void *) p_end, (void *) p));
 
-	/* Since we only accept ASCII characters, there is no need for
-	 * actual decoding.  A non-ASCII character will be >= 0x80 which
-	 * causes a false return value immediately.
+	/* Only ASCII IdentifierNames are accepted without quotes; this
+	 * (including rejection of an empty string) is cached in the
+	 * identifier flag of the key.
 	 */
+	DUK_HSTRING_ENSURE_CHARCLASS(h_key);
 
-	if (p == p_end) {
-		/* Zero length string is not accepted without quotes */
-		return 1;
-	}
-
-	while (p < p_end) {
-		ch = (duk_small_uint_t) (*p);
-
-		/* Accept ASCII IdentifierStart and IdentifierPart if not first char.
-		 * Function selection is a bit uncommon.
-		 */
-		if ((p > p_start ? duk_unicode_is_identifier_part :
-		                   duk_unicode_is_identifier_start) ((duk_codepoint_t) ch)) {
-			p++;
-			continue;
-		}
+	DUK_DDD(DUK_DDDPRINT("duk__enc_key_quotes_needed: h_key=%!O, identifier=%ld",
+	                     (duk_heaphdr *) h_key, (long) (DUK_HSTRING_HAS_IDENTIFIER(h_key) ? 1 : 0)));
 
-		/* all non-ASCII characters also come here (first byte >= 0x80) */
-		return 1;
-	}
-
-	return 0;
+	return (DUK_HSTRING_HAS_IDENTIFIER(h_key) ? 0 : 1);
 }
 
 /* The Quote(value) operation: quote a string.
@@ -967,6 +946,20 @@ DUK_LOCAL void duk__enc_quote_string(duk_json_enc_ctx *js_ctx, duk_hstring *h_st
 	DUK_DDD(DUK_DDDPRINT("duk__enc_quote_string: h_str=%!O", (duk_heaphdr *) h_str));
 
 	DUK_ASSERT(h_str != NULL);
+
+	DUK_HSTRING_ENSURE_CHARCLASS(h_str);
+	if (DUK_HSTRING_HAS_ASCII(h_str) && !DUK_HSTRING_HAS_JSON_ESCAPE(h_str)) {
+		/* Nothing needs escaping in any mode: copy the string as
+		 * is.  The flags are computed on the first quote of a string,
+		 * so repeated serialization of the same strings is cheap.
+		 */
+		DUK_BW_ENSURE(thr, &js_ctx->bw, DUK_HSTRING_GET_BYTELEN(h_str) + 2);
+		DUK_BW_WRITE_RAW_U8(thr, &js_ctx->bw, DUK_ASC_DOUBLEQUOTE);
+		DUK_BW_WRITE_RAW_HSTRING(thr, &js_ctx->bw, h_str);
+		DUK_BW_WRITE_RAW_U8(thr, &js_ctx->bw, DUK_ASC_DOUBLEQUOTE);
+		return;
+	}
+
 	p_start = DUK_HSTRING_GET_DATA(h_str);
 	p_end = p_start + DUK_HSTRING_GET_BYTELEN(h_str);
 	p = p_start;
@@ -974,6 +967,11 @@ DUK_LOCAL void duk__enc_quote_string(duk_json_enc_ctx *js_ctx, duk_hstring *h_st
 	DUK__EMIT_1(js_ctx, DUK_ASC_DOUBLEQUOTE);
 
 	while (p < p_end) {
+		/* Reserve space for the longest output of one codepoint so
+		 * that the common cases below can write without checks.
+		 */
+		DUK_BW_ENSURE(thr, &js_ctx->bw, DUK__JSON_MAX_ESC_LEN);
+
 		cp = *p;
 
 		if (DUK_LIKELY(cp <= 0x7f)) {
@@ -981,7 +979,7 @@ DUK_LOCAL void duk__enc_quote_string(duk_json_enc_ctx *js_ctx, duk_hstring *h_st
 			p++;
 			if (cp == 0x22 || cp == 0x5c) {
 				/* double quote or backslash */
-				DUK__EMIT_2(js_ctx, DUK_ASC_BACKSLASH, cp);
+				DUK_BW_WRITE_RAW_U8_2(thr, &js_ctx->bw, DUK_ASC_BACKSLASH, cp);
 			} else if (cp < 0x20) {
 				duk_uint_fast8_t esc_char;
 
@@ -990,7 +988,7 @@ DUK_LOCAL void duk__enc_quote_string(duk_json_enc_ctx *js_ctx, duk_hstring *h_st
 				 */
 				if (cp < (sizeof(duk__quote_esc) / sizeof(duk_uint8_t)) &&
 				    (esc_char = duk__quote_esc[cp]) != 0) {
-					DUK__EMIT_2(js_ctx, DUK_ASC_BACKSLASH, esc_char);
+					DUK_BW_WRITE_RAW_U8_2(thr, &js_ctx->bw, DUK_ASC_BACKSLASH, esc_char);
 				} else {
 					DUK__EMIT_ESC_AUTO(js_ctx, cp);
 				}
@@ -998,7 +996,7 @@ DUK_LOCAL void duk__enc_quote_string(duk_json_enc_ctx *js_ctx, duk_hstring *h_st
 				DUK__EMIT_ESC_AUTO(js_ctx, cp);
 			} else {
 				/* any other printable -> as is */
-				DUK__EMIT_1(js_ctx, cp);
+				DUK_BW_WRITE_RAW_U8(thr, &js_ctx->bw, cp);
 			}
 		} else {
 			/* slow path decode */
@@ -1031,7 +1029,7 @@ DUK_LOCAL void duk__enc_quote_string(duk_json_enc_ctx *js_ctx, duk_hstring *h_st
 				DUK__EMIT_ESC_AUTO(js_ctx, cp);
 			} else {
 				/* as is */
-				DUK__EMIT_XUTF8(js_ctx, cp);
+				DUK_BW_WRITE_RAW_XUTF8(thr, &js_ctx->bw, cp);
 			}
 		}
 	}
@@ -1593,10 +1591,16 @@ DUK_LOCAL void duk__enc_value2(duk_json_enc_ctx *js_ctx) {
 			p = (duk_uint8_t *) DUK_HBUFFER_GET_DATA_PTR(thr->heap, h);
 			p_end = p + DUK_HBUFFER_GET_SIZE(h);
 			DUK__EMIT_1(js_ctx, DUK_ASC_PIPE);
+			if (DUK_HBUFFER_GET_SIZE(h) > DUK_SIZE_MAX / 2) {
+				DUK_ERROR(thr, DUK_ERR_RANGE_ERROR, DUK_STR_BUFFER_TOO_LONG);
+			}
+			DUK_BW_ENSURE(thr, &js_ctx->bw, DUK_HBUFFER_GET_SIZE(h) * 2);
 			while (p < p_end) {
 				x = *p++;
-				duk_hbuffer_append_byte(js_ctx->thr, js_ctx->h_buf, duk_lc_digits[(x >> 4) & 0x0f]);
-				duk_hbuffer_append_byte(js_ctx->thr, js_ctx->h_buf, duk_lc_digits[x & 0x0f]);
+				DUK_BW_WRITE_RAW_U8_2(thr,
+				                      &js_ctx->bw,
+				                      duk_lc_digits[(x >> 4) & 0x0f],
+				                      duk_lc_digits[x & 0x0f]);
 			}
 			DUK__EMIT_1(js_ctx, DUK_ASC_PIPE);
 		}
@@ -1910,10 +1914,7 @@ void duk_bi_json_stringify_helper(duk_context *ctx,
 		                             DUK_TYPE_MASK_LIGHTFUNC;
 	}
 
-	(void) duk_push_dynamic_buffer(ctx, 0);
-	js_ctx->h_buf = (duk_hbuffer_dynamic *) duk_get_hbuffer(ctx, -1);
-	DUK_ASSERT(js_ctx->h_buf != NULL);
-	DUK_ASSERT(DUK_HBUFFER_HAS_DYNAMIC(js_ctx->h_buf));
+	DUK_BW_INIT_PUSHBUF(thr, &js_ctx->bw, DUK__JSON_STRINGIFY_BUFSIZE);
 
 	js_ctx->idx_loop = duk_push_object_internal(ctx);
 	DUK_ASSERT(js_ctx->idx_loop >= 0);
@@ -2035,7 +2036,7 @@ void duk_bi_json_stringify_helper(duk_context *ctx,
 	DUK_DDD(DUK_DDDPRINT("before: flags=0x%08lx, buf=%!O, loop=%!T, replacer=%!O, "
 	                     "proplist=%!T, gap=%!O, indent=%!O, holder=%!T",
 	                     (unsigned long) js_ctx->flags,
-	                     (duk_heaphdr *) js_ctx->h_buf,
+	                     (duk_heaphdr *) DUK_BW_GET_BUFFER(thr, &js_ctx->bw),
 	                     (duk_tval *) duk_get_tval(ctx, js_ctx->idx_loop),
 	                     (duk_heaphdr *) js_ctx->h_replacer,
 	                     (duk_tval *) (js_ctx->idx_proplist >= 0 ? duk_get_tval(ctx, js_ctx->idx_proplist) : NULL),
@@ -2054,7 +2055,7 @@ void duk_bi_json_stringify_helper(duk_context *ctx,
 	DUK_DDD(DUK_DDDPRINT("after: flags=0x%08lx, buf=%!O, loop=%!T, replacer=%!O, "
 	                     "proplist=%!T, gap=%!O, indent=%!O, holder=%!T",
 	                     (unsigned long) js_ctx->flags,
-	                     (duk_heaphdr *) js_ctx->h_buf,
+	                     (duk_heaphdr *) DUK_BW_GET_BUFFER(thr, &js_ctx->bw),
 	                     (duk_tval *) duk_get_tval(ctx, js_ctx->idx_loop),
 	                     (duk_heaphdr *) js_ctx->h_replacer,
 	                     (duk_tval *) (js_ctx->idx_proplist >= 0 ? duk_get_tval(ctx, js_ctx->idx_proplist) : NULL),
@@ -2074,9 +2075,7 @@ void duk_bi_json_stringify_helper(duk_context *ctx,
 		 */
 
 		duk__enc_value2(js_ctx);  /* [ ... key val ] -> [ ... ] */
-		DUK_ASSERT(js_ctx->h_buf != NULL);
-		duk_push_hbuffer(ctx, (duk_hbuffer *) js_ctx->h_buf);
-		duk_to_string(ctx, -1);
+		DUK_BW_PUSH_AS_STRING(thr, &js_ctx->bw);
 	}
 
 	/* The stack has a variable shape here, so force it to the
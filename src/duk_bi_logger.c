@@ -175,7 +175,7 @@ DUK_INTERNAL duk_ret_t duk_bi_logger_prototype_log_shared(duk_context *ctx) {
 	/* log level could be popped but that's not necessary */
 
 	now = duk_bi_date_get_now(ctx);
-	duk_bi_date_format_timeval(now, date_buf);
+	duk_bi_date_format_timeval(ctx, now, date_buf);
 	date_len = DUK_STRLEN((const char *) date_buf);
 
 	duk_get_prop_stridx(ctx, -2, DUK_STRIDX_LC_N);
@@ -18,11 +18,52 @@
 typedef double (*duk__one_arg_func)(double);
 typedef double (*duk__two_arg_func)(double, double);
 
+/* Indices of one argument functions, must match genbuiltins.py.  The
+ * fastint fast path depends on these, so they are asserted against the
+ * function table in duk_bi_math_object_onearg_shared().
+ */
+#define DUK__MATH_FABS_IDX   0
+#define DUK__MATH_CEIL_IDX   4
+#define DUK__MATH_FLOOR_IDX  7
+#define DUK__MATH_ROUND_IDX  9
+
 DUK_LOCAL duk_ret_t duk__math_minmax(duk_context *ctx, duk_double_t initial, duk__two_arg_func min_max) {
 	duk_idx_t n = duk_get_top(ctx);
 	duk_idx_t i;
 	duk_double_t res = initial;
 	duk_double_t t;
+#if defined(DUK_USE_FASTINT)
+	duk_tval *tv;
+	duk_int64_t fi_res;
+	duk_int64_t fi_t;
+	duk_idx_t i_res;
+	duk_bool_t is_max;
+
+	/* Fast path when all arguments are fastints: there are no coercion
+	 * side effects, NaNs or negative zeroes to deal with, and the result
+	 * is one of the arguments so it can be returned as is.
+	 */
+	if (n > 0) {
+		is_max = (initial < 0.0);  /* -Infinity for max, +Infinity for min */
+		fi_res = 0;
+		i_res = 0;
+		for (i = 0; i < n; i++) {
+			tv = duk_get_tval(ctx, i);
+			DUK_ASSERT(tv != NULL);
+			if (!DUK_TVAL_IS_FASTINT(tv)) {
+				goto skip_fastint;
+			}
+			fi_t = DUK_TVAL_GET_FASTINT(tv);
+			if (i == 0 || (is_max ? fi_t > fi_res : fi_t < fi_res)) {
+				fi_res = fi_t;
+				i_res = i;
+			}
+		}
+		duk_dup(ctx, i_res);
+		return 1;
+	}
+ skip_fastint:
+#endif  /* DUK_USE_FASTINT */
 
 	/*
 	 *  Note: fmax() does not match the E5 semantics.  E5 requires
@@ -284,9 +325,41 @@ DUK_LOCAL const duk__two_arg_func duk__two_arg_funcs[] = {
 DUK_INTERNAL duk_ret_t duk_bi_math_object_onearg_shared(duk_context *ctx) {
 	duk_small_int_t fun_idx = duk_get_current_magic(ctx);
 	duk__one_arg_func fun;
+#if defined(DUK_USE_FASTINT)
+	duk_tval *tv;
+#endif
 
 	DUK_ASSERT(fun_idx >= 0);
 	DUK_ASSERT(fun_idx < (duk_small_int_t) (sizeof(duk__one_arg_funcs) / sizeof(duk__one_arg_func)));
+
+#if defined(DUK_USE_FASTINT)
+#if defined(DUK_USE_AVOID_PLATFORM_FUNCPTRS)
+	DUK_ASSERT(duk__one_arg_funcs[DUK__MATH_FABS_IDX] == duk__fabs);
+	DUK_ASSERT(duk__one_arg_funcs[DUK__MATH_CEIL_IDX] == duk__ceil);
+	DUK_ASSERT(duk__one_arg_funcs[DUK__MATH_FLOOR_IDX] == duk__floor);
+#else
+	DUK_ASSERT(duk__one_arg_funcs[DUK__MATH_FABS_IDX] == DUK_FABS);
+	DUK_ASSERT(duk__one_arg_funcs[DUK__MATH_CEIL_IDX] == DUK_CEIL);
+	DUK_ASSERT(duk__one_arg_funcs[DUK__MATH_FLOOR_IDX] == DUK_FLOOR);
+#endif
+	DUK_ASSERT(duk__one_arg_funcs[DUK__MATH_ROUND_IDX] == duk__round_fixed);
+
+	/* Rounding functions are identities for integers, and so is
+	 * Math.abs() for non-negative ones: return the fastint argument
+	 * (which is the only value on the stack) as is.
+	 */
+	DUK_ASSERT(duk_get_top(ctx) == 1);
+	tv = duk_get_tval(ctx, 0);
+	DUK_ASSERT(tv != NULL);
+	if (DUK_TVAL_IS_FASTINT(tv)) {
+		if (fun_idx == DUK__MATH_CEIL_IDX ||
+		    fun_idx == DUK__MATH_FLOOR_IDX ||
+		    fun_idx == DUK__MATH_ROUND_IDX ||
+		    (fun_idx == DUK__MATH_FABS_IDX && DUK_TVAL_GET_FASTINT(tv) >= 0)) {
+			return 1;
+		}
+	}
+#endif  /* DUK_USE_FASTINT */
 	fun = duk__one_arg_funcs[fun_idx];
 	duk_push_number(ctx, (duk_double_t) fun((double) duk_to_number(ctx, 0)));
 	return 1;
@@ -48,7 +48,8 @@ DUK_INTERNAL duk_ret_t duk_bi_string_constructor(duk_context *ctx) {
 
 DUK_INTERNAL duk_ret_t duk_bi_string_constructor_from_char_code(duk_context *ctx) {
 	duk_hthread *thr = (duk_hthread *) ctx;
-	duk_hbuffer_dynamic *h;
+	duk_bufwriter_ctx bw_alloc;
+	duk_bufwriter_ctx *bw;
 	duk_idx_t i, n;
 	duk_ucodepoint_t cp;
 
@@ -59,8 +60,9 @@ DUK_INTERNAL duk_ret_t duk_bi_string_constructor_from_char_code(duk_context *ctx
 	 */
 
 	n = duk_get_top(ctx);
-	duk_push_dynamic_buffer(ctx, 0);  /* XXX: initial spare size estimate from 'n' */
-	h = (duk_hbuffer_dynamic *) duk_get_hbuffer(ctx, -1);
+
+	bw = &bw_alloc;
+	DUK_BW_INIT_PUSHBUF(thr, bw, n);  /* initial estimate for ASCII only codepoints */
 
 	for (i = 0; i < n; i++) {
 #if defined(DUK_USE_NONSTD_STRING_FROMCHARCODE_32BIT)
@@ -70,13 +72,14 @@ DUK_INTERNAL duk_ret_t duk_bi_string_constructor_from_char_code(duk_context *ctx
 		 * surrogate pairs.
 		 */
 		cp = (duk_ucodepoint_t) duk_to_uint32(ctx, i);
-		duk_hbuffer_append_xutf8(thr, h, cp);
+		DUK_BW_WRITE_ENSURE_XUTF8(thr, bw, cp);
 #else
 		cp = (duk_ucodepoint_t) duk_to_uint16(ctx, i);
-		duk_hbuffer_append_cesu8(thr, h, cp);
+		DUK_BW_WRITE_ENSURE_CESU8(thr, bw, cp);
 #endif
 	}
 
+	DUK_BW_FINISH(thr, bw);
 	duk_to_string(ctx, -1);
 	return 1;
 }
@@ -299,6 +302,143 @@ DUK_INTERNAL duk_ret_t duk_bi_string_prototype_caseconv_shared(duk_context *ctx)
 	return 1;
 }
 
+/*
+ *  Substring search helpers
+ *
+ *  Shared by indexOf(), lastIndexOf(), replace() and split() for plain
+ *  string patterns.  The helpers work on byte offsets only; callers
+ *  convert the match position to a character offset once, by counting
+ *  the characters between a known char/byte offset pair and the match
+ *  (instead of tracking the char offset for every byte scanned); for ASCII
+ *  strings the offsets are the same and no counting is needed.
+ *
+ *  Short needles and haystacks use DUK_MEMCHR() (which is typically well
+ *  optimized by the platform) to find candidates for the first byte and
+ *  DUK_MEMCMP() to verify them.  Longer needles use Boyer-Moore-Horspool
+ *  with a byte sized skip table: shifts are capped to 255 which is always
+ *  safe (just suboptimal for very long needles).
+ */
+
+#define DUK__SEARCH_BMH_MIN_NEEDLE    8    /* minimum needle byte length for BMH */
+#define DUK__SEARCH_BMH_MIN_HAYSTACK  256  /* minimum scanned byte length for BMH */
+
+/* Character length of a byte range of 'h', trivial for ASCII strings. */
+DUK_LOCAL duk_uint32_t duk__search_charlen(duk_hstring *h, const duk_uint8_t *p, duk_size_t blen) {
+	if (DUK_HSTRING_HAS_ASCII(h)) {
+		return (duk_uint32_t) blen;
+	}
+	return (duk_uint32_t) duk_unicode_unvalidated_utf8_length(p, blen);
+}
+
+/* Find the first match starting in [p,p_last], NULL if not found.
+ * The caller ensures that a full needle fits at 'p_last' and q_blen > 0.
+ */
+DUK_LOCAL const duk_uint8_t *duk__search_forward(const duk_uint8_t *p, const duk_uint8_t *p_last, const duk_uint8_t *q_start, duk_size_t q_blen) {
+	duk_uint8_t skip[256];
+	duk_uint8_t firstbyte;
+	duk_uint8_t lastbyte;
+	duk_uint8_t t;
+	duk_size_t i;
+	duk_size_t n;
+
+	DUK_ASSERT(q_blen > 0);
+
+	if (p > p_last) {
+		return NULL;
+	}
+
+	if (q_blen >= DUK__SEARCH_BMH_MIN_NEEDLE &&
+	    (duk_size_t) (p_last - p) >= DUK__SEARCH_BMH_MIN_HAYSTACK) {
+		/* Skip by the last byte of the current window. */
+		n = (q_blen > 255 ? 255 : q_blen);
+		DUK_MEMSET((void *) skip, (int) n, sizeof(skip));
+		for (i = 0; i < q_blen - 1; i++) {
+			n = q_blen - 1 - i;
+			skip[q_start[i]] = (duk_uint8_t) (n > 255 ? 255 : n);
+		}
+
+		lastbyte = q_start[q_blen - 1];
+		for (;;) {
+			t = p[q_blen - 1];
+			if (t == lastbyte && DUK_MEMCMP((const void *) p, (const void *) q_start, (size_t) (q_blen - 1)) == 0) {
+				return p;
+			}
+			if ((duk_size_t) (p_last - p) < (duk_size_t) skip[t]) {
+				return NULL;
+			}
+			p += skip[t];
+		}
+	}
+
+	firstbyte = q_start[0];
+	for (;;) {
+		p = (const duk_uint8_t *) DUK_MEMCHR((const void *) p, (int) firstbyte, (size_t) (p_last - p + 1));
+		if (p == NULL) {
+			return NULL;
+		}
+		if (q_blen == 1 || DUK_MEMCMP((const void *) (p + 1), (const void *) (q_start + 1), (size_t) (q_blen - 1)) == 0) {
+			return p;
+		}
+		if (p == p_last) {
+			return NULL;
+		}
+		p++;
+	}
+}
+
+/* Find the last match starting in [p_first,p], NULL if not found.
+ * The caller ensures that a full needle fits at 'p' and q_blen > 0.
+ */
+DUK_LOCAL const duk_uint8_t *duk__search_backward(const duk_uint8_t *p_first, const duk_uint8_t *p, const duk_uint8_t *q_start, duk_size_t q_blen) {
+	duk_uint8_t skip[256];
+	duk_uint8_t firstbyte;
+	duk_uint8_t t;
+	duk_size_t i;
+	duk_size_t n;
+
+	DUK_ASSERT(q_blen > 0);
+
+	if (p < p_first) {
+		return NULL;
+	}
+
+	firstbyte = q_start[0];
+
+	if (q_blen >= DUK__SEARCH_BMH_MIN_NEEDLE &&
+	    (duk_size_t) (p - p_first) >= DUK__SEARCH_BMH_MIN_HAYSTACK) {
+		/* Mirror image of the forward case: skip by the first byte
+		 * of the current window.
+		 */
+		n = (q_blen > 255 ? 255 : q_blen);
+		DUK_MEMSET((void *) skip, (int) n, sizeof(skip));
+		for (i = q_blen - 1; i > 0; i--) {
+			skip[q_start[i]] = (duk_uint8_t) (i > 255 ? 255 : i);
+		}
+
+		for (;;) {
+			t = p[0];
+			if (t == firstbyte && DUK_MEMCMP((const void *) (p + 1), (const void *) (q_start + 1), (size_t) (q_blen - 1)) == 0) {
+				return p;
+			}
+			if ((duk_size_t) (p - p_first) < (duk_size_t) skip[t]) {
+				return NULL;
+			}
+			p -= skip[t];
+		}
+	}
+
+	for (;;) {
+		if (p[0] == firstbyte &&
+		    (q_blen == 1 || DUK_MEMCMP((const void *) (p + 1), (const void *) (q_start + 1), (size_t) (q_blen - 1)) == 0)) {
+			return p;
+		}
+		if (p == p_first) {
+			return NULL;
+		}
+		p--;
+	}
+}
+
 /*
  *  indexOf() and lastIndexOf()
  */
@@ -310,11 +450,9 @@ DUK_INTERNAL duk_ret_t duk_bi_string_prototype_indexof_shared(duk_context *ctx)
 	duk_int_t clen_this;
 	duk_int_t cpos;
 	duk_int_t bpos;
-	const duk_uint8_t *p_start, *p_end, *p;
+	const duk_uint8_t *p_start, *p_last, *p, *p_match;
 	const duk_uint8_t *q_start;
 	duk_int_t q_blen;
-	duk_uint8_t firstbyte;
-	duk_uint8_t t;
 	duk_small_int_t is_lastindexof = duk_get_current_magic(ctx);  /* 0=indexOf, 1=lastIndexOf */
 
 	h_this = duk_push_this_coercible_to_string(ctx);
@@ -347,55 +485,40 @@ DUK_INTERNAL duk_ret_t duk_bi_string_prototype_indexof_shared(duk_context *ctx)
 	}
 	DUK_ASSERT(q_blen > 0);
 
+	if ((duk_size_t) q_blen > (duk_size_t) DUK_HSTRING_GET_BYTELEN(h_this)) {
+		goto not_found;
+	}
+
 	bpos = (duk_int_t) duk_heap_strcache_offset_char2byte(thr, h_this, (duk_uint32_t) cpos);
 
 	p_start = DUK_HSTRING_GET_DATA(h_this);
-	p_end = p_start + DUK_HSTRING_GET_BYTELEN(h_this);
+	p_last = p_start + DUK_HSTRING_GET_BYTELEN(h_this) - q_blen;  /* last offset where a full match fits */
 	p = p_start + bpos;
 
-	/* This loop is optimized for size.  For speed, there should be
-	 * two separate loops, and we should ensure that memcmp() can be
-	 * used without an extra "will searchstring fit" check.  Doing
-	 * the preconditioning for 'p' and 'p_end' is easy but cpos
-	 * must be updated if 'p' is wound back (backward scanning).
+	/* For Ecmascript strings a match can only begin at an initial
+	 * UTF-8 byte (not a continuation byte) so the character offset
+	 * of the match is 'cpos' adjusted by the number of characters
+	 * between 'p' and the match.  For other strings all bets are off
+	 * but the result is still well defined.
 	 */
 
-	firstbyte = q_start[0];  /* leading byte of match string */
-	while (p <= p_end && p >= p_start) {
-		t = *p;
-
-		/* For Ecmascript strings, this check can only match for
-		 * initial UTF-8 bytes (not continuation bytes).  For other
-		 * strings all bets are off.
-		 */
-
-		if ((t == firstbyte) && ((duk_size_t) (p_end - p) >= (duk_size_t) q_blen)) {
-			DUK_ASSERT(q_blen > 0);  /* no issues with memcmp() zero size, even if broken */
-			if (DUK_MEMCMP(p, q_start, (duk_size_t) q_blen) == 0) {
-				duk_push_int(ctx, cpos);
-				return 1;
-			}
+	if (is_lastindexof) {
+		p_match = duk__search_backward(p_start, (p < p_last ? p : p_last), q_start, (duk_size_t) q_blen);
+		if (p_match != NULL) {
+			cpos -= (duk_int_t) duk__search_charlen(h_this, p_match, (duk_size_t) (p - p_match));
+			duk_push_int(ctx, cpos);
+			return 1;
 		}
-
-		/* track cpos while scanning */
-		if (is_lastindexof) {
-			/* when going backwards, we decrement cpos 'early';
-			 * 'p' may point to a continuation byte of the char
-			 * at offset 'cpos', but that's OK because we'll
-			 * backtrack all the way to the initial byte.
-			 */
-			if ((t & 0xc0) != 0x80) {
-				cpos--;
-			}
-			p--;
-		} else {
-			if ((t & 0xc0) != 0x80) {
-				cpos++;
-			}
-			p++;
+	} else {
+		p_match = duk__search_forward(p, p_last, q_start, (duk_size_t) q_blen);
+		if (p_match != NULL) {
+			cpos += (duk_int_t) duk__search_charlen(h_this, p, (duk_size_t) (p_match - p));
+			duk_push_int(ctx, cpos);
+			return 1;
 		}
 	}
 
+ not_found:
 	/* Not found.  Empty string case is handled specially above. */
 	duk_push_int(ctx, -1);
 	return 1;
@@ -422,7 +545,8 @@ DUK_INTERNAL duk_ret_t duk_bi_string_prototype_replace(duk_context *ctx) {
 	duk_hstring *h_match;
 	duk_hstring *h_search;
 	duk_hobject *h_re;
-	duk_hbuffer_dynamic *h_buf;
+	duk_bufwriter_ctx bw_alloc;
+	duk_bufwriter_ctx *bw;
 #ifdef DUK_USE_REGEXP_SUPPORT
 	duk_bool_t is_regexp;
 	duk_bool_t is_global;
@@ -438,9 +562,9 @@ DUK_INTERNAL duk_ret_t duk_bi_string_prototype_replace(duk_context *ctx) {
 	DUK_ASSERT_TOP(ctx, 2);
 	h_input = duk_push_this_coercible_to_string(ctx);
 	DUK_ASSERT(h_input != NULL);
-	duk_push_dynamic_buffer(ctx, 0);
-	h_buf = (duk_hbuffer_dynamic *) duk_get_hbuffer(ctx, -1);
-	DUK_ASSERT(h_buf != NULL);
+
+	bw = &bw_alloc;
+	DUK_BW_INIT_PUSHBUF(thr, bw, DUK_HSTRING_GET_BYTELEN(h_input));  /* input size is good output starting point */
 	DUK_ASSERT_TOP(ctx, 4);
 
 	/* stack[0] = search value
@@ -526,6 +650,7 @@ DUK_INTERNAL duk_ret_t duk_bi_string_prototype_replace(duk_context *ctx) {
 			duk_get_prop_stridx(ctx, -1, DUK_STRIDX_INDEX);
 			DUK_ASSERT(duk_is_number(ctx, -1));
 			match_start_coff = duk_get_int(ctx, -1);
+			match_start_boff = duk_heap_strcache_offset_char2byte(thr, h_input, match_start_coff);
 			duk_pop(ctx);
 
 			duk_get_prop_index(ctx, -1, 0);
@@ -555,7 +680,7 @@ DUK_INTERNAL duk_ret_t duk_bi_string_prototype_replace(duk_context *ctx) {
 #else  /* DUK_USE_REGEXP_SUPPORT */
 		{  /* unconditionally */
 #endif  /* DUK_USE_REGEXP_SUPPORT */
-			const duk_uint8_t *p_start, *p_end, *p;   /* input string scan */
+			const duk_uint8_t *p_start, *p_match;     /* input string scan */
 			const duk_uint8_t *q_start;               /* match string */
 			duk_size_t q_blen;
 
@@ -564,35 +689,34 @@ DUK_INTERNAL duk_ret_t duk_bi_string_prototype_replace(duk_context *ctx) {
 #endif
 
 			p_start = DUK_HSTRING_GET_DATA(h_input);
-			p_end = p_start + DUK_HSTRING_GET_BYTELEN(h_input);
-			p = p_start;
 
 			h_search = duk_get_hstring(ctx, 0);
 			DUK_ASSERT(h_search != NULL);
 			q_start = DUK_HSTRING_GET_DATA(h_search);
 			q_blen = (duk_size_t) DUK_HSTRING_GET_BYTELEN(h_search);
 
-			p_end -= q_blen;  /* ensure full memcmp() fits in while */
-
-			match_start_coff = 0;
+			if (q_blen == 0) {
+				p_match = p_start;  /* empty string matches at start */
+			} else if (q_blen > (duk_size_t) DUK_HSTRING_GET_BYTELEN(h_input)) {
+				p_match = NULL;
+			} else {
+				p_match = duk__search_forward(p_start,
+				                              p_start + DUK_HSTRING_GET_BYTELEN(h_input) - q_blen,
+				                              q_start,
+				                              q_blen);
+			}
 
-			while (p <= p_end) {
-				DUK_ASSERT(p + q_blen <= DUK_HSTRING_GET_DATA(h_input) + DUK_HSTRING_GET_BYTELEN(h_input));
-				if (DUK_MEMCMP((void *) p, (void *) q_start, (size_t) q_blen) == 0) {
-					duk_dup(ctx, 0);
-					h_match = duk_get_hstring(ctx, -1);
-					DUK_ASSERT(h_match != NULL);
+			if (p_match != NULL) {
+				DUK_ASSERT(p_match + q_blen <= DUK_HSTRING_GET_DATA(h_input) + DUK_HSTRING_GET_BYTELEN(h_input));
+				duk_dup(ctx, 0);
+				h_match = duk_get_hstring(ctx, -1);
+				DUK_ASSERT(h_match != NULL);
 #ifdef DUK_USE_REGEXP_SUPPORT
-					match_caps = 0;
+				match_caps = 0;
 #endif
-					goto found;
-				}
-
-				/* track utf-8 non-continuation bytes */
-				if ((p[0] & 0xc0) != 0x80) {
-					match_start_coff++;
-				}
-				p++;
+				match_start_boff = (duk_uint32_t) (p_match - p_start);
+				match_start_coff = duk__search_charlen(h_input, p_start, (duk_size_t) match_start_boff);
+				goto found;
 			}
 
 			/* not found */
@@ -607,12 +731,10 @@ DUK_INTERNAL duk_ret_t duk_bi_string_prototype_replace(duk_context *ctx) {
 		 * stack[4] = regexp match OR match string
 		 */
 
-		match_start_boff = duk_heap_strcache_offset_char2byte(thr, h_input, match_start_coff);
-
-		duk_hbuffer_append_bytes(thr,
-		                         h_buf,
-		                         DUK_HSTRING_GET_DATA(h_input) + prev_match_end_boff,
-		                         (duk_size_t) (match_start_boff - prev_match_end_boff));
+		DUK_BW_WRITE_ENSURE_BYTES(thr,
+		                          bw,
+		                          DUK_HSTRING_GET_DATA(h_input) + prev_match_end_boff,
+		                          (duk_size_t) (match_start_boff - prev_match_end_boff));
 
 		prev_match_end_boff = match_start_boff + DUK_HSTRING_GET_BYTELEN(h_match);
 
@@ -648,7 +770,7 @@ DUK_INTERNAL duk_ret_t duk_bi_string_prototype_replace(duk_context *ctx) {
 			duk_call(ctx, duk_get_top(ctx) - idx_args);
 			h_repl = duk_to_hstring(ctx, -1);  /* -> [ ... repl_value ] */
 			DUK_ASSERT(h_repl != NULL);
-			duk_hbuffer_append_hstring(thr, h_buf, h_repl);
+			DUK_BW_WRITE_ENSURE_HSTRING(thr, bw, h_repl);
 			duk_pop(ctx);  /* repl_value */
 		} else {
 			r = r_start;
@@ -678,15 +800,15 @@ DUK_INTERNAL duk_ret_t duk_bi_string_prototype_replace(duk_context *ctx) {
 					goto repl_write;
 				}
 				case DUK_ASC_AMP: {
-					duk_hbuffer_append_hstring(thr, h_buf, h_match);
+					DUK_BW_WRITE_ENSURE_HSTRING(thr, bw, h_match);
 					r++;
 					continue;
 				}
 				case DUK_ASC_GRAVE: {
-					duk_hbuffer_append_bytes(thr,
-					                         h_buf,
-					                         DUK_HSTRING_GET_DATA(h_input),
-					                         match_start_boff);
+					DUK_BW_WRITE_ENSURE_BYTES(thr,
+					                          bw,
+					                          DUK_HSTRING_GET_DATA(h_input),
+					                          match_start_boff);
 					r++;
 					continue;
 				}
@@ -700,10 +822,10 @@ DUK_INTERNAL duk_ret_t duk_bi_string_prototype_replace(duk_context *ctx) {
 					                                                    h_input,
 					                                                    match_start_coff + DUK_HSTRING_GET_CHARLEN(h_match));
 
-					duk_hbuffer_append_bytes(thr,
-					                         h_buf,
-					                         DUK_HSTRING_GET_DATA(h_input) + match_end_boff,
-					                         DUK_HSTRING_GET_BYTELEN(h_input) - match_end_boff);
+					DUK_BW_WRITE_ENSURE_BYTES(thr,
+					                          bw,
+					                          DUK_HSTRING_GET_DATA(h_input) + match_end_boff,
+					                          DUK_HSTRING_GET_BYTELEN(h_input) - match_end_boff);
 					r++;
 					continue;
 				}
@@ -742,7 +864,7 @@ DUK_INTERNAL duk_ret_t duk_bi_string_prototype_replace(duk_context *ctx) {
 						duk_get_prop_index(ctx, 4, (duk_uarridx_t) capnum);
 						if (duk_is_string(ctx, -1)) {
 							DUK_ASSERT(duk_get_hstring(ctx, -1) != NULL);
-							duk_hbuffer_append_hstring(thr, h_buf, duk_get_hstring(ctx, -1));
+							DUK_BW_WRITE_ENSURE_HSTRING(thr, bw, duk_get_hstring(ctx, -1));
 						} else {
 							/* undefined -> skip (replaced with empty) */
 						}
@@ -760,7 +882,7 @@ DUK_INTERNAL duk_ret_t duk_bi_string_prototype_replace(duk_context *ctx) {
 
 			 repl_write:
 				/* ch1 = (r_increment << 8) + byte */
-				duk_hbuffer_append_byte(thr, h_buf, (duk_uint8_t) (ch1 & 0xff));
+				DUK_BW_WRITE_ENSURE_U8(thr, bw, (duk_uint8_t) (ch1 & 0xff));
 				r += ch1 >> 8;
 			}  /* while repl */
 		}  /* if (is_repl_func) */
@@ -777,12 +899,13 @@ DUK_INTERNAL duk_ret_t duk_bi_string_prototype_replace(duk_context *ctx) {
 	}
 
 	/* trailer */
-	duk_hbuffer_append_bytes(thr,
-	                         h_buf,
-	                         DUK_HSTRING_GET_DATA(h_input) + prev_match_end_boff,
-	                         (duk_size_t) (DUK_HSTRING_GET_BYTELEN(h_input) - prev_match_end_boff));
+	DUK_BW_WRITE_ENSURE_BYTES(thr,
+	                          bw,
+	                          DUK_HSTRING_GET_DATA(h_input) + prev_match_end_boff,
+	                          (duk_size_t) (DUK_HSTRING_GET_BYTELEN(h_input) - prev_match_end_boff));
 
 	DUK_ASSERT_TOP(ctx, 4);
+	DUK_BW_FINISH(thr, bw);
 	duk_to_string(ctx, -1);
 	return 1;
 }
@@ -920,6 +1043,7 @@ DUK_INTERNAL duk_ret_t duk_bi_string_prototype_split(duk_context *ctx) {
 		{  /* unconditionally */
 #endif  /* DUK_USE_REGEXP_SUPPORT */
 			const duk_uint8_t *p_start, *p_end, *p;   /* input string scan */
+			const duk_uint8_t *p_match;
 			const duk_uint8_t *q_start;               /* match string */
 			duk_size_t q_blen, q_clen;
 
@@ -960,19 +1084,20 @@ DUK_INTERNAL duk_ret_t duk_bi_string_prototype_split(duk_context *ctx) {
 			}
 
 			DUK_ASSERT(q_blen > 0 && q_clen > 0);
-			while (p <= p_end) {
-				DUK_ASSERT(p + q_blen <= DUK_HSTRING_GET_DATA(h_input) + DUK_HSTRING_GET_BYTELEN(h_input));
-				DUK_ASSERT(q_blen > 0);  /* no issues with empty memcmp() */
-				if (DUK_MEMCMP((void *) p, (void *) q_start, (duk_size_t) q_blen) == 0) {
+			if (p <= p_end) {
+				p_match = duk__search_forward(p, p_end, q_start, q_blen);
+				if (p_match != NULL) {
+					DUK_ASSERT(p_match + q_blen <= DUK_HSTRING_GET_DATA(h_input) + DUK_HSTRING_GET_BYTELEN(h_input));
+
+					/* Char offset is updated incrementally from the
+					 * previous match so the input is scanned only once.
+					 */
+					match_start_coff += duk__search_charlen(h_input, p, (duk_size_t) (p_match - p));
+					p = p_match;
+
 					/* never an empty match, so step 13.c.iii can't be triggered */
 					goto found;
 				}
-
-				/* track utf-8 non-continuation bytes */
-				if ((p[0] & 0xc0) != 0x80) {
-					match_start_coff++;
-				}
-				p++;
 			}
 
 		 not_found:
@@ -208,23 +208,39 @@ DUK_INTERNAL duk_ret_t duk_bi_thread_resume(duk_context *ctx) {
  */
 
 DUK_INTERNAL duk_ret_t duk_bi_thread_yield(duk_context *ctx) {
-	duk_hthread *thr = (duk_hthread *) ctx;
-	duk_tval tv_tmp;
-	duk_hobject *caller_func;
 	duk_small_int_t is_error;
 
 	DUK_DDD(DUK_DDDPRINT("Duktape.Thread.yield(): value=%!T, is_error=%!T",
 	                     (duk_tval *) duk_get_tval(ctx, 0),
 	                     (duk_tval *) duk_get_tval(ctx, 1)));
 
-	DUK_ASSERT(thr->state == DUK_HTHREAD_STATE_RUNNING);
-	DUK_ASSERT(thr->heap->curr_thread == thr);
-
 	is_error = (duk_small_int_t) duk_to_boolean(ctx, 1);
 	duk_set_top(ctx, 1);
 
 	/* [ value ] */
 
+	duk_bi_thread_yield_helper(ctx, is_error);
+	return 0;  /* never here */
+}
+
+/*
+ *  Yield the value at the value stack top from the current native call.
+ *  Shared by Duktape.Thread.yield() and duk_yield(): the native call
+ *  (whichever it is) must have been made directly from Ecmascript code.
+ *  When the thread is resumed, the resume value becomes the return value
+ *  of the native call.  Never returns.
+ */
+
+DUK_INTERNAL void duk_bi_thread_yield_helper(duk_context *ctx, duk_small_int_t is_error) {
+	duk_hthread *thr = (duk_hthread *) ctx;
+	duk_tval tv_tmp;
+	duk_hobject *caller_func;
+
+	DUK_ASSERT(thr->state == DUK_HTHREAD_STATE_RUNNING);
+	DUK_ASSERT(thr->heap->curr_thread == thr);
+
+	(void) duk_require_valid_index(ctx, -1);
+
 	/*
 	 *  Thread state and calling context checks
 	 */
@@ -236,22 +252,21 @@ DUK_INTERNAL duk_ret_t duk_bi_thread_yield(duk_context *ctx) {
 	DUK_ASSERT(thr->resumer->state == DUK_HTHREAD_STATE_RESUMED);
 
 	if (thr->callstack_top < 2) {
-		DUK_DD(DUK_DDPRINT("yield state invalid: callstack should contain at least 2 entries (caller and Duktape.Thread.yield)"));
+		DUK_DD(DUK_DDPRINT("yield state invalid: callstack should contain at least 2 entries (caller and yielding native call)"));
 		goto state_error;
 	}
-	DUK_ASSERT(DUK_ACT_GET_FUNC(thr->callstack + thr->callstack_top - 1) != NULL);  /* us */
-	DUK_ASSERT(DUK_HOBJECT_IS_NATIVEFUNCTION(DUK_ACT_GET_FUNC(thr->callstack + thr->callstack_top - 1)));
-	DUK_ASSERT(DUK_ACT_GET_FUNC(thr->callstack + thr->callstack_top - 2) != NULL);  /* caller */
+	DUK_ASSERT(DUK_ACT_GET_FUNC(thr->callstack + thr->callstack_top - 1) == NULL ||  /* us, may be a lightfunc */
+	           DUK_HOBJECT_IS_NATIVEFUNCTION(DUK_ACT_GET_FUNC(thr->callstack + thr->callstack_top - 1)));
 
 	caller_func = DUK_ACT_GET_FUNC(thr->callstack + thr->callstack_top - 2);
-	if (!DUK_HOBJECT_IS_COMPILEDFUNCTION(caller_func)) {
+	if (caller_func == NULL || !DUK_HOBJECT_IS_COMPILEDFUNCTION(caller_func)) {
 		DUK_DD(DUK_DDPRINT("yield state invalid: caller must be Ecmascript code"));
 		goto state_error;
 	}
 
-	DUK_ASSERT(thr->callstack_preventcount >= 1);  /* should never be zero, because we (Duktape.Thread.yield) are on the stack */
+	DUK_ASSERT(thr->callstack_preventcount >= 1);  /* should never be zero, because we (the native call) are on the stack */
 	if (thr->callstack_preventcount != 1) {
-		/* Note: the only yield-preventing call is Duktape.Thread.yield(), hence check for 1, not 0 */
+		/* Note: the only yield-preventing call is the yielding native call, hence check for 1, not 0 */
 		DUK_DD(DUK_DDPRINT("yield state invalid: there must be no yield-preventing calls in current thread callstack (preventcount is %ld)",
 		                   (long) thr->callstack_preventcount));
 		goto state_error;
@@ -266,7 +281,6 @@ DUK_INTERNAL duk_ret_t duk_bi_thread_yield(duk_context *ctx) {
 
 #if defined(DUK_USE_AUGMENT_ERROR_THROW)
 	if (is_error) {
-		DUK_ASSERT_TOP(ctx, 1);  /* value (error) is at stack top */
 		duk_err_augment_error_throw(thr);  /* in yielder's context */
 	}
 #endif
@@ -274,10 +288,10 @@ DUK_INTERNAL duk_ret_t duk_bi_thread_yield(duk_context *ctx) {
 #ifdef DUK_USE_DEBUG
 	if (is_error) {
 		DUK_DDD(DUK_DDDPRINT("YIELD ERROR: value=%!T",
-		                     (duk_tval *) duk_get_tval(ctx, 0)));
+		                     (duk_tval *) duk_get_tval(ctx, -1)));
 	} else {
 		DUK_DDD(DUK_DDDPRINT("YIELD NORMAL: value=%!T",
-		                     (duk_tval *) duk_get_tval(ctx, 0)));
+		                     (duk_tval *) duk_get_tval(ctx, -1)));
 	}
 #endif
 
@@ -293,7 +307,7 @@ DUK_INTERNAL duk_ret_t duk_bi_thread_yield(duk_context *ctx) {
 	/* lj value1: value */
 	DUK_ASSERT(thr->valstack_bottom < thr->valstack_top);
 	DUK_TVAL_SET_TVAL(&tv_tmp, &thr->heap->lj.value1);
-	DUK_TVAL_SET_TVAL(&thr->heap->lj.value1, &thr->valstack_bottom[0]);
+	DUK_TVAL_SET_TVAL(&thr->heap->lj.value1, thr->valstack_top - 1);
 	DUK_TVAL_INCREF(thr, &thr->heap->lj.value1);
 	DUK_TVAL_DECREF(thr, &tv_tmp);
 
@@ -301,11 +315,10 @@ DUK_INTERNAL duk_ret_t duk_bi_thread_yield(duk_context *ctx) {
 
 	DUK_ASSERT(thr->heap->lj.jmpbuf_ptr != NULL);  /* call is from executor, so we know we have a jmpbuf */
 	duk_err_longjmp(thr);  /* execution resumes in bytecode executor */
-	return 0;  /* never here */
+	return;  /* never here */
 
  state_error:
 	DUK_ERROR(thr, DUK_ERR_TYPE_ERROR, "invalid state for yield");
-	return 0;  /* never here */
 }
 
 DUK_INTERNAL duk_ret_t duk_bi_thread_current(duk_context *ctx) {
@@ -96,18 +96,12 @@ DUK_LOCAL void duk__dump_heaphdr_list(duk_heap *heap, duk_heaphdr *root, const c
 #endif
 
 #if 0  /*unused*/
-DUK_LOCAL void duk__dump_stringtable(duk_heap *heap) {
+DUK_LOCAL void duk__dump_stringtable_slots(duk_heap *heap, duk_hstring **table, duk_uint32_t size) {
 	duk_uint_fast32_t i;
 	char buf[64+1];
 
-	DUK_D(DUK_DPRINT("stringtable %p, used %ld, size %ld, load %ld%%",
-	                 (void *) heap->strtable,
-	                 (long) heap->st_used,
-	                 (long) heap->st_size,
-	                 (long) (((double) heap->st_used) / ((double) heap->st_size) * 100.0)));
-
-	for (i = 0; i < (duk_uint_fast32_t) heap->st_size; i++) {
-		duk_hstring *e = heap->strtable[i];
+	for (i = 0; i < (duk_uint_fast32_t) size; i++) {
+		duk_hstring *e = table[i];
 
 		if (!e) {
 			DUK_D(DUK_DPRINT("  [%ld]: NULL", (long) i));
@@ -151,6 +145,28 @@ DUK_LOCAL void duk__dump_stringtable(duk_heap *heap) {
 		}
 	}
 }
+
+DUK_LOCAL void duk__dump_stringtable(duk_heap *heap) {
+	DUK_D(DUK_DPRINT("stringtable %p, used %ld, size %ld, load %ld%%",
+	                 (void *) heap->strtable,
+	                 (long) heap->st_used,
+	                 (long) heap->st_size,
+	                 (long) (((double) heap->st_used) / ((double) heap->st_size) * 100.0)));
+	duk__dump_stringtable_slots(heap, heap->strtable, heap->st_size);
+
+#if defined(DUK_USE_STRTAB_INCREMENTAL_RESIZE)
+	/* during an incremental resize, strings not yet migrated are still
+	 * in the previous table
+	 */
+	if (DUK_STRTAB_MIGRATING(heap)) {
+		DUK_D(DUK_DPRINT("previous stringtable %p, size %ld, migrated up to %ld",
+		                 (void *) heap->strtable_old,
+		                 (long) heap->st_old_size,
+		                 (long) heap->st_old_index));
+		duk__dump_stringtable_slots(heap, heap->strtable_old, heap->st_old_size);
+	}
+#endif
+}
 #endif
 
 #if 0  /*unused*/
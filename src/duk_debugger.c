@@ -1423,15 +1423,19 @@ DUK_LOCAL void duk__debug_dump_strtab_chain(duk_hthread *thr, duk_heap *heap) {
 #endif  /* DUK_USE_STRTAB_CHAIN */
 
 #if defined(DUK_USE_STRTAB_PROBE)
-DUK_LOCAL void duk__debug_dump_strtab_probe(duk_hthread *thr, duk_heap *heap) {
+#if defined(DUK_USE_HEAPPTR16)
+DUK_LOCAL void duk__debug_dump_strtab_probe_raw(duk_hthread *thr, duk_heap *heap, duk_uint16_t *entries16, duk_uint32_t size) {
+#else
+DUK_LOCAL void duk__debug_dump_strtab_probe_raw(duk_hthread *thr, duk_heap *heap, duk_hstring **entries, duk_uint32_t size) {
+#endif
 	duk_uint32_t i;
 	duk_hstring *h;
 
-	for (i = 0; i < heap->st_size; i++) {
+	for (i = 0; i < size; i++) {
 #if defined(DUK_USE_HEAPPTR16)
-		h = DUK_USE_HEAPPTR_DEC16(heap->strtable16[i]);
+		h = DUK_USE_HEAPPTR_DEC16(heap->heap_udata, entries16[i]);
 #else
-		h = heap->strtable[i];
+		h = entries[i];
 #endif
 		if (h == NULL || h == DUK_STRTAB_DELETED_MARKER(heap)) {
 			continue;
@@ -1440,6 +1444,23 @@ DUK_LOCAL void duk__debug_dump_strtab_probe(duk_hthread *thr, duk_heap *heap) {
 		duk__debug_dump_heaphdr(thr, heap, (duk_heaphdr *) h);
 	}
 }
+
+DUK_LOCAL void duk__debug_dump_strtab_probe(duk_hthread *thr, duk_heap *heap) {
+#if defined(DUK_USE_HEAPPTR16)
+	duk__debug_dump_strtab_probe_raw(thr, heap, heap->strtable16, heap->st_size);
+#else
+	duk__debug_dump_strtab_probe_raw(thr, heap, heap->strtable, heap->st_size);
+#endif
+#if defined(DUK_USE_STRTAB_INCREMENTAL_RESIZE)
+	if (DUK_STRTAB_MIGRATING(heap)) {
+#if defined(DUK_USE_HEAPPTR16)
+		duk__debug_dump_strtab_probe_raw(thr, heap, heap->strtable16_old, heap->st_old_size);
+#else
+		duk__debug_dump_strtab_probe_raw(thr, heap, heap->strtable_old, heap->st_old_size);
+#endif
+	}
+#endif
+}
 #endif  /* DUK_USE_STRTAB_PROBE */
 
 DUK_LOCAL void duk__debug_handle_dump_heap(duk_hthread *thr, duk_heap *heap) {
@@ -35,6 +35,9 @@ struct duk_breakpoint;
 struct duk_activation;
 struct duk_catcher;
 struct duk_strcache;
+struct duk_u32cache;
+struct duk_datecache;
+struct duk_stackpool_entry;
 struct duk_ljstate;
 struct duk_strtab_entry;
 
@@ -44,6 +47,7 @@ struct duk_fixedbuffer;
 
 struct duk_bitdecoder_ctx;
 struct duk_bitencoder_ctx;
+struct duk_bufwriter_ctx;
 
 struct duk_token;
 struct duk_re_token;
@@ -84,6 +88,9 @@ typedef struct duk_breakpoint duk_breakpoint;
 typedef struct duk_activation duk_activation;
 typedef struct duk_catcher duk_catcher;
 typedef struct duk_strcache duk_strcache;
+typedef struct duk_u32cache duk_u32cache;
+typedef struct duk_datecache duk_datecache;
+typedef struct duk_stackpool_entry duk_stackpool_entry;
 typedef struct duk_ljstate duk_ljstate;
 typedef struct duk_strtab_entry duk_strtab_entry;
 
@@ -93,6 +100,7 @@ typedef struct duk_fixedbuffer duk_fixedbuffer;
 
 typedef struct duk_bitdecoder_ctx duk_bitdecoder_ctx;
 typedef struct duk_bitencoder_ctx duk_bitencoder_ctx;
+typedef struct duk_bufwriter_ctx duk_bufwriter_ctx;
 
 typedef struct duk_token duk_token;
 typedef struct duk_re_token duk_re_token;
@@ -270,6 +270,7 @@ DUK_INTERNAL void duk_hbuffer_append_byte(duk_hthread *thr, duk_hbuffer_dynamic
 	duk_hbuffer_insert_bytes(thr, buf, DUK_HBUFFER_GET_SIZE(buf), &byte, 1);
 }
 
+#if 0  /*unused*/
 DUK_INTERNAL duk_size_t duk_hbuffer_append_cstring(duk_hthread *thr, duk_hbuffer_dynamic *buf, const char *str) {
 	duk_size_t len;
 
@@ -282,7 +283,9 @@ DUK_INTERNAL duk_size_t duk_hbuffer_append_cstring(duk_hthread *thr, duk_hbuffer
 	duk_hbuffer_insert_bytes(thr, buf, DUK_HBUFFER_GET_SIZE(buf), (duk_uint8_t *) str, len);
 	return len;
 }
+#endif
 
+#if 0  /*unused*/
 DUK_INTERNAL duk_size_t duk_hbuffer_append_hstring(duk_hthread *thr, duk_hbuffer_dynamic *buf, duk_hstring *str) {
 	duk_size_t len;
 
@@ -295,6 +298,7 @@ DUK_INTERNAL duk_size_t duk_hbuffer_append_hstring(duk_hthread *thr, duk_hbuffer
 	duk_hbuffer_insert_bytes(thr, buf, DUK_HBUFFER_GET_SIZE(buf), (duk_uint8_t *) DUK_HSTRING_GET_DATA(str), len);
 	return len;
 }
+#endif
 
 /* Append a Unicode codepoint to the buffer in extended UTF-8 format, i.e.
  * allow codepoints above standard Unicode range (> U+10FFFF) up to seven
@@ -48,6 +48,16 @@
 	} while (0)
 #endif
 
+/*
+ *  Limits
+ */
+
+/* Maximum entry part size hint recorded for instances created with the
+ * function as a constructor.  Instances with more properties than this are
+ * typically used as maps and don't benefit from presizing.
+ */
+#define DUK_HCOMPILEDFUNCTION_MAX_CTOR_ESIZE  64
+
 /*
  *  Accessor macros for function specific data areas
  */
@@ -189,6 +199,14 @@ struct duk_hcompiledfunction {
 	duk_uint16_t nregs;                /* regs to allocate */
 	duk_uint16_t nargs;                /* number of arguments allocated to regs */
 
+	/*
+	 *  Allocation site feedback for 'new': property count of the previous
+	 *  default instance when the constructor call returned, used as the
+	 *  initial entry part size of later instances.  Zero if unknown.
+	 */
+
+	duk_uint16_t ctor_esize;
+
 	/*
 	 *  Additional control information is placed into the object itself
 	 *  as internal properties to avoid unnecessary fields for the
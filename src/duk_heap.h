@@ -145,6 +145,20 @@
 #define DUK_HEAP_STRCACHE_SIZE                            4
 #define DUK_HEAP_STRINGCACHE_NOCACHE_LIMIT                16  /* strings up to the this length are not cached */
 
+/* Cache of interned strings for array index values (u32 -> duk_hstring),
+ * direct mapped using the low bits of the value so that small integers
+ * always have a slot of their own.  Must be a power of two.
+ */
+#define DUK_HEAP_U32CACHE_SIZE                            64
+
+/* Number of freed thread stack sets kept for reuse, and the largest stack
+ * sizes (in entries) which are pooled; larger stacks are freed normally.
+ */
+#define DUK_HEAP_STACKPOOL_SIZE                           8
+#define DUK_HEAP_STACKPOOL_MAX_VALSTACK                   512
+#define DUK_HEAP_STACKPOOL_MAX_CALLSTACK                  64
+#define DUK_HEAP_STACKPOOL_MAX_CATCHSTACK                 64
+
 /* helper to insert a (non-string) heap object into heap allocated list */
 #define DUK_HEAP_INSERT_INTO_HEAP_ALLOCATED(heap,hdr)     duk_heap_insert_into_heap_allocated((heap),(hdr))
 
@@ -178,6 +192,15 @@
 #define DUK_STRTAB_HASH_INITIAL(hash,h_size)    ((hash) % (h_size))
 #define DUK_STRTAB_HASH_PROBE_STEP(hash)        DUK_UTIL_GET_HASH_PROBE_STEP((hash))
 
+/* incremental resize: number of previous stringtable slots migrated into
+ * the current stringtable on each lookup/intern
+ */
+#define DUK_STRTAB_MIGRATE_STEP            16
+
+#if defined(DUK_USE_STRTAB_INCREMENTAL_RESIZE)
+#define DUK_STRTAB_MIGRATING(heap)         ((heap)->st_old_size > 0)
+#endif
+
 /* fixed top level hashtable size (separate chaining) */
 #define DUK_STRTAB_CHAIN_SIZE              DUK_USE_STRTAB_CHAIN_SIZE
 
@@ -324,6 +347,63 @@ struct duk_strcache {
 	duk_uint32_t cidx;
 };
 
+/*
+ *  Array index string cache, avoids number formatting and string table
+ *  lookups for number-to-string coercions of array index values.  The
+ *  references are 'weak' like in the string cache above.
+ */
+
+struct duk_u32cache {
+	duk_hstring *h;
+	duk_uint32_t val;
+};
+
+/*
+ *  Date built-in cache: a range of UTC time values known to share the same
+ *  local time offset (avoids platform calls for repeated conversions near
+ *  the same instant), and the year/month/day breakdown of the last day
+ *  number decomposed.
+ */
+
+#if defined(DUK_USE_DATE_CACHE)
+struct duk_datecache {
+	/* local time offset 'tzo_offset' (seconds) applies to UTC time values
+	 * in [tzo_start,tzo_end] (milliseconds)
+	 */
+	duk_double_t tzo_start;
+	duk_double_t tzo_end;
+	duk_int_t tzo_offset;
+	duk_bool_t tzo_valid;
+
+	/* breakdown of day number 'day_num' (days since epoch); month and
+	 * day-in-month are zero-based
+	 */
+	duk_int_t day_num;
+	duk_int_t day_year;
+	duk_small_int_t day_in_year;
+	duk_small_int_t day_month;
+	duk_small_int_t day_day;
+	duk_bool_t day_valid;
+};
+#endif
+
+/*
+ *  Thread stack pool: the value stack, call stack, and catch stack of a
+ *  freed thread are kept for reuse by a new thread, so that short-lived
+ *  coroutines don't need to allocate and free stacks.
+ */
+
+#if defined(DUK_USE_THREAD_STACK_POOL)
+struct duk_stackpool_entry {
+	duk_tval *valstack;
+	duk_activation *callstack;
+	duk_catcher *catchstack;
+	duk_size_t valstack_size;
+	duk_size_t callstack_size;
+	duk_size_t catchstack_size;
+};
+#endif
+
 /*
  *  Longjmp state, contains the information needed to perform a longjmp.
  *  Longjmp related values are written to value1, value2, and iserror.
@@ -434,6 +514,9 @@ struct duk_heap {
 	/* heap level temporary log formatting buffer */
 	duk_hbuffer_dynamic *log_buffer;
 
+	/* Ecmascript trampoline used by duk_resume(), created on first use */
+	duk_hobject *resume_func;
+
 	/* duk_handle_call / duk_handle_safe_call recursion depth limiting */
 	duk_int_t call_recursion_depth;
 	duk_int_t call_recursion_limit;
@@ -490,6 +573,18 @@ struct duk_heap {
 #endif
 	duk_uint32_t st_size;     /* alloc size in elements */
 	duk_uint32_t st_used;     /* used elements (includes DELETED) */
+#if defined(DUK_USE_STRTAB_INCREMENTAL_RESIZE)
+	/* previous stringtable during an incremental resize; every string
+	 * lives in exactly one of the two tables
+	 */
+#if defined(DUK_USE_HEAPPTR16)
+	duk_uint16_t *strtable16_old;
+#else
+	duk_hstring **strtable_old;
+#endif
+	duk_uint32_t st_old_size;   /* alloc size in elements, 0 if no resize in progress */
+	duk_uint32_t st_old_index;  /* slots [0,st_old_index[ have been migrated */
+#endif
 #endif
 
 	/* XXX: static alloc is OK until separate chaining stringtable
@@ -504,6 +599,38 @@ struct duk_heap {
 	 */
 	duk_strcache strcache[DUK_HEAP_STRCACHE_SIZE];
 
+	/* array index string cache (u32 value -> interned string); 'weak'
+	 * references, see duk_heap_strcache_string_remove().
+	 */
+	duk_u32cache u32cache[DUK_HEAP_U32CACHE_SIZE];
+
+	/* Date built-in local time offset and day breakdown cache */
+#if defined(DUK_USE_DATE_CACHE)
+	duk_datecache datecache;
+#endif
+
+	/* stacks of freed threads, [0,stackpool_count[ in use */
+#if defined(DUK_USE_THREAD_STACK_POOL)
+	duk_stackpool_entry stackpool[DUK_HEAP_STACKPOOL_SIZE];
+	duk_small_uint_t stackpool_count;
+#endif
+
+	/* stack resize statistics (all threads), dumped when heap is freed */
+#if defined(DUK_USE_DEBUG)
+	duk_size_t stats_valstack_grow;
+	duk_size_t stats_valstack_shrink;
+	duk_size_t stats_callstack_grow;
+	duk_size_t stats_callstack_shrink;
+	duk_size_t stats_catchstack_grow;
+	duk_size_t stats_catchstack_shrink;
+#endif
+
+	/* fastint downgrades per opcode/extraop, see Duktape.fastintStats() */
+#if defined(DUK_USE_FASTINT_STATS)
+	duk_size_t stats_fastint_downgrade[DUK_BC_OP_MAX + 1];
+	duk_size_t stats_fastint_downgrade_extra[DUK_BC_EXTRAOP_MAX + 1];
+#endif
+
 	/* built-in strings */
 #if defined(DUK_USE_HEAPPTR16)
 	duk_uint16_t strs16[DUK_HEAP_NUM_STRINGS];
@@ -592,6 +719,7 @@ DUK_INTERNAL_DECL void duk_heaphdr_decref(duk_hthread *thr, duk_heaphdr *h);
 DUK_INTERNAL_DECL void duk_heaphdr_decref_allownull(duk_hthread *thr, duk_heaphdr *h);
 DUK_INTERNAL_DECL void duk_heaphdr_refzero(duk_hthread *thr, duk_heaphdr *h);
 DUK_INTERNAL_DECL void duk_heaphdr_refcount_finalize(duk_hthread *thr, duk_heaphdr *hdr);
+DUK_INTERNAL_DECL duk_bool_t duk_heap_process_pending(duk_hthread *thr, duk_int_t budget);
 #else
 /* no refcounting */
 #endif
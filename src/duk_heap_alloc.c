@@ -37,9 +37,7 @@ DUK_INTERNAL void duk_free_hobject_inner(duk_heap *heap, duk_hobject *h) {
 		/* Currently nothing to free */
 	} else if (DUK_HOBJECT_IS_THREAD(h)) {
 		duk_hthread *t = (duk_hthread *) h;
-		DUK_FREE(heap, t->valstack);
-		DUK_FREE(heap, t->callstack);
-		DUK_FREE(heap, t->catchstack);
+		duk_hthread_free_stacks(heap, t);
 		/* Don't free h->resumer because it exists in the heap.
 		 * Callstack entries also contain function pointers which
 		 * are not freed for the same reason.
@@ -218,11 +216,38 @@ DUK_LOCAL void duk__free_run_finalizers(duk_heap *heap) {
 #endif
 }
 
+#if defined(DUK_USE_DEBUG) && defined(DUK_USE_FASTINT_STATS)
+DUK_LOCAL void duk__dump_fastint_stats(duk_heap *heap) {
+	duk_small_int_t i;
+
+	for (i = 0; i <= DUK_BC_OP_MAX; i++) {
+		if (heap->stats_fastint_downgrade[i] > 0) {
+			DUK_D(DUK_DPRINT("fastint downgrades: %!C: %ld",
+			                 (long) i, (long) heap->stats_fastint_downgrade[i]));
+		}
+	}
+	for (i = 0; i <= DUK_BC_EXTRAOP_MAX; i++) {
+		if (heap->stats_fastint_downgrade_extra[i] > 0) {
+			DUK_D(DUK_DPRINT("fastint downgrades: EXTRA %ld: %ld",
+			                 (long) i, (long) heap->stats_fastint_downgrade_extra[i]));
+		}
+	}
+}
+#endif  /* DUK_USE_DEBUG && DUK_USE_FASTINT_STATS */
+
 DUK_INTERNAL void duk_heap_free(duk_heap *heap) {
 	DUK_D(DUK_DPRINT("free heap: %p", (void *) heap));
 
 #if defined(DUK_USE_DEBUG)
 	duk_heap_dump_strtab(heap);
+	DUK_D(DUK_DPRINT("stack resizes: valstack grow=%ld shrink=%ld, callstack grow=%ld shrink=%ld, "
+	                 "catchstack grow=%ld shrink=%ld",
+	                 (long) heap->stats_valstack_grow, (long) heap->stats_valstack_shrink,
+	                 (long) heap->stats_callstack_grow, (long) heap->stats_callstack_shrink,
+	                 (long) heap->stats_catchstack_grow, (long) heap->stats_catchstack_shrink));
+#if defined(DUK_USE_FASTINT_STATS)
+	duk__dump_fastint_stats(heap);
+#endif
 #endif
 
 #if defined(DUK_USE_DEBUGGER_SUPPORT)
@@ -241,6 +266,14 @@ DUK_INTERNAL void duk_heap_free(duk_heap *heap) {
 	 * XXX: this perhaps requires an execution time limit.
 	 */
 	DUK_D(DUK_DPRINT("execute finalizers before freeing heap"));
+#if defined(DUK_USE_REFZERO_BUDGET)
+	/* objects left over by a budgeted refzero run are freed normally
+	 * (with finalizers) before the heap is torn down
+	 */
+	if (heap->heap_thread != NULL) {
+		(void) duk_heap_process_pending(heap->heap_thread, 0);
+	}
+#endif
 #ifdef DUK_USE_MARK_AND_SWEEP
 	/* run mark-and-sweep a few times just in case (unreachable
 	 * object finalizers run already here)
@@ -251,7 +284,8 @@ DUK_INTERNAL void duk_heap_free(duk_heap *heap) {
 	duk__free_run_finalizers(heap);
 
 	/* Note: heap->heap_thread, heap->curr_thread, heap->heap_object,
-	 * and heap->log_buffer are on the heap allocated list.
+	 * heap->log_buffer, and heap->resume_func are on the heap allocated
+	 * list.
 	 */
 
 	DUK_D(DUK_DPRINT("freeing heap objects of heap: %p", (void *) heap));
@@ -270,6 +304,11 @@ DUK_INTERNAL void duk_heap_free(duk_heap *heap) {
 	DUK_D(DUK_DPRINT("freeing string table of heap: %p", (void *) heap));
 	duk__free_stringtable(heap);
 
+#if defined(DUK_USE_THREAD_STACK_POOL)
+	DUK_D(DUK_DPRINT("freeing thread stack pool of heap: %p", (void *) heap));
+	duk_hthread_free_stack_pool(heap);
+#endif
+
 	DUK_D(DUK_DPRINT("freeing heap structure: %p", (void *) heap));
 	heap->free_func(heap->heap_udata, heap);
 }
@@ -527,6 +566,13 @@ DUK_LOCAL void duk__dump_type_sizes(void) {
 	DUK__DUMPSZ(duk_activation);
 	DUK__DUMPSZ(duk_catcher);
 	DUK__DUMPSZ(duk_strcache);
+	DUK__DUMPSZ(duk_u32cache);
+#if defined(DUK_USE_DATE_CACHE)
+	DUK__DUMPSZ(duk_datecache);
+#endif
+#if defined(DUK_USE_THREAD_STACK_POOL)
+	DUK__DUMPSZ(duk_stackpool_entry);
+#endif
 	DUK__DUMPSZ(duk_ljstate);
 	DUK__DUMPSZ(duk_fixedbuffer);
 	DUK__DUMPSZ(duk_bitdecoder_ctx);
@@ -711,13 +757,20 @@ duk_heap *duk_heap_alloc(duk_alloc_function alloc_func,
 	res->curr_thread = NULL;
 	res->heap_object = NULL;
 	res->log_buffer = NULL;
+	res->resume_func = NULL;
 #if defined(DUK_USE_STRTAB_CHAIN)
 	/* nothing to NULL */
 #elif defined(DUK_USE_STRTAB_PROBE)
 #if defined(DUK_USE_HEAPPTR16)
 	res->strtable16 = (duk_uint16_t *) NULL;
+#if defined(DUK_USE_STRTAB_INCREMENTAL_RESIZE)
+	res->strtable16_old = (duk_uint16_t *) NULL;
+#endif
 #else
 	res->strtable = (duk_hstring **) NULL;
+#if defined(DUK_USE_STRTAB_INCREMENTAL_RESIZE)
+	res->strtable_old = (duk_hstring **) NULL;
+#endif
 #endif
 #endif
 	{
@@ -765,6 +818,15 @@ duk_heap *duk_heap_alloc(duk_alloc_function alloc_func,
 	res->hash_seed = (duk_uint32_t) (duk_intptr_t) res;
 	res->rnd_state = (duk_uint32_t) (duk_intptr_t) res;
 
+#if defined(DUK_USE_DATE_CACHE)
+	/* both date cache entries start out invalid (zero) */
+	DUK_ASSERT(res->datecache.tzo_valid == 0);
+	DUK_ASSERT(res->datecache.day_valid == 0);
+#endif
+#if defined(DUK_USE_THREAD_STACK_POOL)
+	DUK_ASSERT(res->stackpool_count == 0);
+#endif
+
 #ifdef DUK_USE_INTERRUPT_COUNTER
 	/* zero value causes an interrupt before executing first instruction */
 	DUK_ASSERT(res->interrupt_counter == 0);
@@ -851,6 +913,9 @@ duk_heap *duk_heap_alloc(duk_alloc_function alloc_func,
 		for (i = 0; i < DUK_HEAP_STRCACHE_SIZE; i++) {
 			res->strcache[i].h = NULL;
 		}
+		for (i = 0; i < DUK_HEAP_U32CACHE_SIZE; i++) {
+			res->u32cache[i].h = NULL;
+		}
 	}
 #endif
 
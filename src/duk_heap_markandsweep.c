@@ -200,6 +200,7 @@ DUK_LOCAL void duk__mark_roots_heap(duk_heap *heap) {
 	duk__mark_heaphdr(heap, (duk_heaphdr *) heap->heap_thread);
 	duk__mark_heaphdr(heap, (duk_heaphdr *) heap->heap_object);
 	duk__mark_heaphdr(heap, (duk_heaphdr *) heap->log_buffer);
+	duk__mark_heaphdr(heap, (duk_heaphdr *) heap->resume_func);
 
 	for (i = 0; i < DUK_HEAP_NUM_STRINGS; i++) {
 		duk_hstring *h = DUK_HEAP_GET_STRING(heap, i);
@@ -631,33 +632,29 @@ DUK_LOCAL void duk__sweep_stringtable_chain(duk_heap *heap, duk_size_t *out_coun
 #endif  /* DUK_USE_STRTAB_CHAIN */
 
 #if defined(DUK_USE_STRTAB_PROBE)
-DUK_LOCAL void duk__sweep_stringtable_probe(duk_heap *heap, duk_size_t *out_count_keep) {
+#if defined(DUK_USE_HEAPPTR16)
+DUK_LOCAL void duk__sweep_stringtable_probe_raw(duk_heap *heap, duk_uint16_t *entries16, duk_uint32_t size, duk_size_t *p_count_keep, duk_size_t *p_count_free) {
+#else
+DUK_LOCAL void duk__sweep_stringtable_probe_raw(duk_heap *heap, duk_hstring **entries, duk_uint32_t size, duk_size_t *p_count_keep, duk_size_t *p_count_free) {
+#endif
 	duk_hstring *h;
 	duk_uint_fast32_t i;
-#ifdef DUK_USE_DEBUG
-	duk_size_t count_free = 0;
-#endif
-	duk_size_t count_keep = 0;
 
-	DUK_DD(DUK_DDPRINT("duk__sweep_stringtable: %p", (void *) heap));
-
-	for (i = 0; i < heap->st_size; i++) {
+	for (i = 0; i < size; i++) {
 #if defined(DUK_USE_HEAPPTR16)
-		h = (duk_hstring *) DUK_USE_HEAPPTR_DEC16(heap->strtable16[i]);
+		h = (duk_hstring *) DUK_USE_HEAPPTR_DEC16(heap->heap_udata, entries16[i]);
 #else
-		h = heap->strtable[i];
+		h = entries[i];
 #endif
 		if (h == NULL || h == DUK_STRTAB_DELETED_MARKER(heap)) {
 			continue;
 		} else if (DUK_HEAPHDR_HAS_REACHABLE((duk_heaphdr *) h)) {
 			DUK_HEAPHDR_CLEAR_REACHABLE((duk_heaphdr *) h);
-			count_keep++;
+			(*p_count_keep)++;
 			continue;
 		}
 
-#ifdef DUK_USE_DEBUG
-		count_free++;
-#endif
+		(*p_count_free)++;
 
 #if defined(DUK_USE_REFERENCE_COUNTING)
 		/* Non-zero refcounts should not happen for unreachable strings,
@@ -678,9 +675,9 @@ DUK_LOCAL void duk__sweep_stringtable_probe(duk_heap *heap, duk_size_t *out_coun
 		 * pointless because we already know the slot.
 		 */
 #if defined(DUK_USE_HEAPPTR16)
-		heap->strtable16[i] = heap->heapptr_deleted16;
+		entries16[i] = heap->heapptr_deleted16;
 #else
-		heap->strtable[i] = DUK_STRTAB_DELETED_MARKER(heap);
+		entries[i] = DUK_STRTAB_DELETED_MARKER(heap);
 #endif
 
 		/* free inner references (these exist e.g. when external
@@ -691,11 +688,33 @@ DUK_LOCAL void duk__sweep_stringtable_probe(duk_heap *heap, duk_size_t *out_coun
 		/* finally free the struct itself */
 		DUK_FREE(heap, h);
 	}
+}
+
+DUK_LOCAL void duk__sweep_stringtable_probe(duk_heap *heap, duk_size_t *out_count_keep) {
+	duk_size_t count_free = 0;
+	duk_size_t count_keep = 0;
+
+	DUK_DD(DUK_DDPRINT("duk__sweep_stringtable: %p", (void *) heap));
+
+#if defined(DUK_USE_HEAPPTR16)
+	duk__sweep_stringtable_probe_raw(heap, heap->strtable16, heap->st_size, &count_keep, &count_free);
+#else
+	duk__sweep_stringtable_probe_raw(heap, heap->strtable, heap->st_size, &count_keep, &count_free);
+#endif
+#if defined(DUK_USE_STRTAB_INCREMENTAL_RESIZE)
+	/* strings not yet migrated by an incremental resize */
+	if (DUK_STRTAB_MIGRATING(heap)) {
+#if defined(DUK_USE_HEAPPTR16)
+		duk__sweep_stringtable_probe_raw(heap, heap->strtable16_old, heap->st_old_size, &count_keep, &count_free);
+#else
+		duk__sweep_stringtable_probe_raw(heap, heap->strtable_old, heap->st_old_size, &count_keep, &count_free);
+#endif
+	}
+#endif
 
-#ifdef DUK_USE_DEBUG
 	DUK_D(DUK_DPRINT("mark-and-sweep sweep stringtable: %ld freed, %ld kept",
 	                 (long) count_free, (long) count_keep));
-#endif
+	DUK_UNREF(count_free);
 	*out_count_keep = count_keep;
 }
 #endif  /* DUK_USE_STRTAB_PROBE */
@@ -1207,6 +1226,15 @@ DUK_INTERNAL duk_bool_t duk_heap_mark_and_sweep(duk_heap *heap, duk_small_uint_t
 		duk__compact_objects(heap);
 	}
 
+	/* Pooled thread stacks are just a cache, release them when memory
+	 * is tight.
+	 */
+#if defined(DUK_USE_THREAD_STACK_POOL)
+	if (flags & DUK_MS_FLAG_EMERGENCY) {
+		duk_hthread_free_stack_pool(heap);
+	}
+#endif
+
 	/*
 	 *  String table resize check.
 	 *
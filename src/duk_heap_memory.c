@@ -37,6 +37,34 @@ DUK_LOCAL void duk__run_voluntary_gc(duk_heap *heap) {
 #define DUK__VOLUNTARY_PERIODIC_GC(heap)  /* no voluntary gc */
 #endif  /* DUK_USE_MARK_AND_SWEEP && DUK_USE_VOLUNTARY_GC */
 
+/* With a refzero budget, objects may be left pending on the refzero list.
+ * Mark-and-sweep treats them as roots and cannot free them, so flush the
+ * list before the mark-and-sweep retries of a failed allocation.
+ */
+#if defined(DUK_USE_MARK_AND_SWEEP) && defined(DUK_USE_REFZERO_BUDGET)
+#define DUK__FLUSH_PENDING_REFZERO(heap)  do { \
+		if ((heap)->refzero_list != NULL) { \
+			duk__flush_pending_refzero((heap)); \
+		} \
+	} while (0)
+
+DUK_LOCAL void duk__flush_pending_refzero(duk_heap *heap) {
+	if (heap->heap_thread == NULL ||
+	    DUK_HEAP_HAS_REFZERO_FREE_RUNNING(heap) ||
+	    (heap->mark_and_sweep_base_flags & DUK_MS_FLAG_NO_FINALIZERS)) {
+		/* Refzero processing may run finalizers, so respect the same
+		 * restrictions as mark-and-sweep.
+		 */
+		DUK_DD(DUK_DDPRINT("cannot flush pending refzero list now"));
+	} else {
+		DUK_D(DUK_DPRINT("flushing pending refzero list before gc retries"));
+		(void) duk_heap_process_pending(heap->heap_thread, 0);
+	}
+}
+#else
+#define DUK__FLUSH_PENDING_REFZERO(heap)  /* nop */
+#endif  /* DUK_USE_MARK_AND_SWEEP && DUK_USE_REFZERO_BUDGET */
+
 /*
  *  Allocate memory with garbage collection
  */
@@ -91,6 +119,8 @@ DUK_INTERNAL void *duk_heap_mem_alloc(duk_heap *heap, duk_size_t size) {
 		return NULL;
 	}
 
+	DUK__FLUSH_PENDING_REFZERO(heap);
+
 	/*
 	 *  Retry with several GC attempts.  Initial attempts are made without
 	 *  emergency mode; later attempts use emergency mode which minimizes
@@ -199,6 +229,8 @@ DUK_INTERNAL void *duk_heap_mem_realloc(duk_heap *heap, void *ptr, duk_size_t ne
 		return NULL;
 	}
 
+	DUK__FLUSH_PENDING_REFZERO(heap);
+
 	/*
 	 *  Retry with several GC attempts.  Initial attempts are made without
 	 *  emergency mode; later attempts use emergency mode which minimizes
@@ -292,6 +324,8 @@ DUK_INTERNAL void *duk_heap_mem_realloc_indirect(duk_heap *heap, duk_mem_getptr
 		return NULL;
 	}
 
+	DUK__FLUSH_PENDING_REFZERO(heap);
+
 	/*
 	 *  Retry with several GC attempts.  Initial attempts are made without
 	 *  emergency mode; later attempts use emergency mode which minimizes
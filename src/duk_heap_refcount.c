@@ -170,11 +170,16 @@ DUK_INTERNAL void duk_heaphdr_refcount_finalize(duk_hthread *thr, duk_heaphdr *h
  *  empty.  When an object is freed, its references get decref'd and
  *  may cause further objects to be queued for freeing.
  *
- *  This could be expanded to allow incremental freeing: just bail out
- *  early and resume at a future alloc/decref/refzero.
+ *  If 'budget' is positive, at most 'budget' objects are processed and
+ *  the rest are left on the refzero list.  They are processed by a future
+ *  refzero, an explicit duk_process_pending() call, or before heap
+ *  destruction.  Leftover objects are treated as reachability roots by
+ *  mark-and-sweep so they are never swept while waiting.
+ *
+ *  Returns non-zero if the refzero list is non-empty after the call.
  */
 
-DUK_LOCAL void duk__refzero_free_pending(duk_hthread *thr) {
+DUK_LOCAL duk_bool_t duk__refzero_free_pending(duk_hthread *thr, duk_int_t budget) {
 	duk_heaphdr *h1, *h2;
 	duk_heap *heap;
 	duk_int_t count = 0;
@@ -190,11 +195,11 @@ DUK_LOCAL void duk__refzero_free_pending(duk_hthread *thr) {
 
 	if (DUK_HEAP_HAS_REFZERO_FREE_RUNNING(heap)) {
 		DUK_DDD(DUK_DDDPRINT("refzero free running, skip run"));
-		return;
+		return (heap->refzero_list != NULL);
 	}
 
 	/*
-	 *  Churn refzero_list until empty
+	 *  Churn refzero_list until empty or budget exhausted
 	 */
 
 	DUK_HEAP_SET_REFZERO_FREE_RUNNING(heap);
@@ -202,6 +207,12 @@ DUK_LOCAL void duk__refzero_free_pending(duk_hthread *thr) {
 		duk_hobject *obj;
 		duk_bool_t rescued = 0;
 
+		if (budget > 0 && count >= budget) {
+			DUK_DD(DUK_DDPRINT("refzero budget exhausted (%ld objects), leave rest pending",
+			                   (long) count));
+			break;
+		}
+
 		/*
 		 *  Pick an object from the head (don't remove yet).
 		 */
@@ -313,6 +324,33 @@ DUK_LOCAL void duk__refzero_free_pending(duk_hthread *thr) {
 		DUK_D(DUK_DPRINT("refcount triggered mark-and-sweep => rc %ld", (long) rc));
 	}
 #endif  /* DUK_USE_MARK_AND_SWEEP && DUK_USE_VOLUNTARY_GC */
+
+	return (heap->refzero_list != NULL);
+}
+
+/*
+ *  Process pending refzero work explicitly, e.g. from an application
+ *  event loop when using a refzero budget.  A non-positive budget
+ *  processes the whole list.  Returns non-zero if work remains.
+ */
+
+DUK_INTERNAL duk_bool_t duk_heap_process_pending(duk_hthread *thr, duk_int_t budget) {
+	DUK_ASSERT(thr != NULL);
+	DUK_ASSERT(thr->heap != NULL);
+
+#ifdef DUK_USE_MARK_AND_SWEEP
+	/* Same rule as in duk_heaphdr_refzero(): refzero objects are not
+	 * processed while mark-and-sweep is running.
+	 */
+	if (DUK_HEAP_HAS_MARKANDSWEEP_RUNNING(thr->heap)) {
+		return (thr->heap->refzero_list != NULL);
+	}
+#endif
+
+	if (thr->heap->refzero_list == NULL) {
+		return 0;
+	}
+	return duk__refzero_free_pending(thr, budget);
 }
 
 /*
@@ -371,7 +409,11 @@ DUK_INTERNAL void duk_heaphdr_refzero(duk_hthread *thr, duk_heaphdr *h) {
 
 		duk_heap_remove_any_from_heap_allocated(heap, h);
 		duk__queue_refzero(heap, h);
-		duk__refzero_free_pending(thr);
+#if defined(DUK_USE_REFZERO_BUDGET)
+		(void) duk__refzero_free_pending(thr, (duk_int_t) DUK_USE_REFZERO_BUDGET);
+#else
+		(void) duk__refzero_free_pending(thr, 0);
+#endif
 		break;
 
 	case DUK_HTYPE_BUFFER:
@@ -10,7 +10,7 @@
 #include "duk_internal.h"
 
 /*
- *  Delete references to given hstring from the heap string cache.
+ *  Delete references to given hstring from the heap string caches.
  *
  *  String cache references are 'weak': they are not counted towards
  *  reference counts, nor serve as roots for mark-and-sweep.  When an
@@ -32,6 +32,20 @@ DUK_INTERNAL void duk_heap_strcache_string_remove(duk_heap *heap, duk_hstring *h
 			 */
 		}
 	}
+
+	/* The array index string cache only contains array index strings,
+	 * and a string can only be in the slot matching its value.
+	 */
+	if (DUK_HSTRING_HAS_ARRIDX(h)) {
+		duk_u32cache *c;
+
+		c = heap->u32cache + (duk_js_to_arrayindex_string_helper(h) & (DUK_HEAP_U32CACHE_SIZE - 1));
+		if (c->h == h) {
+			DUK_DD(DUK_DDPRINT("deleting weak u32cache reference to hstring %p from heap %p",
+			                   (void *) h, (void *) heap));
+			c->h = NULL;
+		}
+	}
 }
 
 /*
@@ -101,7 +115,7 @@ DUK_INTERNAL duk_uint_fast32_t duk_heap_strcache_offset_char2byte(duk_hthread *t
 	 *  For ASCII strings, the answer is simple.
 	 */
 
-	if (DUK_HSTRING_IS_ASCII(h)) {
+	if (DUK_HSTRING_HAS_ASCII(h)) {
 		/* clen == blen -> pure ascii */
 		return char_offset;
 	}
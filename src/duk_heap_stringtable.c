@@ -10,6 +10,44 @@
 #define DUK__DELETED_MARKER(heap)             DUK_STRTAB_DELETED_MARKER((heap))
 #endif
 
+/*
+ *  String scan at intern time
+ *
+ *  Interning must stay cheap because string building code (e.g. repeated
+ *  'x += y') interns a lot of long strings which are never looked at
+ *  again.  Only the "pure ASCII" flag is computed here: a branchless OR
+ *  over the data, which compilers can vectorize, is much cheaper than the
+ *  character length loop which can then be skipped for ASCII strings.
+ *  Flags needing per-character classification (JSON escapes, identifiers)
+ *  are computed lazily by duk_hstring_scan_charclass() when first needed.
+ */
+
+/* Scan string data, set flags into 'res' and return the character length. */
+DUK_LOCAL duk_uint32_t duk__scan_hstring(duk_hstring *res, const duk_uint8_t *str, duk_uint32_t blen) {
+	const duk_uint8_t *p = str;
+	const duk_uint8_t *p_end = str + blen;
+	duk_uint_fast32_t ormask = 0;
+	duk_uarridx_t dummy;
+
+	while (p_end - p >= 4) {
+		ormask |= (duk_uint_fast32_t) (p[0] | p[1] | p[2] | p[3]);
+		p += 4;
+	}
+	while (p < p_end) {
+		ormask |= (duk_uint_fast32_t) *p++;
+	}
+
+	if (duk_js_to_arrayindex_raw_string(str, blen, &dummy)) {
+		DUK_HSTRING_SET_ARRIDX(res);
+	}
+
+	if (ormask < 0x80U) {
+		DUK_HSTRING_SET_ASCII(res);
+		return blen;
+	}
+	return (duk_uint32_t) duk_unicode_unvalidated_utf8_length(str, (duk_size_t) blen);
+}
+
 /*
  *  Create a hstring and insert into the heap.  The created object
  *  is directly garbage collectable with reference count zero.
@@ -28,7 +66,6 @@ duk_hstring *duk__alloc_init_hstring(duk_heap *heap,
 	duk_hstring *res = NULL;
 	duk_uint8_t *data;
 	duk_size_t alloc_size;
-	duk_uarridx_t dummy;
 	duk_uint32_t clen;
 
 #if defined(DUK_USE_STRLEN16)
@@ -70,10 +107,6 @@ duk_hstring *duk__alloc_init_hstring(duk_heap *heap,
 		data[blen] = (duk_uint8_t) 0;
 	}
 
-	if (duk_js_to_arrayindex_raw_string(str, blen, &dummy)) {
-		DUK_HSTRING_SET_ARRIDX(res);
-	}
-
 	/* All strings beginning with 0xff are treated as "internal",
 	 * even strings interned by the user.  This allows user code to
 	 * create internal properties too, and makes behavior consistent
@@ -87,8 +120,10 @@ duk_hstring *duk__alloc_init_hstring(duk_heap *heap,
 
 	DUK_HSTRING_SET_HASH(res, strhash);
 	DUK_HSTRING_SET_BYTELEN(res, blen);
-	clen = (duk_uint32_t) duk_unicode_unvalidated_utf8_length(str, (duk_size_t) blen);
+	clen = duk__scan_hstring(res, str, blen);
 	DUK_ASSERT(clen <= blen);
+	DUK_ASSERT(clen == (duk_uint32_t) duk_unicode_unvalidated_utf8_length(str, (duk_size_t) blen));
+	DUK_ASSERT(!DUK_HSTRING_HAS_ASCII(res) || clen == blen);  /* converse not true, e.g. 0xff prefix of internal strings */
 	DUK_HSTRING_SET_CHARLEN(res, clen);
 
 	DUK_DDD(DUK_DDDPRINT("interned string, hash=0x%08lx, blen=%ld, clen=%ld, has_arridx=%ld, has_extdata=%ld",
@@ -565,10 +600,14 @@ DUK_LOCAL duk_hstring *duk__find_matching_string_probe(duk_heap *heap, duk_hstri
 	DUK_UNREACHABLE();
 }
 
+/* Returns 1 if the string was found and removed.  A string is always
+ * found unless an incremental resize is in progress, in which case the
+ * string may be in the other table.
+ */
 #if defined(DUK_USE_HEAPPTR16)
-DUK_LOCAL void duk__remove_matching_hstring_probe(duk_heap *heap, duk_uint16_t *entries16, duk_uint32_t size, duk_hstring *h) {
+DUK_LOCAL duk_bool_t duk__remove_matching_hstring_probe(duk_heap *heap, duk_uint16_t *entries16, duk_uint32_t size, duk_hstring *h) {
 #else
-DUK_LOCAL void duk__remove_matching_hstring_probe(duk_heap *heap, duk_hstring **entries, duk_uint32_t size, duk_hstring *h) {
+DUK_LOCAL duk_bool_t duk__remove_matching_hstring_probe(duk_heap *heap, duk_hstring **entries, duk_uint32_t size, duk_hstring *h) {
 #endif
 	duk_uint32_t i;
 	duk_uint32_t step;
@@ -595,8 +634,12 @@ DUK_LOCAL void duk__remove_matching_hstring_probe(duk_heap *heap, duk_hstring **
 #else
 		if (!e) {
 #endif
+#if defined(DUK_USE_STRTAB_INCREMENTAL_RESIZE)
+			return 0;
+#else
 			DUK_UNREACHABLE();
 			break;
+#endif
 		}
 #if defined(DUK_USE_HEAPPTR16)
 		if (e16 == h16) {
@@ -610,7 +653,7 @@ DUK_LOCAL void duk__remove_matching_hstring_probe(duk_heap *heap, duk_hstring **
 #else
 			entries[i] = DUK__DELETED_MARKER(heap);
 #endif
-			break;
+			return 1;
 		}
 
 		DUK_DDD(DUK_DDDPRINT("free matching miss: %ld", (long) i));
@@ -619,8 +662,67 @@ DUK_LOCAL void duk__remove_matching_hstring_probe(duk_heap *heap, duk_hstring **
 		/* looping should never happen */
 		DUK_ASSERT(i != DUK__HASH_INITIAL(hash, size));
 	}
+	return 0;
 }
 
+#if defined(DUK_USE_STRTAB_INCREMENTAL_RESIZE)
+/* Migrate at most 'count' slots of the previous stringtable into the
+ * current one; 'count' == 0 migrates all remaining slots.  There are no
+ * allocations (and thus no GC side effects) here.  Migrated slots are
+ * marked DELETED so that probe sequences in the previous table remain
+ * intact for the strings not yet migrated.
+ */
+DUK_LOCAL void duk__migrate_strtab_probe(duk_heap *heap, duk_uint32_t count) {
+	duk_uint32_t i;
+	duk_uint32_t n;
+	duk_hstring *e;
+
+	if (!DUK_STRTAB_MIGRATING(heap)) {
+		return;
+	}
+
+	i = heap->st_old_index;
+	n = heap->st_old_size;
+	if (count > 0 && n - i > count) {
+		n = i + count;
+	}
+
+	for (; i < n; i++) {
+#if defined(DUK_USE_HEAPPTR16)
+		e = (duk_hstring *) DUK_USE_HEAPPTR_DEC16(heap->heap_udata, heap->strtable16_old[i]);
+#else
+		e = heap->strtable_old[i];
+#endif
+		if (e == NULL || e == DUK__DELETED_MARKER(heap)) {
+			continue;
+		}
+#if defined(DUK_USE_HEAPPTR16)
+		heap->strtable16_old[i] = heap->heapptr_deleted16;
+		duk__insert_hstring_probe(heap, heap->strtable16, heap->st_size, &heap->st_used, e);
+#else
+		heap->strtable_old[i] = DUK__DELETED_MARKER(heap);
+		duk__insert_hstring_probe(heap, heap->strtable, heap->st_size, &heap->st_used, e);
+#endif
+		DUK_ASSERT(heap->st_used < heap->st_size);
+	}
+	heap->st_old_index = i;
+
+	if (i >= heap->st_old_size) {
+		DUK_DD(DUK_DDPRINT("incremental stringtable resize complete: %ld entries, %ld used",
+		                   (long) heap->st_size, (long) heap->st_used));
+#if defined(DUK_USE_HEAPPTR16)
+		DUK_FREE(heap, heap->strtable16_old);
+		heap->strtable16_old = NULL;
+#else
+		DUK_FREE(heap, heap->strtable_old);
+		heap->strtable_old = NULL;
+#endif
+		heap->st_old_size = 0;
+		heap->st_old_index = 0;
+	}
+}
+#endif  /* DUK_USE_STRTAB_INCREMENTAL_RESIZE */
+
 DUK_LOCAL duk_bool_t duk__resize_strtab_raw_probe(duk_heap *heap, duk_uint32_t new_size) {
 #ifdef DUK_USE_MARK_AND_SWEEP
 	duk_small_uint_t prev_mark_and_sweep_base_flags;
@@ -653,6 +755,9 @@ DUK_LOCAL duk_bool_t duk__resize_strtab_raw_probe(duk_heap *heap, duk_uint32_t n
 
 	DUK_ASSERT(new_size > (duk_uint32_t) duk__count_used_probe(heap));  /* required for rehash to succeed, equality not that useful */
 	DUK_ASSERT(old_entries);
+#if defined(DUK_USE_STRTAB_INCREMENTAL_RESIZE)
+	DUK_ASSERT(!DUK_STRTAB_MIGRATING(heap));
+#endif
 #ifdef DUK_USE_MARK_AND_SWEEP
 	DUK_ASSERT((heap->mark_and_sweep_base_flags & DUK_MS_FLAG_NO_STRINGTABLE_RESIZE) == 0);
 #endif
@@ -703,6 +808,29 @@ DUK_LOCAL duk_bool_t duk__resize_strtab_raw_probe(duk_heap *heap, duk_uint32_t n
 #endif
 #endif
 
+#if defined(DUK_USE_STRTAB_INCREMENTAL_RESIZE)
+	/* Don't rehash now: keep the old table and migrate a bounded number
+	 * of its slots on each subsequent lookup, so that the worst case cost
+	 * of a single intern doesn't depend on the stringtable size.
+	 */
+	DUK_DD(DUK_DDPRINT("start incremental stringtable resize: %ld entries, %ld used -> %ld entries",
+	                   (long) old_size, (long) heap->st_used, (long) new_size));
+	DUK_UNREF(i);
+	DUK_UNREF(new_used);
+#if defined(DUK_USE_HEAPPTR16)
+	heap->strtable16_old = old_entries;
+	heap->strtable16 = new_entries;
+#else
+	heap->strtable_old = old_entries;
+	heap->strtable = new_entries;
+#endif
+	heap->st_old_size = old_size;
+	heap->st_old_index = 0;
+	heap->st_size = new_size;
+	heap->st_used = 0;
+
+	return 0;  /* OK */
+#else  /* DUK_USE_STRTAB_INCREMENTAL_RESIZE */
 	/* Because new_size > duk__count_used_probe(heap), guaranteed to work */
 	for (i = 0; i < old_size; i++) {
 		duk_hstring *e;
@@ -738,6 +866,7 @@ DUK_LOCAL duk_bool_t duk__resize_strtab_raw_probe(duk_heap *heap, duk_uint32_t n
 	heap->st_used = new_used;  /* may be less, since DELETED entries are NULLed by rehash */
 
 	return 0;  /* OK */
+#endif  /* DUK_USE_STRTAB_INCREMENTAL_RESIZE */
 
  resize_error:
 	DUK_FREE(heap, new_entries);
@@ -748,7 +877,14 @@ DUK_LOCAL duk_bool_t duk__resize_strtab_probe(duk_heap *heap) {
 	duk_uint32_t new_size;
 	duk_bool_t ret;
 
+#if defined(DUK_USE_STRTAB_INCREMENTAL_RESIZE)
+	/* Counting used entries is a full table scan; st_used (which includes
+	 * DELETED entries) is a cheap upper bound for it.
+	 */
+	new_size = heap->st_used;
+#else
 	new_size = (duk_uint32_t) duk__count_used_probe(heap);
+#endif
 	if (new_size >= 0x80000000UL) {
 		new_size = DUK_STRTAB_HIGHEST_32BIT_PRIME;
 	} else {
@@ -780,6 +916,24 @@ DUK_LOCAL duk_bool_t duk__recheck_strtab_size_probe(duk_heap *heap, duk_uint32_t
 	tmp1 = heap->st_size / DUK_STRTAB_MIN_FREE_DIVISOR;
 	tmp2 = heap->st_size / DUK_STRTAB_MIN_USED_DIVISOR;
 
+#if defined(DUK_USE_STRTAB_INCREMENTAL_RESIZE)
+	if (DUK_STRTAB_MIGRATING(heap)) {
+		/* The current table starts out empty during a migration so
+		 * the load factor low limit is meaningless.  If the current
+		 * table fills up before the migration is done (which should
+		 * not normally happen), finish the migration synchronously
+		 * and recheck.
+		 */
+		if (new_free > tmp1) {
+			return 0;  /* OK */
+		}
+		DUK_D(DUK_DPRINT("stringtable filled up during incremental resize, finish migration"));
+		duk__migrate_strtab_probe(heap, 0);
+		DUK_ASSERT(!DUK_STRTAB_MIGRATING(heap));
+		return duk__recheck_strtab_size_probe(heap, heap->st_used + 1);
+	}
+#endif
+
 	if (new_free <= tmp1 || new_used <= tmp2) {
 		/* load factor too low or high, count actually used entries and resize */
 		return duk__resize_strtab_probe(heap);
@@ -853,12 +1007,22 @@ DUK_LOCAL duk_hstring *duk__do_intern(duk_heap *heap, const duk_uint8_t *str, du
 #endif
 	res = duk__alloc_init_hstring(heap, str, blen, strhash, extdata);
 	if (!res) {
+#if defined(DUK_USE_HSTRING_EXTDATA) && defined(DUK_USE_EXTSTR_FREE)
+		/* Every non-NULL intern check result is paired with exactly
+		 * one free call so that the application can e.g. refcount
+		 * external data shared by several heaps.
+		 */
+		if (extdata) {
+			DUK_USE_EXTSTR_FREE(heap->heap_udata, (const void *) extdata);
+		}
+#endif
 		return NULL;
 	}
 
 #if defined(DUK_USE_STRTAB_CHAIN)
 	if (duk__insert_hstring_chain(heap, res)) {
 		/* failed */
+		duk_free_hstring_inner(heap, res);
 		DUK_FREE(heap, res);
 		return NULL;
 	}
@@ -895,6 +1059,9 @@ DUK_LOCAL duk_hstring *duk__do_lookup(duk_heap *heap, const duk_uint8_t *str, du
 #if defined(DUK_USE_STRTAB_CHAIN)
 	res = duk__find_matching_string_chain(heap, str, blen, *out_strhash);
 #elif defined(DUK_USE_STRTAB_PROBE)
+#if defined(DUK_USE_STRTAB_INCREMENTAL_RESIZE)
+	duk__migrate_strtab_probe(heap, DUK_STRTAB_MIGRATE_STEP);
+#endif
 	res = duk__find_matching_string_probe(heap,
 #if defined(DUK_USE_HEAPPTR16)
 	                                      heap->strtable16,
@@ -905,6 +1072,20 @@ DUK_LOCAL duk_hstring *duk__do_lookup(duk_heap *heap, const duk_uint8_t *str, du
 	                                      str,
 	                                      blen,
 	                                      *out_strhash);
+#if defined(DUK_USE_STRTAB_INCREMENTAL_RESIZE)
+	if (res == NULL && DUK_STRTAB_MIGRATING(heap)) {
+		res = duk__find_matching_string_probe(heap,
+#if defined(DUK_USE_HEAPPTR16)
+		                                      heap->strtable16_old,
+#else
+		                                      heap->strtable_old,
+#endif
+		                                      heap->st_old_size,
+		                                      str,
+		                                      blen,
+		                                      *out_strhash);
+	}
+#endif
 #else
 #error internal error, invalid strtab options
 #endif
@@ -958,11 +1139,41 @@ DUK_INTERNAL duk_hstring *duk_heap_string_lookup_u32(duk_heap *heap, duk_uint32_
 #endif
 
 DUK_INTERNAL duk_hstring *duk_heap_string_intern_u32(duk_heap *heap, duk_uint32_t val) {
-	char buf[DUK_STRTAB_U32_MAX_STRLEN+1];
-	DUK_SNPRINTF(buf, sizeof(buf), "%lu", (unsigned long) val);
-	buf[sizeof(buf) - 1] = (char) 0;
-	DUK_ASSERT(DUK_STRLEN(buf) <= DUK_UINT32_MAX);  /* formatted result limited */
-	return duk_heap_string_intern(heap, (const duk_uint8_t *) buf, (duk_uint32_t) DUK_STRLEN(buf));
+	duk_uint8_t buf[DUK_STRTAB_U32_MAX_STRLEN];
+	duk_uint8_t *p;
+	duk_uint32_t t;
+	duk_u32cache *c;
+	duk_hstring *res;
+
+	/* Array index strings are very commonly needed for sparse arrays and
+	 * objects used as integer keyed maps, so keep a small cache of them.
+	 */
+	c = heap->u32cache + (val & (DUK_HEAP_U32CACHE_SIZE - 1));
+	if (c->h != NULL && c->val == val) {
+		DUK_ASSERT(DUK_HSTRING_GET_ARRIDX_SLOW(c->h) == val);
+		return c->h;
+	}
+
+	/* Format backwards; DUK_SNPRINTF() is relatively slow for this. */
+	p = buf + sizeof(buf);
+	t = val;
+	do {
+		*(--p) = (duk_uint8_t) ('0' + (t % 10U));
+		t = t / 10U;
+	} while (t != 0);
+	DUK_ASSERT(p >= buf);
+
+	res = duk_heap_string_intern(heap, (const duk_uint8_t *) p, (duk_uint32_t) ((buf + sizeof(buf)) - p));
+
+	/* 0xffffffff is not an array index, and the weak reference removal in
+	 * duk_heap_strcache_string_remove() relies on the ARRIDX flag.
+	 */
+	if (res != NULL && val != DUK_HSTRING_NO_ARRAY_INDEX) {
+		DUK_ASSERT(DUK_HSTRING_HAS_ARRIDX(res));
+		c->h = res;
+		c->val = val;
+	}
+	return res;
 }
 
 DUK_INTERNAL duk_hstring *duk_heap_string_intern_u32_checked(duk_hthread *thr, duk_uint32_t val) {
@@ -980,14 +1191,36 @@ DUK_INTERNAL void duk_heap_string_remove(duk_heap *heap, duk_hstring *h) {
 #if defined(DUK_USE_STRTAB_CHAIN)
 	duk__remove_matching_hstring_chain(heap, h);
 #elif defined(DUK_USE_STRTAB_PROBE)
-	duk__remove_matching_hstring_probe(heap,
+#if defined(DUK_USE_STRTAB_INCREMENTAL_RESIZE)
+	if (duk__remove_matching_hstring_probe(heap,
+#if defined(DUK_USE_HEAPPTR16)
+	                                       heap->strtable16,
+#else
+	                                       heap->strtable,
+#endif
+	                                       heap->st_size,
+	                                       h)) {
+		return;
+	}
+	DUK_ASSERT(DUK_STRTAB_MIGRATING(heap));
+	(void) duk__remove_matching_hstring_probe(heap,
+#if defined(DUK_USE_HEAPPTR16)
+	                                          heap->strtable16_old,
+#else
+	                                          heap->strtable_old,
+#endif
+	                                          heap->st_old_size,
+	                                          h);
+#else  /* DUK_USE_STRTAB_INCREMENTAL_RESIZE */
+	(void) duk__remove_matching_hstring_probe(heap,
 #if defined(DUK_USE_HEAPPTR16)
-	                                   heap->strtable16,
+	                                          heap->strtable16,
 #else
-	                                   heap->strtable,
+	                                          heap->strtable,
 #endif
-	                                   heap->st_size,
-	                                   h);
+	                                          heap->st_size,
+	                                          h);
+#endif  /* DUK_USE_STRTAB_INCREMENTAL_RESIZE */
 #else
 #error internal error, invalid strtab options
 #endif
@@ -1003,6 +1236,12 @@ DUK_INTERNAL void duk_heap_force_strtab_resize(duk_heap *heap) {
 #if defined(DUK_USE_STRTAB_CHAIN)
 	DUK_UNREF(heap);
 #elif defined(DUK_USE_STRTAB_PROBE)
+#if defined(DUK_USE_STRTAB_INCREMENTAL_RESIZE)
+	/* An ongoing migration drops DELETED entries anyway. */
+	if (DUK_STRTAB_MIGRATING(heap)) {
+		return;
+	}
+#endif
 	duk__resize_strtab_probe(heap);
 #endif
 }
@@ -1076,6 +1315,12 @@ DUK_INTERNAL void duk_heap_free_strtab(duk_heap *heap) {
 	duk_uint_fast32_t i;
 	duk_hstring *h;
 
+#if defined(DUK_USE_STRTAB_INCREMENTAL_RESIZE)
+	/* Simplest to finish an ongoing migration; no allocations needed. */
+	duk__migrate_strtab_probe(heap, 0);
+	DUK_ASSERT(!DUK_STRTAB_MIGRATING(heap));
+#endif
+
 #if defined(DUK_USE_HEAPPTR16)
 	if (heap->strtable16) {
 #else
@@ -350,6 +350,60 @@ struct duk_heaphdr_string {
 		} \
 	} while (0)
 
+/* Overwrite a value in place (e.g. an executor register) with refcount
+ * updates.  The old value is decref'd last because decref may have side
+ * effects (finalizers) which may e.g. resize the value stack, so the
+ * caller must not assume 'tvptr_dst' is valid afterwards.  Only the old
+ * heap pointer is kept instead of a temporary duk_tval copy, and there's
+ * no refcount traffic at all when the slot already holds the same heap
+ * value.  The non-heap setters skip the incref entirely.
+ */
+#define DUK_TVAL_SET_TVAL_UPDREF(thr,tvptr_dst,tvptr_src) do { \
+		duk_tval *duk__dst = (tvptr_dst); \
+		duk_heaphdr *duk__h_old = NULL; \
+		if (DUK_TVAL_IS_HEAP_ALLOCATED(duk__dst)) { \
+			duk__h_old = DUK_TVAL_GET_HEAPHDR(duk__dst); \
+		} \
+		DUK_TVAL_SET_TVAL(duk__dst, (tvptr_src)); \
+		if (DUK_TVAL_IS_HEAP_ALLOCATED(duk__dst)) { \
+			duk_heaphdr *duk__h_new = DUK_TVAL_GET_HEAPHDR(duk__dst); \
+			if (duk__h_new == duk__h_old) { \
+				duk__h_old = NULL;  /* same value, refcount unchanged */ \
+			} else { \
+				DUK_HEAPHDR_INCREF((thr), duk__h_new); \
+			} \
+		} \
+		if (duk__h_old != NULL) { \
+			DUK_HEAPHDR_DECREF((thr), duk__h_old);  /* side effects */ \
+		} \
+	} while (0)
+#define DUK__TVAL_SET_NONHEAP_UPDREF(thr,tvptr_dst,setter) do { \
+		duk_tval *duk__dst = (tvptr_dst); \
+		if (DUK_TVAL_IS_HEAP_ALLOCATED(duk__dst)) { \
+			duk_heaphdr *duk__h_old = DUK_TVAL_GET_HEAPHDR(duk__dst); \
+			setter; \
+			DUK_ASSERT(!DUK_TVAL_IS_HEAP_ALLOCATED(duk__dst)); \
+			DUK_HEAPHDR_DECREF((thr), duk__h_old);  /* side effects */ \
+		} else { \
+			setter; \
+			DUK_ASSERT(!DUK_TVAL_IS_HEAP_ALLOCATED(duk__dst)); \
+		} \
+	} while (0)
+#define DUK_TVAL_SET_UNDEFINED_ACTUAL_UPDREF(thr,tvptr_dst) \
+	DUK__TVAL_SET_NONHEAP_UPDREF((thr), (tvptr_dst), DUK_TVAL_SET_UNDEFINED_ACTUAL(duk__dst))
+#define DUK_TVAL_SET_NULL_UPDREF(thr,tvptr_dst) \
+	DUK__TVAL_SET_NONHEAP_UPDREF((thr), (tvptr_dst), DUK_TVAL_SET_NULL(duk__dst))
+#define DUK_TVAL_SET_BOOLEAN_UPDREF(thr,tvptr_dst,newval) \
+	DUK__TVAL_SET_NONHEAP_UPDREF((thr), (tvptr_dst), DUK_TVAL_SET_BOOLEAN(duk__dst, (newval)))
+#define DUK_TVAL_SET_NUMBER_UPDREF(thr,tvptr_dst,newval) \
+	DUK__TVAL_SET_NONHEAP_UPDREF((thr), (tvptr_dst), DUK_TVAL_SET_NUMBER(duk__dst, (newval)))
+#if defined(DUK_USE_FASTINT)
+#define DUK_TVAL_SET_FASTINT_UPDREF(thr,tvptr_dst,newval) \
+	DUK__TVAL_SET_NONHEAP_UPDREF((thr), (tvptr_dst), DUK_TVAL_SET_FASTINT(duk__dst, (newval)))
+#define DUK_TVAL_SET_FASTINT_I32_UPDREF(thr,tvptr_dst,newval) \
+	DUK__TVAL_SET_NONHEAP_UPDREF((thr), (tvptr_dst), DUK_TVAL_SET_FASTINT_I32(duk__dst, (newval)))
+#endif
+
 #else  /* DUK_USE_REFERENCE_COUNTING */
 
 #define DUK_TVAL_INCREF_FAST(thr,v)            do {} while (0) /* nop */
@@ -381,6 +435,23 @@ struct duk_heaphdr_string {
 #define DUK_HOBJECT_INCREF_ALLOWNULL(thr,h)    do {} while (0) /* nop */
 #define DUK_HOBJECT_DECREF_ALLOWNULL(thr,h)    do {} while (0) /* nop */
 
+#define DUK_TVAL_SET_TVAL_UPDREF(thr,tvptr_dst,tvptr_src) \
+	DUK_TVAL_SET_TVAL((tvptr_dst), (tvptr_src))
+#define DUK_TVAL_SET_UNDEFINED_ACTUAL_UPDREF(thr,tvptr_dst) \
+	DUK_TVAL_SET_UNDEFINED_ACTUAL((tvptr_dst))
+#define DUK_TVAL_SET_NULL_UPDREF(thr,tvptr_dst) \
+	DUK_TVAL_SET_NULL((tvptr_dst))
+#define DUK_TVAL_SET_BOOLEAN_UPDREF(thr,tvptr_dst,newval) \
+	DUK_TVAL_SET_BOOLEAN((tvptr_dst), (newval))
+#define DUK_TVAL_SET_NUMBER_UPDREF(thr,tvptr_dst,newval) \
+	DUK_TVAL_SET_NUMBER((tvptr_dst), (newval))
+#if defined(DUK_USE_FASTINT)
+#define DUK_TVAL_SET_FASTINT_UPDREF(thr,tvptr_dst,newval) \
+	DUK_TVAL_SET_FASTINT((tvptr_dst), (newval))
+#define DUK_TVAL_SET_FASTINT_I32_UPDREF(thr,tvptr_dst,newval) \
+	DUK_TVAL_SET_FASTINT_I32((tvptr_dst), (newval))
+#endif
+
 #endif  /* DUK_USE_REFERENCE_COUNTING */
 
 #endif  /* DUK_HEAPHDR_H_INCLUDED */
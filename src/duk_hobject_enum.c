@@ -158,6 +158,124 @@ DUK_LOCAL void duk__sort_array_indices(duk_hthread *thr, duk_hobject *h_obj) {
 #endif
 }
 
+/*
+ *  Helpers to find the keys an object contributes to an enumeration.
+ *  These are used both to count the keys (so that the enumerator entry
+ *  part can be allocated at its final size right away) and to add them.
+ */
+
+/* Number of virtual index keys ('0', '1', ...) of a string or buffer object. */
+DUK_LOCAL duk_uint_fast32_t duk__enum_get_virtual_index_count(duk_hthread *thr, duk_hobject *obj) {
+	if (DUK_HOBJECT_HAS_EXOTIC_STRINGOBJ(obj)) {
+		duk_hstring *h_val;
+		h_val = duk_hobject_get_internal_value_string(thr->heap, obj);
+		DUK_ASSERT(h_val != NULL);  /* string objects must not created without internal value */
+		return (duk_uint_fast32_t) DUK_HSTRING_GET_CHARLEN(h_val);
+	} else if (DUK_HOBJECT_IS_BUFFEROBJECT(obj)) {
+		duk_hbufferobject *h_bufobj;
+		h_bufobj = (duk_hbufferobject *) obj;
+		if (h_bufobj == NULL) {
+			/* Neutered buffer, zero length seems
+			 * like good behavior here.
+			 */
+			return 0;
+		} else {
+			/* There's intentionally no check for
+			 * current underlying buffer length.
+			 */
+			return (duk_uint_fast32_t) (h_bufobj->length >> h_bufobj->shift);
+		}
+	}
+	return 0;
+}
+
+/* Number of non-enumerable virtual properties of an object, taken from the
+ * start of duk__bufferobject_virtual_props.  They are only included if
+ * non-enumerable properties are requested.
+ */
+DUK_LOCAL duk_uint_fast32_t duk__enum_get_virtual_prop_count(duk_hobject *obj, duk_small_uint_t enum_flags) {
+	DUK_ASSERT(duk__bufferobject_virtual_props[0] == DUK_STRIDX_LENGTH);
+
+	if (!(enum_flags & DUK_ENUM_INCLUDE_NONENUMERABLE)) {
+		return 0;
+	}
+	if (DUK_HOBJECT_IS_BUFFEROBJECT(obj)) {
+		return (duk_uint_fast32_t) (sizeof(duk__bufferobject_virtual_props) / sizeof(duk_uint16_t));
+	} else if (DUK_HOBJECT_HAS_EXOTIC_STRINGOBJ(obj) ||
+	           DUK_HOBJECT_HAS_EXOTIC_DUKFUNC(obj)) {
+		return 1;  /* only 'length' */
+	}
+	return 0;
+}
+
+/* Entry part key at index 'i' if it is included in the enumeration, NULL
+ * otherwise.
+ */
+DUK_LOCAL duk_hstring *duk__enum_get_entry_key(duk_hthread *thr, duk_hobject *obj, duk_uint_fast32_t i, duk_small_uint_t enum_flags) {
+	duk_hstring *k;
+
+	DUK_UNREF(thr);
+
+	k = DUK_HOBJECT_E_GET_KEY(thr->heap, obj, i);
+	if (!k) {
+		return NULL;
+	}
+	if (!DUK_HOBJECT_E_SLOT_IS_ENUMERABLE(thr->heap, obj, i) &&
+	    !(enum_flags & DUK_ENUM_INCLUDE_NONENUMERABLE)) {
+		return NULL;
+	}
+	if (DUK_HSTRING_HAS_INTERNAL(k) &&
+	    !(enum_flags & DUK_ENUM_INCLUDE_INTERNAL)) {
+		return NULL;
+	}
+	if ((enum_flags & DUK_ENUM_ARRAY_INDICES_ONLY) &&
+	    (DUK_HSTRING_GET_ARRIDX_SLOW(k) == DUK_HSTRING_NO_ARRAY_INDEX)) {
+		return NULL;
+	}
+
+	DUK_ASSERT(DUK_HOBJECT_E_SLOT_IS_ACCESSOR(thr->heap, obj, i) ||
+	           !DUK_TVAL_IS_UNDEFINED_UNUSED(&DUK_HOBJECT_E_GET_VALUE_PTR(thr->heap, obj, i)->v));
+	return k;
+}
+
+/* Upper bound for the number of keys an object adds to the enumerator;
+ * duplicates (shadowed keys) are not detected here.
+ */
+DUK_LOCAL duk_uint_fast32_t duk__enum_count_keys(duk_hthread *thr, duk_hobject *obj, duk_small_uint_t enum_flags) {
+	duk_uint_fast32_t res;
+	duk_uint_fast32_t i;
+
+	res = duk__enum_get_virtual_index_count(thr, obj) +
+	      duk__enum_get_virtual_prop_count(obj, enum_flags);
+
+	for (i = 0; i < (duk_uint_fast32_t) DUK_HOBJECT_GET_ASIZE(obj); i++) {
+		if (!DUK_TVAL_IS_UNDEFINED_UNUSED(DUK_HOBJECT_A_GET_VALUE_PTR(thr->heap, obj, i))) {
+			res++;
+		}
+	}
+
+	for (i = 0; i < (duk_uint_fast32_t) DUK_HOBJECT_GET_ENEXT(obj); i++) {
+		if (duk__enum_get_entry_key(thr, obj, i, enum_flags) != NULL) {
+			res++;
+		}
+	}
+
+	return res;
+}
+
+/* Add a key to the enumerator object.  A key which already exists (e.g. is
+ * shadowed by an inherited key) keeps its original position.  The key is
+ * kept reachable through the value stack because interned index keys are
+ * not reachable otherwise, and adding an entry may trigger a GC if the
+ * entry part was not presized.
+ */
+DUK_LOCAL void duk__enum_add_key(duk_context *ctx, duk_hobject *res, duk_hstring *k) {
+	duk_push_hstring(ctx, k);
+	duk_push_true(ctx);
+	duk_hobject_define_property_internal((duk_hthread *) ctx, res, k, DUK_PROPDESC_FLAGS_WEC);
+	duk_pop(ctx);
+}
+
 /*
  *  Create an internal enumerator object E, which has its keys ordered
  *  to match desired enumeration ordering.  Also initialize internal control
@@ -178,6 +296,7 @@ DUK_INTERNAL void duk_hobject_enumerator_create(duk_context *ctx, duk_small_uint
 	duk_hobject *h_trap_result;
 #endif
 	duk_uint_fast32_t i, len;  /* used for array, stack, and entry indices */
+	duk_uint_fast32_t count;
 
 	DUK_ASSERT(ctx != NULL);
 
@@ -284,6 +403,35 @@ DUK_INTERNAL void duk_hobject_enumerator_create(duk_context *ctx, duk_small_uint
  skip_proxy:
 #endif  /* DUK_USE_ES6_PROXY */
 
+	/*
+	 *  Count keys first so that the enumerator entry part can be allocated
+	 *  once, at its final size.  Keys are then added directly to the entry
+	 *  part without the generic property write path.  The count is an upper
+	 *  bound because shadowed keys are only detected when adding.
+	 */
+
+	count = DUK__ENUM_START_INDEX;
+	curr = enum_target;
+	while (curr) {
+		len = duk__enum_count_keys(thr, curr, enum_flags);
+		if (len > DUK_HOBJECT_MAX_PROPERTIES - count) {
+			/* Too many keys for a presize (which would fail);
+			 * grow on demand instead, as more keys may be shadowed.
+			 */
+			count = DUK_HOBJECT_MAX_PROPERTIES;
+			break;
+		}
+		count += len;
+
+		if (enum_flags & DUK_ENUM_OWN_PROPERTIES_ONLY) {
+			break;
+		}
+		curr = DUK_HOBJECT_GET_PROTOTYPE(thr->heap, curr);
+	}
+	if (count < DUK_HOBJECT_MAX_PROPERTIES) {
+		duk_hobject_resize_entrypart(thr, res, (duk_uint32_t) count);
+	}
+
 	curr = enum_target;
 	while (curr) {
 		/*
@@ -294,76 +442,23 @@ DUK_INTERNAL void duk_hobject_enumerator_create(duk_context *ctx, duk_small_uint
 		 *  object props have special behavior but are concrete.
 		 */
 
-		if (DUK_HOBJECT_HAS_EXOTIC_STRINGOBJ(curr) ||
-		    DUK_HOBJECT_IS_BUFFEROBJECT(curr)) {
-			/* String and buffer enumeration behavior is identical now,
-			 * so use shared handler.
-			 */
-			if (DUK_HOBJECT_HAS_EXOTIC_STRINGOBJ(curr)) {
-				duk_hstring *h_val;
-				h_val = duk_hobject_get_internal_value_string(thr->heap, curr);
-				DUK_ASSERT(h_val != NULL);  /* string objects must not created without internal value */
-				len = (duk_uint_fast32_t) DUK_HSTRING_GET_CHARLEN(h_val);
-			} else {
-				duk_hbufferobject *h_bufobj;
-				DUK_ASSERT(DUK_HOBJECT_IS_BUFFEROBJECT(curr));
-				h_bufobj = (duk_hbufferobject *) curr;
-				if (h_bufobj == NULL) {
-					/* Neutered buffer, zero length seems
-					 * like good behavior here.
-					 */
-					len = 0;
-				} else {
-					/* There's intentionally no check for
-					 * current underlying buffer length.
-					 */
-					len = (duk_uint_fast32_t) (h_bufobj->length >> h_bufobj->shift);
-				}
-			}
-
-			for (i = 0; i < len; i++) {
-				duk_hstring *k;
-
-				k = duk_heap_string_intern_u32_checked(thr, i);
-				DUK_ASSERT(k);
-				duk_push_hstring(ctx, k);
-				duk_push_true(ctx);
-
-				/* [enum_target res key true] */
-				duk_put_prop(ctx, -3);
-
-				/* [enum_target res] */
-			}
-
-			/* 'length' and other virtual properties are not
-			 * enumerable, but are included if non-enumerable
-			 * properties are requested.
-			 */
-
-			if (enum_flags & DUK_ENUM_INCLUDE_NONENUMERABLE) {
-				duk_uint_fast32_t n;
+		len = duk__enum_get_virtual_index_count(thr, curr);
+		for (i = 0; i < len; i++) {
+			duk_hstring *k;
 
-				if (DUK_HOBJECT_IS_BUFFEROBJECT(curr)) {
-					n = sizeof(duk__bufferobject_virtual_props) / sizeof(duk_uint16_t);
-				} else {
-					DUK_ASSERT(DUK_HOBJECT_HAS_EXOTIC_STRINGOBJ(curr));
-					DUK_ASSERT(duk__bufferobject_virtual_props[0] == DUK_STRIDX_LENGTH);
-					n = 1;  /* only 'length' */
-				}
+			k = duk_heap_string_intern_u32_checked(thr, i);
+			DUK_ASSERT(k);
+			duk__enum_add_key(ctx, res, k);
+		}
 
-				for (i = 0; i < n; i++) {
-					duk_push_hstring_stridx(ctx, duk__bufferobject_virtual_props[i]);
-					duk_push_true(ctx);
-					duk_put_prop(ctx, -3);
-				}
+		/* 'length' and other virtual properties are not
+		 * enumerable, but are included if non-enumerable
+		 * properties are requested.
+		 */
 
-			}
-		} else if (DUK_HOBJECT_HAS_EXOTIC_DUKFUNC(curr)) {
-			if (enum_flags & DUK_ENUM_INCLUDE_NONENUMERABLE) {
-				duk_push_hstring_stridx(ctx, DUK_STRIDX_LENGTH);
-				duk_push_true(ctx);
-				duk_put_prop(ctx, -3);
-			}
+		len = duk__enum_get_virtual_prop_count(curr, enum_flags);
+		for (i = 0; i < len; i++) {
+			duk__enum_add_key(ctx, res, DUK_HTHREAD_GET_STRING(thr, duk__bufferobject_virtual_props[i]));
 		}
 
 		/*
@@ -384,14 +479,7 @@ DUK_INTERNAL void duk_hobject_enumerator_create(duk_context *ctx, duk_small_uint
 			}
 			k = duk_heap_string_intern_u32_checked(thr, i);
 			DUK_ASSERT(k);
-
-			duk_push_hstring(ctx, k);
-			duk_push_true(ctx);
-
-			/* [enum_target res key true] */
-			duk_put_prop(ctx, -3);
-
-			/* [enum_target res] */
+			duk__enum_add_key(ctx, res, k);
 		}
 
 		/*
@@ -401,33 +489,11 @@ DUK_INTERNAL void duk_hobject_enumerator_create(duk_context *ctx, duk_small_uint
 		for (i = 0; i < (duk_uint_fast32_t) DUK_HOBJECT_GET_ENEXT(curr); i++) {
 			duk_hstring *k;
 
-			k = DUK_HOBJECT_E_GET_KEY(thr->heap, curr, i);
+			k = duk__enum_get_entry_key(thr, curr, i, enum_flags);
 			if (!k) {
 				continue;
 			}
-			if (!DUK_HOBJECT_E_SLOT_IS_ENUMERABLE(thr->heap, curr, i) &&
-			    !(enum_flags & DUK_ENUM_INCLUDE_NONENUMERABLE)) {
-				continue;
-			}
-			if (DUK_HSTRING_HAS_INTERNAL(k) &&
-			    !(enum_flags & DUK_ENUM_INCLUDE_INTERNAL)) {
-				continue;
-			}
-			if ((enum_flags & DUK_ENUM_ARRAY_INDICES_ONLY) &&
-			    (DUK_HSTRING_GET_ARRIDX_SLOW(k) == DUK_HSTRING_NO_ARRAY_INDEX)) {
-				continue;
-			}
-
-			DUK_ASSERT(DUK_HOBJECT_E_SLOT_IS_ACCESSOR(thr->heap, curr, i) ||
-			           !DUK_TVAL_IS_UNDEFINED_UNUSED(&DUK_HOBJECT_E_GET_VALUE_PTR(thr->heap, curr, i)->v));
-
-			duk_push_hstring(ctx, k);
-			duk_push_true(ctx);
-
-			/* [enum_target res key true] */
-			duk_put_prop(ctx, -3);
-
-			/* [enum_target res] */
+			duk__enum_add_key(ctx, res, k);
 		}
 
 		if (enum_flags & DUK_ENUM_OWN_PROPERTIES_ONLY) {
@@ -468,12 +534,22 @@ DUK_INTERNAL void duk_hobject_enumerator_create(duk_context *ctx, duk_small_uint
 		duk__sort_array_indices(thr, res);
 	}
 
+	/* If no keys were shadowed the entry part already has its final size
+	 * and compaction would be a no-op.
+	 */
+	if (DUK_HOBJECT_GET_ENEXT(res) == count) {
+		DUK_DDD(DUK_DDDPRINT("enumerator presized exactly, skip compaction"));
+		goto return_res;
+	}
+
 #if defined(DUK_USE_ES6_PROXY)
  compact_and_return:
 #endif
 	/* compact; no need to seal because object is internal */
 	duk_hobject_compact_props(thr, res);
 
+ return_res:
+
 	DUK_DDD(DUK_DDDPRINT("created enumerator object: %!iT", (duk_tval *) duk_get_tval(ctx, -1)));
 }
 
@@ -492,6 +568,8 @@ DUK_INTERNAL duk_bool_t duk_hobject_enumerator_next(duk_context *ctx, duk_bool_t
 	duk_hstring *res = NULL;
 	duk_uint_fast32_t idx;
 	duk_bool_t check_existence;
+	duk_tval *tv_next;
+	duk_tval *tv_target;
 
 	DUK_ASSERT(ctx != NULL);
 
@@ -499,10 +577,17 @@ DUK_INTERNAL duk_bool_t duk_hobject_enumerator_next(duk_context *ctx, duk_bool_t
 
 	e = duk_require_hobject(ctx, -1);
 
-	/* XXX use get tval ptr, more efficient */
-	duk_get_prop_stridx(ctx, -1, DUK_STRIDX_INT_NEXT);
-	idx = (duk_uint_fast32_t) duk_require_uint(ctx, -1);
-	duk_pop(ctx);
+	/* The control properties are always the first entries of an enumerator
+	 * object, so access them directly instead of a property lookup.
+	 */
+	DUK_ASSERT(DUK_HOBJECT_GET_ENEXT(e) >= DUK__ENUM_START_INDEX);
+	DUK_ASSERT(DUK_HOBJECT_E_GET_KEY(thr->heap, e, 0) == DUK_HTHREAD_STRING_INT_TARGET(thr));
+	DUK_ASSERT(DUK_HOBJECT_E_GET_KEY(thr->heap, e, 1) == DUK_HTHREAD_STRING_INT_NEXT(thr));
+	tv_target = DUK_HOBJECT_E_GET_VALUE_TVAL_PTR(thr->heap, e, 0);
+	tv_next = DUK_HOBJECT_E_GET_VALUE_TVAL_PTR(thr->heap, e, 1);
+
+	DUK_ASSERT(DUK_TVAL_IS_NUMBER(tv_next));
+	idx = (duk_uint_fast32_t) DUK_TVAL_GET_NUMBER(tv_next);
 	DUK_DDD(DUK_DDDPRINT("enumeration: index is: %ld", (long) idx));
 
 	/* Enumeration keys are checked against the enumeration target (to see
@@ -510,15 +595,14 @@ DUK_INTERNAL duk_bool_t duk_hobject_enumerator_next(duk_context *ctx, duk_bool_t
 	 * be the proxy, and checking key existence against the proxy is not
 	 * required (or sensible, as the keys may be fully virtual).
 	 */
-	duk_get_prop_stridx(ctx, -1, DUK_STRIDX_INT_TARGET);
-	enum_target = duk_require_hobject(ctx, -1);
+	DUK_ASSERT(DUK_TVAL_IS_OBJECT(tv_target));
+	enum_target = DUK_TVAL_GET_OBJECT(tv_target);  /* reachable through enumerator */
 	DUK_ASSERT(enum_target != NULL);
 #if defined(DUK_USE_ES6_PROXY)
 	check_existence = (!DUK_HOBJECT_HAS_EXOTIC_PROXYOBJ(enum_target));
 #else
 	check_existence = 1;
 #endif
-	duk_pop(ctx);  /* still reachable */
 
 	DUK_DDD(DUK_DDDPRINT("getting next enum value, enum_target=%!iO, enumerator=%!iT",
 	                     (duk_heaphdr *) enum_target, (duk_tval *) duk_get_tval(ctx, -1)));
@@ -553,8 +637,17 @@ DUK_INTERNAL duk_bool_t duk_hobject_enumerator_next(duk_context *ctx, duk_bool_t
 
 	DUK_DDD(DUK_DDDPRINT("enumeration: updating next index to %ld", (long) idx));
 
-	duk_push_u32(ctx, (duk_uint32_t) idx);
-	duk_put_prop_stridx(ctx, -2, DUK_STRIDX_INT_NEXT);
+	/* Re-lookup: the existence check may have side effects (such as an
+	 * emergency GC compacting the enumerator) which invalidate the pointer.
+	 * Compaction keeps entry order, so the index is still valid.
+	 */
+	tv_next = DUK_HOBJECT_E_GET_VALUE_TVAL_PTR(thr->heap, e, 1);
+	DUK_ASSERT(DUK_TVAL_IS_NUMBER(tv_next));
+#if defined(DUK_USE_FASTINT)
+	DUK_TVAL_SET_FASTINT_U32(tv_next, (duk_uint32_t) idx);  /* no need for decref/incref because value is a number */
+#else
+	DUK_TVAL_SET_NUMBER(tv_next, (duk_double_t) idx);  /* no need for decref/incref because value is a number */
+#endif
 
 	/* [... enum] */
 
@@ -581,8 +674,86 @@ DUK_INTERNAL duk_bool_t duk_hobject_enumerator_next(duk_context *ctx, duk_bool_t
  *  described in E5 Section 15.2.3.14.
  */
 
+/* Own keys of an ordinary object are unique, so they can be written into a
+ * result array of the right size directly, in enumeration order, without
+ * building an enumerator object for duplicate elimination first.  This is
+ * the common case for Object.keys(), Object.getOwnPropertyNames(), and JSON
+ * encoding.
+ */
+DUK_LOCAL void duk__get_own_keys_direct(duk_context *ctx, duk_hobject *obj, duk_small_uint_t enum_flags) {
+	duk_hthread *thr = (duk_hthread *) ctx;
+	duk_hobject *res;
+	duk_uint_fast32_t count;
+	duk_uint_fast32_t i, len;
+	duk_uarridx_t idx;
+
+	DUK_ASSERT(ctx != NULL);
+	DUK_ASSERT(obj != NULL);
+	DUK_ASSERT(enum_flags & DUK_ENUM_OWN_PROPERTIES_ONLY);
+
+	count = duk__enum_count_keys(thr, obj, enum_flags);
+	if (count > DUK_HOBJECT_MAX_PROPERTIES) {
+		DUK_ERROR(thr, DUK_ERR_ALLOC_ERROR, DUK_STR_OBJECT_PROPERTY_LIMIT);
+	}
+
+	duk_push_array(ctx);
+	res = duk_require_hobject(ctx, -1);
+	DUK_ASSERT(res != NULL);
+	if (count > (duk_uint_fast32_t) DUK_HOBJECT_GET_ASIZE(res)) {
+		duk_hobject_resize_arraypart(thr, res, (duk_uint32_t) count);
+	}
+
+	/* [ ... obj res ] */
+
+	/* Each key is pushed to keep it reachable and then written with an
+	 * internal define which copes with the array part being resized by
+	 * side effects (e.g. an emergency GC compacting it).  Key order must
+	 * match duk_hobject_enumerator_create().
+	 */
+	idx = 0;
+
+	len = duk__enum_get_virtual_index_count(thr, obj);
+	for (i = 0; i < len; i++) {
+		duk_push_hstring(ctx, duk_heap_string_intern_u32_checked(thr, (duk_uint32_t) i));
+		duk_hobject_define_property_internal_arridx(thr, res, idx++, DUK_PROPDESC_FLAGS_WEC);
+	}
+
+	len = duk__enum_get_virtual_prop_count(obj, enum_flags);
+	for (i = 0; i < len; i++) {
+		duk_push_hstring_stridx(ctx, duk__bufferobject_virtual_props[i]);
+		duk_hobject_define_property_internal_arridx(thr, res, idx++, DUK_PROPDESC_FLAGS_WEC);
+	}
+
+	for (i = 0; i < (duk_uint_fast32_t) DUK_HOBJECT_GET_ASIZE(obj); i++) {
+		if (DUK_TVAL_IS_UNDEFINED_UNUSED(DUK_HOBJECT_A_GET_VALUE_PTR(thr->heap, obj, i))) {
+			continue;
+		}
+		duk_push_hstring(ctx, duk_heap_string_intern_u32_checked(thr, (duk_uint32_t) i));
+		duk_hobject_define_property_internal_arridx(thr, res, idx++, DUK_PROPDESC_FLAGS_WEC);
+	}
+
+	for (i = 0; i < (duk_uint_fast32_t) DUK_HOBJECT_GET_ENEXT(obj); i++) {
+		duk_hstring *k;
+
+		k = duk__enum_get_entry_key(thr, obj, i, enum_flags);
+		if (!k) {
+			continue;
+		}
+		duk_push_hstring(ctx, k);
+		duk_hobject_define_property_internal_arridx(thr, res, idx++, DUK_PROPDESC_FLAGS_WEC);
+	}
+
+	/* The count is normally exact, but a finalizer triggered by interning
+	 * may have modified 'obj' in the meantime, so use the actual count.
+	 */
+	duk_hobject_set_length(thr, res, (duk_uint32_t) idx);
+
+	/* [ ... obj res ] */
+}
+
 DUK_INTERNAL duk_ret_t duk_hobject_get_enumerated_keys(duk_context *ctx, duk_small_uint_t enum_flags) {
 	duk_hthread *thr = (duk_hthread *) ctx;
+	duk_hobject *enum_target;
 	duk_hobject *e;
 	duk_uint_fast32_t i;
 	duk_uint_fast32_t idx;
@@ -591,6 +762,23 @@ DUK_INTERNAL duk_ret_t duk_hobject_get_enumerated_keys(duk_context *ctx, duk_sma
 	DUK_ASSERT(duk_get_hobject(ctx, -1) != NULL);
 	DUK_UNREF(thr);
 
+	enum_target = duk_require_hobject(ctx, -1);
+	DUK_ASSERT(enum_target != NULL);
+
+	/* Proxies need the trap result and inherited keys need duplicate
+	 * elimination, so they go through the enumerator.  The same goes for
+	 * sorting array indices because entry part keys are not ordered.
+	 */
+	if ((enum_flags & DUK_ENUM_OWN_PROPERTIES_ONLY) &&
+	    !(enum_flags & DUK_ENUM_SORT_ARRAY_INDICES)
+#if defined(DUK_USE_ES6_PROXY)
+	    && !DUK_HOBJECT_HAS_EXOTIC_PROXYOBJ(enum_target)
+#endif
+	    ) {
+		duk__get_own_keys_direct(ctx, enum_target, enum_flags);
+		return 1;  /* return 1 to allow callers to tail call */
+	}
+
 	/* Create a temporary enumerator to get the (non-duplicated) key list;
 	 * the enumerator state is initialized without being needed, but that
 	 * has little impact.
@@ -149,6 +149,27 @@ DUK_LOCAL duk_uint32_t duk__push_tval_to_hstring_arr_idx(duk_context *ctx, duk_t
 	DUK_ASSERT(tv != NULL);
 	DUK_ASSERT(out_h != NULL);
 
+	/* Fast path for number keys which are array indices: no number
+	 * formatting, and the string is usually found in the heap u32 cache.
+	 */
+#if defined(DUK_USE_FASTINT)
+	if (DUK_TVAL_IS_FASTINT(tv)) {
+		arr_idx = duk__tval_fastint_to_arr_idx(tv);
+	} else
+#endif
+	if (DUK_TVAL_IS_NUMBER(tv)) {
+		arr_idx = duk__tval_number_to_arr_idx(tv);
+	} else {
+		arr_idx = DUK__NO_ARRAY_INDEX;
+	}
+	if (arr_idx != DUK__NO_ARRAY_INDEX) {
+		h = duk_heap_string_intern_u32_checked((duk_hthread *) ctx, arr_idx);
+		DUK_ASSERT(h != NULL);
+		duk_push_hstring(ctx, h);
+		*out_h = h;
+		return arr_idx;
+	}
+
 	duk_push_tval(ctx, tv);
 	duk_to_string(ctx, -1);
 	h = duk_get_hstring(ctx, -1);
@@ -697,30 +718,6 @@ void duk__realloc_props(duk_hthread *thr,
 		duk_pop_n(ctx, new_e_next);
 	}
 
-	/*
-	 *  Copy keys and values in the entry part (compacting them at the same time).
-	 */
-
-	for (i = 0; i < DUK_HOBJECT_GET_ENEXT(obj); i++) {
-		duk_hstring *key;
-
-		DUK_ASSERT(DUK_HOBJECT_GET_PROPS(thr->heap, obj) != NULL);
-
-		key = DUK_HOBJECT_E_GET_KEY(thr->heap, obj, i);
-		if (!key) {
-			continue;
-		}
-
-		DUK_ASSERT(new_p != NULL && new_e_k != NULL &&
-		           new_e_pv != NULL && new_e_f != NULL);
-
-		new_e_k[new_e_next] = key;
-		new_e_pv[new_e_next] = DUK_HOBJECT_E_GET_VALUE(thr->heap, obj, i);
-		new_e_f[new_e_next] = DUK_HOBJECT_E_GET_FLAGS(thr->heap, obj, i);
-		new_e_next++;
-	}
-	/* the entries [new_e_next, new_e_size_adjusted[ are left uninitialized on purpose (ok, not gc reachable) */
-
 	/*
 	 *  Copy array elements to new array part.
 	 */
@@ -767,6 +764,53 @@ void duk__realloc_props(duk_hthread *thr,
 		}
 	}
 
+	/*
+	 *  Copy keys and values in the entry part (compacting them at the same time).
+	 *
+	 *  When the array part grows, sparse array index entries which now fall
+	 *  inside it are moved into the array part.  Caller has ensured they are
+	 *  plain WEC data properties (see duk__grow_props_for_array_item()).  The
+	 *  value refcount is transferred as is; the entry key reference is dropped,
+	 *  which has no side effects other than possibly freeing the string.
+	 */
+
+	for (i = 0; i < DUK_HOBJECT_GET_ENEXT(obj); i++) {
+		duk_hstring *key;
+
+		DUK_ASSERT(DUK_HOBJECT_GET_PROPS(thr->heap, obj) != NULL);
+
+		key = DUK_HOBJECT_E_GET_KEY(thr->heap, obj, i);
+		if (!key) {
+			continue;
+		}
+
+		if (new_a_size > DUK_HOBJECT_GET_ASIZE(obj) &&
+		    DUK_HSTRING_HAS_ARRIDX(key) &&
+		    DUK_HSTRING_GET_ARRIDX_SLOW(key) < new_a_size) {
+			duk_uint32_t arr_idx = DUK_HSTRING_GET_ARRIDX_SLOW(key);
+
+			DUK_ASSERT(!abandon_array);
+			DUK_ASSERT(arr_idx >= DUK_HOBJECT_GET_ASIZE(obj));
+			DUK_ASSERT(DUK_HOBJECT_E_GET_FLAGS(thr->heap, obj, i) == DUK_PROPDESC_FLAGS_WEC);
+			DUK_ASSERT(new_a != NULL);
+			DUK_ASSERT(DUK_TVAL_IS_UNDEFINED_UNUSED(&new_a[arr_idx]));
+
+			DUK_DDD(DUK_DDDPRINT("move sparse entry %ld into grown array part", (long) arr_idx));
+			DUK_TVAL_SET_TVAL(&new_a[arr_idx], DUK_HOBJECT_E_GET_VALUE_TVAL_PTR(thr->heap, obj, i));
+			DUK_HSTRING_DECREF(thr, key);  /* no side effects */
+			continue;
+		}
+
+		DUK_ASSERT(new_p != NULL && new_e_k != NULL &&
+		           new_e_pv != NULL && new_e_f != NULL);
+
+		new_e_k[new_e_next] = key;
+		new_e_pv[new_e_next] = DUK_HOBJECT_E_GET_VALUE(thr->heap, obj, i);
+		new_e_f[new_e_next] = DUK_HOBJECT_E_GET_FLAGS(thr->heap, obj, i);
+		new_e_next++;
+	}
+	/* the entries [new_e_next, new_e_size_adjusted[ are left uninitialized on purpose (ok, not gc reachable) */
+
 	/*
 	 *  Rebuild the hash part always from scratch (guaranteed to finish).
 	 *
@@ -779,8 +823,10 @@ void duk__realloc_props(duk_hthread *thr,
 	if (DUK_UNLIKELY(new_h_size > 0)) {
 		DUK_ASSERT(new_h != NULL);
 
-		/* fill new_h with u32 0xff = UNUSED */
-		DUK_ASSERT(DUK_HOBJECT_GET_PROPS(thr->heap, obj) != NULL);
+		/* fill new_h with u32 0xff = UNUSED; the old property table may
+		 * be NULL (e.g. a fresh object resized straight to a size which
+		 * needs a hash part).
+		 */
 		DUK_ASSERT(new_h_size > 0);
 		DUK_MEMSET(new_h, 0xff, sizeof(duk_uint32_t) * new_h_size);
 
@@ -939,26 +985,6 @@ DUK_LOCAL void duk__grow_props_for_new_entry_item(duk_hthread *thr, duk_hobject
 	duk__realloc_props(thr, obj, new_e_size, new_a_size, new_h_size, 0);
 }
 
-/* Grow array part for a new highest array index. */
-DUK_LOCAL void duk__grow_props_for_array_item(duk_hthread *thr, duk_hobject *obj, duk_uint32_t highest_arr_idx) {
-	duk_uint32_t new_e_size;
-	duk_uint32_t new_a_size;
-	duk_uint32_t new_h_size;
-
-	DUK_ASSERT(thr != NULL);
-	DUK_ASSERT(obj != NULL);
-	DUK_ASSERT(highest_arr_idx >= DUK_HOBJECT_GET_ASIZE(obj));
-
-	/* minimum new length is highest_arr_idx + 1 */
-
-	new_e_size = DUK_HOBJECT_GET_ESIZE(obj);
-	new_h_size = DUK_HOBJECT_GET_HSIZE(obj);
-	new_a_size = highest_arr_idx + duk__get_min_grow_a(highest_arr_idx);
-	DUK_ASSERT(new_a_size >= highest_arr_idx + 1);  /* duk__get_min_grow_a() is always >= 1 */
-
-	duk__realloc_props(thr, obj, new_e_size, new_a_size, new_h_size, 0);
-}
-
 /* Abandon array part, moving array entries into entries part.
  * This requires a props resize, which is a heavy operation.
  * We also compact the entries part while we're at it, although
@@ -1002,6 +1028,91 @@ DUK_LOCAL void duk__abandon_array_checked(duk_hthread *thr, duk_hobject *obj) {
 	duk__realloc_props(thr, obj, new_e_size, new_a_size, new_h_size, 1);
 }
 
+/* Grow array part for a new highest array index.  Sparse array index
+ * entries in the entry part which fall inside the grown array part are
+ * moved into it.  If any of them can't be represented in the array part
+ * (accessor or non-default attributes), the array part is abandoned
+ * instead: callers must check for that.
+ */
+DUK_LOCAL void duk__grow_props_for_array_item(duk_hthread *thr, duk_hobject *obj, duk_uint32_t highest_arr_idx) {
+	duk_uint32_t new_e_size;
+	duk_uint32_t new_a_size;
+	duk_uint32_t new_h_size;
+	duk_uint_fast32_t i;
+
+	DUK_ASSERT(thr != NULL);
+	DUK_ASSERT(obj != NULL);
+	DUK_ASSERT(highest_arr_idx >= DUK_HOBJECT_GET_ASIZE(obj));
+
+	/* minimum new length is highest_arr_idx + 1 */
+
+	new_e_size = DUK_HOBJECT_GET_ESIZE(obj);
+	new_h_size = DUK_HOBJECT_GET_HSIZE(obj);
+	new_a_size = highest_arr_idx + duk__get_min_grow_a(highest_arr_idx);
+	DUK_ASSERT(new_a_size >= highest_arr_idx + 1);  /* duk__get_min_grow_a() is always >= 1 */
+
+	for (i = 0; i < DUK_HOBJECT_GET_ENEXT(obj); i++) {
+		duk_hstring *key;
+
+		key = DUK_HOBJECT_E_GET_KEY(thr->heap, obj, i);
+		if (key == NULL ||
+		    !DUK_HSTRING_HAS_ARRIDX(key) ||
+		    DUK_HSTRING_GET_ARRIDX_SLOW(key) >= new_a_size) {
+			continue;
+		}
+		if (DUK_HOBJECT_E_GET_FLAGS(thr->heap, obj, i) != DUK_PROPDESC_FLAGS_WEC) {
+			DUK_DD(DUK_DDPRINT("sparse array entry %ld cannot move to array part, abandon array",
+			                   (long) DUK_HSTRING_GET_ARRIDX_SLOW(key)));
+			duk__abandon_array_checked(thr, obj);
+			return;
+		}
+	}
+
+	duk__realloc_props(thr, obj, new_e_size, new_a_size, new_h_size, 0);
+}
+
+/*
+ *  Resize the entry part of an object so that 'new_e_size' entries fit
+ *  without further growth steps.  Useful when the number of properties
+ *  to be added is known beforehand (e.g. enumerator objects): repeated
+ *  growth and a final compaction can then be avoided.  The array part is
+ *  kept as is, and the hash part is sized as in compaction.
+ */
+
+DUK_INTERNAL void duk_hobject_resize_entrypart(duk_hthread *thr, duk_hobject *obj, duk_uint32_t new_e_size) {
+	duk_uint32_t new_a_size;
+	duk_uint32_t new_h_size;
+
+	DUK_ASSERT(thr != NULL);
+	DUK_ASSERT(obj != NULL);
+	DUK_ASSERT(new_e_size >= duk__count_used_e_keys(thr, obj));
+
+#if defined(DUK_USE_HOBJECT_HASH_PART)
+	new_h_size = duk__get_default_h_size(new_e_size);
+#else
+	new_h_size = 0;
+#endif
+	new_a_size = DUK_HOBJECT_GET_ASIZE(obj);
+
+	duk__realloc_props(thr, obj, new_e_size, new_a_size, new_h_size, 0);
+}
+
+/* Same for the array part, e.g. for a result array of known length. */
+DUK_INTERNAL void duk_hobject_resize_arraypart(duk_hthread *thr, duk_hobject *obj, duk_uint32_t new_a_size) {
+	duk_uint32_t new_e_size;
+	duk_uint32_t new_h_size;
+
+	DUK_ASSERT(thr != NULL);
+	DUK_ASSERT(obj != NULL);
+	DUK_ASSERT(DUK_HOBJECT_HAS_ARRAY_PART(obj));
+	DUK_ASSERT(new_a_size >= DUK_HOBJECT_GET_ASIZE(obj));
+
+	new_e_size = DUK_HOBJECT_GET_ESIZE(obj);
+	new_h_size = DUK_HOBJECT_GET_HSIZE(obj);
+
+	duk__realloc_props(thr, obj, new_e_size, new_a_size, new_h_size, 0);
+}
+
 /*
  *  Compact an object.  Minimizes allocation size for objects which are
  *  not likely to be extended.  This is useful for internal and non-
@@ -1577,26 +1688,27 @@ DUK_LOCAL duk_bool_t duk__get_own_property_desc_raw(duk_hthread *thr, duk_hobjec
 	 *  Array part
 	 */
 
-	if (DUK_HOBJECT_HAS_ARRAY_PART(obj) && arr_idx != DUK__NO_ARRAY_INDEX) {
-		if (arr_idx < DUK_HOBJECT_GET_ASIZE(obj)) {
-			tv = DUK_HOBJECT_A_GET_VALUE_PTR(thr->heap, obj, arr_idx);
-			if (!DUK_TVAL_IS_UNDEFINED_UNUSED(tv)) {
-				DUK_DDD(DUK_DDDPRINT("-> found in array part"));
-				if (flags & DUK__DESC_FLAG_PUSH_VALUE) {
-					duk_push_tval(ctx, tv);
-				}
-				/* implicit attributes */
-				out_desc->flags = DUK_PROPDESC_FLAG_WRITABLE |
-				                  DUK_PROPDESC_FLAG_CONFIGURABLE |
-				                  DUK_PROPDESC_FLAG_ENUMERABLE;
-				out_desc->a_idx = arr_idx;
-				goto prop_found;
+	if (DUK_HOBJECT_HAS_ARRAY_PART(obj) &&
+	    arr_idx < DUK_HOBJECT_GET_ASIZE(obj)) {
+		DUK_ASSERT(arr_idx != DUK__NO_ARRAY_INDEX);
+		tv = DUK_HOBJECT_A_GET_VALUE_PTR(thr->heap, obj, arr_idx);
+		if (!DUK_TVAL_IS_UNDEFINED_UNUSED(tv)) {
+			DUK_DDD(DUK_DDDPRINT("-> found in array part"));
+			if (flags & DUK__DESC_FLAG_PUSH_VALUE) {
+				duk_push_tval(ctx, tv);
 			}
+			/* implicit attributes */
+			out_desc->flags = DUK_PROPDESC_FLAG_WRITABLE |
+			                  DUK_PROPDESC_FLAG_CONFIGURABLE |
+			                  DUK_PROPDESC_FLAG_ENUMERABLE;
+			out_desc->a_idx = arr_idx;
+			goto prop_found;
 		}
-		/* assume array part is comprehensive (contains all array indexed elements
-		 * or none of them); hence no need to check the entries part here.
+		/* array part covers all array indices below its size (entry part
+		 * only has sparse indices above it); hence no need to check the
+		 * entries part here.
 		 */
-		DUK_DDD(DUK_DDDPRINT("-> not found as a concrete property (has array part, "
+		DUK_DDD(DUK_DDDPRINT("-> not found as a concrete property (inside array part, "
 		                     "should be there if present)"));
 		goto prop_not_found_concrete;
 	}
@@ -2920,14 +3032,15 @@ duk_bool_t duk__handle_put_array_length_smaller(duk_hthread *thr,
 	 *  New length is smaller than old length, need to delete properties above
 	 *  the new length.
 	 *
-	 *  If array part exists, this is straightforward: array entries cannot
-	 *  be non-configurable so this is guaranteed to work.
+	 *  Array part entries are writable, configurable, and enumerable, so
+	 *  nothing can prevent them from being deleted.
 	 *
-	 *  If array part does not exist, array-indexed values are scattered
-	 *  in the entry part, and some may not be configurable (preventing length
-	 *  from becoming lower than their index + 1).  To handle the algorithm
-	 *  in E5 Section 15.4.5.1, step l correctly, we scan the entire property
-	 *  set twice.
+	 *  Array-indexed values in the entry part (all of them if the array part
+	 *  does not exist, sparse entries above the array part otherwise) may
+	 *  not be configurable (preventing length from becoming lower than their
+	 *  index + 1).  To handle the algorithm in E5 Section 15.4.5.1, step l
+	 *  correctly, we scan the entire entry part twice.  The entry part of an
+	 *  array with an array part is usually tiny ('length' only).
 	 */
 
 	DUK_ASSERT(thr != NULL);
@@ -2936,15 +3049,64 @@ duk_bool_t duk__handle_put_array_length_smaller(duk_hthread *thr,
 	DUK_ASSERT(out_result_len != NULL);
 	DUK_ASSERT_VALSTACK_SPACE(thr, DUK__VALSTACK_SPACE);
 
-	if (DUK_HOBJECT_HAS_ARRAY_PART(obj)) {
-		/*
-		 *  All defined array-indexed properties are in the array part
-		 *  (we assume the array part is comprehensive), and all array
-		 *  entries are writable, configurable, and enumerable.  Thus,
-		 *  nothing can prevent array entries from being deleted.
-		 */
+	/* Stage 1: find highest preventing non-configurable entry (if any).
+	 * When forcing, ignore non-configurability.  Array part entries are
+	 * always configurable.
+	 */
 
-		DUK_DDD(DUK_DDDPRINT("have array part, easy case"));
+	DUK_DDD(DUK_DDDPRINT("array length write, stage 1: find target_len "
+	                     "(highest preventing non-configurable entry (if any))"));
+
+	target_len = new_len;
+	if (force_flag) {
+		DUK_DDD(DUK_DDDPRINT("array length write; force flag -> skip stage 1"));
+		goto skip_stage1;
+	}
+	for (i = 0; i < DUK_HOBJECT_GET_ENEXT(obj); i++) {
+		key = DUK_HOBJECT_E_GET_KEY(thr->heap, obj, i);
+		if (!key) {
+			DUK_DDD(DUK_DDDPRINT("skip entry index %ld: null key", (long) i));
+			continue;
+		}
+		if (!DUK_HSTRING_HAS_ARRIDX(key)) {
+			DUK_DDD(DUK_DDDPRINT("skip entry index %ld: key not an array index", (long) i));
+			continue;
+		}
+
+		DUK_ASSERT(DUK_HSTRING_HAS_ARRIDX(key));  /* XXX: macro checks for array index flag, which is unnecessary here */
+		arr_idx = DUK_HSTRING_GET_ARRIDX_SLOW(key);
+		DUK_ASSERT(arr_idx != DUK__NO_ARRAY_INDEX);
+		DUK_ASSERT(arr_idx < old_len);  /* consistency requires this */
+
+		if (arr_idx < new_len) {
+			DUK_DDD(DUK_DDDPRINT("skip entry index %ld: key is array index %ld, below new_len",
+			                     (long) i, (long) arr_idx));
+			continue;
+		}
+		if (DUK_HOBJECT_E_SLOT_IS_CONFIGURABLE(thr->heap, obj, i)) {
+			DUK_DDD(DUK_DDDPRINT("skip entry index %ld: key is a relevant array index %ld, but configurable",
+			                     (long) i, (long) arr_idx));
+			continue;
+		}
+
+		/* relevant array index is non-configurable, blocks write */
+		if (arr_idx >= target_len) {
+			DUK_DDD(DUK_DDDPRINT("entry at index %ld has arr_idx %ld, is not configurable, "
+			                     "update target_len %ld -> %ld",
+			                     (long) i, (long) arr_idx, (long) target_len,
+			                     (long) (arr_idx + 1)));
+			target_len = arr_idx + 1;
+		}
+	}
+ skip_stage1:
+
+	/* stage 2: delete configurable entries above target length */
+
+	DUK_DDD(DUK_DDDPRINT("old_len=%ld, new_len=%ld, target_len=%ld",
+	                     (long) old_len, (long) new_len, (long) target_len));
+
+	if (DUK_HOBJECT_HAS_ARRAY_PART(obj)) {
+		DUK_DDD(DUK_DDDPRINT("array length write, stage 2: remove array part entries >= target_len"));
 
 		if (old_len < DUK_HOBJECT_GET_ASIZE(obj)) {
 			/* XXX: assertion that entries >= old_len are already unused */
@@ -2954,133 +3116,66 @@ duk_bool_t duk__handle_put_array_length_smaller(duk_hthread *thr,
 		}
 		DUK_ASSERT(i <= DUK_HOBJECT_GET_ASIZE(obj));
 
-		while (i > new_len) {
+		while (i > target_len) {
 			i--;
 			tv = DUK_HOBJECT_A_GET_VALUE_PTR(thr->heap, obj, i);
 			DUK_TVAL_SET_TVAL(&tv_tmp, tv);
 			DUK_TVAL_SET_UNDEFINED_UNUSED(tv);
 			DUK_TVAL_DECREF(thr, &tv_tmp);
 		}
+	}
 
-		*out_result_len = new_len;
-		return 1;
-	} else {
-		/*
-		 *  Entries part is a bit more complex
-		 */
-
-		/* Stage 1: find highest preventing non-configurable entry (if any).
-		 * When forcing, ignore non-configurability.
-		 */
-
-		DUK_DDD(DUK_DDDPRINT("no array part, slow case"));
-
-		DUK_DDD(DUK_DDDPRINT("array length write, no array part, stage 1: find target_len "
-		                     "(highest preventing non-configurable entry (if any))"));
+	DUK_DDD(DUK_DDDPRINT("array length write, stage 2: remove entry part entries >= target_len"));
 
-		target_len = new_len;
-		if (force_flag) {
-			DUK_DDD(DUK_DDDPRINT("array length write, no array part; force flag -> skip stage 1"));
-			goto skip_stage1;
+	for (i = 0; i < DUK_HOBJECT_GET_ENEXT(obj); i++) {
+		key = DUK_HOBJECT_E_GET_KEY(thr->heap, obj, i);
+		if (!key) {
+			DUK_DDD(DUK_DDDPRINT("skip entry index %ld: null key", (long) i));
+			continue;
 		}
-		for (i = 0; i < DUK_HOBJECT_GET_ENEXT(obj); i++) {
-			key = DUK_HOBJECT_E_GET_KEY(thr->heap, obj, i);
-			if (!key) {
-				DUK_DDD(DUK_DDDPRINT("skip entry index %ld: null key", (long) i));
-				continue;
-			}
-			if (!DUK_HSTRING_HAS_ARRIDX(key)) {
-				DUK_DDD(DUK_DDDPRINT("skip entry index %ld: key not an array index", (long) i));
-				continue;
-			}
-
-			DUK_ASSERT(DUK_HSTRING_HAS_ARRIDX(key));  /* XXX: macro checks for array index flag, which is unnecessary here */
-			arr_idx = DUK_HSTRING_GET_ARRIDX_SLOW(key);
-			DUK_ASSERT(arr_idx != DUK__NO_ARRAY_INDEX);
-			DUK_ASSERT(arr_idx < old_len);  /* consistency requires this */
-
-			if (arr_idx < new_len) {
-				DUK_DDD(DUK_DDDPRINT("skip entry index %ld: key is array index %ld, below new_len",
-				                     (long) i, (long) arr_idx));
-				continue;
-			}
-			if (DUK_HOBJECT_E_SLOT_IS_CONFIGURABLE(thr->heap, obj, i)) {
-				DUK_DDD(DUK_DDDPRINT("skip entry index %ld: key is a relevant array index %ld, but configurable",
-				                     (long) i, (long) arr_idx));
-				continue;
-			}
-
-			/* relevant array index is non-configurable, blocks write */
-			if (arr_idx >= target_len) {
-				DUK_DDD(DUK_DDDPRINT("entry at index %ld has arr_idx %ld, is not configurable, "
-				                     "update target_len %ld -> %ld",
-				                     (long) i, (long) arr_idx, (long) target_len,
-				                     (long) (arr_idx + 1)));
-				target_len = arr_idx + 1;
-			}
+		if (!DUK_HSTRING_HAS_ARRIDX(key)) {
+			DUK_DDD(DUK_DDDPRINT("skip entry index %ld: key not an array index", (long) i));
+			continue;
 		}
-	 skip_stage1:
-
-		/* stage 2: delete configurable entries above target length */
-
-		DUK_DDD(DUK_DDDPRINT("old_len=%ld, new_len=%ld, target_len=%ld",
-		                     (long) old_len, (long) new_len, (long) target_len));
-
-		DUK_DDD(DUK_DDDPRINT("array length write, no array part, stage 2: remove "
-		                     "entries >= target_len"));
-
-		for (i = 0; i < DUK_HOBJECT_GET_ENEXT(obj); i++) {
-			key = DUK_HOBJECT_E_GET_KEY(thr->heap, obj, i);
-			if (!key) {
-				DUK_DDD(DUK_DDDPRINT("skip entry index %ld: null key", (long) i));
-				continue;
-			}
-			if (!DUK_HSTRING_HAS_ARRIDX(key)) {
-				DUK_DDD(DUK_DDDPRINT("skip entry index %ld: key not an array index", (long) i));
-				continue;
-			}
 
-			DUK_ASSERT(DUK_HSTRING_HAS_ARRIDX(key));  /* XXX: macro checks for array index flag, which is unnecessary here */
-			arr_idx = DUK_HSTRING_GET_ARRIDX_SLOW(key);
-			DUK_ASSERT(arr_idx != DUK__NO_ARRAY_INDEX);
-			DUK_ASSERT(arr_idx < old_len);  /* consistency requires this */
+		DUK_ASSERT(DUK_HSTRING_HAS_ARRIDX(key));  /* XXX: macro checks for array index flag, which is unnecessary here */
+		arr_idx = DUK_HSTRING_GET_ARRIDX_SLOW(key);
+		DUK_ASSERT(arr_idx != DUK__NO_ARRAY_INDEX);
+		DUK_ASSERT(arr_idx < old_len);  /* consistency requires this */
 
-			if (arr_idx < target_len) {
-				DUK_DDD(DUK_DDDPRINT("skip entry index %ld: key is array index %ld, below target_len",
-				                     (long) i, (long) arr_idx));
-				continue;
-			}
-			DUK_ASSERT(force_flag || DUK_HOBJECT_E_SLOT_IS_CONFIGURABLE(thr->heap, obj, i));  /* stage 1 guarantees */
-
-			DUK_DDD(DUK_DDDPRINT("delete entry index %ld: key is array index %ld",
+		if (arr_idx < target_len) {
+			DUK_DDD(DUK_DDDPRINT("skip entry index %ld: key is array index %ld, below target_len",
 			                     (long) i, (long) arr_idx));
-
-			/*
-			 *  Slow delete, but we don't care as we're already in a very slow path.
-			 *  The delete always succeeds: key has no exotic behavior, property
-			 *  is configurable, and no resize occurs.
-			 */
-			rc = duk_hobject_delprop_raw(thr, obj, key, force_flag ? DUK_DELPROP_FLAG_FORCE : 0);
-			DUK_UNREF(rc);
-			DUK_ASSERT(rc != 0);
+			continue;
 		}
+		DUK_ASSERT(force_flag || DUK_HOBJECT_E_SLOT_IS_CONFIGURABLE(thr->heap, obj, i));  /* stage 1 guarantees */
 
-		/* stage 3: update length (done by caller), decide return code */
+		DUK_DDD(DUK_DDDPRINT("delete entry index %ld: key is array index %ld",
+		                     (long) i, (long) arr_idx));
 
-		DUK_DDD(DUK_DDDPRINT("array length write, no array part, stage 3: update length (done by caller)"));
+		/*
+		 *  Slow delete, but we don't care as we're already in a very slow path.
+		 *  The delete always succeeds: key has no exotic behavior, property
+		 *  is configurable, and no resize occurs.
+		 */
+		rc = duk_hobject_delprop_raw(thr, obj, key, force_flag ? DUK_DELPROP_FLAG_FORCE : 0);
+		DUK_UNREF(rc);
+		DUK_ASSERT(rc != 0);
+	}
 
-		*out_result_len = target_len;
+	/* stage 3: update length (done by caller), decide return code */
 
-		if (target_len == new_len) {
-			DUK_DDD(DUK_DDDPRINT("target_len matches new_len, return success"));
-			return 1;
-		}
-		DUK_DDD(DUK_DDDPRINT("target_len does not match new_len (some entry prevented "
-		                     "full length adjustment), return error"));
-		return 0;
-	}
+	DUK_DDD(DUK_DDDPRINT("array length write, stage 3: update length (done by caller)"));
 
-	DUK_UNREACHABLE();
+	*out_result_len = target_len;
+
+	if (target_len == new_len) {
+		DUK_DDD(DUK_DDDPRINT("target_len matches new_len, return success"));
+		return 1;
+	}
+	DUK_DDD(DUK_DDDPRINT("target_len does not match new_len (some entry prevented "
+	                     "full length adjustment), return error"));
+	return 0;
 }
 
 /* XXX: is valstack top best place for argument? */
@@ -3826,35 +3921,50 @@ DUK_INTERNAL duk_bool_t duk_hobject_putprop(duk_hthread *thr, duk_tval *tv_obj,
 
 		/*
 		 *  Array needs to grow, but we don't want it becoming too sparse.
-		 *  If it were to become sparse, abandon array part, moving all
-		 *  array entries into the entries part (for good).
+		 *  If it were to become sparse, the value is written to the entry
+		 *  part instead as a sparse array entry, keeping the (dense) array
+		 *  part as is.  Sparse entries are moved into the array part if it
+		 *  later grows to cover them.  The array part is only abandoned
+		 *  (moving all array entries into the entries part for good) if
+		 *  the array part itself has become too sparse.
 		 *
 		 *  Since we don't keep track of actual density (used vs. size) of
 		 *  the array part, we need to estimate somehow.  The check is made
-		 *  in two parts:
+		 *  in three parts:
 		 *
 		 *    - Check whether the resize need is small compared to the
 		 *      current size (relatively); if so, resize without further
 		 *      checking (essentially we assume that the original part is
 		 *      "dense" so that the result would be dense enough).
 		 *
+		 *    - Check whether the result would be too sparse even if the
+		 *      current array part was full; if so, write a sparse entry
+		 *      without counting the used array entries.
+		 *
 		 *    - Otherwise, compute the resize using an actual density
 		 *      measurement based on counting the used array entries.
 		 */
 
 		DUK_DDD(DUK_DDDPRINT("write to new array requires array resize, decide whether to do a "
-		                     "fast resize without abandon check (arr_idx=%ld, old_size=%ld)",
+		                     "fast resize without sparse check (arr_idx=%ld, old_size=%ld)",
 		                     (long) arr_idx, (long) DUK_HOBJECT_GET_ASIZE(orig)));
 
 		if (duk__abandon_array_slow_check_required(arr_idx, DUK_HOBJECT_GET_ASIZE(orig))) {
 			duk_uint32_t old_used;
 			duk_uint32_t old_size;
 
-			DUK_DDD(DUK_DDDPRINT("=> fast check is NOT OK, do slow check for array abandon"));
+			DUK_DDD(DUK_DDDPRINT("=> fast check is NOT OK, do slow check for sparse write"));
+
+			if (duk__abandon_array_density_check(DUK_HOBJECT_GET_ASIZE(orig), arr_idx)) {
+				DUK_DD(DUK_DDPRINT("write to new array entry far beyond array part, "
+				                   "write a sparse entry (arr_idx=%ld, a_size=%ld)",
+				                   (long) arr_idx, (long) DUK_HOBJECT_GET_ASIZE(orig)));
+				goto write_to_entry_part;
+			}
 
 			duk__compute_a_stats(thr, orig, &old_used, &old_size);
 
-			DUK_DDD(DUK_DDDPRINT("abandon check, array stats: old_used=%ld, old_size=%ld, arr_idx=%ld",
+			DUK_DDD(DUK_DDDPRINT("sparse check, array stats: old_used=%ld, old_size=%ld, arr_idx=%ld",
 			                     (long) old_used, (long) old_size, (long) arr_idx));
 
 			/* Note: intentionally use approximations to shave a few instructions:
@@ -3862,15 +3972,20 @@ DUK_INTERNAL duk_bool_t duk_hobject_putprop(duk_hthread *thr, duk_tval *tv_obj,
 			 *   a_size = arr_idx   (accurate: arr_idx + 1)
 			 */
 			if (duk__abandon_array_density_check(old_used, arr_idx)) {
-				DUK_DD(DUK_DDPRINT("write to new array entry beyond current length, "
-				                   "decided to abandon array part (would become too sparse)"));
+				if (duk__abandon_array_density_check(old_used, old_size)) {
+					DUK_DD(DUK_DDPRINT("write to new array entry beyond current length, "
+					                   "decided to abandon array part (already too sparse)"));
 
-				/* abandoning requires a props allocation resize and
-				 * 'rechecks' the valstack, invalidating any existing
-				 * valstack value pointers!
-				 */
-				duk__abandon_array_checked(thr, orig);
-				DUK_ASSERT(!DUK_HOBJECT_HAS_ARRAY_PART(orig));
+					/* abandoning requires a props allocation resize and
+					 * 'rechecks' the valstack, invalidating any existing
+					 * valstack value pointers!
+					 */
+					duk__abandon_array_checked(thr, orig);
+					DUK_ASSERT(!DUK_HOBJECT_HAS_ARRAY_PART(orig));
+				} else {
+					DUK_DD(DUK_DDPRINT("write to new array entry beyond current length, "
+					                   "write a sparse entry (would become too sparse)"));
+				}
 
 				goto write_to_entry_part;
 			}
@@ -3883,13 +3998,19 @@ DUK_INTERNAL duk_bool_t duk_hobject_putprop(duk_hthread *thr, duk_tval *tv_obj,
 		DUK_DD(DUK_DDPRINT("write to new array entry beyond current length, "
 		                   "decided to extend current allocation"));
 
+		/* may abandon the array part (invalidating valstack value pointers)
+		 * if sparse entries can't be moved into the grown array part
+		 */
 		duk__grow_props_for_array_item(thr, orig, arr_idx);
+		if (!DUK_HOBJECT_HAS_ARRAY_PART(orig)) {
+			goto write_to_entry_part;
+		}
 
 	 no_array_growth:
 
-		/* Note: assume array part is comprehensive, so that either
-		 * the write goes to the array part, or we've abandoned the
-		 * array above (and will not come here).
+		/* Note: array part covers all array indices below its size, so
+		 * the write goes to the array part; sparse writes and abandoning
+		 * the array part were handled above (and will not come here).
 		 */
 
 		DUK_ASSERT(DUK_HOBJECT_HAS_ARRAY_PART(orig));
@@ -4496,14 +4617,18 @@ DUK_INTERNAL void duk_hobject_define_property_internal(duk_hthread *thr, duk_hob
 			DUK_DDD(DUK_DDDPRINT("property does not exist, object has array part -> possibly extend array part and write value (assert attributes)"));
 			DUK_ASSERT(propflags == DUK_PROPDESC_FLAGS_WEC);
 
-			/* always grow the array, no sparse / abandon support here */
+			/* always grow the array, no sparse support here; growing
+			 * may abandon the array part (see duk__grow_props_for_array_item())
+			 */
 			if (arr_idx >= DUK_HOBJECT_GET_ASIZE(obj)) {
 				duk__grow_props_for_array_item(thr, obj, arr_idx);
 			}
 
-			DUK_ASSERT(arr_idx < DUK_HOBJECT_GET_ASIZE(obj));
-			tv1 = DUK_HOBJECT_A_GET_VALUE_PTR(thr->heap, obj, arr_idx);
-			goto write_value;
+			if (DUK_HOBJECT_HAS_ARRAY_PART(obj)) {
+				DUK_ASSERT(arr_idx < DUK_HOBJECT_GET_ASIZE(obj));
+				tv1 = DUK_HOBJECT_A_GET_VALUE_PTR(thr->heap, obj, arr_idx);
+				goto write_value;
+			}
 		}
 	}
 
@@ -4570,22 +4695,26 @@ DUK_INTERNAL void duk_hobject_define_property_internal_arridx(duk_hthread *thr,
 
 		DUK_DDD(DUK_DDDPRINT("define property to array part (property may or may not exist yet)"));
 
-		/* always grow the array, no sparse / abandon support here */
+		/* always grow the array, no sparse support here; growing
+		 * may abandon the array part, then use the slow path
+		 */
 		if (arr_idx >= DUK_HOBJECT_GET_ASIZE(obj)) {
 			duk__grow_props_for_array_item(thr, obj, arr_idx);
 		}
 
-		DUK_ASSERT(arr_idx < DUK_HOBJECT_GET_ASIZE(obj));
-		tv1 = DUK_HOBJECT_A_GET_VALUE_PTR(thr->heap, obj, arr_idx);
-		tv2 = duk_require_tval(ctx, -1);
+		if (DUK_HOBJECT_HAS_ARRAY_PART(obj)) {
+			DUK_ASSERT(arr_idx < DUK_HOBJECT_GET_ASIZE(obj));
+			tv1 = DUK_HOBJECT_A_GET_VALUE_PTR(thr->heap, obj, arr_idx);
+			tv2 = duk_require_tval(ctx, -1);
 
-		DUK_TVAL_SET_TVAL(&tv_tmp, tv1);
-		DUK_TVAL_SET_TVAL(tv1, tv2);
-		DUK_TVAL_INCREF(thr, tv1);
-		DUK_TVAL_DECREF(thr, &tv_tmp);  /* side effects */
+			DUK_TVAL_SET_TVAL(&tv_tmp, tv1);
+			DUK_TVAL_SET_TVAL(tv1, tv2);
+			DUK_TVAL_INCREF(thr, tv1);
+			DUK_TVAL_DECREF(thr, &tv_tmp);  /* side effects */
 
-		duk_pop(ctx);  /* [ ...val ] -> [ ... ] */
-		return;
+			duk_pop(ctx);  /* [ ...val ] -> [ ... ] */
+			return;
+		}
 	}
 
 	DUK_DDD(DUK_DDDPRINT("define property fast path didn't work, use slow path"));
@@ -5124,10 +5253,13 @@ void duk_hobject_define_property_helper(duk_context *ctx,
 				new_flags |= DUK_PROPDESC_FLAG_CONFIGURABLE;
 			}
 
-			if (arr_idx != DUK__NO_ARRAY_INDEX && DUK_HOBJECT_HAS_ARRAY_PART(obj)) {
+			if (DUK_HOBJECT_HAS_ARRAY_PART(obj) && arr_idx < DUK_HOBJECT_GET_ASIZE(obj)) {
 				DUK_DDD(DUK_DDDPRINT("accessor cannot go to array part, abandon array"));
 				duk__abandon_array_checked(thr, obj);
 			}
+			/* else: index above array part (if any) goes to the entry part as
+			 * a sparse entry, no need to abandon the array part
+			 */
 
 			/* write to entry part */
 			e_idx = duk__alloc_entry_checked(thr, obj, key);
@@ -5166,7 +5298,7 @@ void duk_hobject_define_property_helper(duk_context *ctx,
 				DUK_TVAL_SET_UNDEFINED_ACTUAL(&tv);  /* default value */
 			}
 
-			if (arr_idx != DUK__NO_ARRAY_INDEX && DUK_HOBJECT_HAS_ARRAY_PART(obj)) {
+			if (DUK_HOBJECT_HAS_ARRAY_PART(obj) && arr_idx < DUK_HOBJECT_GET_ASIZE(obj)) {
 				if (new_flags == DUK_PROPDESC_FLAGS_WEC) {
 #if 0
 					DUK_DDD(DUK_DDDPRINT("new data property attributes match array defaults, attempt to write to array part"));
@@ -5174,13 +5306,16 @@ void duk_hobject_define_property_helper(duk_context *ctx,
 #endif
 					/* XXX: handling for array part missing now; this doesn't affect
 					 * compliance but causes array entry writes using defineProperty()
-					 * to always abandon array part.
+					 * inside the array part to always abandon array part.
 					 */
 				}
 				DUK_DDD(DUK_DDDPRINT("new data property cannot go to array part, abandon array"));
 				duk__abandon_array_checked(thr, obj);
 				/* fall through */
 			}
+			/* else: index above array part (if any) goes to the entry part as
+			 * a sparse entry, no need to abandon the array part
+			 */
 
 			/* write to entry part */
 			e_idx = duk__alloc_entry_checked(thr, obj, key);
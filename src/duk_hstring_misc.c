@@ -31,3 +31,72 @@ DUK_INTERNAL duk_ucodepoint_t duk_hstring_char_code_at_raw(duk_hthread *thr, duk
 	cp = duk_unicode_decode_xutf8_checked(thr, &p, p_start, p_end);
 	return cp;
 }
+
+/*
+ *  Lazily computed character class flags
+ *
+ *  The per-character class table covers ASCII only; a string with any
+ *  byte >= 0x80 never gets the JSON_ESCAPE or IDENTIFIER flag (JSON/JX/JC
+ *  quoting then uses its slow path which handles escapes anyway).
+ */
+
+#define DUK__CC_JSON_ESCAPE  0x01  /* needs escaping in JSON/JX/JC: control chars, '"', '\\', DEL */
+#define DUK__CC_ID_START     0x02  /* ASCII IdentifierStart: [A-Za-z$_] */
+#define DUK__CC_ID_PART      0x04  /* ASCII IdentifierPart: [A-Za-z0-9$_] */
+
+#define DUK__E  DUK__CC_JSON_ESCAPE
+#define DUK__I  (DUK__CC_ID_START | DUK__CC_ID_PART)
+#define DUK__D  DUK__CC_ID_PART
+
+DUK_LOCAL const duk_uint8_t duk__charclass[128] = {
+	DUK__E, DUK__E, DUK__E, DUK__E, DUK__E, DUK__E, DUK__E, DUK__E,  /* 0x00 */
+	DUK__E, DUK__E, DUK__E, DUK__E, DUK__E, DUK__E, DUK__E, DUK__E,
+	DUK__E, DUK__E, DUK__E, DUK__E, DUK__E, DUK__E, DUK__E, DUK__E,  /* 0x10 */
+	DUK__E, DUK__E, DUK__E, DUK__E, DUK__E, DUK__E, DUK__E, DUK__E,
+	0, 0, DUK__E, 0, DUK__I, 0, 0, 0,                                /* 0x20 */
+	0, 0, 0, 0, 0, 0, 0, 0,
+	DUK__D, DUK__D, DUK__D, DUK__D, DUK__D, DUK__D, DUK__D, DUK__D,  /* 0x30 */
+	DUK__D, DUK__D, 0, 0, 0, 0, 0, 0,
+	0, DUK__I, DUK__I, DUK__I, DUK__I, DUK__I, DUK__I, DUK__I,       /* 0x40 */
+	DUK__I, DUK__I, DUK__I, DUK__I, DUK__I, DUK__I, DUK__I, DUK__I,
+	DUK__I, DUK__I, DUK__I, DUK__I, DUK__I, DUK__I, DUK__I, DUK__I,  /* 0x50 */
+	DUK__I, DUK__I, DUK__I, 0, DUK__E, 0, 0, DUK__I,
+	0, DUK__I, DUK__I, DUK__I, DUK__I, DUK__I, DUK__I, DUK__I,       /* 0x60 */
+	DUK__I, DUK__I, DUK__I, DUK__I, DUK__I, DUK__I, DUK__I, DUK__I,
+	DUK__I, DUK__I, DUK__I, DUK__I, DUK__I, DUK__I, DUK__I, DUK__I,  /* 0x70 */
+	DUK__I, DUK__I, DUK__I, 0, 0, 0, 0, DUK__E
+};
+
+#undef DUK__E
+#undef DUK__I
+#undef DUK__D
+
+DUK_INTERNAL void duk_hstring_scan_charclass(duk_hstring *h) {
+	const duk_uint8_t *p, *p_start, *p_end;
+	duk_small_uint_t cls_or = 0;
+	duk_small_uint_t cls_and = 0xff;
+	duk_small_uint_t cls;
+
+	DUK_ASSERT(h != NULL);
+
+	if (DUK_HSTRING_HAS_ASCII(h)) {
+		p_start = DUK_HSTRING_GET_DATA(h);
+		p_end = p_start + DUK_HSTRING_GET_BYTELEN(h);
+		for (p = p_start; p < p_end; p++) {
+			DUK_ASSERT(*p < 0x80);
+			cls = duk__charclass[*p];
+			cls_or |= cls;
+			cls_and &= cls;
+		}
+
+		if (cls_or & DUK__CC_JSON_ESCAPE) {
+			DUK_HSTRING_SET_JSON_ESCAPE(h);
+		}
+		if (p_start < p_end && (duk__charclass[*p_start] & DUK__CC_ID_START) &&
+		    (cls_and & DUK__CC_ID_PART)) {
+			DUK_HSTRING_SET_IDENTIFIER(h);
+		}
+	}
+
+	DUK_HSTRING_SET_CHARCLASS(h);
+}
@@ -44,6 +44,15 @@
 #define DUK_CATCHSTACK_INITIAL_SIZE      4
 #define DUK_CATCHSTACK_DEFAULT_MAX       10000L
 
+/* With DUK_USE_STACK_GEOMETRIC_GROWTH stacks also grow by 1/2^DUK_STACK_GROW_SHIFT
+ * of their size, so that deep recursion needs a logarithmic number of reallocs.
+ * A stack is only shrunk when at most 1/2^DUK_STACK_SHRINK_SHIFT of it is in use
+ * and keeps the same relative headroom after the shrink; the hysteresis avoids
+ * realloc churn when execution oscillates around a certain depth.
+ */
+#define DUK_STACK_GROW_SHIFT             2      /* grow by 25% */
+#define DUK_STACK_SHRINK_SHIFT           1      /* shrink when at most 50% used */
+
 /*
  *  Activation defines
  */
@@ -309,6 +318,10 @@ struct duk_hthread {
 DUK_INTERNAL_DECL void duk_hthread_copy_builtin_objects(duk_hthread *thr_from, duk_hthread *thr_to);
 DUK_INTERNAL_DECL void duk_hthread_create_builtin_objects(duk_hthread *thr);
 DUK_INTERNAL_DECL duk_bool_t duk_hthread_init_stacks(duk_heap *heap, duk_hthread *thr);
+DUK_INTERNAL_DECL void duk_hthread_free_stacks(duk_heap *heap, duk_hthread *thr);
+#if defined(DUK_USE_THREAD_STACK_POOL)
+DUK_INTERNAL_DECL void duk_hthread_free_stack_pool(duk_heap *heap);
+#endif
 DUK_INTERNAL_DECL void duk_hthread_terminate(duk_hthread *thr);
 
 DUK_INTERNAL_DECL void duk_hthread_callstack_grow(duk_hthread *thr);
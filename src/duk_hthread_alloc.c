@@ -23,6 +23,39 @@ DUK_INTERNAL duk_bool_t duk_hthread_init_stacks(duk_heap *heap, duk_hthread *thr
 	DUK_ASSERT(thr->callstack == NULL);
 	DUK_ASSERT(thr->catchstack == NULL);
 
+#if defined(DUK_USE_THREAD_STACK_POOL)
+	/* Reuse the stacks of a freed thread if available.  Only the value
+	 * stack needs to be initialized; call stack and catch stack entries
+	 * above top are garbage anyway.
+	 */
+	if (heap->stackpool_count > 0) {
+		duk_stackpool_entry *ent;
+
+		ent = heap->stackpool + (--heap->stackpool_count);
+		DUK_ASSERT(ent->valstack != NULL && ent->callstack != NULL && ent->catchstack != NULL);
+		DUK_ASSERT(ent->valstack_size >= DUK_VALSTACK_INITIAL_SIZE);
+
+		thr->valstack = ent->valstack;
+		thr->valstack_end = ent->valstack + ent->valstack_size;
+		thr->valstack_bottom = thr->valstack;
+		thr->valstack_top = thr->valstack;
+		for (i = 0; i < ent->valstack_size; i++) {
+			DUK_TVAL_SET_UNDEFINED_UNUSED(&thr->valstack[i]);
+		}
+
+		thr->callstack = ent->callstack;
+		thr->callstack_size = ent->callstack_size;
+		DUK_ASSERT(thr->callstack_top == 0);
+
+		thr->catchstack = ent->catchstack;
+		thr->catchstack_size = ent->catchstack_size;
+		DUK_ASSERT(thr->catchstack_top == 0);
+
+		DUK_DDD(DUK_DDDPRINT("reused pooled thread stacks, %ld left", (long) heap->stackpool_count));
+		return 1;
+	}
+#endif
+
 	/* valstack */
 	alloc_size = sizeof(duk_tval) * DUK_VALSTACK_INITIAL_SIZE;
 	thr->valstack = (duk_tval *) DUK_ALLOC(heap, alloc_size);
@@ -71,6 +104,63 @@ DUK_INTERNAL duk_bool_t duk_hthread_init_stacks(duk_heap *heap, duk_hthread *thr
 	return 0;
 }
 
+/*
+ *  Free the stacks of a thread being freed, or keep them in the heap
+ *  stack pool for reuse if there is room and they are not too large.
+ *  Must not have side effects as this is called while freeing objects.
+ */
+
+DUK_INTERNAL void duk_hthread_free_stacks(duk_heap *heap, duk_hthread *thr) {
+#if defined(DUK_USE_THREAD_STACK_POOL)
+	duk_size_t valstack_size;
+#endif
+
+	DUK_ASSERT(heap != NULL);
+	DUK_ASSERT(thr != NULL);
+
+#if defined(DUK_USE_THREAD_STACK_POOL)
+	valstack_size = (duk_size_t) (thr->valstack_end - thr->valstack);
+	if (heap->stackpool_count < DUK_HEAP_STACKPOOL_SIZE &&
+	    thr->valstack != NULL && thr->callstack != NULL && thr->catchstack != NULL &&
+	    valstack_size >= DUK_VALSTACK_INITIAL_SIZE &&
+	    valstack_size <= DUK_HEAP_STACKPOOL_MAX_VALSTACK &&
+	    thr->callstack_size <= DUK_HEAP_STACKPOOL_MAX_CALLSTACK &&
+	    thr->catchstack_size <= DUK_HEAP_STACKPOOL_MAX_CATCHSTACK) {
+		duk_stackpool_entry *ent;
+
+		ent = heap->stackpool + (heap->stackpool_count++);
+		ent->valstack = thr->valstack;
+		ent->callstack = thr->callstack;
+		ent->catchstack = thr->catchstack;
+		ent->valstack_size = valstack_size;
+		ent->callstack_size = thr->callstack_size;
+		ent->catchstack_size = thr->catchstack_size;
+
+		DUK_DDD(DUK_DDDPRINT("pooled thread stacks, %ld pooled", (long) heap->stackpool_count));
+		return;
+	}
+#endif
+
+	DUK_FREE(heap, thr->valstack);
+	DUK_FREE(heap, thr->callstack);
+	DUK_FREE(heap, thr->catchstack);
+}
+
+#if defined(DUK_USE_THREAD_STACK_POOL)
+DUK_INTERNAL void duk_hthread_free_stack_pool(duk_heap *heap) {
+	duk_stackpool_entry *ent;
+
+	DUK_ASSERT(heap != NULL);
+
+	while (heap->stackpool_count > 0) {
+		ent = heap->stackpool + (--heap->stackpool_count);
+		DUK_FREE(heap, ent->valstack);
+		DUK_FREE(heap, ent->callstack);
+		DUK_FREE(heap, ent->catchstack);
+	}
+}
+#endif
+
 /* For indirect allocs. */
 
 DUK_INTERNAL void *duk_hthread_get_valstack_ptr(duk_heap *heap, void *ud) {
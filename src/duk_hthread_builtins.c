@@ -512,6 +512,11 @@ DUK_INTERNAL void duk_hthread_create_builtin_objects(duk_hthread *thr) {
 	(void) duk_hobject_delprop_raw(thr, thr->builtins[DUK_BIDX_OBJECT_PROTOTYPE], DUK_HTHREAD_STRING___PROTO__(thr), DUK_DELPROP_FLAG_THROW);
 #endif
 
+#if !defined(DUK_USE_FASTINT_STATS)
+	DUK_DD(DUK_DDPRINT("delete Duktape.fastintStats built-in which is not enabled in features"));
+	(void) duk_hobject_delprop_raw(thr, thr->builtins[DUK_BIDX_DUKTAPE], DUK_HTHREAD_STRING_FASTINT_STATS(thr), DUK_DELPROP_FLAG_THROW);
+#endif
+
 #if !defined(DUK_USE_ES6_OBJECT_SETPROTOTYPEOF)
 	DUK_DD(DUK_DDPRINT("delete Object.setPrototypeOf built-in which is not enabled in features"));
 	(void) duk_hobject_delprop_raw(thr, thr->builtins[DUK_BIDX_OBJECT_CONSTRUCTOR], DUK_HTHREAD_STRING_SET_PROTOTYPE_OF(thr), DUK_DELPROP_FLAG_THROW);
@@ -44,6 +44,15 @@ DUK_INTERNAL void duk_hthread_callstack_grow(duk_hthread *thr) {
 		DUK_ERROR(thr, DUK_ERR_RANGE_ERROR, DUK_STR_CALLSTACK_LIMIT);
 	}
 
+#if defined(DUK_USE_STACK_GEOMETRIC_GROWTH)
+	/* Geometric growth doesn't affect the limit check above. */
+	new_size += old_size >> DUK_STACK_GROW_SHIFT;
+	if (new_size >= thr->callstack_max) {
+		new_size = thr->callstack_max - 1;
+	}
+	DUK_ASSERT(new_size > old_size);
+#endif
+
 	DUK_DD(DUK_DDPRINT("growing callstack %ld -> %ld", (long) old_size, (long) new_size));
 
 	/*
@@ -59,6 +68,9 @@ DUK_INTERNAL void duk_hthread_callstack_grow(duk_hthread *thr) {
 	}
 	thr->callstack = new_ptr;
 	thr->callstack_size = new_size;
+#if defined(DUK_USE_DEBUG)
+	thr->heap->stats_callstack_grow++;
+#endif
 
 	/* note: any entries above the callstack top are garbage and not zeroed */
 }
@@ -75,7 +87,15 @@ DUK_INTERNAL void duk_hthread_callstack_shrink_check(duk_hthread *thr) {
 		return;
 	}
 
+#if defined(DUK_USE_STACK_GEOMETRIC_GROWTH)
+	if (thr->callstack_top > (thr->callstack_size >> DUK_STACK_SHRINK_SHIFT)) {
+		return;
+	}
+	new_size = thr->callstack_top + DUK_CALLSTACK_SHRINK_SPARE + (thr->callstack_top >> DUK_STACK_GROW_SHIFT);
+	DUK_ASSERT(new_size < thr->callstack_size);
+#else
 	new_size = thr->callstack_top + DUK_CALLSTACK_SHRINK_SPARE;
+#endif
 	DUK_ASSERT(new_size >= thr->callstack_top);
 
 	DUK_DD(DUK_DDPRINT("shrinking callstack %ld -> %ld", (long) thr->callstack_size, (long) new_size));
@@ -90,6 +110,9 @@ DUK_INTERNAL void duk_hthread_callstack_shrink_check(duk_hthread *thr) {
 	if (p) {
 		thr->callstack = p;
 		thr->callstack_size = new_size;
+#if defined(DUK_USE_DEBUG)
+		thr->heap->stats_callstack_shrink++;
+#endif
 	} else {
 		/* Because new_size != 0, if condition doesn't need to be
 		 * (p != NULL || new_size == 0).
@@ -349,6 +372,15 @@ DUK_INTERNAL void duk_hthread_catchstack_grow(duk_hthread *thr) {
 		DUK_ERROR(thr, DUK_ERR_RANGE_ERROR, DUK_STR_CATCHSTACK_LIMIT);
 	}
 
+#if defined(DUK_USE_STACK_GEOMETRIC_GROWTH)
+	/* Geometric growth doesn't affect the limit check above. */
+	new_size += old_size >> DUK_STACK_GROW_SHIFT;
+	if (new_size >= thr->catchstack_max) {
+		new_size = thr->catchstack_max - 1;
+	}
+	DUK_ASSERT(new_size > old_size);
+#endif
+
 	DUK_DD(DUK_DDPRINT("growing catchstack %ld -> %ld", (long) old_size, (long) new_size));
 
 	/*
@@ -364,6 +396,9 @@ DUK_INTERNAL void duk_hthread_catchstack_grow(duk_hthread *thr) {
 	}
 	thr->catchstack = new_ptr;
 	thr->catchstack_size = new_size;
+#if defined(DUK_USE_DEBUG)
+	thr->heap->stats_catchstack_grow++;
+#endif
 
 	/* note: any entries above the catchstack top are garbage and not zeroed */
 }
@@ -380,7 +415,15 @@ DUK_INTERNAL void duk_hthread_catchstack_shrink_check(duk_hthread *thr) {
 		return;
 	}
 
+#if defined(DUK_USE_STACK_GEOMETRIC_GROWTH)
+	if (thr->catchstack_top > (thr->catchstack_size >> DUK_STACK_SHRINK_SHIFT)) {
+		return;
+	}
+	new_size = thr->catchstack_top + DUK_CATCHSTACK_SHRINK_SPARE + (thr->catchstack_top >> DUK_STACK_GROW_SHIFT);
+	DUK_ASSERT(new_size < thr->catchstack_size);
+#else
 	new_size = thr->catchstack_top + DUK_CATCHSTACK_SHRINK_SPARE;
+#endif
 	DUK_ASSERT(new_size >= thr->catchstack_top);
 
 	DUK_DD(DUK_DDPRINT("shrinking catchstack %ld -> %ld", (long) thr->catchstack_size, (long) new_size));
@@ -395,6 +438,9 @@ DUK_INTERNAL void duk_hthread_catchstack_shrink_check(duk_hthread *thr) {
 	if (p) {
 		thr->catchstack = p;
 		thr->catchstack_size = new_size;
+#if defined(DUK_USE_DEBUG)
+		thr->heap->stats_catchstack_shrink++;
+#endif
 	} else {
 		/* Because new_size != 0, if condition doesn't need to be
 		 * (p != NULL || new_size == 0).
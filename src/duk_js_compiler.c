@@ -115,6 +115,7 @@ DUK_LOCAL_DECL void duk__insert_jump_entry(duk_compiler_ctx *comp_ctx, duk_int_t
 DUK_LOCAL_DECL void duk__patch_jump(duk_compiler_ctx *comp_ctx, duk_int_t jump_pc, duk_int_t target_pc);
 DUK_LOCAL_DECL void duk__patch_jump_here(duk_compiler_ctx *comp_ctx, duk_int_t jump_pc);
 DUK_LOCAL_DECL void duk__patch_trycatch(duk_compiler_ctx *comp_ctx, duk_int_t trycatch_pc, duk_regconst_t reg_catch, duk_regconst_t const_varname, duk_small_uint_t flags);
+DUK_LOCAL_DECL void duk__patch_literal_size(duk_compiler_ctx *comp_ctx, duk_int_t pc, duk_uint32_t size_hint);
 DUK_LOCAL_DECL void duk__emit_if_false_skip(duk_compiler_ctx *comp_ctx, duk_regconst_t regconst);
 DUK_LOCAL_DECL void duk__emit_if_true_skip(duk_compiler_ctx *comp_ctx, duk_regconst_t regconst);
 DUK_LOCAL_DECL void duk__emit_invalid(duk_compiler_ctx *comp_ctx);
@@ -1662,6 +1663,27 @@ DUK_LOCAL void duk__patch_trycatch(duk_compiler_ctx *comp_ctx, duk_int_t trycatc
 	instr->ins = DUK_ENC_OP_A_B_C(DUK_OP_TRYCATCH, flags, reg_catch, const_varname);
 }
 
+/* Patch the initial size hint into a NEWOBJ/NEWARR emitted before the
+ * literal was parsed.  The hint is a non-register number in slot C and is
+ * clamped because it's only an allocation hint.
+ */
+DUK_LOCAL void duk__patch_literal_size(duk_compiler_ctx *comp_ctx, duk_int_t pc, duk_uint32_t size_hint) {
+	duk_compiler_instr *instr;
+
+	instr = duk__get_instr_ptr(comp_ctx, pc);
+	DUK_ASSERT(instr != NULL);
+	DUK_ASSERT(DUK_DEC_OP(instr->ins) == DUK_OP_EXTRA);
+	DUK_ASSERT(DUK_DEC_A(instr->ins) == DUK_EXTRAOP_NEWOBJ ||
+	           DUK_DEC_A(instr->ins) == DUK_EXTRAOP_NEWARR);
+	DUK_ASSERT(DUK_DEC_C(instr->ins) == 0);
+
+	if (size_hint > DUK_BC_C_MAX) {
+		size_hint = DUK_BC_C_MAX;
+	}
+	DUK_DDD(DUK_DDDPRINT("patch literal size hint at pc %ld: %ld", (long) pc, (long) size_hint));
+	instr->ins |= DUK_ENC_OP_A_B_C(0, 0, 0, size_hint);
+}
+
 DUK_LOCAL void duk__emit_if_false_skip(duk_compiler_ctx *comp_ctx, duk_regconst_t regconst) {
 	duk__emit_a_b_c(comp_ctx,
 	                DUK_OP_IF | DUK__EMIT_FLAG_NO_SHUFFLE_A | DUK__EMIT_FLAG_NO_SHUFFLE_C,
@@ -2693,6 +2715,7 @@ DUK_LOCAL void duk__nud_array_literal(duk_compiler_ctx *comp_ctx, duk_ivalue *re
 	duk_reg_t reg_obj;                 /* result reg */
 	duk_reg_t reg_temp;                /* temp reg */
 	duk_reg_t temp_start;              /* temp reg value for start of loop */
+	duk_int_t pc_newarr;               /* pc of NEWARR, for patching size hint */
 	duk_small_uint_t max_init_values;  /* max # of values initialized in one MPUTARR set */
 	duk_small_uint_t num_values;       /* number of values in current MPUTARR set */
 	duk_uarridx_t curr_idx;            /* current (next) array index */
@@ -2706,10 +2729,11 @@ DUK_LOCAL void duk__nud_array_literal(duk_compiler_ctx *comp_ctx, duk_ivalue *re
 	max_init_values = DUK__MAX_ARRAY_INIT_VALUES;  /* XXX: depend on available temps? */
 
 	reg_obj = DUK__ALLOCTEMP(comp_ctx);
+	pc_newarr = duk__get_current_pc(comp_ctx);
 	duk__emit_extraop_b_c(comp_ctx,
-	                      DUK_EXTRAOP_NEWARR | DUK__EMIT_FLAG_B_IS_TARGET,
+	                      DUK_EXTRAOP_NEWARR | DUK__EMIT_FLAG_B_IS_TARGET | DUK__EMIT_FLAG_NO_SHUFFLE_C,
 	                      reg_obj,
-	                      0);  /* XXX: patch initial size afterwards? */
+	                      0);  /* initial size patched afterwards */
 	temp_start = DUK__GETTEMP(comp_ctx);
 
 	/*
@@ -2814,6 +2838,9 @@ DUK_LOCAL void duk__nud_array_literal(duk_compiler_ctx *comp_ctx, duk_ivalue *re
 	DUK_DDD(DUK_DDDPRINT("array literal done, curridx=%ld, initidx=%ld",
 	                     (long) curr_idx, (long) init_idx));
 
+	/* Trailing elisions don't need array part slots. */
+	duk__patch_literal_size(comp_ctx, pc_newarr, (duk_uint32_t) init_idx);
+
 	/* trailing elisions? */
 	if (curr_idx > init_idx) {
 		/* yes, must set array length explicitly */
@@ -2903,6 +2930,7 @@ DUK_LOCAL void duk__nud_object_literal(duk_compiler_ctx *comp_ctx, duk_ivalue *r
 	duk_reg_t reg_key;                /* temp reg for key literal */
 	duk_reg_t reg_temp;               /* temp reg */
 	duk_reg_t temp_start;             /* temp reg value for start of loop */
+	duk_int_t pc_newobj;              /* pc of NEWOBJ, for patching size hint */
 	duk_small_uint_t max_init_pairs;  /* max # of key-value pairs initialized in one MPUTOBJ set */
 	duk_small_uint_t num_pairs;       /* number of pairs in current MPUTOBJ set */
 	duk_bool_t first;                 /* first value: comma must not precede the value */
@@ -2913,10 +2941,11 @@ DUK_LOCAL void duk__nud_object_literal(duk_compiler_ctx *comp_ctx, duk_ivalue *r
 	max_init_pairs = DUK__MAX_OBJECT_INIT_PAIRS;  /* XXX: depend on available temps? */
 
 	reg_obj = DUK__ALLOCTEMP(comp_ctx);
+	pc_newobj = duk__get_current_pc(comp_ctx);
 	duk__emit_extraop_b_c(comp_ctx,
-	                      DUK_EXTRAOP_NEWOBJ | DUK__EMIT_FLAG_B_IS_TARGET,
+	                      DUK_EXTRAOP_NEWOBJ | DUK__EMIT_FLAG_B_IS_TARGET | DUK__EMIT_FLAG_NO_SHUFFLE_C,
 	                      reg_obj,
-	                      0);  /* XXX: patch initial size afterwards? */
+	                      0);  /* initial size patched afterwards */
 	temp_start = DUK__GETTEMP(comp_ctx);
 
 	/* temp object for tracking / detecting duplicate keys */
@@ -3123,6 +3152,12 @@ DUK_LOCAL void duk__nud_object_literal(duk_compiler_ctx *comp_ctx, duk_ivalue *r
 	DUK_ASSERT(comp_ctx->curr_token.t == DUK_TOK_RCURLY);
 	duk__advance(comp_ctx);
 
+	/* The tracking object has exactly one entry per distinct key (it
+	 * has no array part and nothing is deleted from it).
+	 */
+	DUK_ASSERT(!DUK_HOBJECT_HAS_ARRAY_PART(duk_get_hobject(ctx, -1)));
+	duk__patch_literal_size(comp_ctx, pc_newobj, (duk_uint32_t) DUK_HOBJECT_GET_ENEXT(duk_get_hobject(ctx, -1)));
+
 	DUK__SETTEMP(comp_ctx, temp_start);
 
 	res->t = DUK_IVAL_PLAIN;
@@ -10,6 +10,29 @@
 
 DUK_LOCAL_DECL void duk__reconfig_valstack(duk_hthread *thr, duk_size_t act_idx, duk_small_uint_t retval_count);
 
+/*
+ *  Fastint downgrade statistics: count operations which had at least one
+ *  fastint input but produced a double result, see DUK_OPT_FASTINT_STATS.
+ */
+
+#if defined(DUK_USE_FASTINT_STATS)
+#define DUK__FASTINT_STATS_OP(thr,op)  do { \
+		(thr)->heap->stats_fastint_downgrade[(op)]++; \
+	} while (0)
+#define DUK__FASTINT_STATS_EXTRAOP(thr,extraop)  do { \
+		(thr)->heap->stats_fastint_downgrade_extra[(extraop)]++; \
+	} while (0)
+#define DUK__FASTINT_STATS_OP_CHECK2(thr,op,tv_x,tv_y)  do { \
+		if (DUK_TVAL_IS_FASTINT((tv_x)) || DUK_TVAL_IS_FASTINT((tv_y))) { \
+			DUK__FASTINT_STATS_OP((thr), (op)); \
+		} \
+	} while (0)
+#else
+#define DUK__FASTINT_STATS_OP(thr,op)  do { } while (0)
+#define DUK__FASTINT_STATS_EXTRAOP(thr,extraop)  do { } while (0)
+#define DUK__FASTINT_STATS_OP_CHECK2(thr,op,tv_x,tv_y)  do { } while (0)
+#endif
+
 /*
  *  Arithmetic, binary, and logical helpers.
  *
@@ -70,7 +93,6 @@ DUK_LOCAL void duk__vm_arith_add(duk_hthread *thr, duk_tval *tv_x, duk_tval *tv_
 	if (DUK_TVAL_IS_FASTINT(tv_x) && DUK_TVAL_IS_FASTINT(tv_y)) {
 		duk_int64_t v1, v2, v3;
 		duk_int32_t v3_hi;
-		duk_tval tv_tmp;
 		duk_tval *tv_z;
 
 		/* Input values are signed 48-bit so we can detect overflow
@@ -83,10 +105,7 @@ DUK_LOCAL void duk__vm_arith_add(duk_hthread *thr, duk_tval *tv_x, duk_tval *tv_
 		v3_hi = (duk_int32_t) (v3 >> 32);
 		if (DUK_LIKELY(v3_hi >= -0x8000LL && v3_hi <= 0x7fffLL)) {
 			tv_z = thr->valstack_bottom + idx_z;
-			DUK_TVAL_SET_TVAL(&tv_tmp, tv_z);
-			DUK_TVAL_SET_FASTINT(tv_z, v3);
-			DUK_ASSERT(!DUK_TVAL_IS_HEAP_ALLOCATED(tv_z));  /* no need to incref */
-			DUK_TVAL_DECREF(thr, &tv_tmp);   /* side effects */
+			DUK_TVAL_SET_FASTINT_UPDREF(thr, tv_z, v3);  /* side effects */
 			return;
 		} else {
 			/* overflow, fall through */
@@ -96,18 +115,15 @@ DUK_LOCAL void duk__vm_arith_add(duk_hthread *thr, duk_tval *tv_x, duk_tval *tv_
 #endif  /* DUK_USE_FASTINT */
 
 	if (DUK_TVAL_IS_NUMBER(tv_x) && DUK_TVAL_IS_NUMBER(tv_y)) {
-		duk_tval tv_tmp;
 		duk_tval *tv_z;
 
+		DUK__FASTINT_STATS_OP_CHECK2(thr, DUK_OP_ADD, tv_x, tv_y);
 		du.d = DUK_TVAL_GET_NUMBER(tv_x) + DUK_TVAL_GET_NUMBER(tv_y);
 		DUK_DBLUNION_NORMALIZE_NAN_CHECK(&du);
 		DUK_ASSERT(DUK_DBLUNION_IS_NORMALIZED(&du));
 
 		tv_z = thr->valstack_bottom + idx_z;
-		DUK_TVAL_SET_TVAL(&tv_tmp, tv_z);
-		DUK_TVAL_SET_NUMBER(tv_z, du.d);
-		DUK_ASSERT(!DUK_TVAL_IS_HEAP_ALLOCATED(tv_z));  /* no need to incref */
-		DUK_TVAL_DECREF(thr, &tv_tmp);   /* side effects */
+		DUK_TVAL_SET_NUMBER_UPDREF(thr, tv_z, du.d);  /* side effects */
 		return;
 	}
 
@@ -160,7 +176,6 @@ DUK_LOCAL void duk__vm_arith_binary_op(duk_hthread *thr, duk_tval *tv_x, duk_tva
 	 */
 
 	duk_context *ctx = (duk_context *) thr;
-	duk_tval tv_tmp;
 	duk_tval *tv_z;
 	duk_double_t d1, d2;
 	duk_double_union du;
@@ -237,10 +252,7 @@ DUK_LOCAL void duk__vm_arith_binary_op(duk_hthread *thr, duk_tval *tv_x, duk_tva
 		v3_hi = (duk_int32_t) (v3 >> 32);
 		if (DUK_LIKELY(v3_hi >= -0x8000LL && v3_hi <= 0x7fffLL)) {
 			tv_z = thr->valstack_bottom + idx_z;
-			DUK_TVAL_SET_TVAL(&tv_tmp, tv_z);
-			DUK_TVAL_SET_FASTINT(tv_z, v3);
-			DUK_ASSERT(!DUK_TVAL_IS_HEAP_ALLOCATED(tv_z));  /* no need to incref */
-			DUK_TVAL_DECREF(thr, &tv_tmp);   /* side effects */
+			DUK_TVAL_SET_FASTINT_UPDREF(thr, tv_z, v3);  /* side effects */
 			return;
 		}
 		/* fall through if overflow etc */
@@ -250,6 +262,7 @@ DUK_LOCAL void duk__vm_arith_binary_op(duk_hthread *thr, duk_tval *tv_x, duk_tva
 
 	if (DUK_TVAL_IS_NUMBER(tv_x) && DUK_TVAL_IS_NUMBER(tv_y)) {
 		/* fast path */
+		DUK__FASTINT_STATS_OP_CHECK2(thr, opcode, tv_x, tv_y);
 		d1 = DUK_TVAL_GET_NUMBER(tv_x);
 		d2 = DUK_TVAL_GET_NUMBER(tv_y);
 	} else {
@@ -293,10 +306,7 @@ DUK_LOCAL void duk__vm_arith_binary_op(duk_hthread *thr, duk_tval *tv_x, duk_tva
 	DUK_ASSERT(DUK_DBLUNION_IS_NORMALIZED(&du));
 
 	tv_z = thr->valstack_bottom + idx_z;
-	DUK_TVAL_SET_TVAL(&tv_tmp, tv_z);
-	DUK_TVAL_SET_NUMBER(tv_z, du.d);
-	DUK_ASSERT(!DUK_TVAL_IS_HEAP_ALLOCATED(tv_z));  /* no need to incref */
-	DUK_TVAL_DECREF(thr, &tv_tmp);   /* side effects */
+	DUK_TVAL_SET_NUMBER_UPDREF(thr, tv_z, du.d);  /* side effects */
 }
 
 DUK_LOCAL void duk__vm_bitwise_binary_op(duk_hthread *thr, duk_tval *tv_x, duk_tval *tv_y, duk_small_uint_fast_t idx_z, duk_small_uint_fast_t opcode) {
@@ -311,7 +321,6 @@ DUK_LOCAL void duk__vm_bitwise_binary_op(duk_hthread *thr, duk_tval *tv_x, duk_t
 	 */
 
 	duk_context *ctx = (duk_context *) thr;
-	duk_tval tv_tmp;
 	duk_tval *tv_z;
 	duk_int32_t i1, i2, i3;
 	duk_uint32_t u1, u2, u3;
@@ -335,7 +344,13 @@ DUK_LOCAL void duk__vm_bitwise_binary_op(duk_hthread *thr, duk_tval *tv_x, duk_t
 	}
 	else
 #endif  /* DUK_USE_FASTINT */
-	{
+	if (DUK_TVAL_IS_NUMBER(tv_x) && DUK_TVAL_IS_NUMBER(tv_y)) {
+		/* ToInt32() of a number (double or fastint) has no side
+		 * effects, so there's no need to go through the value stack.
+		 */
+		i1 = duk_js_toint32(thr, tv_x);
+		i2 = duk_js_toint32(thr, tv_y);
+	} else {
 		duk_push_tval(ctx, tv_x);
 		duk_push_tval(ctx, tv_y);
 		i1 = duk_to_int32(ctx, -2);
@@ -404,10 +419,7 @@ DUK_LOCAL void duk__vm_bitwise_binary_op(duk_hthread *thr, duk_tval *tv_x, duk_t
 
  fastint_result_set:
 	tv_z = thr->valstack_bottom + idx_z;
-	DUK_TVAL_SET_TVAL(&tv_tmp, tv_z);
-	DUK_TVAL_SET_FASTINT(tv_z, fi3);
-	DUK_ASSERT(!DUK_TVAL_IS_HEAP_ALLOCATED(tv_z));  /* no need to incref */
-	DUK_TVAL_DECREF(thr, &tv_tmp);   /* side effects */
+	DUK_TVAL_SET_FASTINT_UPDREF(thr, tv_z, fi3);  /* side effects */
 #else
 	d3 = (duk_double_t) i3;
 
@@ -416,10 +428,7 @@ DUK_LOCAL void duk__vm_bitwise_binary_op(duk_hthread *thr, duk_tval *tv_x, duk_t
 	DUK_ASSERT_DOUBLE_IS_NORMALIZED(d3);   /* always normalized */
 
 	tv_z = thr->valstack_bottom + idx_z;
-	DUK_TVAL_SET_TVAL(&tv_tmp, tv_z);
-	DUK_TVAL_SET_NUMBER(tv_z, d3);
-	DUK_ASSERT(!DUK_TVAL_IS_HEAP_ALLOCATED(tv_z));  /* no need to incref */
-	DUK_TVAL_DECREF(thr, &tv_tmp);   /* side effects */
+	DUK_TVAL_SET_NUMBER_UPDREF(thr, tv_z, d3);  /* side effects */
 #endif
 }
 
@@ -462,6 +471,7 @@ DUK_LOCAL void duk__vm_arith_unary_op(duk_hthread *thr, duk_tval *tv_x, duk_idx_
 			return;
 		}
 		/* fall through if overflow etc */
+		DUK__FASTINT_STATS_EXTRAOP(thr, opcode);
 	}
 #endif  /* DUK_USE_FASTINT */
 
@@ -500,7 +510,6 @@ DUK_LOCAL void duk__vm_bitwise_not(duk_hthread *thr, duk_tval *tv_x, duk_small_u
 	 */
 
 	duk_context *ctx = (duk_context *) thr;
-	duk_tval tv_tmp;
 	duk_tval *tv_z;
 	duk_int32_t i1, i2;
 #if !defined(DUK_USE_FASTINT)
@@ -519,7 +528,9 @@ DUK_LOCAL void duk__vm_bitwise_not(duk_hthread *thr, duk_tval *tv_x, duk_small_u
 	}
 	else
 #endif  /* DUK_USE_FASTINT */
-	{
+	if (DUK_TVAL_IS_NUMBER(tv_x)) {
+		i1 = duk_js_toint32(thr, tv_x);  /* no side effects */
+	} else {
 		duk_push_tval(ctx, tv_x);
 		i1 = duk_to_int32(ctx, -1);
 		duk_pop(ctx);
@@ -530,10 +541,7 @@ DUK_LOCAL void duk__vm_bitwise_not(duk_hthread *thr, duk_tval *tv_x, duk_small_u
 #if defined(DUK_USE_FASTINT)
 	/* Result is always fastint compatible. */
 	tv_z = thr->valstack_bottom + idx_z;
-	DUK_TVAL_SET_TVAL(&tv_tmp, tv_z);
-	DUK_TVAL_SET_FASTINT_I32(tv_z, i2);
-	DUK_ASSERT(!DUK_TVAL_IS_HEAP_ALLOCATED(tv_z));  /* no need to incref */
-	DUK_TVAL_DECREF(thr, &tv_tmp);   /* side effects */
+	DUK_TVAL_SET_FASTINT_I32_UPDREF(thr, tv_z, i2);  /* side effects */
 #else
 	d2 = (duk_double_t) i2;
 
@@ -541,10 +549,7 @@ DUK_LOCAL void duk__vm_bitwise_not(duk_hthread *thr, duk_tval *tv_x, duk_small_u
 	DUK_ASSERT_DOUBLE_IS_NORMALIZED(d2);   /* always normalized */
 
 	tv_z = thr->valstack_bottom + idx_z;
-	DUK_TVAL_SET_TVAL(&tv_tmp, tv_z);
-	DUK_TVAL_SET_NUMBER(tv_z, d2);
-	DUK_ASSERT(!DUK_TVAL_IS_HEAP_ALLOCATED(tv_z));  /* no need to incref */
-	DUK_TVAL_DECREF(thr, &tv_tmp);   /* side effects */
+	DUK_TVAL_SET_NUMBER_UPDREF(thr, tv_z, d2);  /* side effects */
 #endif
 }
 
@@ -553,7 +558,6 @@ DUK_LOCAL void duk__vm_logical_not(duk_hthread *thr, duk_tval *tv_x, duk_tval *t
 	 *  E5 Section 11.4.9
 	 */
 
-	duk_tval tv_tmp;
 	duk_bool_t res;
 
 	DUK_ASSERT(thr != NULL);
@@ -569,9 +573,7 @@ DUK_LOCAL void duk__vm_logical_not(duk_hthread *thr, duk_tval *tv_x, duk_tval *t
 	res = duk_js_toboolean(tv_x);  /* does not modify tv_x */
 	DUK_ASSERT(res == 0 || res == 1);
 	res ^= 1;
-	DUK_TVAL_SET_TVAL(&tv_tmp, tv_z);
-	DUK_TVAL_SET_BOOLEAN(tv_z, res);  /* no need to incref */
-	DUK_TVAL_DECREF(thr, &tv_tmp);  /* side effects */
+	DUK_TVAL_SET_BOOLEAN_UPDREF(thr, tv_z, res);  /* side effects */
 }
 
 /*
@@ -637,7 +639,6 @@ DUK_LOCAL void duk__reconfig_valstack(duk_hthread *thr, duk_size_t act_idx, duk_
 
 DUK_LOCAL void duk__handle_catch_or_finally(duk_hthread *thr, duk_size_t cat_idx, duk_bool_t is_finally) {
 	duk_context *ctx = (duk_context *) thr;
-	duk_tval tv_tmp;
 	duk_tval *tv1;
 
 	DUK_DDD(DUK_DDDPRINT("handling catch/finally, cat_idx=%ld, is_finally=%ld",
@@ -654,16 +655,10 @@ DUK_LOCAL void duk__handle_catch_or_finally(duk_hthread *thr, duk_size_t cat_idx
 	                     (duk_tval *) &thr->heap->lj.value2));
 
 	tv1 = thr->valstack + thr->catchstack[cat_idx].idx_base;
-	DUK_TVAL_SET_TVAL(&tv_tmp, tv1);
-	DUK_TVAL_SET_TVAL(tv1, &thr->heap->lj.value1);
-	DUK_TVAL_INCREF(thr, tv1);
-	DUK_TVAL_DECREF(thr, &tv_tmp);  /* side effects */
+	DUK_TVAL_SET_TVAL_UPDREF(thr, tv1, &thr->heap->lj.value1);  /* side effects */
 
 	tv1 = thr->valstack + thr->catchstack[cat_idx].idx_base + 1;
-	DUK_TVAL_SET_TVAL(&tv_tmp, tv1);
-	DUK_TVAL_SET_NUMBER(tv1, (duk_double_t) thr->heap->lj.type);  /* XXX: set int */
-	DUK_ASSERT(!DUK_TVAL_IS_HEAP_ALLOCATED(tv1));   /* no need to incref */
-	DUK_TVAL_DECREF(thr, &tv_tmp);  /* side effects */
+	DUK_TVAL_SET_NUMBER_UPDREF(thr, tv1, (duk_double_t) thr->heap->lj.type);  /* XXX: set int; side effects */
 
 	/*
 	 *  Unwind catchstack and callstack.
@@ -802,9 +797,10 @@ DUK_LOCAL void duk__handle_label(duk_hthread *thr, duk_size_t cat_idx) {
  * return terminates a thread and yields to the resumer.
  */
 DUK_LOCAL void duk__handle_yield(duk_hthread *thr, duk_hthread *resumer, duk_size_t act_idx) {
-	duk_tval tv_tmp;
 	duk_tval *tv1;
 
+	DUK_UNREF(thr);
+
 	/* this may also be called for DUK_LJ_TYPE_RETURN; this is OK as long as
 	 * lj.value1 is correct.
 	 */
@@ -814,18 +810,20 @@ DUK_LOCAL void duk__handle_yield(duk_hthread *thr, duk_hthread *resumer, duk_siz
 
 	DUK_DDD(DUK_DDDPRINT("resume idx_retval is %ld", (long) resumer->callstack[act_idx].idx_retval));
 
+	/* The resume() activation may hold the only reference to 'thr', so
+	 * unwinding it may free 'thr'.  The caller must have switched to the
+	 * resumer already, and 'thr' must not be touched after this call.
+	 */
+	DUK_ASSERT(thr->heap->curr_thread == resumer);
+	DUK_ASSERT(thr->resumer == NULL);
+
 	tv1 = resumer->valstack + resumer->callstack[act_idx].idx_retval;  /* return value from Duktape.Thread.resume() */
-	DUK_TVAL_SET_TVAL(&tv_tmp, tv1);
-	DUK_TVAL_SET_TVAL(tv1, &thr->heap->lj.value1);
-	DUK_TVAL_INCREF(thr, tv1);
-	DUK_TVAL_DECREF(thr, &tv_tmp);  /* side effects */
+	DUK_TVAL_SET_TVAL_UPDREF(resumer, tv1, &resumer->heap->lj.value1);  /* side effects */
 
 	duk_hthread_callstack_unwind(resumer, act_idx + 1);  /* unwind to 'resume' caller */
 
 	/* no need to unwind catchstack */
 	duk__reconfig_valstack(resumer, act_idx, 1);  /* 1 = have retval */
-
-	/* caller must change active thread, and set thr->resumer to NULL */
 }
 
 DUK_LOCAL
@@ -899,11 +897,10 @@ duk_small_uint_t duk__handle_longjmp(duk_hthread *thr,
 		DUK_ASSERT(resumee->state == DUK_HTHREAD_STATE_INACTIVE ||
 		           resumee->state == DUK_HTHREAD_STATE_YIELDED);                                                     /* checked by Duktape.Thread.resume() */
 		DUK_ASSERT(resumee->state != DUK_HTHREAD_STATE_YIELDED ||
-		           resumee->callstack_top >= 2);                                                                     /* YIELDED: Ecmascript activation + Duktape.Thread.yield() activation */
+		           resumee->callstack_top >= 2);                                                                     /* YIELDED: Ecmascript activation + yielding native activation */
 		DUK_ASSERT(resumee->state != DUK_HTHREAD_STATE_YIELDED ||
-		           (DUK_ACT_GET_FUNC(resumee->callstack + resumee->callstack_top - 1) != NULL &&
-		            DUK_HOBJECT_IS_NATIVEFUNCTION(DUK_ACT_GET_FUNC(resumee->callstack + resumee->callstack_top - 1)) &&
-		            ((duk_hnativefunction *) DUK_ACT_GET_FUNC(resumee->callstack + resumee->callstack_top - 1))->func == duk_bi_thread_yield));
+		           DUK_ACT_GET_FUNC(resumee->callstack + resumee->callstack_top - 1) == NULL ||                      /* lightfunc */
+		           DUK_HOBJECT_IS_NATIVEFUNCTION(DUK_ACT_GET_FUNC(resumee->callstack + resumee->callstack_top - 1)));  /* Duktape.Thread.yield() or duk_yield() caller */
 		DUK_ASSERT(resumee->state != DUK_HTHREAD_STATE_YIELDED ||
 		           (DUK_ACT_GET_FUNC(resumee->callstack + resumee->callstack_top - 2) != NULL &&
 		            DUK_HOBJECT_IS_COMPILEDFUNCTION(DUK_ACT_GET_FUNC(resumee->callstack + resumee->callstack_top - 2))));      /* an Ecmascript function */
@@ -946,13 +943,10 @@ duk_small_uint_t duk__handle_longjmp(duk_hthread *thr,
 			act_idx = resumee->callstack_top - 2;  /* Ecmascript function */
 			DUK_ASSERT_DISABLE(resumee->callstack[act_idx].idx_retval >= 0);  /* unsigned */
 
-			tv = resumee->valstack + resumee->callstack[act_idx].idx_retval;  /* return value from Duktape.Thread.yield() */
+			tv = resumee->valstack + resumee->callstack[act_idx].idx_retval;  /* return value from the yielding native call */
 			DUK_ASSERT(tv >= resumee->valstack && tv < resumee->valstack_top);
 			tv2 = &thr->heap->lj.value1;
-			DUK_TVAL_SET_TVAL(&tv_tmp, tv);
-			DUK_TVAL_SET_TVAL(tv, tv2);
-			DUK_TVAL_INCREF(thr, tv);
-			DUK_TVAL_DECREF(thr, &tv_tmp);  /* side effects */
+			DUK_TVAL_SET_TVAL_UPDREF(thr, tv, tv2);  /* side effects */
 
 			duk_hthread_callstack_unwind(resumee, act_idx + 1);  /* unwind to 'yield' caller */
 
@@ -1010,8 +1004,9 @@ duk_small_uint_t duk__handle_longjmp(duk_hthread *thr,
 	case DUK_LJ_TYPE_YIELD: {
 		/*
 		 *  Currently only allowed only if yielding thread has only
-		 *  Ecmascript activations (except for the Duktape.Thread.yield()
-		 *  call at the callstack top) and none of them constructor
+		 *  Ecmascript activations (except for the yielding native call,
+		 *  Duktape.Thread.yield() or a Duktape/C function calling
+		 *  duk_yield(), at the callstack top) and none of them constructor
 		 *  calls.
 		 *
 		 *  This excludes the 'entry' thread which will always have
@@ -1024,10 +1019,9 @@ duk_small_uint_t duk__handle_longjmp(duk_hthread *thr,
 
 		DUK_ASSERT(thr != entry_thread);                                                                             /* Duktape.Thread.yield() should prevent */
 		DUK_ASSERT(thr->state == DUK_HTHREAD_STATE_RUNNING);                                                         /* unchanged from Duktape.Thread.yield() */
-		DUK_ASSERT(thr->callstack_top >= 2);                                                                         /* Ecmascript activation + Duktape.Thread.yield() activation */
-		DUK_ASSERT(DUK_ACT_GET_FUNC(thr->callstack + thr->callstack_top - 1) != NULL &&
-		           DUK_HOBJECT_IS_NATIVEFUNCTION(DUK_ACT_GET_FUNC(thr->callstack + thr->callstack_top - 1)) &&
-		           ((duk_hnativefunction *) DUK_ACT_GET_FUNC(thr->callstack + thr->callstack_top - 1))->func == duk_bi_thread_yield);
+		DUK_ASSERT(thr->callstack_top >= 2);                                                                         /* Ecmascript activation + yielding native activation */
+		DUK_ASSERT(DUK_ACT_GET_FUNC(thr->callstack + thr->callstack_top - 1) == NULL ||                              /* lightfunc */
+		           DUK_HOBJECT_IS_NATIVEFUNCTION(DUK_ACT_GET_FUNC(thr->callstack + thr->callstack_top - 1)));          /* Duktape.Thread.yield() or duk_yield() caller */
 		DUK_ASSERT(DUK_ACT_GET_FUNC(thr->callstack + thr->callstack_top - 2) != NULL &&
 		           DUK_HOBJECT_IS_COMPILEDFUNCTION(DUK_ACT_GET_FUNC(thr->callstack + thr->callstack_top - 2)));      /* an Ecmascript function */
 		DUK_ASSERT_DISABLE((thr->callstack + thr->callstack_top - 2)->idx_retval >= 0);                              /* unsigned */
@@ -1058,15 +1052,13 @@ duk_small_uint_t duk__handle_longjmp(duk_hthread *thr,
 			DUK_DD(DUK_DDPRINT("-> yield an error, converted to a throw in the resumer, propagate"));
 			goto check_longjmp;
 		} else {
-			duk__handle_yield(thr, resumer, resumer->callstack_top - 2);
-
 			thr->state = DUK_HTHREAD_STATE_YIELDED;
 			thr->resumer = NULL;
 			resumer->state = DUK_HTHREAD_STATE_RUNNING;
 			DUK_HEAP_SWITCH_THREAD(thr->heap, resumer);
-#if 0
-			thr = resumer;  /* not needed, as we exit right away */
-#endif
+
+			duk__handle_yield(thr, resumer, resumer->callstack_top - 2);  /* may free 'thr' */
+			thr = resumer;
 
 			DUK_DD(DUK_DDPRINT("-> yield a value, restart execution in resumer"));
 			retval = DUK__LONGJMP_RESTART;
@@ -1158,10 +1150,7 @@ duk_small_uint_t duk__handle_longjmp(duk_hthread *thr,
 			DUK_ASSERT(DUK_HOBJECT_IS_COMPILEDFUNCTION(DUK_ACT_GET_FUNC(thr->callstack + thr->callstack_top - 2)));   /* must be ecmascript */
 
 			tv1 = thr->valstack + (thr->callstack + thr->callstack_top - 2)->idx_retval;
-			DUK_TVAL_SET_TVAL(&tv_tmp, tv1);
-			DUK_TVAL_SET_TVAL(tv1, &thr->heap->lj.value1);
-			DUK_TVAL_INCREF(thr, tv1);
-			DUK_TVAL_DECREF(thr, &tv_tmp);  /* side effects */
+			DUK_TVAL_SET_TVAL_UPDREF(thr, tv1, &thr->heap->lj.value1);  /* side effects */
 
 			DUK_DDD(DUK_DDDPRINT("return value at idx_retval=%ld is %!T",
 			                     (long) (thr->callstack + thr->callstack_top - 2)->idx_retval,
@@ -1191,17 +1180,15 @@ duk_small_uint_t duk__handle_longjmp(duk_hthread *thr,
 
 		resumer = thr->resumer;
 
-		duk__handle_yield(thr, resumer, resumer->callstack_top - 2);
-
 		duk_hthread_terminate(thr);  /* updates thread state, minimizes its allocations */
 		DUK_ASSERT(thr->state == DUK_HTHREAD_STATE_TERMINATED);
 
 		thr->resumer = NULL;
 		resumer->state = DUK_HTHREAD_STATE_RUNNING;
 		DUK_HEAP_SWITCH_THREAD(thr->heap, resumer);
-#if 0
-		thr = resumer;  /* not needed */
-#endif
+
+		duk__handle_yield(thr, resumer, resumer->callstack_top - 2);  /* may free 'thr' */
+		thr = resumer;
 
 		DUK_DD(DUK_DDPRINT("-> return not caught, thread terminated; handle like yield, restart execution in resumer"));
 		retval = DUK__LONGJMP_RESTART;
@@ -1432,7 +1419,6 @@ duk_bool_t duk__handle_fast_return(duk_hthread *thr,
                                    duk_tval *tv_retval,
                                    duk_hthread *entry_thread,
                                    duk_size_t entry_callstack_top) {
-	duk_tval tv_tmp;
 	duk_tval *tv1;
 
 	/* retval == NULL indicates 'undefined' return value */
@@ -1453,15 +1439,11 @@ duk_bool_t duk__handle_fast_return(duk_hthread *thr,
 	DUK_ASSERT(DUK_HOBJECT_IS_COMPILEDFUNCTION(DUK_ACT_GET_FUNC(thr->callstack + thr->callstack_top - 2)));   /* must be ecmascript */
 
 	tv1 = thr->valstack + (thr->callstack + thr->callstack_top - 2)->idx_retval;
-	DUK_TVAL_SET_TVAL(&tv_tmp, tv1);
 	if (tv_retval) {
-		DUK_TVAL_SET_TVAL(tv1, tv_retval);
-		DUK_TVAL_INCREF(thr, tv1);
+		DUK_TVAL_SET_TVAL_UPDREF(thr, tv1, tv_retval);  /* side effects */
 	} else {
-		DUK_TVAL_SET_UNDEFINED_ACTUAL(tv1);
-		/* no need to incref */
+		DUK_TVAL_SET_UNDEFINED_ACTUAL_UPDREF(thr, tv1);  /* side effects */
 	}
-	DUK_TVAL_DECREF(thr, &tv_tmp);  /* side effects */
 
 	/* No catchstack to unwind. */
 #if 0
@@ -2266,60 +2248,45 @@ DUK_INTERNAL void duk_js_execute_bytecode(duk_hthread *exec_thr) {
 		 * first place.
 		 */
 
-		/* XXX: use macros for the repetitive tval/refcount handling. */
-
 		switch ((int) DUK_DEC_OP(ins)) {
 		/* XXX: switch cast? */
 
 		case DUK_OP_LDREG: {
 			duk_small_uint_fast_t a;
 			duk_uint_fast_t bc;
-			duk_tval tv_tmp;
 			duk_tval *tv1, *tv2;
 
 			a = DUK_DEC_A(ins); tv1 = DUK__REGP(a);
 			bc = DUK_DEC_BC(ins); tv2 = DUK__REGP(bc);
-			DUK_TVAL_SET_TVAL(&tv_tmp, tv1);
-			DUK_TVAL_SET_TVAL(tv1, tv2);
-			DUK_TVAL_INCREF(thr, tv1);
-			DUK_TVAL_DECREF(thr, &tv_tmp);  /* side effects */
+			DUK_TVAL_SET_TVAL_UPDREF(thr, tv1, tv2);  /* side effects */
 			break;
 		}
 
 		case DUK_OP_STREG: {
 			duk_small_uint_fast_t a;
 			duk_uint_fast_t bc;
-			duk_tval tv_tmp;
 			duk_tval *tv1, *tv2;
 
 			a = DUK_DEC_A(ins); tv1 = DUK__REGP(a);
 			bc = DUK_DEC_BC(ins); tv2 = DUK__REGP(bc);
-			DUK_TVAL_SET_TVAL(&tv_tmp, tv2);
-			DUK_TVAL_SET_TVAL(tv2, tv1);
-			DUK_TVAL_INCREF(thr, tv2);
-			DUK_TVAL_DECREF(thr, &tv_tmp);  /* side effects */
+			DUK_TVAL_SET_TVAL_UPDREF(thr, tv2, tv1);  /* side effects */
 			break;
 		}
 
 		case DUK_OP_LDCONST: {
 			duk_small_uint_fast_t a;
 			duk_uint_fast_t bc;
-			duk_tval tv_tmp;
 			duk_tval *tv1, *tv2;
 
 			a = DUK_DEC_A(ins); tv1 = DUK__REGP(a);
 			bc = DUK_DEC_BC(ins); tv2 = DUK__CONSTP(bc);
-			DUK_TVAL_SET_TVAL(&tv_tmp, tv1);
-			DUK_TVAL_SET_TVAL(tv1, tv2);
-			DUK_TVAL_INCREF(thr, tv2);  /* may be e.g. string */
-			DUK_TVAL_DECREF(thr, &tv_tmp);  /* side effects */
+			DUK_TVAL_SET_TVAL_UPDREF(thr, tv1, tv2);  /* side effects */
 			break;
 		}
 
 		case DUK_OP_LDINT: {
 			duk_small_uint_fast_t a;
 			duk_int_fast_t bc;
-			duk_tval tv_tmp;
 			duk_tval *tv1;
 #if defined(DUK_USE_FASTINT)
 			duk_int32_t val;
@@ -2330,15 +2297,11 @@ DUK_INTERNAL void duk_js_execute_bytecode(duk_hthread *exec_thr) {
 #if defined(DUK_USE_FASTINT)
 			a = DUK_DEC_A(ins); tv1 = DUK__REGP(a);
 			bc = DUK_DEC_BC(ins); val = (duk_int32_t) (bc - DUK_BC_LDINT_BIAS);
-			DUK_TVAL_SET_TVAL(&tv_tmp, tv1);
-			DUK_TVAL_SET_FASTINT_I32(tv1, val);
-			DUK_TVAL_DECREF(thr, &tv_tmp);  /* side effects */
+			DUK_TVAL_SET_FASTINT_I32_UPDREF(thr, tv1, val);  /* side effects */
 #else
 			a = DUK_DEC_A(ins); tv1 = DUK__REGP(a);
 			bc = DUK_DEC_BC(ins); val = (duk_double_t) (bc - DUK_BC_LDINT_BIAS);
-			DUK_TVAL_SET_TVAL(&tv_tmp, tv1);
-			DUK_TVAL_SET_NUMBER(tv1, val);
-			DUK_TVAL_DECREF(thr, &tv_tmp);  /* side effects */
+			DUK_TVAL_SET_NUMBER_UPDREF(thr, tv1, val);  /* side effects */
 #endif
 			break;
 		}
@@ -2462,28 +2425,46 @@ DUK_INTERNAL void duk_js_execute_bytecode(duk_hthread *exec_thr) {
 			arr_idx = (duk_uint32_t) DUK_TVAL_GET_NUMBER(tv1);
 			idx++;
 
-			duk_push_hobject(ctx, obj);
+			if (DUK_HOBJECT_HAS_ARRAY_PART(obj) &&
+			    arr_idx < DUK_HOBJECT_GET_ASIZE(obj) &&
+			    (duk_uint32_t) count <= DUK_HOBJECT_GET_ASIZE(obj) - arr_idx) {
+				duk_tval *tv_dst;
 
-			while (count > 0) {
-				/* duk_xdef_prop() will define an own property without any array
-				 * special behaviors.  We'll need to set the array length explicitly
-				 * in the end.  For arrays with elisions, the compiler will emit an
-				 * explicit SETALEN which will update the length.
+				/* Array part was presized by NEWARR (and hasn't been compacted
+				 * since), so write the values directly.  The slots of a fresh
+				 * array literal are unused so there's nothing to DECREF.
 				 */
+				tv_dst = DUK_HOBJECT_A_GET_VALUE_PTR(thr->heap, obj, arr_idx);
+				arr_idx += (duk_uint32_t) count;
+				while (count > 0) {
+					DUK_ASSERT(DUK_TVAL_IS_UNDEFINED_UNUSED(tv_dst));
+					tv1 = DUK__REGP(idx);
+					DUK_TVAL_SET_TVAL(tv_dst, tv1);
+					DUK_TVAL_INCREF(thr, tv_dst);  /* no side effects */
+					count--;
+					idx++;
+					tv_dst++;
+				}
+			} else {
+				duk_push_hobject(ctx, obj);
 
-				/* XXX: because we're dealing with 'own' properties of a fresh array,
-				 * the array initializer should just ensure that the array has a large
-				 * enough array part and write the values directly into array part,
-				 * and finally set 'length' manually in the end (as already happens now).
-				 */
+				while (count > 0) {
+					/* duk_xdef_prop() will define an own property without any array
+					 * special behaviors.  We'll need to set the array length explicitly
+					 * in the end.  For arrays with elisions, the compiler will emit an
+					 * explicit SETALEN which will update the length.
+					 */
 
-				duk_push_tval(ctx, DUK__REGP(idx));          /* -> [... obj value] */
-				duk_xdef_prop_index_wec(ctx, -2, arr_idx);   /* -> [... obj] */
+					duk_push_tval(ctx, DUK__REGP(idx));          /* -> [... obj value] */
+					duk_xdef_prop_index_wec(ctx, -2, arr_idx);   /* -> [... obj] */
 
-				/* XXX: could use at least one fewer loop counters */
-				count--;
-				idx++;
-				arr_idx++;
+					/* XXX: could use at least one fewer loop counters */
+					count--;
+					idx++;
+					arr_idx++;
+				}
+
+				duk_pop(ctx);  /* [... obj] -> [...] */
 			}
 
 			/* XXX: E5.1 Section 11.1.4 coerces the final length through
@@ -2491,8 +2472,6 @@ DUK_INTERNAL void duk_js_execute_bytecode(duk_hthread *exec_thr) {
 			 * 'arr_idx' type.
 			 */
 			duk_hobject_set_length(thr, obj, (duk_uint32_t) arr_idx);
-
-			duk_pop(ctx);  /* [... obj] -> [...] */
 			break;
 		}
 
@@ -2991,37 +2970,55 @@ DUK_INTERNAL void duk_js_execute_bytecode(duk_hthread *exec_thr) {
 
 		case DUK_OP_EQ:
 		case DUK_OP_NEQ: {
-			duk_context *ctx = (duk_context *) thr;
 			duk_small_uint_fast_t a = DUK_DEC_A(ins);
 			duk_small_uint_fast_t b = DUK_DEC_B(ins);
 			duk_small_uint_fast_t c = DUK_DEC_C(ins);
+			duk_tval *tv_x, *tv_y, *tv_z;
 			duk_bool_t tmp;
 
 			/* E5 Sections 11.9.1, 11.9.3 */
-			tmp = duk_js_equals(thr, DUK__REGCONSTP(b), DUK__REGCONSTP(c));
+			tv_x = DUK__REGCONSTP(b);
+			tv_y = DUK__REGCONSTP(c);
+#if defined(DUK_USE_FASTINT)
+			if (DUK_TVAL_IS_FASTINT(tv_x) && DUK_TVAL_IS_FASTINT(tv_y)) {
+				tmp = (DUK_TVAL_GET_FASTINT(tv_x) == DUK_TVAL_GET_FASTINT(tv_y));
+			} else
+#endif
+			{
+				tmp = duk_js_equals(thr, tv_x, tv_y);
+			}
 			if (DUK_DEC_OP(ins) == DUK_OP_NEQ) {
 				tmp = !tmp;
 			}
-			duk_push_boolean(ctx, tmp);
-			duk_replace(ctx, (duk_idx_t) a);
+			tv_z = DUK__REGP(a);  /* relookup, duk_js_equals() may have side effects */
+			DUK_TVAL_SET_BOOLEAN_UPDREF(thr, tv_z, tmp);  /* side effects */
 			break;
 		}
 
 		case DUK_OP_SEQ:
 		case DUK_OP_SNEQ: {
-			duk_context *ctx = (duk_context *) thr;
 			duk_small_uint_fast_t a = DUK_DEC_A(ins);
 			duk_small_uint_fast_t b = DUK_DEC_B(ins);
 			duk_small_uint_fast_t c = DUK_DEC_C(ins);
+			duk_tval *tv_x, *tv_y, *tv_z;
 			duk_bool_t tmp;
 
 			/* E5 Sections 11.9.1, 11.9.3 */
-			tmp = duk_js_strict_equals(DUK__REGCONSTP(b), DUK__REGCONSTP(c));
+			tv_x = DUK__REGCONSTP(b);
+			tv_y = DUK__REGCONSTP(c);
+#if defined(DUK_USE_FASTINT)
+			if (DUK_TVAL_IS_FASTINT(tv_x) && DUK_TVAL_IS_FASTINT(tv_y)) {
+				tmp = (DUK_TVAL_GET_FASTINT(tv_x) == DUK_TVAL_GET_FASTINT(tv_y));
+			} else
+#endif
+			{
+				tmp = duk_js_strict_equals(tv_x, tv_y);
+			}
 			if (DUK_DEC_OP(ins) == DUK_OP_SNEQ) {
 				tmp = !tmp;
 			}
-			duk_push_boolean(ctx, tmp);
-			duk_replace(ctx, (duk_idx_t) a);
+			tv_z = DUK__REGP(a);
+			DUK_TVAL_SET_BOOLEAN_UPDREF(thr, tv_z, tmp);  /* side effects */
 			break;
 		}
 
@@ -3032,79 +3029,120 @@ DUK_INTERNAL void duk_js_execute_bytecode(duk_hthread *exec_thr) {
 		 * actually not the case, because there are also run-time coercions
 		 * of the arguments (with potential side effects).
 		 *
+		 * Two fastints have no coercion side effects and are never NaN,
+		 * so they're compared directly.  The result register is looked
+		 * up only after the comparison because coercion side effects may
+		 * resize the value stack.
+		 *
 		 * XXX: can be combined; check code size.
 		 */
 
 		case DUK_OP_GT: {
-			duk_context *ctx = (duk_context *) thr;
 			duk_small_uint_fast_t a = DUK_DEC_A(ins);
 			duk_small_uint_fast_t b = DUK_DEC_B(ins);
 			duk_small_uint_fast_t c = DUK_DEC_C(ins);
+			duk_tval *tv_x, *tv_y, *tv_z;
 			duk_bool_t tmp;
 
-			/* x > y  -->  y < x */
-			tmp = duk_js_compare_helper(thr,
-			                            DUK__REGCONSTP(c),  /* y */
-			                            DUK__REGCONSTP(b),  /* x */
-			                            0);                 /* flags */
+			tv_x = DUK__REGCONSTP(b);
+			tv_y = DUK__REGCONSTP(c);
+#if defined(DUK_USE_FASTINT)
+			if (DUK_TVAL_IS_FASTINT(tv_x) && DUK_TVAL_IS_FASTINT(tv_y)) {
+				tmp = (DUK_TVAL_GET_FASTINT(tv_x) > DUK_TVAL_GET_FASTINT(tv_y));
+			} else
+#endif
+			{
+				/* x > y  -->  y < x */
+				tmp = duk_js_compare_helper(thr,
+				                            tv_y,  /* y */
+				                            tv_x,  /* x */
+				                            0);    /* flags */
+			}
 
-			duk_push_boolean(ctx, tmp);
-			duk_replace(ctx, (duk_idx_t) a);
+			tv_z = DUK__REGP(a);
+			DUK_TVAL_SET_BOOLEAN_UPDREF(thr, tv_z, tmp);  /* side effects */
 			break;
 		}
 
 		case DUK_OP_GE: {
-			duk_context *ctx = (duk_context *) thr;
 			duk_small_uint_fast_t a = DUK_DEC_A(ins);
 			duk_small_uint_fast_t b = DUK_DEC_B(ins);
 			duk_small_uint_fast_t c = DUK_DEC_C(ins);
+			duk_tval *tv_x, *tv_y, *tv_z;
 			duk_bool_t tmp;
 
-			/* x >= y  -->  not (x < y) */
-			tmp = duk_js_compare_helper(thr,
-			                            DUK__REGCONSTP(b),  /* x */
-			                            DUK__REGCONSTP(c),  /* y */
-			                            DUK_COMPARE_FLAG_EVAL_LEFT_FIRST |
-			                            DUK_COMPARE_FLAG_NEGATE);  /* flags */
+			tv_x = DUK__REGCONSTP(b);
+			tv_y = DUK__REGCONSTP(c);
+#if defined(DUK_USE_FASTINT)
+			if (DUK_TVAL_IS_FASTINT(tv_x) && DUK_TVAL_IS_FASTINT(tv_y)) {
+				tmp = (DUK_TVAL_GET_FASTINT(tv_x) >= DUK_TVAL_GET_FASTINT(tv_y));
+			} else
+#endif
+			{
+				/* x >= y  -->  not (x < y) */
+				tmp = duk_js_compare_helper(thr,
+				                            tv_x,  /* x */
+				                            tv_y,  /* y */
+				                            DUK_COMPARE_FLAG_EVAL_LEFT_FIRST |
+				                            DUK_COMPARE_FLAG_NEGATE);  /* flags */
+			}
 
-			duk_push_boolean(ctx, tmp);
-			duk_replace(ctx, (duk_idx_t) a);
+			tv_z = DUK__REGP(a);
+			DUK_TVAL_SET_BOOLEAN_UPDREF(thr, tv_z, tmp);  /* side effects */
 			break;
 		}
 
 		case DUK_OP_LT: {
-			duk_context *ctx = (duk_context *) thr;
 			duk_small_uint_fast_t a = DUK_DEC_A(ins);
 			duk_small_uint_fast_t b = DUK_DEC_B(ins);
 			duk_small_uint_fast_t c = DUK_DEC_C(ins);
+			duk_tval *tv_x, *tv_y, *tv_z;
 			duk_bool_t tmp;
 
-			/* x < y */
-			tmp = duk_js_compare_helper(thr,
-			                            DUK__REGCONSTP(b),  /* x */
-			                            DUK__REGCONSTP(c),  /* y */
-			                            DUK_COMPARE_FLAG_EVAL_LEFT_FIRST);  /* flags */
+			tv_x = DUK__REGCONSTP(b);
+			tv_y = DUK__REGCONSTP(c);
+#if defined(DUK_USE_FASTINT)
+			if (DUK_TVAL_IS_FASTINT(tv_x) && DUK_TVAL_IS_FASTINT(tv_y)) {
+				tmp = (DUK_TVAL_GET_FASTINT(tv_x) < DUK_TVAL_GET_FASTINT(tv_y));
+			} else
+#endif
+			{
+				/* x < y */
+				tmp = duk_js_compare_helper(thr,
+				                            tv_x,  /* x */
+				                            tv_y,  /* y */
+				                            DUK_COMPARE_FLAG_EVAL_LEFT_FIRST);  /* flags */
+			}
 
-			duk_push_boolean(ctx, tmp);
-			duk_replace(ctx, (duk_idx_t) a);
+			tv_z = DUK__REGP(a);
+			DUK_TVAL_SET_BOOLEAN_UPDREF(thr, tv_z, tmp);  /* side effects */
 			break;
 		}
 
 		case DUK_OP_LE: {
-			duk_context *ctx = (duk_context *) thr;
 			duk_small_uint_fast_t a = DUK_DEC_A(ins);
 			duk_small_uint_fast_t b = DUK_DEC_B(ins);
 			duk_small_uint_fast_t c = DUK_DEC_C(ins);
+			duk_tval *tv_x, *tv_y, *tv_z;
 			duk_bool_t tmp;
 
-			/* x <= y  -->  not (x > y)  -->  not (y < x) */
-			tmp = duk_js_compare_helper(thr,
-			                            DUK__REGCONSTP(c),  /* y */
-			                            DUK__REGCONSTP(b),  /* x */
-			                            DUK_COMPARE_FLAG_NEGATE);  /* flags */
+			tv_x = DUK__REGCONSTP(b);
+			tv_y = DUK__REGCONSTP(c);
+#if defined(DUK_USE_FASTINT)
+			if (DUK_TVAL_IS_FASTINT(tv_x) && DUK_TVAL_IS_FASTINT(tv_y)) {
+				tmp = (DUK_TVAL_GET_FASTINT(tv_x) <= DUK_TVAL_GET_FASTINT(tv_y));
+			} else
+#endif
+			{
+				/* x <= y  -->  not (x > y)  -->  not (y < x) */
+				tmp = duk_js_compare_helper(thr,
+				                            tv_y,  /* y */
+				                            tv_x,  /* x */
+				                            DUK_COMPARE_FLAG_NEGATE);  /* flags */
+			}
 
-			duk_push_boolean(ctx, tmp);
-			duk_replace(ctx, (duk_idx_t) a);
+			tv_z = DUK__REGP(a);
+			DUK_TVAL_SET_BOOLEAN_UPDREF(thr, tv_z, tmp);  /* side effects */
 			break;
 		}
 
@@ -3512,7 +3550,6 @@ DUK_INTERNAL void duk_js_execute_bytecode(duk_hthread *exec_thr) {
 			duk_small_uint_fast_t a = DUK_DEC_A(ins);
 			duk_uint_fast_t bc = DUK_DEC_BC(ins);
 			duk_tval *tv1, *tv2;
-			duk_tval tv_tmp;
 			duk_double_t x, y, z;
 
 			/* Two lowest bits of opcode are used to distinguish
@@ -3543,13 +3580,14 @@ DUK_INTERNAL void duk_js_execute_bytecode(duk_hthread *exec_thr) {
 				DUK_TVAL_SET_FASTINT(tv1, y_fi);  /* no need for refcount update */
 
 				tv2 = DUK__REGP(a);
-				DUK_TVAL_SET_TVAL(&tv_tmp, tv2);
 				z_fi = (ins & DUK_ENC_OP(0x02)) ? x_fi : y_fi;
-				DUK_TVAL_SET_FASTINT(tv2, z_fi);    /* no need for incref */
-				DUK_TVAL_DECREF(thr, &tv_tmp);  /* side effects */
+				DUK_TVAL_SET_FASTINT_UPDREF(thr, tv2, z_fi);  /* side effects */
 				break;
 			}
 		 skip_fastint:
+			if (DUK_TVAL_IS_FASTINT(tv1)) {
+				DUK__FASTINT_STATS_OP(thr, DUK_DEC_OP(ins));
+			}
 #endif
 			if (DUK_TVAL_IS_NUMBER(tv1)) {
 				/* Fast path for the case where the register
@@ -3578,10 +3616,8 @@ DUK_INTERNAL void duk_js_execute_bytecode(duk_hthread *exec_thr) {
 			}
 
 			tv2 = DUK__REGP(a);
-			DUK_TVAL_SET_TVAL(&tv_tmp, tv2);
 			z = (ins & DUK_ENC_OP(0x02)) ? x : y;
-			DUK_TVAL_SET_NUMBER(tv2, z);    /* no need for incref */
-			DUK_TVAL_DECREF(thr, &tv_tmp);  /* side effects */
+			DUK_TVAL_SET_NUMBER_UPDREF(thr, tv2, z);  /* side effects */
 			break;
 		}
 
@@ -3611,7 +3647,9 @@ DUK_INTERNAL void duk_js_execute_bytecode(duk_hthread *exec_thr) {
 			DUK_ASSERT(name != NULL);
 			(void) duk_js_getvar_activation(thr, act, name, 1 /*throw*/);  /* -> [... val this] */
 
-			/* XXX: fastint fast path would be very useful here */
+			/* Both the new and the old value are downgrade checked so
+			 * that e.g. counters in outer scopes stay fastints.
+			 */
 
 			x = duk_to_number(ctx, -2);
 			duk_pop_2(ctx);
@@ -3624,10 +3662,12 @@ DUK_INTERNAL void duk_js_execute_bytecode(duk_hthread *exec_thr) {
 			duk_push_number(ctx, y);
 			tv1 = duk_get_tval(ctx, -1);
 			DUK_ASSERT(tv1 != NULL);
+			DUK_TVAL_CHKFAST_INPLACE(tv1);
 			duk_js_putvar_activation(thr, act, name, tv1, DUK__STRICT());
 			duk_pop(ctx);
 
 			duk_push_number(ctx, (ins & DUK_ENC_OP(0x02)) ? x : y);
+			DUK_TVAL_CHKFAST_INPLACE(duk_get_tval(ctx, -1));
 			duk_replace(ctx, (duk_idx_t) a);
 			break;
 		}
@@ -3678,6 +3718,7 @@ DUK_INTERNAL void duk_js_execute_bytecode(duk_hthread *exec_thr) {
 			duk_push_number(ctx, y);
 			tv_val = duk_get_tval(ctx, -1);
 			DUK_ASSERT(tv_val != NULL);
+			DUK_TVAL_CHKFAST_INPLACE(tv_val);
 			tv_obj = DUK__REGCONSTP(b);
 			tv_key = DUK__REGCONSTP(c);
 			rc = duk_hobject_putprop(thr, tv_obj, tv_key, tv_val, DUK__STRICT());
@@ -3687,6 +3728,7 @@ DUK_INTERNAL void duk_js_execute_bytecode(duk_hthread *exec_thr) {
 			duk_pop(ctx);
 
 			duk_push_number(ctx, (ins & DUK_ENC_OP(0x02)) ? x : y);
+			DUK_TVAL_CHKFAST_INPLACE(duk_get_tval(ctx, -1));
 			duk_replace(ctx, (duk_idx_t) a);
 			break;
 		}
@@ -3711,7 +3753,6 @@ DUK_INTERNAL void duk_js_execute_bytecode(duk_hthread *exec_thr) {
 			case DUK_EXTRAOP_LDTHIS: {
 				/* Note: 'this' may be bound to any value, not just an object */
 				duk_uint_fast_t bc = DUK_DEC_BC(ins);
-				duk_tval tv_tmp;
 				duk_tval *tv1, *tv2;
 
 				tv1 = DUK__REGP(bc);
@@ -3720,56 +3761,51 @@ DUK_INTERNAL void duk_js_execute_bytecode(duk_hthread *exec_thr) {
 
 				DUK_DDD(DUK_DDDPRINT("LDTHIS: %!T to r%ld", (duk_tval *) tv2, (long) bc));
 
-				DUK_TVAL_SET_TVAL(&tv_tmp, tv1);
-				DUK_TVAL_SET_TVAL(tv1, tv2);
-				DUK_TVAL_INCREF(thr, tv1);
-				DUK_TVAL_DECREF(thr, &tv_tmp);  /* side effects */
+				DUK_TVAL_SET_TVAL_UPDREF(thr, tv1, tv2);  /* side effects */
 				break;
 			}
 
 			case DUK_EXTRAOP_LDUNDEF: {
 				duk_uint_fast_t bc = DUK_DEC_BC(ins);
-				duk_tval tv_tmp;
 				duk_tval *tv1;
 
 				tv1 = DUK__REGP(bc);
-				DUK_TVAL_SET_TVAL(&tv_tmp, tv1);
-				DUK_TVAL_SET_UNDEFINED_ACTUAL(tv1);
-				DUK_TVAL_DECREF(thr, &tv_tmp);  /* side effects */
+				DUK_TVAL_SET_UNDEFINED_ACTUAL_UPDREF(thr, tv1);  /* side effects */
 				break;
 			}
 
 			case DUK_EXTRAOP_LDNULL: {
 				duk_uint_fast_t bc = DUK_DEC_BC(ins);
-				duk_tval tv_tmp;
 				duk_tval *tv1;
 
 				tv1 = DUK__REGP(bc);
-				DUK_TVAL_SET_TVAL(&tv_tmp, tv1);
-				DUK_TVAL_SET_NULL(tv1);
-				DUK_TVAL_DECREF(thr, &tv_tmp);  /* side effects */
+				DUK_TVAL_SET_NULL_UPDREF(thr, tv1);  /* side effects */
 				break;
 			}
 
 			case DUK_EXTRAOP_LDTRUE:
 			case DUK_EXTRAOP_LDFALSE: {
 				duk_uint_fast_t bc = DUK_DEC_BC(ins);
-				duk_tval tv_tmp;
 				duk_tval *tv1;
 				duk_small_uint_fast_t bval = (extraop == DUK_EXTRAOP_LDTRUE ? 1 : 0);
 
 				tv1 = DUK__REGP(bc);
-				DUK_TVAL_SET_TVAL(&tv_tmp, tv1);
-				DUK_TVAL_SET_BOOLEAN(tv1, bval);
-				DUK_TVAL_DECREF(thr, &tv_tmp);  /* side effects */
+				DUK_TVAL_SET_BOOLEAN_UPDREF(thr, tv1, bval);  /* side effects */
 				break;
 			}
 
 			case DUK_EXTRAOP_NEWOBJ: {
 				duk_context *ctx = (duk_context *) thr;
 				duk_small_uint_fast_t b = DUK_DEC_B(ins);
+				duk_small_uint_fast_t c = DUK_DEC_C(ins);
 
+				/* C -> initial entry part size hint (object literal
+				 * property count, clamped) or zero.
+				 */
 				duk_push_object(ctx);
+				if (c > 0) {
+					duk_hobject_resize_entrypart(thr, duk_get_hobject(ctx, -1), (duk_uint32_t) c);
+				}
 				duk_replace(ctx, (duk_idx_t) b);
 				break;
 			}
@@ -3777,8 +3813,18 @@ DUK_INTERNAL void duk_js_execute_bytecode(duk_hthread *exec_thr) {
 			case DUK_EXTRAOP_NEWARR: {
 				duk_context *ctx = (duk_context *) thr;
 				duk_small_uint_fast_t b = DUK_DEC_B(ins);
+				duk_small_uint_fast_t c = DUK_DEC_C(ins);
+				duk_hobject *h;
 
+				/* C -> initial array part size hint (number of initialized
+				 * array literal elements, clamped) or zero.
+				 */
 				duk_push_array(ctx);
+				h = duk_get_hobject(ctx, -1);
+				DUK_ASSERT(h != NULL);
+				if ((duk_uint32_t) c > DUK_HOBJECT_GET_ASIZE(h)) {
+					duk_hobject_resize_arraypart(thr, h, (duk_uint32_t) c);
+				}
 				duk_replace(ctx, (duk_idx_t) b);
 				break;
 			}
@@ -3979,7 +4025,6 @@ DUK_INTERNAL void duk_js_execute_bytecode(duk_hthread *exec_thr) {
 
 			case DUK_EXTRAOP_ENDTRY: {
 				duk_catcher *cat;
-				duk_tval tv_tmp;
 				duk_tval *tv1;
 
 				DUK_ASSERT(thr->catchstack_top >= 1);
@@ -3996,16 +4041,12 @@ DUK_INTERNAL void duk_js_execute_bytecode(duk_hthread *exec_thr) {
 
 					tv1 = thr->valstack + cat->idx_base;
 					DUK_ASSERT(tv1 >= thr->valstack && tv1 < thr->valstack_top);
-					DUK_TVAL_SET_TVAL(&tv_tmp, tv1);
-					DUK_TVAL_SET_UNDEFINED_ACTUAL(tv1);
-					DUK_TVAL_DECREF(thr, &tv_tmp);     /* side effects */
+					DUK_TVAL_SET_UNDEFINED_ACTUAL_UPDREF(thr, tv1);  /* side effects */
 					tv1 = NULL;
 
 					tv1 = thr->valstack + cat->idx_base + 1;
 					DUK_ASSERT(tv1 >= thr->valstack && tv1 < thr->valstack_top);
-					DUK_TVAL_SET_TVAL(&tv_tmp, tv1);
-					DUK_TVAL_SET_NUMBER(tv1, (duk_double_t) DUK_LJ_TYPE_NORMAL);  /* XXX: set int */
-					DUK_TVAL_DECREF(thr, &tv_tmp);     /* side effects */
+					DUK_TVAL_SET_NUMBER_UPDREF(thr, tv1, (duk_double_t) DUK_LJ_TYPE_NORMAL);  /* XXX: set int; side effects */
 					tv1 = NULL;
 
 					DUK_CAT_CLEAR_FINALLY_ENABLED(cat);
@@ -4021,7 +4062,6 @@ DUK_INTERNAL void duk_js_execute_bytecode(duk_hthread *exec_thr) {
 
 			case DUK_EXTRAOP_ENDCATCH: {
 				duk_catcher *cat;
-				duk_tval tv_tmp;
 				duk_tval *tv1;
 
 				DUK_ASSERT(thr->catchstack_top >= 1);
@@ -4052,16 +4092,12 @@ DUK_INTERNAL void duk_js_execute_bytecode(duk_hthread *exec_thr) {
 
 					tv1 = thr->valstack + cat->idx_base;
 					DUK_ASSERT(tv1 >= thr->valstack && tv1 < thr->valstack_top);
-					DUK_TVAL_SET_TVAL(&tv_tmp, tv1);
-					DUK_TVAL_SET_UNDEFINED_ACTUAL(tv1);
-					DUK_TVAL_DECREF(thr, &tv_tmp);     /* side effects */
+					DUK_TVAL_SET_UNDEFINED_ACTUAL_UPDREF(thr, tv1);  /* side effects */
 					tv1 = NULL;
 
 					tv1 = thr->valstack + cat->idx_base + 1;
 					DUK_ASSERT(tv1 >= thr->valstack && tv1 < thr->valstack_top);
-					DUK_TVAL_SET_TVAL(&tv_tmp, tv1);
-					DUK_TVAL_SET_NUMBER(tv1, (duk_double_t) DUK_LJ_TYPE_NORMAL);  /* XXX: set int */
-					DUK_TVAL_DECREF(thr, &tv_tmp);     /* side effects */
+					DUK_TVAL_SET_NUMBER_UPDREF(thr, tv1, (duk_double_t) DUK_LJ_TYPE_NORMAL);  /* XXX: set int; side effects */
 					tv1 = NULL;
 
 					DUK_CAT_CLEAR_FINALLY_ENABLED(cat);
@@ -274,8 +274,14 @@ DUK_INTERNAL duk_double_t duk_js_tointeger_number(duk_double_t x) {
 }
 
 DUK_INTERNAL duk_double_t duk_js_tointeger(duk_hthread *thr, duk_tval *tv) {
-	/* XXX: fastint */
-	duk_double_t d = duk_js_tonumber(thr, tv);  /* invalidates tv */
+	duk_double_t d;
+
+#if defined(DUK_USE_FASTINT)
+	if (DUK_TVAL_IS_FASTINT(tv)) {
+		return (duk_double_t) DUK_TVAL_GET_FASTINT(tv);
+	}
+#endif
+	d = duk_js_tonumber(thr, tv);  /* invalidates tv */
 	return duk_js_tointeger_number(d);
 }
 
@@ -504,6 +504,97 @@ DUK_LOCAL void duk__init_lexer_window(duk_lexer_ctx *lex_ctx) {
 }
 #endif  /* DUK_USE_LEXER_SLIDING_WINDOW */
 
+#if defined(DUK_USE_LEXER_ASCII_FASTPATH)
+/*
+ *  ASCII fast path helpers.
+ *
+ *  Runs of ASCII identifier characters, whitespace, and comment text are
+ *  scanned directly from the source bytes using a character class table
+ *  instead of going through the lookup window one codepoint at a time.
+ *  Because the run is pure ASCII, its length in bytes equals its length in
+ *  characters, so the window can then be moved past the run: short runs
+ *  are skipped through the window, long runs by resetting the window to
+ *  the byte offset after the run (which avoids decoding the run at all).
+ *  Line numbers inside a skipped run are only counted when the run may
+ *  contain line terminators (multi-line comments).
+ */
+
+#define DUK__ACLS_IDPART      (1 << 0)  /* IdentifierPart: [A-Za-z0-9$_] */
+#define DUK__ACLS_WHITESPACE  (1 << 1)  /* space, tab */
+#define DUK__ACLS_SLCOMMENT   (1 << 2)  /* single line comment text: anything except LF, CR */
+#define DUK__ACLS_MLCOMMENT   (1 << 3)  /* multi line comment text: anything except '*' */
+
+DUK_LOCAL const duk_uint8_t duk__ascii_class[128] = {
+	0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0e, 0x08, 0x0c, 0x0c, 0x08, 0x0c, 0x0c,
+	0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c,
+	0x0e, 0x0c, 0x0c, 0x0c, 0x0d, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x04, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c,
+	0x0d, 0x0d, 0x0d, 0x0d, 0x0d, 0x0d, 0x0d, 0x0d, 0x0d, 0x0d, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c,
+	0x0c, 0x0d, 0x0d, 0x0d, 0x0d, 0x0d, 0x0d, 0x0d, 0x0d, 0x0d, 0x0d, 0x0d, 0x0d, 0x0d, 0x0d, 0x0d,
+	0x0d, 0x0d, 0x0d, 0x0d, 0x0d, 0x0d, 0x0d, 0x0d, 0x0d, 0x0d, 0x0d, 0x0c, 0x0c, 0x0c, 0x0c, 0x0d,
+	0x0c, 0x0d, 0x0d, 0x0d, 0x0d, 0x0d, 0x0d, 0x0d, 0x0d, 0x0d, 0x0d, 0x0d, 0x0d, 0x0d, 0x0d, 0x0d,
+	0x0d, 0x0d, 0x0d, 0x0d, 0x0d, 0x0d, 0x0d, 0x0d, 0x0d, 0x0d, 0x0d, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c
+};
+
+/* Runs at least this long are skipped by resetting the window; shorter
+ * runs are cheaper to skip through the window.
+ */
+#if defined(DUK_USE_LEXER_SLIDING_WINDOW)
+#define DUK__ASCII_RESYNC_LIMIT  DUK_LEXER_BUFFER_SIZE
+#else
+#define DUK__ASCII_RESYNC_LIMIT  DUK_LEXER_WINDOW_SIZE
+#endif
+
+/* Length of the run of ASCII characters matching 'mask', starting at the
+ * current window position.  If 'out_lines' is non-NULL, line terminators
+ * inside the run are counted using the same rules as the window decoder.
+ */
+DUK_LOCAL duk_size_t duk__scan_ascii_run(duk_lexer_ctx *lex_ctx, duk_small_uint_t mask, duk_int_t *out_lines) {
+	const duk_uint8_t *p_start, *p, *p_end;
+	duk_int_t lines = 0;
+	duk_uint8_t t;
+
+	DUK_ASSERT(lex_ctx->window[0].offset <= lex_ctx->input_length);
+
+	p_start = lex_ctx->input + lex_ctx->window[0].offset;
+	p_end = lex_ctx->input + lex_ctx->input_length;
+	for (p = p_start; p < p_end; p++) {
+		t = *p;
+		if (t >= 0x80U || !(duk__ascii_class[t] & mask)) {
+			break;
+		}
+		if (DUK_UNLIKELY(t <= 0x0dU) && out_lines != NULL) {
+			if (t == 0x0aU || (t == 0x0dU && (p + 1 >= p_end || p[1] != 0x0aU))) {
+				lines++;
+			}
+		}
+	}
+
+	if (out_lines != NULL) {
+		*out_lines = lines;
+	}
+	return (duk_size_t) (p - p_start);
+}
+
+/* Move the window past 'count' ASCII characters containing 'lines' line
+ * terminators, as returned by duk__scan_ascii_run().
+ */
+DUK_LOCAL void duk__skip_ascii_run(duk_lexer_ctx *lex_ctx, duk_size_t count, duk_int_t lines) {
+	duk_lexer_point pt;
+
+	if (count >= DUK__ASCII_RESYNC_LIMIT) {
+		pt.offset = lex_ctx->window[0].offset + count;
+		pt.line = lex_ctx->window[0].line + lines;
+		duk_lexer_setpoint(lex_ctx, &pt);
+		return;
+	}
+	while (count > DUK_LEXER_WINDOW_SIZE) {
+		DUK__ADVANCECHARS(lex_ctx, DUK_LEXER_WINDOW_SIZE);
+		count -= DUK_LEXER_WINDOW_SIZE;
+	}
+	DUK__ADVANCECHARS(lex_ctx, count);
+}
+#endif  /* DUK_USE_LEXER_ASCII_FASTPATH */
+
 /*
  *  (Re)initialize the temporary byte buffer.  May be called extra times
  *  with little impact.
@@ -765,7 +856,11 @@ void duk_lexer_parse_js_input_element(duk_lexer_ctx *lex_ctx,
 	switch (x) {
 	case DUK_ASC_SPACE:
 	case DUK_ASC_HT:  /* fast paths for space and tab */
+#if defined(DUK_USE_LEXER_ASCII_FASTPATH)
+		duk__skip_ascii_run(lex_ctx, duk__scan_ascii_run(lex_ctx, DUK__ACLS_WHITESPACE, NULL), 0);
+#else
 		DUK__ADVANCECHARS(lex_ctx, 1);
+#endif
 		goto restart;
 	case DUK_ASC_LF:  /* LF line terminator; CR LF and Unicode lineterms are handled in slow path */
 		DUK__ADVANCECHARS(lex_ctx, 1);
@@ -780,6 +875,10 @@ void duk_lexer_parse_js_input_element(duk_lexer_ctx *lex_ctx,
 
 			/* DUK__ADVANCECHARS(lex_ctx, 2) would be correct here, but it unnecessary */
 			for (;;) {
+#if defined(DUK_USE_LEXER_ASCII_FASTPATH)
+				/* Skip ASCII text in bulk, decode anything else. */
+				duk__skip_ascii_run(lex_ctx, duk__scan_ascii_run(lex_ctx, DUK__ACLS_SLCOMMENT, NULL), 0);
+#endif
 				x = DUK__L0();
 				if (x < 0 || duk_unicode_is_line_terminator(x)) {
 					break;
@@ -797,6 +896,21 @@ void duk_lexer_parse_js_input_element(duk_lexer_ctx *lex_ctx,
 			duk_bool_t last_asterisk = 0;
 			DUK__ADVANCECHARS(lex_ctx, 2);
 			for (;;) {
+#if defined(DUK_USE_LEXER_ASCII_FASTPATH)
+				/* Skip ASCII text not containing '*' in bulk; an
+				 * asterisk ends the run so the terminating "*" "/"
+				 * pair is always matched below.
+				 */
+				if (!last_asterisk) {
+					duk_size_t run;
+					duk_int_t lines;
+					run = duk__scan_ascii_run(lex_ctx, DUK__ACLS_MLCOMMENT, &lines);
+					if (lines > 0) {
+						got_lineterm = 1;
+					}
+					duk__skip_ascii_run(lex_ctx, run, lines);
+				}
+#endif
 				x = DUK__L0();
 				if (x < 0) {
 					DUK_ERROR(lex_ctx->thr, DUK_ERR_SYNTAX_ERROR,
@@ -1284,6 +1398,29 @@ void duk_lexer_parse_js_input_element(duk_lexer_ctx *lex_ctx,
 		duk_small_int_t i, i_end;
 		duk_bool_t first = 1;
 		duk_hstring *str;
+#if defined(DUK_USE_LEXER_ASCII_FASTPATH)
+		duk_size_t run;
+		duk_size_t next_offset;
+
+		/* Fast path: an identifier consisting of ASCII characters only
+		 * and not followed by an escape or a non-ASCII character (which
+		 * might be an IdentifierPart) is interned directly from the
+		 * source bytes.  The first character has already been checked
+		 * to be an IdentifierStart.
+		 */
+		run = duk__scan_ascii_run(lex_ctx, DUK__ACLS_IDPART, NULL);
+		next_offset = lex_ctx->window[0].offset + run;
+		if (run > 0 &&
+		    (next_offset >= lex_ctx->input_length ||
+		     (lex_ctx->input[next_offset] < 0x80U && lex_ctx->input[next_offset] != DUK_ASC_BACKSLASH))) {
+			duk_push_lstring((duk_context *) lex_ctx->thr,
+			                 (const char *) (lex_ctx->input + lex_ctx->window[0].offset),
+			                 run);
+			duk_replace((duk_context *) lex_ctx->thr, lex_ctx->slot1_idx);
+			duk__skip_ascii_run(lex_ctx, run, 0);
+			goto identifier_interned;
+		}
+#endif
 
 		DUK__INITBUFFER(lex_ctx);
 		for (;;) {
@@ -1327,13 +1464,16 @@ void duk_lexer_parse_js_input_element(duk_lexer_ctx *lex_ctx,
 		}
 
 		duk__internbuffer(lex_ctx, lex_ctx->slot1_idx);
+		DUK__INITBUFFER(lex_ctx);  /* free some memory */
+
+#if defined(DUK_USE_LEXER_ASCII_FASTPATH)
+		 identifier_interned:
+#endif
 		out_token->str1 = duk_get_hstring((duk_context *) lex_ctx->thr, lex_ctx->slot1_idx);
 		str = out_token->str1;
 		DUK_ASSERT(str != NULL);
 		out_token->t_nores = DUK_TOK_IDENTIFIER;
 
-		DUK__INITBUFFER(lex_ctx);  /* free some memory */
-
 		/*
 		 *  Interned identifier is compared against reserved words, which are
 		 *  currently interned into the heap context.  See genstrings.py.
@@ -1349,7 +1489,11 @@ void duk_lexer_parse_js_input_element(duk_lexer_ctx *lex_ctx,
 		 *  work around this a bit.
 		 */
 
-		/* XXX: optimize by adding the token numbers directly into the
+		/* The reserved word flags are set when the built-in strings are
+		 * interned, so the token number lookup is only needed for actual
+		 * reserved words; other identifiers skip it entirely.
+		 *
+		 * XXX: optimize by adding the token numbers directly into the
 		 * always interned duk_hstring objects (there should be enough
 		 * flag bits free for that)?
 		 */
@@ -1357,7 +1501,9 @@ void duk_lexer_parse_js_input_element(duk_lexer_ctx *lex_ctx,
 		i_end = (strict_mode ? DUK_STRIDX_END_RESERVED : DUK_STRIDX_START_STRICT_RESERVED);
 
 		advtok = DUK__ADVTOK(0, DUK_TOK_IDENTIFIER);
-		if (out_token->num_escapes == 0) {
+		if (out_token->num_escapes == 0 &&
+		    DUK_HSTRING_HAS_RESERVED_WORD(str) &&
+		    (strict_mode || !DUK_HSTRING_HAS_STRICT_RESERVED_WORD(str))) {
 			for (i = DUK_STRIDX_START_RESERVED; i < i_end; i++) {
 				DUK_ASSERT(i >= 0 && i < DUK_HEAP_NUM_STRINGS);
 				if (DUK_HTHREAD_GET_STRING(lex_ctx->thr, i) == str) {
@@ -1401,6 +1547,33 @@ void duk_lexer_parse_js_input_element(duk_lexer_ctx *lex_ctx,
 		                         */
 		duk_small_uint_t s2n_flags;
 		duk_codepoint_t y;
+#if defined(DUK_USE_LEXER_ASCII_FASTPATH)
+		const duk_uint8_t *p, *p_start, *p_end;
+
+		/* Fast path: a decimal integer literal without a leading zero,
+		 * fraction, or exponent which fits into 15 digits (and is thus
+		 * exactly representable) is converted directly from the source
+		 * bytes.  Everything else goes through the generic path below,
+		 * including the error checks for what may follow a literal.
+		 */
+		if (DUK__ISDIGIT(x)) {
+			p_start = lex_ctx->input + lex_ctx->window[0].offset;
+			p_end = lex_ctx->input + lex_ctx->input_length;
+			val = 0.0;
+			for (p = p_start; p < p_end && DUK__ISDIGIT(*p) && p - p_start < 15; p++) {
+				val = val * 10.0 + (duk_double_t) (*p - DUK_ASC_0);
+			}
+			if ((x != DUK_ASC_0 || p - p_start == 1) &&
+			    (p >= p_end ||
+			     (*p < 0x80U && !(duk__ascii_class[*p] & DUK__ACLS_IDPART) &&
+			      *p != DUK_ASC_PERIOD && *p != DUK_ASC_BACKSLASH))) {
+				duk__skip_ascii_run(lex_ctx, (duk_size_t) (p - p_start), 0);
+				out_token->num = val;
+				advtok = DUK__ADVTOK(0, DUK_TOK_NUMBER);
+				goto skip_slow_path;
+			}
+		}
+#endif
 
 		DUK__INITBUFFER(lex_ctx);
 		y = DUK__L1();
@@ -2,7 +2,8 @@
  *  Number-to-string and string-to-number conversions.
  *
  *  Slow path number-to-string and string-to-number conversion is based on
- *  a Dragon4 variant, with fast paths for small integers.  Big integer
+ *  a Dragon4 variant, with fast paths for small integers and (when 64-bit
+ *  arithmetic is available) for common decimal conversions.  Big integer
  *  arithmetic is needed for guaranteeing that the conversion is correct
  *  and uses a minimum number of digits.  The big number arithmetic has a
  *  fixed maximum size and does not require dynamic allocations.
@@ -799,7 +800,7 @@ DUK_LOCAL void duk__dragon4_prepare(duk__numconv_stringify_ctx *nc_ctx) {
 		/* When doing string-to-number, lowest_mantissa is always 0 so
 		 * the exponent check, while incorrect, won't matter.
 		 */
-		if (nc_ctx->e > DUK__IEEE_DOUBLE_EXP_MIN /*not minimum exponent*/ &&
+		if (nc_ctx->e > DUK__IEEE_DOUBLE_EXP_MIN - 52 /*not minimum exponent*/ &&
 		    lowest_mantissa /* lowest mantissa for this exponent*/) {
 			/* r <- (* f b 2)                                [if b==2 -> (* f 4)]
 			 * s <- (* (expt b (- 1 e)) 2) == b^(1-e) * 2    [if b==2 -> b^(2-e)]
@@ -1013,7 +1014,7 @@ DUK_LOCAL void duk__dragon4_generate(duk__numconv_stringify_ctx *nc_ctx) {
 			tc1 = (duk__bi_compare(&nc_ctx->r, &nc_ctx->mm) <= (nc_ctx->low_ok ? 0 : -1));
 
 			duk__bi_add(&nc_ctx->t1, &nc_ctx->r, &nc_ctx->mp);  /* t1 <- (+ r m+) */
-			tc2 = (duk__bi_compare(&nc_ctx->t1, &nc_ctx->s) >= (&nc_ctx->high_ok ? 0 : 1));
+			tc2 = (duk__bi_compare(&nc_ctx->t1, &nc_ctx->s) >= (nc_ctx->high_ok ? 0 : 1));
 
 			DUK_DDD(DUK_DDDPRINT("tc1=%ld, tc2=%ld", (long) tc1, (long) tc2));
 		} else {
@@ -1030,13 +1031,16 @@ DUK_LOCAL void duk__dragon4_generate(duk__numconv_stringify_ctx *nc_ctx) {
 		if (tc1) {
 			if (tc2) {
 				/* tc1 = true, tc2 = true */
+				duk_small_int_t cmp;
+
 				duk__bi_mul_small(&nc_ctx->t1, &nc_ctx->r, 2);
-				if (duk__bi_compare(&nc_ctx->t1, &nc_ctx->s) < 0) {  /* (< (* r 2) s) */
-					DUK_DDD(DUK_DDDPRINT("tc1=true, tc2=true, 2r > s: output d --> %ld (k=%ld)",
+				cmp = duk__bi_compare(&nc_ctx->t1, &nc_ctx->s);
+				if (cmp < 0 || (cmp == 0 && (d & 1) == 0)) {  /* (< (* r 2) s), ties to even (E5.1 Section 9.8.1) */
+					DUK_DDD(DUK_DDDPRINT("tc1=true, tc2=true, 2r < s or tie with even d: output d --> %ld (k=%ld)",
 					                     (long) d, (long) nc_ctx->k));
 					DUK__DRAGON4_OUTPUT_PREINC(nc_ctx, count, d);
 				} else {
-					DUK_DDD(DUK_DDDPRINT("tc1=true, tc2=true, 2r <= s: output d+1 --> %ld (k=%ld)",
+					DUK_DDD(DUK_DDDPRINT("tc1=true, tc2=true, 2r > s or tie with odd d: output d+1 --> %ld (k=%ld)",
 					                     (long) (d + 1), (long) nc_ctx->k));
 					DUK__DRAGON4_OUTPUT_PREINC(nc_ctx, count, d + 1);
 				}
@@ -1531,6 +1535,480 @@ DUK_LOCAL void duk__dragon4_ctx_to_double(duk__numconv_stringify_ctx *nc_ctx, du
 	*x = DUK_DBLUNION_GET_DOUBLE(&u);
 }
 
+/*
+ *  Fast paths using 64-bit arithmetic
+ *
+ *  Number-to-string: Grisu3 (Florian Loitsch, "Printing Floating-Point
+ *  Numbers Quickly and Accurately with Integers") generates the shortest
+ *  digit string for the vast majority of doubles.  When Grisu3 cannot
+ *  prove its result is the shortest and closest one (about 0.5% of inputs),
+ *  it bails out and the caller falls back to Dragon4.
+ *
+ *  String-to-number: the decimal significand (if it fits into 64 bits) is
+ *  multiplied by a cached power of ten while tracking the worst case error
+ *  of the approximation, similarly to Eisel-Lemire.  If the error makes the
+ *  rounding direction ambiguous the caller falls back to Dragon4.
+ *
+ *  Both algorithms use the same table of normalized 64-bit approximations
+ *  of powers of ten, covering 10^-348 to 10^340 in steps of 8.
+ */
+
+#if defined(DUK_USE_NUMCONV_FASTPATH)
+
+typedef struct {
+	duk_uint64_t f;         /* significand */
+	duk_small_int_t e;      /* binary exponent: value = f * 2^e */
+} duk__diyfp;
+
+typedef struct {
+	duk_uint32_t f_hi;      /* significand, high 32 bits */
+	duk_uint32_t f_lo;      /* significand, low 32 bits */
+	duk_int16_t e;          /* binary exponent */
+} duk__cached_power;
+
+#define DUK__CACHED_POWERS_MIN_EXP10   (-348)  /* decimal exponent of first entry */
+#define DUK__CACHED_POWERS_MAX_EXP10   340     /* decimal exponent of last entry */
+#define DUK__CACHED_POWERS_STEP        8       /* decimal exponent distance */
+#define DUK__GRISU_ALPHA               (-60)   /* target binary exponent range */
+#define DUK__GRISU_GAMMA               (-32)
+#define DUK__U64_LOW32_MASK            ((duk_uint64_t) 0xffffffffUL)
+#define DUK__U64_HIDDEN_BIT            (((duk_uint64_t) 1) << 52)
+#define DUK__U64_SIGNIFICAND_MASK      (DUK__U64_HIDDEN_BIT - 1)
+#define DUK__DBL_DENORMAL_EXP          (-1074)  /* exponent of a denormal with f in [0,2^52[ */
+#define DUK__DBL_MAX_EXP               972      /* 0x7ff - 1075 */
+
+/* Generated with a small Python script using exact rational arithmetic:
+ * significand of 10^k normalized to [2^63,2^64[ and rounded to nearest.
+ */
+DUK_LOCAL const duk__cached_power duk__cached_powers[] = {
+	{ 0xfa8fd5a0UL, 0x081c0288UL, -1220 },
+	{ 0xbaaee17fUL, 0xa23ebf76UL, -1193 },
+	{ 0x8b16fb20UL, 0x3055ac76UL, -1166 },
+	{ 0xcf42894aUL, 0x5dce35eaUL, -1140 },
+	{ 0x9a6bb0aaUL, 0x55653b2dUL, -1113 },
+	{ 0xe61acf03UL, 0x3d1a45dfUL, -1087 },
+	{ 0xab70fe17UL, 0xc79ac6caUL, -1060 },
+	{ 0xff77b1fcUL, 0xbebcdc4fUL, -1034 },
+	{ 0xbe5691efUL, 0x416bd60cUL, -1007 },
+	{ 0x8dd01fadUL, 0x907ffc3cUL, -980 },
+	{ 0xd3515c28UL, 0x31559a83UL, -954 },
+	{ 0x9d71ac8fUL, 0xada6c9b5UL, -927 },
+	{ 0xea9c2277UL, 0x23ee8bcbUL, -901 },
+	{ 0xaecc4991UL, 0x4078536dUL, -874 },
+	{ 0x823c1279UL, 0x5db6ce57UL, -847 },
+	{ 0xc2109436UL, 0x4dfb5637UL, -821 },
+	{ 0x9096ea6fUL, 0x3848984fUL, -794 },
+	{ 0xd77485cbUL, 0x25823ac7UL, -768 },
+	{ 0xa086cfcdUL, 0x97bf97f4UL, -741 },
+	{ 0xef340a98UL, 0x172aace5UL, -715 },
+	{ 0xb23867fbUL, 0x2a35b28eUL, -688 },
+	{ 0x84c8d4dfUL, 0xd2c63f3bUL, -661 },
+	{ 0xc5dd4427UL, 0x1ad3cdbaUL, -635 },
+	{ 0x936b9fceUL, 0xbb25c996UL, -608 },
+	{ 0xdbac6c24UL, 0x7d62a584UL, -582 },
+	{ 0xa3ab6658UL, 0x0d5fdaf6UL, -555 },
+	{ 0xf3e2f893UL, 0xdec3f126UL, -529 },
+	{ 0xb5b5ada8UL, 0xaaff80b8UL, -502 },
+	{ 0x87625f05UL, 0x6c7c4a8bUL, -475 },
+	{ 0xc9bcff60UL, 0x34c13053UL, -449 },
+	{ 0x964e858cUL, 0x91ba2655UL, -422 },
+	{ 0xdff97724UL, 0x70297ebdUL, -396 },
+	{ 0xa6dfbd9fUL, 0xb8e5b88fUL, -369 },
+	{ 0xf8a95fcfUL, 0x88747d94UL, -343 },
+	{ 0xb9447093UL, 0x8fa89bcfUL, -316 },
+	{ 0x8a08f0f8UL, 0xbf0f156bUL, -289 },
+	{ 0xcdb02555UL, 0x653131b6UL, -263 },
+	{ 0x993fe2c6UL, 0xd07b7facUL, -236 },
+	{ 0xe45c10c4UL, 0x2a2b3b06UL, -210 },
+	{ 0xaa242499UL, 0x697392d3UL, -183 },
+	{ 0xfd87b5f2UL, 0x8300ca0eUL, -157 },
+	{ 0xbce50864UL, 0x92111aebUL, -130 },
+	{ 0x8cbccc09UL, 0x6f5088ccUL, -103 },
+	{ 0xd1b71758UL, 0xe219652cUL, -77 },
+	{ 0x9c400000UL, 0x00000000UL, -50 },
+	{ 0xe8d4a510UL, 0x00000000UL, -24 },
+	{ 0xad78ebc5UL, 0xac620000UL, 3 },
+	{ 0x813f3978UL, 0xf8940984UL, 30 },
+	{ 0xc097ce7bUL, 0xc90715b3UL, 56 },
+	{ 0x8f7e32ceUL, 0x7bea5c70UL, 83 },
+	{ 0xd5d238a4UL, 0xabe98068UL, 109 },
+	{ 0x9f4f2726UL, 0x179a2245UL, 136 },
+	{ 0xed63a231UL, 0xd4c4fb27UL, 162 },
+	{ 0xb0de6538UL, 0x8cc8ada8UL, 189 },
+	{ 0x83c7088eUL, 0x1aab65dbUL, 216 },
+	{ 0xc45d1df9UL, 0x42711d9aUL, 242 },
+	{ 0x924d692cUL, 0xa61be758UL, 269 },
+	{ 0xda01ee64UL, 0x1a708deaUL, 295 },
+	{ 0xa26da399UL, 0x9aef774aUL, 322 },
+	{ 0xf209787bUL, 0xb47d6b85UL, 348 },
+	{ 0xb454e4a1UL, 0x79dd1877UL, 375 },
+	{ 0x865b8692UL, 0x5b9bc5c2UL, 402 },
+	{ 0xc83553c5UL, 0xc8965d3dUL, 428 },
+	{ 0x952ab45cUL, 0xfa97a0b3UL, 455 },
+	{ 0xde469fbdUL, 0x99a05fe3UL, 481 },
+	{ 0xa59bc234UL, 0xdb398c25UL, 508 },
+	{ 0xf6c69a72UL, 0xa3989f5cUL, 534 },
+	{ 0xb7dcbf53UL, 0x54e9beceUL, 561 },
+	{ 0x88fcf317UL, 0xf22241e2UL, 588 },
+	{ 0xcc20ce9bUL, 0xd35c78a5UL, 614 },
+	{ 0x98165af3UL, 0x7b2153dfUL, 641 },
+	{ 0xe2a0b5dcUL, 0x971f303aUL, 667 },
+	{ 0xa8d9d153UL, 0x5ce3b396UL, 694 },
+	{ 0xfb9b7cd9UL, 0xa4a7443cUL, 720 },
+	{ 0xbb764c4cUL, 0xa7a44410UL, 747 },
+	{ 0x8bab8eefUL, 0xb6409c1aUL, 774 },
+	{ 0xd01fef10UL, 0xa657842cUL, 800 },
+	{ 0x9b10a4e5UL, 0xe9913129UL, 827 },
+	{ 0xe7109bfbUL, 0xa19c0c9dUL, 853 },
+	{ 0xac2820d9UL, 0x623bf429UL, 880 },
+	{ 0x80444b5eUL, 0x7aa7cf85UL, 907 },
+	{ 0xbf21e440UL, 0x03acdd2dUL, 933 },
+	{ 0x8e679c2fUL, 0x5e44ff8fUL, 960 },
+	{ 0xd433179dUL, 0x9c8cb841UL, 986 },
+	{ 0x9e19db92UL, 0xb4e31ba9UL, 1013 },
+	{ 0xeb96bf6eUL, 0xbadf77d9UL, 1039 },
+	{ 0xaf87023bUL, 0x9bf0ee6bUL, 1066 },
+};
+
+DUK_LOCAL void duk__diyfp_get_cached_power(duk_small_int_t idx, duk__diyfp *res) {
+	const duk__cached_power *cp;
+
+	DUK_ASSERT(idx >= 0 && idx < (duk_small_int_t) (sizeof(duk__cached_powers) / sizeof(duk__cached_power)));
+	cp = duk__cached_powers + idx;
+	res->f = (((duk_uint64_t) cp->f_hi) << 32) | ((duk_uint64_t) cp->f_lo);
+	res->e = (duk_small_int_t) cp->e;
+}
+
+DUK_LOCAL void duk__diyfp_normalize(duk__diyfp *x) {
+	DUK_ASSERT(x->f != 0);
+
+	while ((x->f >> 32) == 0) {
+		x->f <<= 32;
+		x->e -= 32;
+	}
+	while ((x->f >> 63) == 0) {
+		x->f <<= 1;
+		x->e--;
+	}
+}
+
+/* x <- x * y, keeping the (rounded) high 64 bits of the 128-bit product. */
+DUK_LOCAL void duk__diyfp_multiply(duk__diyfp *x, const duk__diyfp *y) {
+	duk_uint64_t a, b, c, d;
+	duk_uint64_t ac, bc, ad, bd;
+	duk_uint64_t tmp;
+
+	a = x->f >> 32;
+	b = x->f & DUK__U64_LOW32_MASK;
+	c = y->f >> 32;
+	d = y->f & DUK__U64_LOW32_MASK;
+	ac = a * c;
+	bc = b * c;
+	ad = a * d;
+	bd = b * d;
+	tmp = (bd >> 32) + (ad & DUK__U64_LOW32_MASK) + (bc & DUK__U64_LOW32_MASK);
+	tmp += ((duk_uint64_t) 1) << 31;  /* round */
+	x->f = ac + (ad >> 32) + (bc >> 32) + (tmp >> 32);
+	x->e = x->e + y->e + 64;
+}
+
+/* Decode a positive, finite, non-zero double into 'w' (not normalized). */
+DUK_LOCAL void duk__diyfp_from_double(duk_double_t x, duk__diyfp *w) {
+	duk_double_union u;
+	duk_uint32_t hi;
+	duk_small_int_t expt;
+
+	DUK_DBLUNION_SET_DOUBLE(&u, x);
+	hi = DUK_DBLUNION_GET_HIGH32(&u);
+	expt = (duk_small_int_t) ((hi >> 20) & 0x07ffUL);
+	w->f = (((duk_uint64_t) (hi & 0x000fffffUL)) << 32) | ((duk_uint64_t) DUK_DBLUNION_GET_LOW32(&u));
+	if (expt == 0) {
+		/* denormal */
+		w->e = DUK__DBL_DENORMAL_EXP;
+	} else {
+		w->f |= DUK__U64_HIDDEN_BIT;
+		w->e = expt - DUK__IEEE_DOUBLE_EXP_BIAS - 52;
+	}
+}
+
+/* Convert a value with at most 53 significant bits back into a double,
+ * handling overflow to Infinity, denormals, and underflow to zero.
+ */
+DUK_LOCAL duk_double_t duk__diyfp_to_double(duk__diyfp *x) {
+	duk_double_union u;
+	duk_uint64_t f;
+	duk_small_int_t e;
+	duk_uint32_t biased;
+
+	f = x->f;
+	e = x->e;
+	while (f > (DUK__U64_HIDDEN_BIT | DUK__U64_SIGNIFICAND_MASK)) {
+		f >>= 1;
+		e++;
+	}
+	if (e >= DUK__DBL_MAX_EXP) {
+		return DUK_DOUBLE_INFINITY;
+	}
+	if (e < DUK__DBL_DENORMAL_EXP) {
+		return 0.0;
+	}
+	while (e > DUK__DBL_DENORMAL_EXP && (f & DUK__U64_HIDDEN_BIT) == 0) {
+		f <<= 1;
+		e--;
+	}
+	if (e == DUK__DBL_DENORMAL_EXP && (f & DUK__U64_HIDDEN_BIT) == 0) {
+		biased = 0;
+	} else {
+		biased = (duk_uint32_t) (e + DUK__IEEE_DOUBLE_EXP_BIAS + 52);
+	}
+	DUK_DBLUNION_SET_HIGH32(&u, (((duk_uint32_t) (f >> 32)) & 0x000fffffUL) | (biased << 20));
+	DUK_DBLUNION_SET_LOW32(&u, (duk_uint32_t) (f & DUK__U64_LOW32_MASK));
+	return DUK_DBLUNION_GET_DOUBLE(&u);
+}
+
+/* Adjust the last generated digit towards 'w' and check that the result
+ * is guaranteed to be the closest shortest representation.  All values
+ * are scaled by the same (unknown) factor; 'unit' is the error of the
+ * approximation.
+ */
+DUK_LOCAL duk_bool_t duk__grisu3_round_weed(duk_uint8_t *digits,
+                                            duk_small_int_t count,
+                                            duk_uint64_t dist_high_w,
+                                            duk_uint64_t unsafe_interval,
+                                            duk_uint64_t rest,
+                                            duk_uint64_t ten_kappa,
+                                            duk_uint64_t unit) {
+	duk_uint64_t small_dist = dist_high_w - unit;
+	duk_uint64_t big_dist = dist_high_w + unit;
+
+	/* Move the last digit down as long as the candidate gets closer to
+	 * the value even in the worst case of the approximation error.
+	 */
+	while (rest < small_dist &&
+	       unsafe_interval - rest >= ten_kappa &&
+	       (rest + ten_kappa < small_dist ||
+	        small_dist - rest >= rest + ten_kappa - small_dist)) {
+		DUK_ASSERT(digits[count - 1] > 0);
+		digits[count - 1]--;
+		rest += ten_kappa;
+	}
+
+	/* If the next lower candidate could be closer, bail out. */
+	if (rest < big_dist &&
+	    unsafe_interval - rest >= ten_kappa &&
+	    (rest + ten_kappa < big_dist ||
+	     big_dist - rest > rest + ten_kappa - big_dist)) {
+		return 0;
+	}
+
+	/* Candidate must be within the safe interval. */
+	return (2 * unit <= rest) && (rest <= unsafe_interval - 4 * unit);
+}
+
+/* Shortest digit generation for a positive, finite, non-zero double.
+ * On success, the digits (values 0-9) and count are stored in 'nc_ctx'
+ * and nc_ctx->k is set so that the value is 0.d1d2...dn * 10^k.
+ */
+DUK_LOCAL duk_bool_t duk__grisu3(duk__numconv_stringify_ctx *nc_ctx, duk_double_t x) {
+	duk__diyfp w, m_plus, m_minus, c_mk;
+	duk_uint64_t unit, unsafe_interval, one_f, fractionals, rest, dist_high_w;
+	duk_uint32_t integrals, divisor;
+	duk_small_int_t one_e;
+	duk_small_int_t min_e, k_est, idx, mk, kappa, count;
+	duk_uint8_t *digits = nc_ctx->digits;
+
+	duk__diyfp_from_double(x, &w);
+	DUK_ASSERT(w.f != 0);
+
+	/* Boundaries m+ and m- halfway to the neighbouring doubles; the lower
+	 * gap is smaller when the significand is 2^52 (except for the smallest
+	 * normal exponent).
+	 */
+	m_plus.f = (w.f << 1) + 1;
+	m_plus.e = w.e - 1;
+	duk__diyfp_normalize(&m_plus);
+	if (w.f == DUK__U64_HIDDEN_BIT && w.e > DUK__DBL_DENORMAL_EXP) {
+		m_minus.f = (w.f << 2) - 1;
+		m_minus.e = w.e - 2;
+	} else {
+		m_minus.f = (w.f << 1) - 1;
+		m_minus.e = w.e - 1;
+	}
+	m_minus.f <<= m_minus.e - m_plus.e;
+	m_minus.e = m_plus.e;
+	duk__diyfp_normalize(&w);
+	DUK_ASSERT(w.e == m_plus.e);
+
+	/* Find cached power c_mk = 10^mk so that the scaled exponent is in
+	 * [alpha,gamma].  The estimate is exact except for rounding, adjust
+	 * if necessary.
+	 */
+	min_e = DUK__GRISU_ALPHA - (w.e + 64);
+	k_est = (duk_small_int_t) DUK_CEIL((double) (min_e + 63) * 0.30102999566398114);  /* log10(2) */
+	idx = (k_est - DUK__CACHED_POWERS_MIN_EXP10 - 1) / DUK__CACHED_POWERS_STEP + 1;
+	for (;;) {
+		duk__diyfp_get_cached_power(idx, &c_mk);
+		if (w.e + c_mk.e + 64 < DUK__GRISU_ALPHA) {
+			idx++;
+		} else if (w.e + c_mk.e + 64 > DUK__GRISU_GAMMA) {
+			idx--;
+		} else {
+			break;
+		}
+	}
+	mk = DUK__CACHED_POWERS_MIN_EXP10 + idx * DUK__CACHED_POWERS_STEP;
+
+	duk__diyfp_multiply(&w, &c_mk);
+	duk__diyfp_multiply(&m_plus, &c_mk);
+	duk__diyfp_multiply(&m_minus, &c_mk);
+
+	/* Digit generation.  The scaled boundaries are off by at most one
+	 * unit, so work with the widened (unsafe) interval and let round_weed
+	 * decide whether the result is safe.
+	 */
+	unit = 1;
+	m_minus.f -= unit;  /* too low */
+	m_plus.f += unit;   /* too high */
+	unsafe_interval = m_plus.f - m_minus.f;
+	one_e = w.e;
+	DUK_ASSERT(-one_e >= 32 && -one_e <= 60);
+	one_f = ((duk_uint64_t) 1) << (-one_e);
+	integrals = (duk_uint32_t) (m_plus.f >> (-one_e));
+	fractionals = m_plus.f & (one_f - 1);
+	dist_high_w = m_plus.f - w.f;
+
+	/* Largest power of ten <= integrals. */
+	if (integrals == 0) {
+		divisor = 0;
+		kappa = 0;
+	} else {
+		divisor = 1;
+		kappa = 1;
+		while (integrals / divisor >= 10) {
+			divisor *= 10;
+			kappa++;
+		}
+	}
+
+	count = 0;
+	while (kappa > 0) {
+		digits[count++] = (duk_uint8_t) (integrals / divisor);
+		integrals %= divisor;
+		kappa--;
+		rest = (((duk_uint64_t) integrals) << (-one_e)) + fractionals;
+		if (rest < unsafe_interval) {
+			nc_ctx->count = count;
+			nc_ctx->k = count + kappa - mk;
+			return duk__grisu3_round_weed(digits, count, dist_high_w, unsafe_interval,
+			                              rest, ((duk_uint64_t) divisor) << (-one_e), unit);
+		}
+		divisor /= 10;
+	}
+	for (;;) {
+		DUK_ASSERT(count < 20);
+		fractionals *= 10;
+		unit *= 10;
+		unsafe_interval *= 10;
+		digits[count++] = (duk_uint8_t) (fractionals >> (-one_e));
+		fractionals &= one_f - 1;
+		kappa--;
+		if (fractionals < unsafe_interval) {
+			nc_ctx->count = count;
+			nc_ctx->k = count + kappa - mk;
+			return duk__grisu3_round_weed(digits, count, dist_high_w * unit, unsafe_interval,
+			                              fractionals, one_f, unit);
+		}
+	}
+}
+
+/* Compute f * 10^expt (f != 0) as a correctly rounded double.  Returns 0
+ * if the approximation is too imprecise to decide rounding.  'f_digits'
+ * is the number of decimal digits in 'f'.
+ */
+DUK_LOCAL duk_bool_t duk__fast_s2n(duk_uint64_t f, duk_small_int_t f_digits, duk_small_int_t expt, duk_double_t *res) {
+	duk__diyfp x, c;
+	duk_uint64_t error;  /* in 1/8 units of the last bit */
+	duk_uint64_t prec_bits, prec_mask, half_way;
+	duk_small_int_t old_e, idx, adj, i, magnitude, sig_size, prec_count, shift;
+
+	DUK_ASSERT(f != 0);
+	DUK_ASSERT(expt >= DUK__CACHED_POWERS_MIN_EXP10 && expt <= DUK__CACHED_POWERS_MAX_EXP10);
+
+	x.f = f;
+	x.e = 0;
+	duk__diyfp_normalize(&x);
+	error = 0;  /* 'f' is exact */
+
+	idx = (expt - DUK__CACHED_POWERS_MIN_EXP10) / DUK__CACHED_POWERS_STEP;
+	adj = expt - (DUK__CACHED_POWERS_MIN_EXP10 + idx * DUK__CACHED_POWERS_STEP);
+	DUK_ASSERT(adj >= 0 && adj < DUK__CACHED_POWERS_STEP);
+	if (adj > 0) {
+		/* Exact adjustment power 10^adj; the product is exact too if it
+		 * fits into 64 bits (19 decimal digits).
+		 */
+		c.f = 1;
+		for (i = 0; i < adj; i++) {
+			c.f *= 10;
+		}
+		c.e = 0;
+		duk__diyfp_normalize(&c);
+		duk__diyfp_multiply(&x, &c);
+		if (f_digits + adj > 19) {
+			error += 4;
+		}
+	}
+
+	duk__diyfp_get_cached_power(idx, &c);
+	duk__diyfp_multiply(&x, &c);
+	/* Cached power and multiplication rounding errors (0.5 each), and
+	 * the cross term of two inexact values (rounded up to 1/8).
+	 */
+	error += (duk_uint64_t) (4 + (error == 0 ? 0 : 1) + 4);
+
+	old_e = x.e;
+	duk__diyfp_normalize(&x);
+	error <<= old_e - x.e;
+
+	/* Number of significand bits available in the result, fewer for
+	 * denormals.
+	 */
+	magnitude = 64 + x.e;
+	if (magnitude >= DUK__DBL_DENORMAL_EXP + 53) {
+		sig_size = 53;
+	} else if (magnitude <= DUK__DBL_DENORMAL_EXP) {
+		sig_size = 0;
+	} else {
+		sig_size = magnitude - DUK__DBL_DENORMAL_EXP;
+	}
+	prec_count = 64 - sig_size;
+	if (prec_count + 3 >= 64) {
+		/* Keep the scaled half way point and error representable. */
+		shift = (prec_count + 3) - 64 + 1;
+		x.f >>= shift;
+		x.e += shift;
+		error = (error >> shift) + 1 + 8;
+		prec_count -= shift;
+	}
+
+	prec_mask = (((duk_uint64_t) 1) << prec_count) - 1;
+	prec_bits = (x.f & prec_mask) * 8;
+	half_way = (((duk_uint64_t) 1) << (prec_count - 1)) * 8;
+	if (half_way - error < prec_bits && prec_bits < half_way + error) {
+		/* Too close to the half way point to decide. */
+		return 0;
+	}
+
+	x.f >>= prec_count;
+	x.e += prec_count;
+	if (prec_bits >= half_way + error) {
+		x.f++;
+	}
+	*res = duk__diyfp_to_double(&x);
+	return 1;
+}
+
+#endif  /* DUK_USE_NUMCONV_FASTPATH */
+
 /*
  *  Exposed number-to-string API
  *
@@ -1601,6 +2079,12 @@ DUK_INTERNAL void duk_numconv_stringify(duk_context *ctx, duk_small_int_t radix,
 		duk_uint8_t *buf = (duk_uint8_t *) (&nc_ctx->f);
 		duk_uint8_t *p = buf;
 
+		if (radix == 10 && (!neg || uval == 0)) {
+			/* Array index strings may be cached by the heap. */
+			duk_push_hstring(ctx, duk_heap_string_intern_u32_checked((duk_hthread *) ctx, uval));
+			return;
+		}
+
 		DUK_ASSERT(DUK__NUMCONV_CTX_BIGINTS_SIZE >= 32 + 1);  /* max size: radix=2 + sign */
 		if (neg && uval != 0) {
 			/* no negative sign for zero */
@@ -1673,6 +2157,23 @@ DUK_INTERNAL void duk_numconv_stringify(duk_context *ctx, duk_small_int_t radix,
 		goto zero_skip;
 	}
 
+#if defined(DUK_USE_NUMCONV_FASTPATH)
+	/*
+	 *  Grisu3 fast path for free format decimal output.  Exponential
+	 *  notation is decided by the formatting step, so it's compatible
+	 *  with forced exponential notation too.
+	 */
+
+	if (radix == 10 && !nc_ctx->is_fixed) {
+		if (duk__grisu3(nc_ctx, x)) {
+			DUK_DDD(DUK_DDDPRINT("grisu3 fast path succeeded: count=%ld, k=%ld",
+			                     (long) nc_ctx->count, (long) nc_ctx->k));
+			goto zero_skip;
+		}
+		DUK_DDD(DUK_DDDPRINT("grisu3 fast path failed, fall back to dragon4"));
+	}
+#endif  /* DUK_USE_NUMCONV_FASTPATH */
+
 	duk__dragon4_double_to_ctx(nc_ctx, x);   /* -> sets 'f' and 'e' */
 	DUK__BI_PRINT("f", &nc_ctx->f);
 	DUK_DDD(DUK_DDDPRINT("e=%ld", (long) nc_ctx->e));
@@ -1741,6 +2242,155 @@ DUK_INTERNAL void duk_numconv_stringify(duk_context *ctx, duk_small_int_t radix,
  *  fails due to an internal error, an InternalError is thrown.
  */
 
+#if defined(DUK_USE_NUMCONV_FASTPATH)
+/* Fast scanner for plain decimal input: optional ASCII whitespace and
+ * sign, at most 19 significant digits, optional fraction and exponent.
+ * The untrimmed input string is scanned directly.  Returns 0 if the input
+ * is anything else (non-ASCII whitespace, hex/octal prefixes, leading
+ * zeroes, 'Infinity', empty input, invalid formats, etc) or if the result
+ * can't be computed exactly; the caller then uses the generic parser which
+ * also produces all the error results.
+ */
+DUK_LOCAL duk_bool_t duk__numconv_parse_fast(duk_hstring *h_str, duk_small_uint_t flags, duk_double_t *out) {
+	const duk_uint8_t *p;
+	const duk_uint8_t *p_end;
+	duk_uint64_t f;
+	duk_small_int_t sig_digits;
+	duk_small_int_t dig_whole;
+	duk_small_int_t dig_frac;
+	duk_small_int_t expt;
+	duk_small_int_t expt_adj;
+	duk_small_int_t expt_neg;
+	duk_small_int_t neg;
+	duk_small_int_t dig;
+	duk_double_t res;
+
+	p = (const duk_uint8_t *) DUK_HSTRING_GET_DATA(h_str);
+	p_end = p + DUK_HSTRING_GET_BYTELEN(h_str);
+
+#define DUK__FAST_ISWHITE(x)  ((x) == 0x20 || ((x) >= 0x09 && (x) <= 0x0d))
+	if (flags & DUK_S2N_FLAG_TRIM_WHITE) {
+		while (p < p_end && DUK__FAST_ISWHITE(*p)) {
+			p++;
+		}
+	}
+	if (p >= p_end) {
+		return 0;
+	}
+
+	neg = 0;
+	if (*p == (duk_uint8_t) '-' && (flags & DUK_S2N_FLAG_ALLOW_MINUS)) {
+		neg = 1;
+		p++;
+	} else if (*p == (duk_uint8_t) '+' && (flags & DUK_S2N_FLAG_ALLOW_PLUS)) {
+		p++;
+	}
+
+	/* Hex/octal prefixes and leading zeroes are left to the slow path. */
+	if (p + 1 < p_end && p[0] == (duk_uint8_t) '0' &&
+	    ((p[1] >= (duk_uint8_t) '0' && p[1] <= (duk_uint8_t) '9') ||
+	     p[1] == (duk_uint8_t) 'x' || p[1] == (duk_uint8_t) 'X')) {
+		return 0;
+	}
+
+	f = 0;
+	sig_digits = 0;
+	dig_whole = 0;
+	dig_frac = -1;
+	expt_adj = 0;
+	for (;;) {
+		if (p < p_end && *p >= (duk_uint8_t) '0' && *p <= (duk_uint8_t) '9') {
+			dig = (duk_small_int_t) (*p++ - (duk_uint8_t) '0');
+			if (f != 0 || dig != 0) {
+				if (sig_digits >= 19) {
+					return 0;
+				}
+				f = f * 10 + (duk_uint64_t) dig;
+				sig_digits++;
+			}
+			if (dig_frac >= 0) {
+				dig_frac++;
+				expt_adj--;
+			} else {
+				dig_whole++;
+			}
+		} else if (p < p_end && *p == (duk_uint8_t) '.' && dig_frac < 0 &&
+		           (flags & DUK_S2N_FLAG_ALLOW_FRAC)) {
+			p++;
+			dig_frac = 0;
+		} else {
+			break;
+		}
+	}
+
+	/* Same format checks as in the slow path; failures are left to it. */
+	if (dig_whole == 0) {
+		if (dig_frac <= 0 || !(flags & DUK_S2N_FLAG_ALLOW_NAKED_FRAC)) {
+			return 0;
+		}
+	} else if (dig_frac == 0 && !(flags & DUK_S2N_FLAG_ALLOW_EMPTY_FRAC)) {
+		return 0;
+	}
+
+	expt = 0;
+	if (p < p_end && (*p == (duk_uint8_t) 'e' || *p == (duk_uint8_t) 'E') &&
+	    (flags & DUK_S2N_FLAG_ALLOW_EXP)) {
+		p++;
+		expt_neg = 0;
+		if (p < p_end && *p == (duk_uint8_t) '-') {
+			expt_neg = 1;
+			p++;
+		} else if (p < p_end && *p == (duk_uint8_t) '+') {
+			p++;
+		}
+		if (!(p < p_end && *p >= (duk_uint8_t) '0' && *p <= (duk_uint8_t) '9')) {
+			return 0;
+		}
+		while (p < p_end && *p >= (duk_uint8_t) '0' && *p <= (duk_uint8_t) '9') {
+			expt = expt * 10 + (duk_small_int_t) (*p++ - (duk_uint8_t) '0');
+			if (expt > 9999) {
+				return 0;
+			}
+		}
+		if (expt_neg) {
+			expt = -expt;
+		}
+	}
+
+	if (flags & DUK_S2N_FLAG_TRIM_WHITE) {
+		while (p < p_end && DUK__FAST_ISWHITE(*p)) {
+			p++;
+		}
+	}
+#undef DUK__FAST_ISWHITE
+	if (p != p_end && !(flags & DUK_S2N_FLAG_ALLOW_GARBAGE)) {
+		return 0;
+	}
+
+	expt += expt_adj;
+	while (expt < 0 && f != 0 && (f % 10) == 0) {
+		/* e.g. "1.50" -> 15e-1, "2.000" -> 2 */
+		f /= 10;
+		sig_digits--;
+		expt++;
+	}
+	if (f == 0) {
+		res = 0.0;
+	} else if (expt == 0 && f <= (((duk_uint64_t) 1) << 53)) {
+		res = (duk_double_t) f;  /* exact */
+	} else if (expt >= DUK__CACHED_POWERS_MIN_EXP10 && expt <= DUK__CACHED_POWERS_MAX_EXP10) {
+		if (!duk__fast_s2n(f, sig_digits, expt, &res)) {
+			return 0;
+		}
+	} else {
+		return 0;
+	}
+
+	*out = (neg ? -res : res);
+	return 1;
+}
+#endif  /* DUK_USE_NUMCONV_FASTPATH */
+
 DUK_INTERNAL void duk_numconv_parse(duk_context *ctx, duk_small_int_t radix, duk_small_uint_t flags) {
 	duk_hthread *thr = (duk_hthread *) ctx;
 	duk__numconv_stringify_ctx nc_ctx_alloc;  /* large context; around 2kB now */
@@ -1786,6 +2436,24 @@ DUK_INTERNAL void duk_numconv_parse(duk_context *ctx, duk_small_int_t radix, duk
 	DUK_ASSERT(radix >= 2 && radix <= 36);
 	DUK_ASSERT(radix - 2 < (duk_small_int_t) sizeof(duk__str2num_digits_for_radix));
 
+#if defined(DUK_USE_NUMCONV_FASTPATH)
+	/* Fast path for the common case of plain decimal input (numeric CSV
+	 * fields, query parameters, etc).
+	 */
+	if (radix == 10) {
+		h_str = duk_get_hstring(ctx, -1);
+		if (h_str != NULL && duk__numconv_parse_fast(h_str, flags, &res)) {
+			DUK_DDD(DUK_DDDPRINT("fast scanner number parse"));
+			duk_pop(ctx);
+			duk_push_number(ctx, res);
+#if defined(DUK_USE_FASTINT)
+			DUK_TVAL_CHKFAST_INPLACE(duk_get_tval(ctx, -1));
+#endif
+			return;
+		}
+	}
+#endif  /* DUK_USE_NUMCONV_FASTPATH */
+
 	/*
 	 *  Preliminaries: trim, sign, Infinity check
 	 *
@@ -2157,6 +2825,29 @@ DUK_INTERNAL void duk_numconv_parse(duk_context *ctx, duk_small_int_t radix, duk
 		goto negcheck_and_ret;
 	}
 
+#if defined(DUK_USE_NUMCONV_FASTPATH)
+	/* 64-bit fast path for decimal input whose significand fits into 64
+	 * bits.  Digits beyond the precision limit have already been dropped
+	 * so 'f' is exact.
+	 */
+
+	if (radix == 10 &&
+	    nc_ctx->f.n >= 1 && nc_ctx->f.n <= 2 &&
+	    expt >= DUK__CACHED_POWERS_MIN_EXP10 && expt <= DUK__CACHED_POWERS_MAX_EXP10) {
+		duk_uint64_t f64;
+
+		f64 = (duk_uint64_t) nc_ctx->f.v[0];
+		if (nc_ctx->f.n == 2) {
+			f64 |= ((duk_uint64_t) nc_ctx->f.v[1]) << 32;
+		}
+		if (duk__fast_s2n(f64, dig_prec, expt, &res)) {
+			DUK_DDD(DUK_DDDPRINT("64-bit fast path number parse"));
+			goto negcheck_and_ret;
+		}
+		DUK_DDD(DUK_DDDPRINT("64-bit fast path failed, fall back to dragon4"));
+	}
+#endif  /* DUK_USE_NUMCONV_FASTPATH */
+
 	/* Significand ('f') padding. */
 
 	while (dig_prec < duk__str2num_digits_for_radix[radix - 2]) {
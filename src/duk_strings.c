@@ -47,6 +47,9 @@ DUK_INTERNAL const char *duk_str_failed_to_extend_valstack = "failed to extend v
 DUK_INTERNAL const char *duk_str_base64_encode_failed = "base64 encode failed";
 DUK_INTERNAL const char *duk_str_base64_decode_failed = "base64 decode failed";
 DUK_INTERNAL const char *duk_str_hex_decode_failed = "hex decode failed";
+DUK_INTERNAL const char *duk_str_serialize_failed = "serialize failed";
+DUK_INTERNAL const char *duk_str_deserialize_failed = "deserialize failed";
+DUK_INTERNAL const char *duk_str_serialize_reclimit = "serialize recursion limit";
 DUK_INTERNAL const char *duk_str_no_sourcecode = "no sourcecode";
 DUK_INTERNAL const char *duk_str_concat_result_too_long = "concat result too long";
 DUK_INTERNAL const char *duk_str_unimplemented = "unimplemented";
@@ -71,6 +71,9 @@ DUK_INTERNAL_DECL const char *duk_str_not_configurable;
 #define DUK_STR_BASE64_ENCODE_FAILED duk_str_base64_encode_failed
 #define DUK_STR_BASE64_DECODE_FAILED duk_str_base64_decode_failed
 #define DUK_STR_HEX_DECODE_FAILED duk_str_hex_decode_failed
+#define DUK_STR_SERIALIZE_FAILED duk_str_serialize_failed
+#define DUK_STR_DESERIALIZE_FAILED duk_str_deserialize_failed
+#define DUK_STR_SERIALIZE_RECLIMIT duk_str_serialize_reclimit
 #define DUK_STR_NO_SOURCECODE duk_str_no_sourcecode
 #define DUK_STR_CONCAT_RESULT_TOO_LONG duk_str_concat_result_too_long
 #define DUK_STR_UNIMPLEMENTED duk_str_unimplemented
@@ -107,6 +110,9 @@ DUK_INTERNAL_DECL const char *duk_str_failed_to_extend_valstack;
 DUK_INTERNAL_DECL const char *duk_str_base64_encode_failed;
 DUK_INTERNAL_DECL const char *duk_str_base64_decode_failed;
 DUK_INTERNAL_DECL const char *duk_str_hex_decode_failed;
+DUK_INTERNAL_DECL const char *duk_str_serialize_failed;
+DUK_INTERNAL_DECL const char *duk_str_deserialize_failed;
+DUK_INTERNAL_DECL const char *duk_str_serialize_reclimit;
 DUK_INTERNAL_DECL const char *duk_str_no_sourcecode;
 DUK_INTERNAL_DECL const char *duk_str_concat_result_too_long;
 DUK_INTERNAL_DECL const char *duk_str_unimplemented;
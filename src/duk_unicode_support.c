@@ -653,8 +653,8 @@ DUK_INTERNAL duk_small_int_t duk_unicode_is_letter(duk_codepoint_t cp) {
  *
  *  The return value is the case converted codepoint or -1 if the conversion
  *  results in multiple characters (this is useful for regexp Canonicalization
- *  operation).  If 'buf' is not NULL, the result codepoint(s) are also
- *  appended to the hbuffer.
+ *  operation).  If 'bw' is not NULL, the result codepoint(s) are also
+ *  appended to the buffer writer.
  *
  *  Context and locale specific rules must be checked before consulting
  *  this function.
@@ -662,7 +662,7 @@ DUK_INTERNAL duk_small_int_t duk_unicode_is_letter(duk_codepoint_t cp) {
 
 DUK_LOCAL
 duk_codepoint_t duk__slow_case_conversion(duk_hthread *thr,
-                                          duk_hbuffer_dynamic *buf,
+                                          duk_bufwriter_ctx *bw,
                                           duk_codepoint_t cp,
                                           duk_bitdecoder_ctx *bd_ctx) {
 	duk_small_int_t skip = 0;
@@ -728,11 +728,11 @@ duk_codepoint_t duk__slow_case_conversion(duk_hthread *thr,
 		DUK_DDD(DUK_DDDPRINT("1:n conversion %ld -> %ld chars", (long) start_i, (long) t));
 		if (cp == start_i) {
 			DUK_DDD(DUK_DDDPRINT("1:n matches input codepoint"));
-			if (buf) {
+			if (bw) {
 				while (t--) {
 					tmp_cp = (duk_codepoint_t) duk_bd_decode(bd_ctx, 16);
-					DUK_ASSERT(buf != NULL);
-					duk_hbuffer_append_xutf8(thr, buf, (duk_ucodepoint_t) tmp_cp);
+					DUK_ASSERT(bw != NULL);
+					DUK_BW_WRITE_ENSURE_XUTF8(thr, bw, (duk_ucodepoint_t) tmp_cp);
 				}
 			}
 			return -1;
@@ -748,8 +748,8 @@ duk_codepoint_t duk__slow_case_conversion(duk_hthread *thr,
 	/* fall through */
 
  single:
-	if (buf) {
-		duk_hbuffer_append_xutf8(thr, buf, cp);
+	if (bw) {
+		DUK_BW_WRITE_ENSURE_XUTF8(thr, bw, cp);
 	}
 	return cp;
 }
@@ -766,7 +766,7 @@ duk_codepoint_t duk__slow_case_conversion(duk_hthread *thr,
  */
 DUK_LOCAL
 duk_codepoint_t duk__case_transform_helper(duk_hthread *thr,
-                                           duk_hbuffer_dynamic *buf,
+                                           duk_bufwriter_ctx *bw,
                                            duk_codepoint_t cp,
                                            duk_codepoint_t prev,
                                            duk_codepoint_t next,
@@ -831,11 +831,11 @@ duk_codepoint_t duk__case_transform_helper(duk_hthread *thr,
 		bd_ctx.data = (duk_uint8_t *) duk_unicode_caseconv_lc;
 		bd_ctx.length = (duk_size_t) sizeof(duk_unicode_caseconv_lc);
 	}
-	return duk__slow_case_conversion(thr, buf, cp, &bd_ctx);
+	return duk__slow_case_conversion(thr, bw, cp, &bd_ctx);
 
  singlechar:
-	if (buf) {
-		duk_hbuffer_append_xutf8(thr, buf, cp);
+	if (bw) {
+		DUK_BW_WRITE_ENSURE_XUTF8(thr, bw, cp);
 	}
 	return cp;
 
@@ -850,27 +850,77 @@ duk_codepoint_t duk__case_transform_helper(duk_hthread *thr,
  *  Replace valstack top with case converted version.
  */
 
+/* ASCII case conversion is a plain bit flip: 'A' (0x41) <-> 'a' (0x61). */
+#define DUK__ASCII_CASE_BIT  0x20
+
+/* Fast path for pure ASCII strings (identifiers, keywords, HTTP header
+ * names, etc): no UTF-8 decoding and no case tables.  The ASCII check is a
+ * flag computed at intern time; the input is scanned once to check whether
+ * something actually changes, and if not, the input string is kept as is.  The conversion loop is
+ * branchless so that compilers can vectorize it.  Returns 0 if the input
+ * is not ASCII and the slow path must be used.
+ */
+DUK_LOCAL duk_bool_t duk__case_convert_ascii(duk_hthread *thr, duk_hstring *h_input, duk_small_int_t uppercase) {
+	duk_context *ctx = (duk_context *) thr;
+	const duk_uint8_t *p, *p_start, *p_end;
+	duk_uint8_t *q;
+	duk_uint_fast32_t lo, x;
+	duk_uint_fast32_t changes = 0;
+	duk_size_t blen;
+
+	if (!DUK_HSTRING_HAS_ASCII(h_input)) {
+		return 0;
+	}
+
+	blen = (duk_size_t) DUK_HSTRING_GET_BYTELEN(h_input);
+	p_start = (const duk_uint8_t *) DUK_HSTRING_GET_DATA(h_input);
+	p_end = p_start + blen;
+
+	/* Lowercase: convert [A-Z], uppercase: convert [a-z]. */
+	lo = (uppercase ? DUK_ASC_LC_A : DUK_ASC_UC_A);
+
+	for (p = p_start; p < p_end; p++) {
+		x = (duk_uint_fast32_t) *p;
+		changes |= ((duk_uint_fast32_t) (x - lo) < 26U);
+	}
+	if (!changes) {
+		/* [ ... input ] -> [ ... input ] */
+		return 1;
+	}
+
+	q = (duk_uint8_t *) duk_push_fixed_buffer(ctx, blen);
+	DUK_ASSERT(q != NULL);
+	for (p = p_start; p < p_end; p++) {
+		x = (duk_uint_fast32_t) *p;
+		*q++ = (duk_uint8_t) (x ^ (((duk_uint_fast32_t) (x - lo) < 26U) ? DUK__ASCII_CASE_BIT : 0));
+	}
+
+	duk_to_string(ctx, -1);
+	duk_remove(ctx, -2);
+	return 1;
+}
+
 DUK_INTERNAL void duk_unicode_case_convert_string(duk_hthread *thr, duk_small_int_t uppercase) {
 	duk_context *ctx = (duk_context *) thr;
 	duk_hstring *h_input;
-	duk_hbuffer_dynamic *h_buf;
+	duk_bufwriter_ctx bw_alloc;
+	duk_bufwriter_ctx *bw;
 	const duk_uint8_t *p, *p_start, *p_end;
 	duk_codepoint_t prev, curr, next;
 
 	h_input = duk_require_hstring(ctx, -1);
 	DUK_ASSERT(h_input != NULL);
 
-	/* XXX: should init the buffer with a spare of at least h_input->blen
-	 * to avoid unnecessary growth steps.
-	 */
-	duk_push_dynamic_buffer(ctx, 0);
-	h_buf = (duk_hbuffer_dynamic *) duk_get_hbuffer(ctx, -1);
-	DUK_ASSERT(h_buf != NULL);
-	DUK_ASSERT(DUK_HBUFFER_HAS_DYNAMIC(h_buf));
+	if (duk__case_convert_ascii(thr, h_input, uppercase)) {
+		return;
+	}
+
+	bw = &bw_alloc;
+	DUK_BW_INIT_PUSHBUF(thr, bw, DUK_HSTRING_GET_BYTELEN(h_input));
 
 	/* [ ... input buffer ] */
 
-	p_start = (duk_uint8_t *) DUK_HSTRING_GET_DATA(h_input);
+	p_start = (const duk_uint8_t *) DUK_HSTRING_GET_DATA(h_input);
 	p_end = p_start + DUK_HSTRING_GET_BYTELEN(h_input);
 	p = p_start;
 
@@ -894,7 +944,7 @@ DUK_INTERNAL void duk_unicode_case_convert_string(duk_hthread *thr, duk_small_in
 		if (curr >= 0) {
 			/* may generate any number of output codepoints */
 			duk__case_transform_helper(thr,
-			                           h_buf,
+			                           bw,
 			                           (duk_codepoint_t) curr,
 			                           prev,
 			                           next,
@@ -902,7 +952,8 @@ DUK_INTERNAL void duk_unicode_case_convert_string(duk_hthread *thr, duk_small_in
 		}
 	}
 
-	duk_to_string(ctx, -1);  /* invalidates h_buf pointer */
+	DUK_BW_FINISH(thr, bw);
+	duk_to_string(ctx, -1);
 	duk_remove(ctx, -2);
 }
 
@@ -915,11 +966,30 @@ DUK_INTERNAL void duk_unicode_case_convert_string(duk_hthread *thr, duk_small_in
  *  specific rules can apply.  Locale specific rules can apply, though.
  */
 
+/* Canonicalize() results for the ASCII range: uppercase [a-z]. */
+DUK_LOCAL const duk_uint8_t duk__re_canon_ascii[128] = {
+	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+	0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f,
+	0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f,
+	0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x3b, 0x3c, 0x3d, 0x3e, 0x3f,
+	0x40, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4a, 0x4b, 0x4c, 0x4d, 0x4e, 0x4f,
+	0x50, 0x51, 0x52, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5a, 0x5b, 0x5c, 0x5d, 0x5e, 0x5f,
+	0x60, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4a, 0x4b, 0x4c, 0x4d, 0x4e, 0x4f,
+	0x50, 0x51, 0x52, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5a, 0x7b, 0x7c, 0x7d, 0x7e, 0x7f
+};
+
 DUK_INTERNAL duk_codepoint_t duk_unicode_re_canonicalize_char(duk_hthread *thr, duk_codepoint_t cp) {
 	duk_codepoint_t y;
 
+	/* ASCII fast path: direct lookup, no case conversion helper call.
+	 * Must match the ASCII handling of duk__case_transform_helper().
+	 */
+	if (DUK_LIKELY(cp >= 0 && cp < 0x80L)) {
+		return (duk_codepoint_t) duk__re_canon_ascii[cp];
+	}
+
 	y = duk__case_transform_helper(thr,
-	                               NULL,    /* buf */
+	                               NULL,    /* bw */
 	                               cp,      /* curr char */
 	                               -1,      /* prev char */
 	                               -1,      /* next char */
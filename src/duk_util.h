@@ -34,6 +34,140 @@ struct duk_bitencoder_ctx {
 	duk_small_int_t truncated;
 };
 
+/*
+ *  Buffer writer
+ *
+ *  Helper for building output (usually a string) into a dynamic buffer.
+ *  The current write position, base and limit are cached as raw pointers
+ *  so that the common case is a single bounds check followed by direct
+ *  writes: call sites first ensure ("reserve") enough space for a small
+ *  bounded amount of data and then write it without further checks.
+ *  Growing the buffer automatically adds a spare proportional to the
+ *  current size, so the number of resizes is logarithmic in output size.
+ *
+ *  While a writer is active the whole buffer allocation is considered
+ *  writable and the buffer size is not kept up-to-date; the written data
+ *  is [p_base,p[.  The buffer is finalized by pushing the written part
+ *  as a string (or by setting the final size).  The buffer must be kept
+ *  reachable (usually in the value stack) and must not be resized by
+ *  other code while the writer is active.
+ */
+
+struct duk_bufwriter_ctx {
+	duk_uint8_t *p;
+	duk_uint8_t *p_base;
+	duk_uint8_t *p_limit;
+	duk_hbuffer_dynamic *buf;
+};
+
+#define DUK_BW_SPARE_ADD           64
+#define DUK_BW_SPARE_SHIFT         4    /* 2^4 -> 1/16 = 6.25% spare */
+
+/* Initialization and finalization. */
+#define DUK_BW_INIT_PUSHBUF(thr,bw_ctx,sz)  do { \
+		duk_bw_init_pushbuf((thr), (bw_ctx), (sz)); \
+	} while (0)
+#define DUK_BW_PUSH_AS_STRING(thr,bw_ctx)  do { \
+		duk_push_lstring((duk_context *) (thr), \
+		                 (const char *) (bw_ctx)->p_base, \
+		                 (duk_size_t) ((bw_ctx)->p - (bw_ctx)->p_base)); \
+	} while (0)
+#define DUK_BW_FINISH(thr,bw_ctx)  do { \
+		duk_bw_finish((thr), (bw_ctx)); \
+	} while (0)
+
+#if defined(DUK_USE_ASSERTIONS)
+#define DUK_BW_ASSERT_VALID(thr,bw_ctx)  do { \
+		DUK_ASSERT((bw_ctx) != NULL); \
+		DUK_ASSERT((bw_ctx)->buf != NULL); \
+		DUK_ASSERT((bw_ctx)->p_base == (duk_uint8_t *) DUK_HBUFFER_DYNAMIC_GET_DATA_PTR((thr)->heap, (bw_ctx)->buf)); \
+		DUK_ASSERT((bw_ctx)->p >= (bw_ctx)->p_base); \
+		DUK_ASSERT((bw_ctx)->p <= (bw_ctx)->p_limit); \
+	} while (0)
+#else
+#define DUK_BW_ASSERT_VALID(thr,bw_ctx)  do {} while (0)
+#endif
+
+/* Working with the pointer and current size. */
+#define DUK_BW_GET_PTR(thr,bw_ctx)  ((bw_ctx)->p)
+#define DUK_BW_SET_PTR(thr,bw_ctx,ptr)  do { \
+		(bw_ctx)->p = (ptr); \
+	} while (0)
+#define DUK_BW_GET_BASEPTR(thr,bw_ctx)  ((bw_ctx)->p_base)
+#define DUK_BW_GET_SIZE(thr,bw_ctx)  ((duk_size_t) ((bw_ctx)->p - (bw_ctx)->p_base))
+#define DUK_BW_GET_BUFFER(thr,bw_ctx)  ((bw_ctx)->buf)
+
+/* Ensure (reserve) space for at least 'sz' bytes; the GETPTR variant
+ * evaluates to the (possibly changed) write pointer.
+ */
+#define DUK_BW_ENSURE(thr,bw_ctx,sz)  do { \
+		duk_size_t duk__sz = (sz); \
+		DUK_BW_ASSERT_VALID((thr), (bw_ctx)); \
+		if (DUK_UNLIKELY((duk_size_t) ((bw_ctx)->p_limit - (bw_ctx)->p) < duk__sz)) { \
+			(void) duk_bw_resize((thr), (bw_ctx), duk__sz); \
+		} \
+	} while (0)
+#define DUK_BW_ENSURE_GETPTR(thr,bw_ctx,sz) \
+	(((duk_size_t) ((bw_ctx)->p_limit - (bw_ctx)->p) < (duk_size_t) (sz)) ? \
+		duk_bw_resize((thr), (bw_ctx), (sz)) : (bw_ctx)->p)
+
+/* Raw writes, caller has ensured space. */
+#define DUK_BW_WRITE_RAW_U8(thr,bw_ctx,val)  do { \
+		DUK_ASSERT((bw_ctx)->p < (bw_ctx)->p_limit); \
+		*(bw_ctx)->p++ = (duk_uint8_t) (val); \
+	} while (0)
+#define DUK_BW_WRITE_RAW_U8_2(thr,bw_ctx,val1,val2)  do { \
+		duk_uint8_t *duk__p; \
+		DUK_ASSERT((duk_size_t) ((bw_ctx)->p_limit - (bw_ctx)->p) >= 2); \
+		duk__p = (bw_ctx)->p; \
+		*duk__p++ = (duk_uint8_t) (val1); \
+		*duk__p++ = (duk_uint8_t) (val2); \
+		(bw_ctx)->p = duk__p; \
+	} while (0)
+#define DUK_BW_WRITE_RAW_XUTF8(thr,bw_ctx,cp)  do { \
+		DUK_ASSERT((duk_size_t) ((bw_ctx)->p_limit - (bw_ctx)->p) >= DUK_UNICODE_MAX_XUTF8_LENGTH); \
+		(bw_ctx)->p += duk_unicode_encode_xutf8((duk_ucodepoint_t) (cp), (bw_ctx)->p); \
+	} while (0)
+#define DUK_BW_WRITE_RAW_CESU8(thr,bw_ctx,cp)  do { \
+		DUK_ASSERT((duk_size_t) ((bw_ctx)->p_limit - (bw_ctx)->p) >= DUK_UNICODE_MAX_CESU8_LENGTH); \
+		(bw_ctx)->p += duk_unicode_encode_cesu8((duk_ucodepoint_t) (cp), (bw_ctx)->p); \
+	} while (0)
+#define DUK_BW_WRITE_RAW_BYTES(thr,bw_ctx,valptr,valsz)  do { \
+		duk_size_t duk__valsz = (duk_size_t) (valsz); \
+		DUK_ASSERT((duk_size_t) ((bw_ctx)->p_limit - (bw_ctx)->p) >= duk__valsz); \
+		DUK_MEMCPY((void *) ((bw_ctx)->p), (const void *) (valptr), duk__valsz); \
+		(bw_ctx)->p += duk__valsz; \
+	} while (0)
+#define DUK_BW_WRITE_RAW_HSTRING(thr,bw_ctx,val) \
+	DUK_BW_WRITE_RAW_BYTES((thr), (bw_ctx), DUK_HSTRING_GET_DATA((val)), DUK_HSTRING_GET_BYTELEN((val)))
+
+/* Writes with an implicit ensure. */
+#define DUK_BW_WRITE_ENSURE_U8(thr,bw_ctx,val)  do { \
+		DUK_BW_ENSURE((thr), (bw_ctx), 1); \
+		DUK_BW_WRITE_RAW_U8((thr), (bw_ctx), (val)); \
+	} while (0)
+#define DUK_BW_WRITE_ENSURE_U8_2(thr,bw_ctx,val1,val2)  do { \
+		DUK_BW_ENSURE((thr), (bw_ctx), 2); \
+		DUK_BW_WRITE_RAW_U8_2((thr), (bw_ctx), (val1), (val2)); \
+	} while (0)
+#define DUK_BW_WRITE_ENSURE_XUTF8(thr,bw_ctx,cp)  do { \
+		DUK_BW_ENSURE((thr), (bw_ctx), DUK_UNICODE_MAX_XUTF8_LENGTH); \
+		DUK_BW_WRITE_RAW_XUTF8((thr), (bw_ctx), (cp)); \
+	} while (0)
+#define DUK_BW_WRITE_ENSURE_CESU8(thr,bw_ctx,cp)  do { \
+		DUK_BW_ENSURE((thr), (bw_ctx), DUK_UNICODE_MAX_CESU8_LENGTH); \
+		DUK_BW_WRITE_RAW_CESU8((thr), (bw_ctx), (cp)); \
+	} while (0)
+#define DUK_BW_WRITE_ENSURE_BYTES(thr,bw_ctx,valptr,valsz)  do { \
+		duk_size_t duk__valsz2 = (duk_size_t) (valsz); \
+		DUK_BW_ENSURE((thr), (bw_ctx), duk__valsz2); \
+		DUK_BW_WRITE_RAW_BYTES((thr), (bw_ctx), (valptr), duk__valsz2); \
+	} while (0)
+#define DUK_BW_WRITE_ENSURE_HSTRING(thr,bw_ctx,val) \
+	DUK_BW_WRITE_ENSURE_BYTES((thr), (bw_ctx), DUK_HSTRING_GET_DATA((val)), DUK_HSTRING_GET_BYTELEN((val)))
+#define DUK_BW_WRITE_ENSURE_CSTRING(thr,bw_ctx,val) \
+	DUK_BW_WRITE_ENSURE_BYTES((thr), (bw_ctx), (const duk_uint8_t *) (val), DUK_STRLEN((const char *) (val)))
+
 /*
  *  Externs and prototypes
  */
@@ -42,6 +176,10 @@ struct duk_bitencoder_ctx {
 DUK_INTERNAL_DECL duk_uint8_t duk_lc_digits[36];
 DUK_INTERNAL_DECL duk_uint8_t duk_uc_nybbles[16];
 DUK_INTERNAL_DECL duk_int8_t duk_hex_dectab[256];
+#if defined(DUK_USE_HEX_FASTPATH)
+DUK_INTERNAL_DECL duk_int16_t duk_hex_dectab_shift4[256];
+DUK_INTERNAL_DECL duk_uint16_t duk_hex_enctab[256];
+#endif
 #endif  /* !DUK_SINGLE_FILE */
 
 /* Note: assumes that duk_util_probe_steps size is 32 */
@@ -64,6 +202,11 @@ DUK_INTERNAL_DECL duk_int32_t duk_bd_decode_flagged(duk_bitdecoder_ctx *ctx, duk
 DUK_INTERNAL_DECL void duk_be_encode(duk_bitencoder_ctx *ctx, duk_uint32_t data, duk_small_int_t bits);
 DUK_INTERNAL_DECL void duk_be_finish(duk_bitencoder_ctx *ctx);
 
+DUK_INTERNAL_DECL void duk_bw_init(duk_hthread *thr, duk_bufwriter_ctx *bw_ctx, duk_hbuffer_dynamic *h_buf);
+DUK_INTERNAL_DECL void duk_bw_init_pushbuf(duk_hthread *thr, duk_bufwriter_ctx *bw_ctx, duk_size_t buf_size);
+DUK_INTERNAL_DECL duk_uint8_t *duk_bw_resize(duk_hthread *thr, duk_bufwriter_ctx *bw_ctx, duk_size_t sz);
+DUK_INTERNAL_DECL void duk_bw_finish(duk_hthread *thr, duk_bufwriter_ctx *bw_ctx);
+
 DUK_INTERNAL_DECL duk_uint32_t duk_util_tinyrandom_get_bits(duk_hthread *thr, duk_small_int_t n);
 DUK_INTERNAL_DECL duk_double_t duk_util_tinyrandom_get_double(duk_hthread *thr);
 
@@ -0,0 +1,94 @@
+/*
+ *  Buffer writer (dynamic buffer only)
+ *
+ *  Macros for common operations are in duk_util.h; functions here handle
+ *  initialization, resizing and finalization.
+ */
+
+#include "duk_internal.h"
+
+DUK_LOCAL void duk__bw_update_ptrs(duk_hthread *thr, duk_bufwriter_ctx *bw_ctx, duk_size_t curr_offset, duk_size_t new_length) {
+	duk_uint8_t *p;
+
+	DUK_ASSERT(thr != NULL);
+	DUK_ASSERT(bw_ctx != NULL);
+	DUK_UNREF(thr);
+
+	p = (duk_uint8_t *) DUK_HBUFFER_DYNAMIC_GET_DATA_PTR(thr->heap, bw_ctx->buf);
+	DUK_ASSERT(p != NULL || new_length == 0);
+	bw_ctx->p = p + curr_offset;
+	bw_ctx->p_base = p;
+	bw_ctx->p_limit = p + new_length;
+}
+
+DUK_INTERNAL void duk_bw_init(duk_hthread *thr, duk_bufwriter_ctx *bw_ctx, duk_hbuffer_dynamic *h_buf) {
+	duk_size_t alloc_size;
+
+	DUK_ASSERT(thr != NULL);
+	DUK_ASSERT(bw_ctx != NULL);
+	DUK_ASSERT(h_buf != NULL);
+	DUK_ASSERT(DUK_HBUFFER_HAS_DYNAMIC(h_buf));
+
+	/* The whole allocation is writable; the buffer size is updated
+	 * to match the written data only when the writer is finished.
+	 */
+	bw_ctx->buf = h_buf;
+	alloc_size = DUK_HBUFFER_DYNAMIC_GET_ALLOC_SIZE(h_buf);
+	DUK_HBUFFER_DYNAMIC_SET_SIZE(h_buf, alloc_size);
+	duk__bw_update_ptrs(thr, bw_ctx, 0, alloc_size);
+}
+
+DUK_INTERNAL void duk_bw_init_pushbuf(duk_hthread *thr, duk_bufwriter_ctx *bw_ctx, duk_size_t buf_size) {
+	duk_context *ctx;
+
+	DUK_ASSERT(thr != NULL);
+	DUK_ASSERT(bw_ctx != NULL);
+	ctx = (duk_context *) thr;
+
+	(void) duk_push_dynamic_buffer(ctx, buf_size);
+	duk_bw_init(thr, bw_ctx, (duk_hbuffer_dynamic *) duk_get_hbuffer(ctx, -1));
+}
+
+/* Resize the buffer so that at least 'sz' bytes can be written at the
+ * current position, and return the (possibly changed) write pointer.
+ */
+DUK_INTERNAL duk_uint8_t *duk_bw_resize(duk_hthread *thr, duk_bufwriter_ctx *bw_ctx, duk_size_t sz) {
+	duk_size_t curr_off;
+	duk_size_t add_sz;
+	duk_size_t new_sz;
+
+	DUK_ASSERT(thr != NULL);
+	DUK_ASSERT(bw_ctx != NULL);
+
+	/* We could do this operation without caller updating bw_ctx->ptr,
+	 * but by writing it back here we can share code better.
+	 */
+
+	curr_off = (duk_size_t) (bw_ctx->p - bw_ctx->p_base);
+	add_sz = (curr_off >> DUK_BW_SPARE_SHIFT) + DUK_BW_SPARE_ADD;
+	new_sz = curr_off + sz + add_sz;
+	if (new_sz < curr_off) {
+		/* overflow */
+		DUK_ERROR(thr, DUK_ERR_RANGE_ERROR, DUK_STR_BUFFER_TOO_LONG);
+		return NULL;  /* not reachable */
+	}
+
+	DUK_DDD(DUK_DDDPRINT("resize bufwriter from %ld to %ld (add_sz=%ld)",
+	                     (long) (bw_ctx->p_limit - bw_ctx->p_base), (long) new_sz, (long) add_sz));
+
+	duk_hbuffer_resize(thr, bw_ctx->buf, new_sz, new_sz);
+	duk__bw_update_ptrs(thr, bw_ctx, curr_off, new_sz);
+	return bw_ctx->p;
+}
+
+/* Set the buffer size to match the written data, leaving the allocation
+ * (and any spare) as is.  The writer must not be used afterwards.
+ */
+DUK_INTERNAL void duk_bw_finish(duk_hthread *thr, duk_bufwriter_ctx *bw_ctx) {
+	DUK_ASSERT(thr != NULL);
+	DUK_ASSERT(bw_ctx != NULL);
+	DUK_BW_ASSERT_VALID(thr, bw_ctx);
+	DUK_UNREF(thr);
+
+	DUK_HBUFFER_DYNAMIC_SET_SIZE(bw_ctx->buf, (duk_size_t) (bw_ctx->p - bw_ctx->p_base));
+}
@@ -1130,6 +1130,7 @@ bi_duktape = {
 		{ 'name': 'enc',			'native': 'duk_bi_duktape_object_enc',		'length': 0,	'varargs': True },
 		{ 'name': 'dec',			'native': 'duk_bi_duktape_object_dec',		'length': 0,	'varargs': True },
 		{ 'name': 'compact',			'native': 'duk_bi_duktape_object_compact',	'length': 1 },
+		{ 'name': 'fastintStats',		'native': 'duk_bi_duktape_object_fastint_stats',	'length': 1 },
 	],
 }
 
@@ -76,6 +76,7 @@ mkdir $DIST/examples/alloc-torture
 mkdir $DIST/examples/alloc-hybrid
 mkdir $DIST/examples/debug-trans-socket
 mkdir $DIST/examples/codepage-conv
+mkdir $DIST/examples/extstr-shared
 
 # Copy most files directly
 
@@ -90,6 +91,7 @@ for i in \
 	duk_api_compile.c	\
 	duk_api_memory.c	\
 	duk_api_object.c	\
+	duk_api_serialize.c	\
 	duk_api_string.c	\
 	duk_api_var.c		\
 	duk_api_logging.c	\
@@ -185,6 +187,7 @@ for i in \
 	duk_unicode_tables.c	\
 	duk_util_bitdecoder.c	\
 	duk_util_bitencoder.c	\
+	duk_util_bufwriter.c	\
 	duk_util.h		\
 	duk_util_hashbytes.c	\
 	duk_util_hashprime.c	\
@@ -349,6 +352,15 @@ for i in \
 	cp examples/codepage-conv/$i $DIST/examples/codepage-conv/
 done
 
+for i in \
+	README.rst \
+	duk_extstr_shared.c \
+	duk_extstr_shared.h \
+	test.c \
+	; do
+	cp examples/extstr-shared/$i $DIST/examples/extstr-shared/
+done
+
 cp extras/README.rst $DIST/extras/
 # XXX: copy extras
 
@@ -981,6 +981,7 @@ def generateGuide():
 	res += processRawDoc('guide/customjson.html')
 	res += processRawDoc('guide/customdirectives.html')
 	res += processRawDoc('guide/bufferobjects.html')
+	res += processRawDoc('guide/datetime.html')
 	res += processRawDoc('guide/errorobjects.html')
 	res += processRawDoc('guide/functionobjects.html')
 	res += processRawDoc('guide/debugger.html')